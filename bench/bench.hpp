@@ -0,0 +1,290 @@
+// Minimal harness shared by the microbenchmarks.
+//
+// Every benchmark runs over a grid of container sizes and overlap
+// distributions and writes its measurements as a JSON array, so that the
+// output of two versions of the library can be diffed.
+//
+// options:
+//   --sizes=1000,100000            number of segments per container
+//   --overlap=disjoint,sparse,dense
+//   --repetitions=5                timed runs per measurement
+//   --out=file.json                write to a file instead of stdout
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/// How the generated segments overlap each other.
+enum class overlap {
+  disjoint, ///< Segments neither overlap nor touch.
+  sparse,   ///< Short segments, occasional overlaps.
+  dense     ///< Long segments, every point is covered many times.
+};
+
+inline const char* name(overlap distribution) {
+  switch (distribution) {
+  case overlap::disjoint:
+    return "disjoint";
+  case overlap::sparse:
+    return "sparse";
+  default:
+    return "dense";
+  }
+}
+
+struct options {
+  std::vector<std::size_t> sizes;
+  std::vector<overlap> overlaps{overlap::disjoint, overlap::sparse,
+                                overlap::dense};
+  std::size_t repetitions = 5;
+  std::string out;
+};
+
+namespace detail {
+inline std::vector<std::string_view> split(std::string_view list) {
+  std::vector<std::string_view> items;
+  while (!list.empty()) {
+    const std::size_t comma = std::min(list.find(','), list.size());
+    items.push_back(list.substr(0, comma));
+    list.remove_prefix(std::min(comma + 1, list.size()));
+  }
+  return items;
+}
+
+[[noreturn]] inline void usage(const char* program) {
+  std::fprintf(stderr,
+               "usage: %s [--sizes=N,...] [--overlap=disjoint,sparse,dense]"
+               " [--repetitions=N] [--out=file]\n",
+               program);
+  std::exit(2);
+}
+} // namespace detail
+
+inline options parse(int argc, char* argv[],
+                     std::vector<std::size_t> default_sizes = {1000, 100000}) {
+  options parsed;
+  parsed.sizes = std::move(default_sizes);
+  for (int arg = 1; arg < argc; ++arg) {
+    const std::string_view option = argv[arg];
+    const std::size_t equal = option.find('=');
+    if (equal == std::string_view::npos)
+      detail::usage(argv[0]);
+    const std::string_view key = option.substr(0, equal);
+    const std::string value(option.substr(equal + 1));
+
+    if (key == "--sizes") {
+      parsed.sizes.clear();
+      for (std::string_view item : detail::split(value))
+        parsed.sizes.push_back(std::strtoull(std::string(item).c_str(),
+                                             nullptr, 10));
+    } else if (key == "--overlap") {
+      parsed.overlaps.clear();
+      for (std::string_view item : detail::split(value)) {
+        if (item == "disjoint")
+          parsed.overlaps.push_back(overlap::disjoint);
+        else if (item == "sparse")
+          parsed.overlaps.push_back(overlap::sparse);
+        else if (item == "dense")
+          parsed.overlaps.push_back(overlap::dense);
+        else
+          detail::usage(argv[0]);
+      }
+    } else if (key == "--repetitions") {
+      parsed.repetitions =
+          std::max<std::size_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+    } else if (key == "--out") {
+      parsed.out = value;
+    } else {
+      detail::usage(argv[0]);
+    }
+  }
+  return parsed;
+}
+
+/// Bounds [lower, upper) of `count` segments with the given overlap, in
+/// random order. The covered domain grows with `count`, so that disjoint
+/// and dense inputs of equal size span comparable ranges.
+inline std::vector<std::pair<std::int64_t, std::int64_t>>
+bounds(std::size_t count, overlap distribution, std::uint64_t seed = 42) {
+  std::mt19937_64 gen(seed);
+  std::vector<std::pair<std::int64_t, std::int64_t>> result;
+  result.reserve(count);
+
+  const auto span = static_cast<std::int64_t>(16 * std::max<std::size_t>(
+                                                       count, 1));
+  std::uniform_int_distribution<std::int64_t> pos(0, span);
+  std::uniform_int_distribution<std::int64_t> short_len(1, 12);
+  std::uniform_int_distribution<std::int64_t> long_len(1, 1000);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    switch (distribution) {
+    case overlap::disjoint: {
+      const auto lo = static_cast<std::int64_t>(16 * i);
+      result.emplace_back(lo, lo + short_len(gen));
+      break;
+    }
+    case overlap::sparse: {
+      const std::int64_t lo = pos(gen);
+      result.emplace_back(lo, lo + short_len(gen));
+      break;
+    }
+    default: {
+      const std::int64_t lo = pos(gen);
+      result.emplace_back(lo, lo + long_len(gen));
+      break;
+    }
+    }
+  }
+  std::shuffle(result.begin(), result.end(), gen);
+  return result;
+}
+
+/// Intervals of an interval set with the given overlap.
+template <typename SetT>
+std::vector<typename SetT::interval_type>
+intervals(std::size_t count, overlap distribution, std::uint64_t seed = 42) {
+  using interval_type = typename SetT::interval_type;
+  std::vector<interval_type> result;
+  result.reserve(count);
+  for (const auto& [lo, up] : bounds(count, distribution, seed))
+    result.push_back(interval_type::right_open(lo, up));
+  return result;
+}
+
+/// Segments of an interval map with the given overlap and values in [1, 8].
+template <typename MapT>
+std::vector<typename MapT::segment_type>
+segments(std::size_t count, overlap distribution, std::uint64_t seed = 42) {
+  using interval_type = typename MapT::interval_type;
+  using codomain_type = typename MapT::codomain_type;
+  std::vector<typename MapT::segment_type> result;
+  result.reserve(count);
+  std::size_t ordinal = 0;
+  for (const auto& [lo, up] : bounds(count, distribution, seed))
+    result.emplace_back(interval_type::right_open(lo, up),
+                        static_cast<codomain_type>(++ordinal % 8 + 1));
+  return result;
+}
+
+/// An interval container with the intervals or segments of `values` added.
+template <typename Type, typename Values> Type populate(const Values& values) {
+  Type object;
+  for (const auto& value : values)
+    object.add(value);
+  return object;
+}
+
+/// Keeps the compiler from discarding computations whose results are unused.
+template <typename Type> void do_not_optimize(const Type& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static const volatile void* sink;
+  sink = &value;
+#endif
+}
+
+/// Describes one measurement.
+struct entry {
+  std::string benchmark;
+  std::string container;
+  std::size_t size = 0;
+  overlap distribution = overlap::disjoint;
+  unsigned threads = 1;
+  /// Number of operations of one run, e.g. segments added or points found.
+  std::size_t operations = 0;
+};
+
+/// Collects the results of a benchmark executable and writes them as JSON
+/// when it goes out of scope.
+class reporter {
+public:
+  explicit reporter(const options& opts) : opts_(opts) {}
+  reporter(const reporter&) = delete;
+  reporter& operator=(const reporter&) = delete;
+
+  ~reporter() {
+    std::FILE* out = opts_.out.empty() ? stdout
+                                       : std::fopen(opts_.out.c_str(), "w");
+    if (out == nullptr) {
+      std::perror(opts_.out.c_str());
+      return;
+    }
+    std::fprintf(out, "[");
+    for (std::size_t i = 0; i < results_.size(); ++i)
+      write(out, results_[i].first, results_[i].second,
+            i + 1 == results_.size());
+    std::fprintf(out, "]\n");
+    if (out != stdout)
+      std::fclose(out);
+  }
+
+  const options& opts() const { return opts_; }
+
+  /** Measures `run(setup())` for `opts().repetitions` runs. Only `run` is
+      timed, `setup` prepares a fresh operand for every run. */
+  template <typename Setup, typename Run>
+  void measure(entry info, Setup setup, Run run) {
+    std::vector<double> seconds;
+    for (std::size_t repetition = 0; repetition < opts_.repetitions;
+         ++repetition) {
+      auto operand = setup();
+      const auto start = std::chrono::steady_clock::now();
+      run(operand);
+      const auto stop = std::chrono::steady_clock::now();
+      do_not_optimize(operand);
+      seconds.push_back(std::chrono::duration<double>(stop - start).count());
+    }
+    results_.emplace_back(std::move(info), std::move(seconds));
+  }
+
+  /// Measures `run()` without a per-run setup.
+  template <typename Run> void measure(entry info, Run run) {
+    measure(std::move(info), [] { return 0; }, [&](int) { run(); });
+  }
+
+private:
+  static void write_string(std::FILE* out, std::string_view text) {
+    std::fputc('"', out);
+    for (const char ch : text) {
+      if (ch == '"' || ch == '\\')
+        std::fputc('\\', out);
+      std::fputc(ch, out);
+    }
+    std::fputc('"', out);
+  }
+
+  static void write(std::FILE* out, const entry& info,
+                    std::vector<double> seconds, bool last) {
+    std::sort(seconds.begin(), seconds.end());
+    const double per_op =
+        1e9 / static_cast<double>(std::max<std::size_t>(info.operations, 1));
+
+    std::fprintf(out, "\n  {\"benchmark\": ");
+    write_string(out, info.benchmark);
+    std::fprintf(out, ", \"container\": ");
+    write_string(out, info.container);
+    std::fprintf(out,
+                 ", \"size\": %zu, \"overlap\": \"%s\", \"threads\": %u"
+                 ", \"operations\": %zu, \"repetitions\": %zu"
+                 ", \"ns_per_op_min\": %.3f, \"ns_per_op_median\": %.3f}%s",
+                 info.size, name(info.distribution), info.threads,
+                 info.operations, seconds.size(), seconds.front() * per_op,
+                 seconds[seconds.size() / 2] * per_op, last ? "\n" : ",");
+  }
+
+  options opts_;
+  std::vector<std::pair<entry, std::vector<double>>> results_;
+};
+
+} // namespace bench
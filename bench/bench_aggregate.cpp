@@ -0,0 +1,65 @@
+// Range aggregation over interval maps. "aggregate" queries an augmented map
+// for the length weighted sum of an interval, "aggregate_walk" computes the
+// same over the equal_range of a plain interval_map. One operation is one
+// query of a random interval that spans about 1% of the domain.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using domain_type = std::int64_t;
+using codomain_type = std::int64_t;
+using plain_map = icl::interval_map<domain_type, codomain_type>;
+using augmented_map = icl::augmented_interval_map<domain_type, codomain_type>;
+using interval_type = plain_map::interval_type;
+
+std::vector<interval_type> queries(std::size_t size, std::size_t count) {
+  const auto span = static_cast<domain_type>(16 * size);
+  std::mt19937_64 gen(7);
+  std::uniform_int_distribution<domain_type> pos(0, span);
+  std::vector<interval_type> result;
+  for (std::size_t i = 0; i < count; ++i) {
+    const domain_type lo = pos(gen);
+    result.push_back(interval_type::right_open(lo, lo + span / 100 + 1));
+  }
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  constexpr std::size_t count = 1000;
+
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto values = bench::segments<plain_map>(size, distribution);
+      const plain_map plain = bench::populate<plain_map>(values);
+      const augmented_map augmented = bench::populate<augmented_map>(values);
+      const std::vector<interval_type> ranges = queries(size, count);
+
+      report.measure(
+          {"aggregate", "augmented_interval_map", size, distribution, 1,
+           count},
+          [&] {
+            codomain_type sum = 0;
+            for (const interval_type& range : ranges)
+              sum += augmented.aggregate(range, icl::aggregate_weighted_sum);
+            bench::do_not_optimize(sum);
+          });
+
+      report.measure(
+          {"aggregate_walk", "interval_map", size, distribution, 1, count},
+          [&] {
+            codomain_type sum = 0;
+            for (const interval_type& range : ranges) {
+              const auto exterior = plain.equal_range(range);
+              for (auto it_ = exterior.first; it_ != exterior.second; ++it_)
+                sum += (*it_).second *
+                       static_cast<codomain_type>(
+                           icl::length((*it_).first & range));
+            }
+            bench::do_not_optimize(sum);
+          });
+    }
+  return 0;
+}
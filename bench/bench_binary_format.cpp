@@ -0,0 +1,82 @@
+// Storing and loading interval containers in the binary format. One
+// operation of "write_binary" and "read_binary" is one segment written to
+// or read from a file, "read_binary" rebuilds the container. One operation
+// of "open_mapped" is the opening of a mapped_view of the file, that does
+// not read the segments. One operation of "find_mapped" is the lookup of a
+// random point in an opened view.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/mapped_file.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+std::vector<std::int64_t> points(std::size_t count) {
+  std::mt19937_64 gen(7);
+  std::uniform_int_distribution<std::int64_t> pos(
+      0, static_cast<std::int64_t>(16 * count));
+  std::vector<std::int64_t> result(count);
+  for (std::int64_t& point : result)
+    point = pos(gen);
+  return result;
+}
+
+template <typename Type, typename Values>
+void run(bench::reporter& report, const char* container, Values values) {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "icl_bench_binary_format.bin";
+
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const Type object = bench::populate<Type>(values(size, distribution));
+      const std::size_t segments = object.iterative_size();
+
+      report.measure(
+          {"write_binary", container, size, distribution, 1, segments}, [&] {
+            std::ofstream file(path, std::ios::binary);
+            icl::write_binary(file, object);
+          });
+
+      report.measure(
+          {"read_binary", container, size, distribution, 1, segments}, [&] {
+            const icl::mapped_file file(path);
+            bench::do_not_optimize(icl::read_binary<Type>(file.bytes()));
+          });
+
+      report.measure({"open_mapped", container, size, distribution, 1, 1},
+                     [&] {
+                       const icl::mapped_view<Type> view(path);
+                       bench::do_not_optimize(view.iterative_size());
+                     });
+
+      const icl::mapped_view<Type> view(path);
+      const std::vector<std::int64_t> lookups = points(size);
+      report.measure({"find_mapped", container, size, distribution, 1, size},
+                     [&] {
+                       std::size_t found = 0;
+                       for (const std::int64_t point : lookups)
+                         found += view.find(point) != view.end();
+                       bench::do_not_optimize(found);
+                     });
+    }
+  std::filesystem::remove(path);
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_set<domain_type>>(
+      report, "interval_set", [](std::size_t size, bench::overlap overlap) {
+        return bench::intervals<icl::interval_set<domain_type>>(size,
+                                                                overlap);
+      });
+  run<icl::interval_map<domain_type, std::int64_t>>(
+      report, "interval_map", [](std::size_t size, bench::overlap overlap) {
+        return bench::segments<icl::interval_map<domain_type, std::int64_t>>(
+            size, overlap);
+      });
+  return 0;
+}
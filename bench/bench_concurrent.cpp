@@ -0,0 +1,113 @@
+// Point lookups on an interval map shared by an increasing number of reader
+// threads, while one writer thread adds and subtracts segments: through
+// `icl::concurrent`, whose readers take no lock, and through an interval
+// map guarded by a `std::shared_mutex`. One operation is one lookup.
+#include "bench.hpp"
+#include "icl/concurrent.hpp"
+#include "icl/interval_map.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/// An interval map guarded by a reader writer lock.
+template <typename MapT> class locked {
+public:
+  explicit locked(const MapT& object) : _object(object) {}
+
+  typename MapT::codomain_type
+  operator()(const typename MapT::domain_type& key) const {
+    const std::shared_lock lock(_mutex);
+    return _object(key);
+  }
+
+  void add(const typename MapT::segment_type& segment) {
+    const std::unique_lock lock(_mutex);
+    _object.add(segment);
+  }
+
+  void subtract(const typename MapT::segment_type& segment) {
+    const std::unique_lock lock(_mutex);
+    _object.subtract(segment);
+  }
+
+private:
+  MapT _object;
+  mutable std::shared_mutex _mutex;
+};
+
+/// Runs `readers` threads of `lookups` lookups each, while one writer
+/// updates `shared` until they are done.
+template <typename Shared, typename Segments>
+void lookups_while_writing(Shared& shared, const Segments& segments,
+                           unsigned readers, std::size_t lookups,
+                           std::int64_t span) {
+  std::atomic<unsigned> reading{readers};
+  std::thread writer([&] {
+    for (std::size_t i = 0; reading > 0; i = (i + 1) % segments.size()) {
+      shared.add(segments[i]);
+      shared.subtract(segments[i]);
+    }
+  });
+  std::vector<std::thread> threads;
+  for (unsigned reader = 0; reader < readers; ++reader)
+    threads.emplace_back([&, reader] {
+      std::mt19937_64 gen(reader);
+      std::uniform_int_distribution<std::int64_t> pos(0, span);
+      std::int64_t sum = 0;
+      for (std::size_t i = 0; i < lookups; ++i)
+        sum += shared(pos(gen));
+      bench::do_not_optimize(sum);
+      --reading;
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+  writer.join();
+}
+
+template <typename MapT>
+void run(bench::reporter& report, const char* container) {
+  constexpr std::size_t lookups = 100'000;
+  const unsigned max_threads =
+      std::max(4u, std::thread::hardware_concurrency());
+
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto segments = bench::segments<MapT>(size, distribution);
+      const auto object = bench::populate<MapT>(segments);
+      const auto span = static_cast<std::int64_t>(16 * size);
+      const auto updates =
+          bench::segments<MapT>(std::min<std::size_t>(size, 1000),
+                                distribution, 43);
+
+      for (unsigned threads = 1;;
+           threads = std::min(2 * threads, max_threads)) {
+        icl::concurrent<MapT> shared(object);
+        report.measure({"lookup_concurrent", container, size, distribution,
+                        threads, threads * lookups},
+                       [&] {
+                         lookups_while_writing(shared, updates, threads,
+                                               lookups, span);
+                       });
+        locked<MapT> guarded(object);
+        report.measure({"lookup_shared_mutex", container, size, distribution,
+                        threads, threads * lookups},
+                       [&] {
+                         lookups_while_writing(guarded, updates, threads,
+                                               lookups, span);
+                       });
+        if (threads == max_threads)
+          break;
+      }
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<std::int64_t, std::int64_t>>(report, "interval_map");
+  return 0;
+}
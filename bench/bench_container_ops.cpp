@@ -0,0 +1,58 @@
+// Container on container operations `+=`, `&=` and `-=` of two containers
+// of the same size. One operation is one segment of the operand.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <cstdint>
+
+template <typename Type, typename Values>
+void run(bench::reporter& report, const char* container, Values values) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const Type object = bench::populate<Type>(values(size, distribution, 42));
+      const Type operand =
+          bench::populate<Type>(values(size, distribution, 43));
+      const std::size_t operations = operand.iterative_size();
+      const auto copy = [&] { return object; };
+
+      report.measure({"+=", container, size, distribution, 1, operations},
+                     copy, [&](Type& result) { result += operand; });
+      report.measure({"&=", container, size, distribution, 1, operations},
+                     copy, [&](Type& result) { result &= operand; });
+      report.measure({"-=", container, size, distribution, 1, operations},
+                     copy, [&](Type& result) { result -= operand; });
+    }
+}
+
+template <typename SetT>
+void run_set(bench::reporter& report, const char* container) {
+  run<SetT>(report, container,
+            [](std::size_t size, bench::overlap overlap, std::uint64_t seed) {
+              return bench::intervals<SetT>(size, overlap, seed);
+            });
+}
+
+template <typename MapT>
+void run_map(bench::reporter& report, const char* container) {
+  run<MapT>(report, container,
+            [](std::size_t size, bench::overlap overlap, std::uint64_t seed) {
+              return bench::segments<MapT>(size, overlap, seed);
+            });
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run_set<icl::interval_set<domain_type>>(report, "interval_set");
+  run_set<icl::split_interval_set<domain_type>>(report, "split_interval_set");
+  run_set<icl::flat_interval_set<domain_type>>(report, "flat_interval_set");
+  run_map<icl::interval_map<domain_type, std::int64_t>>(report,
+                                                        "interval_map");
+  run_map<icl::split_interval_map<domain_type, std::int64_t>>(
+      report, "split_interval_map");
+  run_map<icl::flat_interval_map<domain_type, std::int64_t>>(
+      report, "flat_interval_map");
+  return 0;
+}
@@ -0,0 +1,57 @@
+// Traversal of interval containers element by element with
+// `element_iterator`. One operation is one element visited.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/split_interval_set.hpp"
+#include <cstdint>
+#include <iterator>
+
+template <typename Type, typename Values>
+void run(bench::reporter& report, const char* container, Values values) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const Type object = bench::populate<Type>(values(size, distribution));
+      const auto operations = static_cast<std::size_t>(std::distance(
+          icl::elements_begin(object), icl::elements_end(object)));
+
+      report.measure({"element_iterator", container, size, distribution, 1,
+                      operations},
+                     [&] {
+                       std::size_t visited = 0;
+                       for (auto it_ = icl::elements_begin(object);
+                            it_ != icl::elements_end(object); ++it_) {
+                         bench::do_not_optimize(*it_);
+                         ++visited;
+                       }
+                       bench::do_not_optimize(visited);
+                     });
+    }
+}
+
+template <typename SetT>
+void run_set(bench::reporter& report, const char* container) {
+  run<SetT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::intervals<SetT>(size, overlap);
+  });
+}
+
+template <typename MapT>
+void run_map(bench::reporter& report, const char* container) {
+  run<MapT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::segments<MapT>(size, overlap);
+  });
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv, {1000, 10000}));
+  run_set<icl::interval_set<domain_type>>(report, "interval_set");
+  run_set<icl::split_interval_set<domain_type>>(report, "split_interval_set");
+  run_set<icl::flat_interval_set<domain_type>>(report, "flat_interval_set");
+  run_map<icl::interval_map<domain_type, std::int64_t>>(report,
+                                                        "interval_map");
+  run_map<icl::flat_interval_map<domain_type, std::int64_t>>(
+      report, "flat_interval_map");
+  return 0;
+}
@@ -0,0 +1,135 @@
+// The comparator of interval containers. "generic" orders intervals by
+// non_empty::exclusive_less, the path that inspects the bounds, "fast" by
+// exclusive_less_than, that is specialised for right-open integral
+// intervals, and "bits" orders dynamically bounded intervals by the last and
+// first element derived from the bound bits, the alternative that
+// exclusive_less_than does not take. One operation is one lookup of a random
+// point, by a binary search over a sorted vector ("_vector") and by a
+// descent of a std::set ("_tree"). The disjoint intervals of the containers
+// are given mixed bounds.
+#include "bench.hpp"
+#include "icl/compact_discrete_interval.hpp"
+#include "icl/detail/exclusive_less_than.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_set.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+template <typename IntervalT> struct generic_less {
+  bool operator()(const IntervalT& left, const IntervalT& right) const {
+    return icl::non_empty::exclusive_less(left, right);
+  }
+};
+
+template <typename IntervalT> struct bits_less {
+  bool operator()(const IntervalT& left, const IntervalT& right) const {
+    using domain_type = icl::interval_traits<IntervalT>::domain_type;
+    const icl::bound_type left_bits = left.bounds().bits();
+    const icl::bound_type right_bits = right.bounds().bits();
+    const auto last_ = static_cast<domain_type>(
+        icl::upper(left) -
+        static_cast<domain_type>(~left_bits & icl::interval_bounds::_right));
+    const auto first_ = static_cast<domain_type>(
+        icl::lower(right) +
+        static_cast<domain_type>((~right_bits & icl::interval_bounds::_left) >>
+                                 1));
+    return last_ < first_;
+  }
+};
+
+/// The joined intervals of a set, each stated with random bounds
+template <typename IntervalT>
+std::vector<IntervalT> disjoint(std::size_t size, bench::overlap overlap) {
+  using plain_set = icl::interval_set<std::int64_t>;
+
+  const auto joined =
+      bench::populate<plain_set>(bench::intervals<plain_set>(size, overlap));
+  std::mt19937_64 gen(11);
+  std::uniform_int_distribution<int> bounds(0, 3);
+  std::vector<IntervalT> result;
+  for (const auto& inter_val : joined) {
+    const std::int64_t first = icl::first(inter_val);
+    const std::int64_t last = icl::last(inter_val);
+    switch (bounds(gen)) {
+    case 0:
+      result.push_back(IntervalT::closed(first, last));
+      break;
+    case 1:
+      result.push_back(IntervalT::open(first - 1, last + 1));
+      break;
+    case 2:
+      result.push_back(IntervalT::left_open(first - 1, last));
+      break;
+    default:
+      result.push_back(IntervalT::right_open(first, last + 1));
+      break;
+    }
+  }
+  return result;
+}
+
+std::vector<std::int64_t> points(std::size_t count) {
+  std::mt19937_64 gen(7);
+  std::uniform_int_distribution<std::int64_t> pos(
+      0, static_cast<std::int64_t>(16 * count));
+  std::vector<std::int64_t> result(count);
+  for (std::int64_t& point : result)
+    point = pos(gen);
+  return result;
+}
+
+template <typename IntervalT, typename Compare>
+void run(bench::reporter& report, const char* benchmark,
+         const char* container) {
+  const std::string vector_name = std::string(benchmark) + "_vector";
+  const std::string tree_name = std::string(benchmark) + "_tree";
+
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const std::vector<IntervalT> sorted =
+          disjoint<IntervalT>(size, distribution);
+      const std::set<IntervalT, Compare> tree(sorted.begin(), sorted.end());
+      std::vector<IntervalT> probes;
+      for (const std::int64_t point : points(size))
+        probes.push_back(IntervalT::closed(point, point));
+
+      report.measure(
+          {vector_name, container, size, distribution, 1, probes.size()},
+          [&] {
+            std::size_t found = 0;
+            for (const IntervalT& probe : probes) {
+              const auto it_ = std::lower_bound(sorted.begin(), sorted.end(),
+                                                probe, Compare());
+              found += it_ != sorted.end() && !Compare()(probe, *it_);
+            }
+            bench::do_not_optimize(found);
+          });
+
+      report.measure(
+          {tree_name, container, size, distribution, 1, probes.size()}, [&] {
+            std::size_t found = 0;
+            for (const IntervalT& probe : probes)
+              found += tree.find(probe) != tree.end();
+            bench::do_not_optimize(found);
+          });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+
+  using discrete_type = icl::discrete_interval<std::int64_t>;
+  using compact_type = icl::compact_discrete_interval<std::int64_t>;
+  run<discrete_type, generic_less<discrete_type>>(report, "generic",
+                                                  "discrete_interval");
+  run<discrete_type, bits_less<discrete_type>>(report, "bits",
+                                               "discrete_interval");
+  run<compact_type, generic_less<compact_type>>(report, "generic",
+                                                "compact_discrete_interval");
+  run<compact_type, icl::exclusive_less_than<compact_type>>(
+      report, "fast", "compact_discrete_interval");
+  return 0;
+}
@@ -0,0 +1,45 @@
+// The expression `(a + b - c) & d` on four interval maps of the same size,
+// computed by the operators with a container per operator, or as a lazy
+// expression in one sweep. One operation is one segment of the operands.
+#include "bench.hpp"
+#include "icl/expression.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/split_interval_map.hpp"
+#include <cstdint>
+
+template <typename MapT>
+void run(bench::reporter& report, const char* container) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const MapT a =
+          bench::populate<MapT>(bench::segments<MapT>(size, distribution, 1));
+      const MapT b =
+          bench::populate<MapT>(bench::segments<MapT>(size, distribution, 2));
+      const MapT c =
+          bench::populate<MapT>(bench::segments<MapT>(size, distribution, 3));
+      const MapT d =
+          bench::populate<MapT>(bench::segments<MapT>(size, distribution, 4));
+      const std::size_t operations = a.iterative_size() + b.iterative_size() +
+                                     c.iterative_size() + d.iterative_size();
+
+      report.measure(
+          {"operators", container, size, distribution, 1, operations}, [&] {
+            const MapT result = (a + b - c) & d;
+            bench::do_not_optimize(result.iterative_size());
+          });
+      report.measure({"lazy", container, size, distribution, 1, operations},
+                     [&] {
+                       const MapT result = (icl::lazy(a) + b - c) & d;
+                       bench::do_not_optimize(result.iterative_size());
+                     });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<domain_type, std::int64_t>>(report, "interval_map");
+  run<icl::split_interval_map<domain_type, std::int64_t>>(
+      report, "split_interval_map");
+  return 0;
+}
@@ -0,0 +1,118 @@
+// Point lookup with `find` on each interval container. One operation is one
+// lookup of a random point of the covered domain. "find_batched" passes all
+// points to the batched find at once, "find_batched_sorted" sorted ones.
+// Containers on contiguous storage are searched through a bound_index as
+// well, "find_indexed" by one point at a time, "find_indexed_batched" by all.
+// "find_frozen" searches the snapshot that freeze() takes of a container.
+#include "bench.hpp"
+#include "icl/bound_index.hpp"
+#include "icl/frozen.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+std::vector<std::int64_t> points(std::size_t count) {
+  std::mt19937_64 gen(7);
+  std::uniform_int_distribution<std::int64_t> pos(
+      0, static_cast<std::int64_t>(16 * count));
+  std::vector<std::int64_t> result(count);
+  for (std::int64_t& point : result)
+    point = pos(gen);
+  return result;
+}
+
+template <typename Type, typename Values>
+void run(bench::reporter& report, const char* container, Values values) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const Type object = bench::populate<Type>(values(size, distribution));
+      const std::vector<std::int64_t> lookups = points(size);
+
+      report.measure({"find", container, size, distribution, 1, size}, [&] {
+        std::size_t found = 0;
+        for (const std::int64_t point : lookups)
+          found += object.find(point) != object.end();
+        bench::do_not_optimize(found);
+      });
+
+      std::vector<typename Type::const_iterator> found(size);
+      report.measure({"find_batched", container, size, distribution, 1, size},
+                     [&] {
+                       object.find(lookups, found);
+                       bench::do_not_optimize(found.data());
+                     });
+
+      std::vector<std::int64_t> sorted = lookups;
+      std::sort(sorted.begin(), sorted.end());
+      report.measure(
+          {"find_batched_sorted", container, size, distribution, 1, size},
+          [&] {
+            object.find(icl::sorted_points, sorted, found);
+            bench::do_not_optimize(found.data());
+          });
+
+      const icl::frozen<Type> snapshot = object.freeze();
+      report.measure({"find_frozen", container, size, distribution, 1, size},
+                     [&] {
+                       std::size_t found = 0;
+                       for (const std::int64_t point : lookups)
+                         found += snapshot.find(point) != snapshot.end();
+                       bench::do_not_optimize(found);
+                     });
+
+      if constexpr (icl::bound_indexable<Type>) {
+        const icl::bound_index<Type> index(object);
+        report.measure(
+            {"find_indexed", container, size, distribution, 1, size}, [&] {
+              std::size_t found = 0;
+              for (const std::int64_t point : lookups)
+                found += index.find(point) != object.end();
+              bench::do_not_optimize(found);
+            });
+
+        report.measure(
+            {"find_indexed_batched", container, size, distribution, 1, size},
+            [&] {
+              index.find(lookups, found);
+              bench::do_not_optimize(found.data());
+            });
+      }
+    }
+}
+
+template <typename SetT>
+void run_set(bench::reporter& report, const char* container) {
+  run<SetT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::intervals<SetT>(size, overlap);
+  });
+}
+
+template <typename MapT>
+void run_map(bench::reporter& report, const char* container) {
+  run<MapT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::segments<MapT>(size, overlap);
+  });
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run_set<icl::interval_set<domain_type>>(report, "interval_set");
+  run_set<icl::separate_interval_set<domain_type>>(report,
+                                                   "separate_interval_set");
+  run_set<icl::split_interval_set<domain_type>>(report, "split_interval_set");
+  run_set<icl::flat_interval_set<domain_type>>(report, "flat_interval_set");
+  run_map<icl::interval_map<domain_type, std::int64_t>>(report,
+                                                        "interval_map");
+  run_map<icl::split_interval_map<domain_type, std::int64_t>>(
+      report, "split_interval_map");
+  run_map<icl::flat_interval_map<domain_type, std::int64_t>>(
+      report, "flat_interval_map");
+  return 0;
+}
@@ -0,0 +1,71 @@
+// Interval multimaps of records with the overlaps of `bench::bounds`:
+// construction in bulk and by single insertions, and overlap queries
+// answered by the interval tree or by a scan over the records sorted by
+// their lower bounds, that stops at the first record behind the query.
+// One operation is one record for the constructions and one query for the
+// queries.
+#include "bench.hpp"
+#include "icl/interval_multimap.hpp"
+#include <cstdint>
+#include <vector>
+
+template <typename MultimapT>
+void run(bench::reporter& report, const char* container) {
+  using interval_type = typename MultimapT::interval_type;
+  using segment_type = typename MultimapT::segment_type;
+  constexpr std::size_t queries = 1000;
+
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      std::vector<segment_type> records;
+      for (const auto& [lo, up] : bench::bounds(size, distribution, 42))
+        records.emplace_back(interval_type::right_open(lo, up), lo);
+      // Queries of the lengths of the records, spread over their domain
+      const auto scale = static_cast<std::int64_t>(size / queries + 1);
+      std::vector<interval_type> probes;
+      for (const auto& [lo, up] : bench::bounds(queries, distribution, 43))
+        probes.push_back(
+            interval_type::right_open(lo * scale, lo * scale + up - lo));
+
+      report.measure({"bulk", container, size, distribution, 1, size}, [&] {
+        const MultimapT object(records.begin(), records.end());
+        bench::do_not_optimize(object.size());
+      });
+      report.measure({"insert", container, size, distribution, 1, size}, [&] {
+        MultimapT object;
+        for (const segment_type& record : records)
+          object.insert(record);
+        bench::do_not_optimize(object.size());
+      });
+
+      const MultimapT object(records.begin(), records.end());
+      const std::vector<segment_type> sorted(object.begin(), object.end());
+      report.measure(
+          {"overlapping", container, size, distribution, 1, queries}, [&] {
+            std::size_t found = 0;
+            for (const interval_type& probe : probes)
+              for (const auto& record : object.overlapping(probe))
+                found += record.second != 0;
+            bench::do_not_optimize(found);
+          });
+      report.measure(
+          {"sorted_scan", container, size, distribution, 1, queries}, [&] {
+            std::size_t found = 0;
+            for (const interval_type& probe : probes)
+              for (const segment_type& record : sorted) {
+                if (icl::exclusive_less(probe, record.first))
+                  break;
+                if (icl::intersects(record.first, probe))
+                  found += record.second != 0;
+              }
+            bench::do_not_optimize(found);
+          });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_multimap<std::int64_t, std::int64_t>>(report,
+                                                          "interval_multimap");
+  return 0;
+}
@@ -0,0 +1,88 @@
+// Segment updates on interval maps with a set valued codomain: `add` and
+// `insert` of segments that are copied from a vector, or moved out of it.
+// One operation is one segment.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/split_interval_map.hpp"
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// A set of names, that are combined by union.
+struct tag_set {
+  std::set<std::string> names;
+
+  tag_set& operator+=(const tag_set& other) {
+    names.insert(other.names.begin(), other.names.end());
+    return *this;
+  }
+  tag_set& operator-=(const tag_set& other) {
+    for (const std::string& name : other.names)
+      names.erase(name);
+    return *this;
+  }
+  friend bool operator==(const tag_set&, const tag_set&) = default;
+  friend auto operator<=>(const tag_set&, const tag_set&) = default;
+};
+
+/// The segments of `bench::segments` with sets of four names as values.
+template <typename MapT>
+std::vector<typename MapT::segment_type>
+tagged_segments(std::size_t size, bench::overlap distribution) {
+  std::vector<typename MapT::segment_type> result;
+  result.reserve(size);
+  for (const auto& [lo, up] : bench::bounds(size, distribution, 42)) {
+    tag_set tags;
+    for (std::int64_t name = 0; name < 4; ++name)
+      tags.names.insert("tenant-" + std::to_string((lo + name * 7) % 64));
+    result.emplace_back(MapT::interval_type::right_open(lo, up),
+                        std::move(tags));
+  }
+  return result;
+}
+
+template <typename MapT>
+void run(bench::reporter& report, const char* container) {
+  using segment_type = typename MapT::segment_type;
+  struct operand {
+    MapT object;
+    std::vector<segment_type> segments;
+  };
+
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto segments = tagged_segments<MapT>(size, distribution);
+      const auto setup = [&] { return operand{MapT(), segments}; };
+
+      report.measure({"add", container, size, distribution, 1, size}, setup,
+                     [](operand& updated) {
+                       for (const segment_type& segment : updated.segments)
+                         updated.object.add(segment);
+                     });
+      report.measure({"add&&", container, size, distribution, 1, size}, setup,
+                     [](operand& updated) {
+                       for (segment_type& segment : updated.segments)
+                         updated.object.add(std::move(segment));
+                     });
+      report.measure({"insert", container, size, distribution, 1, size},
+                     setup, [](operand& updated) {
+                       for (const segment_type& segment : updated.segments)
+                         updated.object.insert(segment);
+                     });
+      report.measure({"insert&&", container, size, distribution, 1, size},
+                     setup, [](operand& updated) {
+                       for (segment_type& segment : updated.segments)
+                         updated.object.insert(std::move(segment));
+                     });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<std::int64_t, tag_set>>(report, "interval_map");
+  run<icl::split_interval_map<std::int64_t, tag_set>>(report,
+                                                      "split_interval_map");
+  return 0;
+}
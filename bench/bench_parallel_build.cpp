@@ -0,0 +1,66 @@
+// Bulk construction of interval containers from unsorted ranges,
+// sequentially and in parallel with an increasing number of threads. One
+// operation is one segment of the input.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <thread>
+
+#if __has_include(<tbb/global_control.h>)
+#include <tbb/global_control.h>
+#define ICL_BENCH_HAS_THREAD_CONTROL 1
+#endif
+
+template <typename Type, typename Values>
+void run(bench::reporter& report, const char* container, Values values) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto input = values(size, distribution);
+
+      report.measure({"build", container, size, distribution, 1, size}, [&] {
+        const Type object(input.begin(), input.end());
+        bench::do_not_optimize(object);
+      });
+
+      const unsigned max_threads =
+          std::max(1u, std::thread::hardware_concurrency());
+      for (unsigned threads = 1;;
+           threads = std::min(2 * threads, max_threads)) {
+#ifdef ICL_BENCH_HAS_THREAD_CONTROL
+        tbb::global_control limit(
+            tbb::global_control::max_allowed_parallelism, threads);
+#else
+        threads = max_threads; // The number of threads is up to the library
+#endif
+        report.measure(
+            {"build_parallel", container, size, distribution, threads, size},
+            [&] {
+              const Type object(std::execution::par, input.begin(),
+                                input.end());
+              bench::do_not_optimize(object);
+            });
+        if (threads == max_threads)
+          break;
+      }
+    }
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  using set_type = icl::interval_set<domain_type>;
+  using map_type = icl::interval_map<domain_type, std::int64_t>;
+
+  bench::reporter report(bench::parse(argc, argv, {1'000'000}));
+  run<set_type>(report, "interval_set",
+                [](std::size_t size, bench::overlap overlap) {
+                  return bench::intervals<set_type>(size, overlap);
+                });
+  run<map_type>(report, "interval_map",
+                [](std::size_t size, bench::overlap overlap) {
+                  return bench::segments<map_type>(size, overlap);
+                });
+  return 0;
+}
@@ -0,0 +1,70 @@
+// Versions of an interval map, each a snapshot followed by one update: of
+// `icl::persistent`, whose snapshots take constant time and whose updates
+// copy a path of its tree, and of an interval map that is copied for each
+// snapshot. The snapshots are kept, as a reader would keep them. Besides,
+// the cost of the updates alone, to `icl::persistent` and to the map. One
+// operation is one update.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/persistent.hpp"
+#include <cstdint>
+#include <vector>
+
+template <typename MapT>
+void run(bench::reporter& report, const char* container) {
+  constexpr std::size_t versions = 200;
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto segments = bench::segments<MapT>(size, distribution);
+      const auto updates =
+          bench::segments<MapT>(versions, distribution, /*seed=*/7);
+      MapT plain;
+      for (const auto& segment : segments)
+        plain.add(segment);
+      const icl::persistent<MapT> object(plain);
+
+      report.measure(
+          {"versions_persistent", container, size, distribution, 1, versions},
+          [&] { return object; },
+          [&](icl::persistent<MapT>& current) {
+            std::vector<icl::persistent<MapT>> kept;
+            kept.reserve(versions);
+            for (const auto& segment : updates) {
+              kept.push_back(current.snapshot());
+              current.add(segment);
+            }
+          });
+      report.measure(
+          {"versions_copy", container, size, distribution, 1, versions},
+          [&] { return plain; },
+          [&](MapT& current) {
+            std::vector<MapT> kept;
+            kept.reserve(versions);
+            for (const auto& segment : updates) {
+              kept.push_back(current);
+              current.add(segment);
+            }
+          });
+
+      report.measure(
+          {"add_persistent", container, size, distribution, 1, versions},
+          [&] { return object; },
+          [&](icl::persistent<MapT>& current) {
+            for (const auto& segment : updates)
+              current.add(segment);
+          });
+      report.measure(
+          {"add_plain", container, size, distribution, 1, versions},
+          [&] { return plain; },
+          [&](MapT& current) {
+            for (const auto& segment : updates)
+              current.add(segment);
+          });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<std::int64_t, std::int64_t>>(report, "interval_map");
+  return 0;
+}
@@ -0,0 +1,74 @@
+// Streaming interval maps through the segment stream format into memory.
+// One operation of "write_segments" and "read_segments" is one segment
+// written or read. One operation of "merge_segments" is one segment of the
+// two input streams, that are merged in blocks; "operator+=" adds the same
+// maps in memory for comparison.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/segment_stream.hpp"
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+template <typename Type>
+void run(bench::reporter& report, const char* container) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const Type left =
+          bench::populate<Type>(bench::segments<Type>(size, distribution, 1));
+      const Type right =
+          bench::populate<Type>(bench::segments<Type>(size, distribution, 2));
+      const std::size_t segments = left.iterative_size();
+
+      report.measure(
+          {"write_segments", container, size, distribution, 1, segments},
+          [&] {
+            std::ostringstream stream;
+            icl::write_segments(stream, left);
+            bench::do_not_optimize(stream.tellp());
+          });
+
+      std::ostringstream left_stream;
+      std::ostringstream right_stream;
+      icl::write_segments(left_stream, left);
+      icl::write_segments(right_stream, right);
+      const std::string left_data = left_stream.str();
+      const std::string right_data = right_stream.str();
+
+      report.measure(
+          {"read_segments", container, size, distribution, 1, segments}, [&] {
+            std::istringstream stream(left_data);
+            icl::segment_reader<Type> reader(stream);
+            std::size_t count = 0;
+            for (const auto& segment : reader)
+              count += segment.second != 0;
+            bench::do_not_optimize(count);
+          });
+
+      const std::size_t operands = segments + right.iterative_size();
+      report.measure(
+          {"merge_segments", container, size, distribution, 1, operands},
+          [&] {
+            std::istringstream left_input(left_data);
+            std::istringstream right_input(right_data);
+            std::ostringstream merged;
+            icl::merge_segments<Type>(left_input, right_input, merged);
+            bench::do_not_optimize(merged.tellp());
+          });
+
+      report.measure(
+          {"operator+=", container, size, distribution, 1, operands},
+          [&] { return left; },
+          [&](Type& sum) {
+            sum += right;
+            bench::do_not_optimize(sum.iterative_size());
+          });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<domain_type, std::int64_t>>(report, "interval_map");
+  return 0;
+}
@@ -0,0 +1,52 @@
+// Segment updates on interval maps: `add`, `subtract` and `insert` of
+// single segments. One operation is one segment.
+#include "bench.hpp"
+#include "icl/compact_discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/split_interval_map.hpp"
+#include <cstdint>
+
+template <typename MapT>
+void run(bench::reporter& report, const char* container) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto added = bench::segments<MapT>(size, distribution, 42);
+      const auto subtracted = bench::segments<MapT>(size, distribution, 43);
+      const MapT populated = bench::populate<MapT>(added);
+
+      report.measure({"add", container, size, distribution, 1, size},
+                     [] { return MapT(); },
+                     [&](MapT& object) {
+                       for (const auto& segment : added)
+                         object.add(segment);
+                     });
+      report.measure({"subtract", container, size, distribution, 1, size},
+                     [&] { return populated; },
+                     [&](MapT& object) {
+                       for (const auto& segment : subtracted)
+                         object.subtract(segment);
+                     });
+      report.measure({"insert", container, size, distribution, 1, size},
+                     [] { return MapT(); },
+                     [&](MapT& object) {
+                       for (const auto& segment : added)
+                         object.insert(segment);
+                     });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<std::int64_t, std::int64_t>>(report, "interval_map");
+  run<icl::split_interval_map<std::int64_t, std::int64_t>>(
+      report, "split_interval_map");
+  run<icl::flat_interval_map<std::int64_t, std::int64_t>>(
+      report, "flat_interval_map");
+  run<icl::augmented_interval_map<std::int64_t, std::int64_t>>(
+      report, "augmented_interval_map");
+  run<icl::interval_map<std::int64_t, std::int64_t, icl::partial_absorber,
+                        std::less, icl::inplace_plus, icl::inter_section,
+                        icl::compact_discrete_interval<std::int64_t>>>(
+      report, "compact_interval_map");
+  return 0;
+}
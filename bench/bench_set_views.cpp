@@ -0,0 +1,63 @@
+// Set operations on two interval sets of the same size, iterated lazily
+// with `views::intersection` and `views::union_` or materialised with `&=`
+// and `+=` on a copy and iterated. One operation is one segment of the
+// operands.
+#include "bench.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/split_interval_set.hpp"
+#include "icl/views.hpp"
+#include <cstdint>
+
+template <typename Range> std::size_t count_segments(const Range& range) {
+  std::size_t count = 0;
+  for (const auto& segment : range)
+    count += !icl::is_empty(segment);
+  return count;
+}
+
+template <typename SetT>
+void run(bench::reporter& report, const char* container) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const SetT left =
+          bench::populate<SetT>(bench::intervals<SetT>(size, distribution, 42));
+      const SetT right =
+          bench::populate<SetT>(bench::intervals<SetT>(size, distribution, 43));
+      const std::size_t operations =
+          left.iterative_size() + right.iterative_size();
+
+      report.measure(
+          {"views::intersection", container, size, distribution, 1,
+           operations},
+          [&] {
+            bench::do_not_optimize(
+                count_segments(icl::views::intersection(left, right)));
+          });
+      report.measure({"&=", container, size, distribution, 1, operations},
+                     [&] {
+                       SetT result = left;
+                       result &= right;
+                       bench::do_not_optimize(count_segments(result));
+                     });
+      report.measure(
+          {"views::union_", container, size, distribution, 1, operations},
+          [&] {
+            bench::do_not_optimize(
+                count_segments(icl::views::union_(left, right)));
+          });
+      report.measure({"+=", container, size, distribution, 1, operations},
+                     [&] {
+                       SetT result = left;
+                       result += right;
+                       bench::do_not_optimize(count_segments(result));
+                     });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_set<domain_type>>(report, "interval_set");
+  run<icl::split_interval_set<domain_type>>(report, "split_interval_set");
+  return 0;
+}
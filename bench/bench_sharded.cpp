@@ -0,0 +1,81 @@
+// Segments added to an interval map by an increasing number of threads:
+// to `icl::sharded` with 64 shards, whose threads wait for each other only
+// on the same shards, and to an interval map guarded by one mutex. The
+// threads add every n-th segment of the input. One operation is one
+// segment.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/sharded.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// An interval map guarded by a mutex.
+template <typename MapT> struct locked {
+  void add(const typename MapT::segment_type& segment) {
+    const std::scoped_lock lock(mutex);
+    object.add(segment);
+  }
+
+  MapT object;
+  std::mutex mutex;
+};
+
+/// Adds the segments to `shared` by `threads` threads.
+template <typename Shared, typename Segments>
+void add_in_parallel(Shared& shared, const Segments& segments,
+                     unsigned threads) {
+  std::vector<std::thread> workers;
+  for (unsigned worker = 0; worker < threads; ++worker)
+    workers.emplace_back([&, worker] {
+      for (std::size_t i = worker; i < segments.size(); i += threads)
+        shared.add(segments[i]);
+    });
+  for (std::thread& thread : workers)
+    thread.join();
+}
+
+template <typename MapT>
+void run(bench::reporter& report, const char* container) {
+  constexpr std::size_t shards = 64;
+  const unsigned max_threads =
+      std::max(4u, std::thread::hardware_concurrency());
+
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto segments = bench::segments<MapT>(size, distribution);
+      // Bounds that cut the domain of the segments into equal ranges
+      std::vector<std::int64_t> bounds;
+      const auto span = static_cast<std::int64_t>(16 * size);
+      for (std::size_t shard = 1; shard < shards; ++shard)
+        bounds.push_back(span * static_cast<std::int64_t>(shard) /
+                         static_cast<std::int64_t>(shards));
+
+      for (unsigned threads = 1;;
+           threads = std::min(2 * threads, max_threads)) {
+        report.measure(
+            {"add_sharded", container, size, distribution, threads, size},
+            [&] { return std::make_unique<icl::sharded<MapT>>(bounds); },
+            [&](std::unique_ptr<icl::sharded<MapT>>& shared) {
+              add_in_parallel(*shared, segments, threads);
+            });
+        report.measure(
+            {"add_mutex", container, size, distribution, threads, size},
+            [] { return std::make_unique<locked<MapT>>(); },
+            [&](std::unique_ptr<locked<MapT>>& shared) {
+              add_in_parallel(*shared, segments, threads);
+            });
+        if (threads == max_threads)
+          break;
+      }
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<std::int64_t, std::int64_t>>(report, "interval_map");
+  return 0;
+}
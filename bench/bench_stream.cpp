@@ -0,0 +1,64 @@
+// Output of interval containers with `operator<<` into a string stream and
+// with `std::format_to` into a string, where the library has <format>. One
+// operation is one segment written.
+#include "bench.hpp"
+#include "icl/format.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <version>
+
+template <typename Type, typename Values>
+void run(bench::reporter& report, const char* container, Values values) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const Type object = bench::populate<Type>(values(size, distribution));
+
+      report.measure({"operator<<", container, size, distribution, 1,
+                      object.iterative_size()},
+                     [&] {
+                       std::ostringstream stream;
+                       stream << object;
+                       bench::do_not_optimize(stream.tellp());
+                     });
+
+#ifdef __cpp_lib_format
+      report.measure({"format_to", container, size, distribution, 1,
+                      object.iterative_size()},
+                     [&] {
+                       std::string text;
+                       std::format_to(std::back_inserter(text), "{}", object);
+                       bench::do_not_optimize(text.size());
+                     });
+#endif
+    }
+}
+
+template <typename SetT>
+void run_set(bench::reporter& report, const char* container) {
+  run<SetT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::intervals<SetT>(size, overlap);
+  });
+}
+
+template <typename MapT>
+void run_map(bench::reporter& report, const char* container) {
+  run<MapT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::segments<MapT>(size, overlap);
+  });
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run_set<icl::interval_set<domain_type>>(report, "interval_set");
+  run_set<icl::flat_interval_set<domain_type>>(report, "flat_interval_set");
+  run_map<icl::interval_map<domain_type, std::int64_t>>(report,
+                                                        "interval_map");
+  run_map<icl::flat_interval_map<domain_type, std::int64_t>>(
+      report, "flat_interval_map");
+  return 0;
+}
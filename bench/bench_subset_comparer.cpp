@@ -0,0 +1,61 @@
+// Inclusion tests of interval containers that run the subset comparer:
+// `inclusion_compare` and `contains` of a container on a container. The
+// subset holds every other segment of the superset, so that the comparison
+// has to traverse both containers. One operation is one segment of the
+// superset.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/split_interval_set.hpp"
+#include <cstdint>
+
+template <typename Type, typename Values>
+void run(bench::reporter& report, const char* container, Values values) {
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const Type super = bench::populate<Type>(values(size, distribution));
+      Type sub;
+      bool odd = false;
+      for (const auto& segment : super)
+        if ((odd = !odd))
+          sub.insert(segment);
+      const std::size_t operations = super.iterative_size();
+
+      report.measure({"inclusion_compare", container, size, distribution, 1,
+                      operations},
+                     [&] {
+                       bench::do_not_optimize(
+                           icl::inclusion_compare(sub, super));
+                     });
+      report.measure(
+          {"contains", container, size, distribution, 1, operations},
+          [&] { bench::do_not_optimize(icl::contains(super, sub)); });
+    }
+}
+
+template <typename SetT>
+void run_set(bench::reporter& report, const char* container) {
+  run<SetT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::intervals<SetT>(size, overlap);
+  });
+}
+
+template <typename MapT>
+void run_map(bench::reporter& report, const char* container) {
+  run<MapT>(report, container, [](std::size_t size, bench::overlap overlap) {
+    return bench::segments<MapT>(size, overlap);
+  });
+}
+
+int main(int argc, char* argv[]) {
+  using domain_type = std::int64_t;
+  bench::reporter report(bench::parse(argc, argv));
+  run_set<icl::interval_set<domain_type>>(report, "interval_set");
+  run_set<icl::split_interval_set<domain_type>>(report, "split_interval_set");
+  run_set<icl::flat_interval_set<domain_type>>(report, "flat_interval_set");
+  run_map<icl::interval_map<domain_type, std::int64_t>>(report,
+                                                        "interval_map");
+  run_map<icl::flat_interval_map<domain_type, std::int64_t>>(
+      report, "flat_interval_map");
+  return 0;
+}
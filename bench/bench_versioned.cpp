@@ -0,0 +1,87 @@
+// The history of an interval map in `icl::versioned`, which records each
+// update as the segments it replaced: updates to it, compared to those to
+// the map alone, and the queries of old versions, `find_at` of single keys
+// and `diff` of neighbouring versions, compared to `find` in the map. One
+// operation is one update or query.
+#include "bench.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/versioned.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+template <typename MapT>
+void run(bench::reporter& report, const char* container) {
+  constexpr std::size_t updates = 1000;
+  constexpr std::size_t queries = 1000;
+  for (const std::size_t size : report.opts().sizes)
+    for (const bench::overlap distribution : report.opts().overlaps) {
+      const auto segments = bench::segments<MapT>(size, distribution);
+      const auto changes =
+          bench::segments<MapT>(updates, distribution, /*seed=*/7);
+      MapT plain;
+      for (const auto& segment : segments)
+        plain.add(segment);
+
+      report.measure(
+          {"add_versioned", container, size, distribution, 1, updates},
+          [&] { return icl::versioned<MapT>(plain); },
+          [&](icl::versioned<MapT>& object) {
+            for (const auto& segment : changes)
+              object.add(segment);
+          });
+      report.measure(
+          {"add_plain", container, size, distribution, 1, updates},
+          [&] { return plain; },
+          [&](MapT& object) {
+            for (const auto& segment : changes)
+              object.add(segment);
+          });
+
+      icl::versioned<MapT> history(plain);
+      MapT current = plain;
+      for (const auto& segment : changes) {
+        history.add(segment);
+        current.add(segment);
+      }
+      // Keys within the segments, and versions of the whole history
+      std::mt19937_64 gen(3);
+      std::vector<std::pair<std::uint64_t, std::int64_t>> probes;
+      for (std::size_t query = 0; query < queries; ++query)
+        probes.emplace_back(
+            gen() % (updates + 1),
+            icl::lower(segments[gen() % segments.size()].first));
+
+      report.measure(
+          {"find_at_versioned", container, size, distribution, 1, queries},
+          [&] {
+            std::int64_t sum = 0;
+            for (const auto& [version, key] : probes)
+              sum += history.find_at(version, key).value_or(0);
+            bench::do_not_optimize(sum);
+          });
+      report.measure(
+          {"find_plain", container, size, distribution, 1, queries}, [&] {
+            std::int64_t sum = 0;
+            for (const auto& probe : probes)
+              sum += current(probe.second);
+            bench::do_not_optimize(sum);
+          });
+      report.measure(
+          {"diff_versioned", container, size, distribution, 1, queries},
+          [&] {
+            std::size_t sum = 0;
+            for (const auto& probe : probes) {
+              const auto version = probe.first % updates;
+              sum += history.diff(version, version + 1).added.iterative_size();
+            }
+            bench::do_not_optimize(sum);
+          });
+    }
+}
+
+int main(int argc, char* argv[]) {
+  bench::reporter report(bench::parse(argc, argv));
+  run<icl::interval_map<std::int64_t, std::int64_t>>(report, "interval_map");
+  return 0;
+}
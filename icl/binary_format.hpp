@@ -0,0 +1,607 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/detail/bound_search.hpp"
+#include "icl/detail/flat_map.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/dynamic_interval_traits.hpp"
+#include "icl/type_traits/identity_element.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include "icl/type_traits/is_total.hpp"
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace icl {
+
+/** \brief The header of the binary format of interval containers, see
+    \c write_binary and \c binary_view.
+
+    A file holds the header, followed by the contiguous arrays of the lower
+    bounds, the upper bounds, the bound bits, if the intervals have dynamic
+    bounds, and the values, if the container is a map. Each array starts at
+    an offset that is a multiple of \c binary_header::alignment. All numbers
+    are stored in the byte order of the writer, \c endian_tag tells which
+    one it is. */
+struct binary_header {
+  static constexpr std::array<char, 4> signature = {'I', 'C', 'L', 'B'};
+  static constexpr std::uint32_t byte_order = 0x01020304;
+  static constexpr std::uint16_t current_version = 1;
+  static constexpr std::size_t alignment = 64;
+
+  /// Kinds of containers
+  static constexpr std::uint8_t set_kind = 0;
+  static constexpr std::uint8_t map_kind = 1;
+
+  std::array<char, 4> magic;
+  std::uint32_t endian_tag;
+  std::uint16_t version;
+  /// \c set_kind or \c map_kind
+  std::uint8_t container;
+  /// The \c interval_bound_type of the intervals: static bounds or dynamic
+  std::uint8_t bounds;
+  /// Type tags: \c 'i' signed, \c 'u' unsigned, \c 'f' floating point,
+  /// \c 'b' bool, followed by the size in bytes. Sets have no codomain.
+  char domain_kind;
+  std::uint8_t domain_size;
+  char codomain_kind;
+  std::uint8_t codomain_size;
+  /// The number of segments
+  std::uint64_t count;
+  /// Offsets of the arrays from the start of the file, 0 if absent
+  std::uint64_t lower_offset;
+  std::uint64_t upper_offset;
+  std::uint64_t bounds_offset;
+  std::uint64_t value_offset;
+  /// The size of the file
+  std::uint64_t file_size;
+};
+
+static_assert(sizeof(binary_header) == 64);
+static_assert(std::is_trivially_copyable_v<binary_header>);
+
+/// Thrown by \c binary_view on data that is not in the binary format of the
+/// container type
+struct binary_format_error : std::runtime_error {
+  explicit binary_format_error(const std::string& what)
+      : std::runtime_error("icl binary format: " + what) {}
+};
+
+namespace detail {
+
+/// The type tag of an arithmetic type
+template <typename Type> constexpr char binary_kind() {
+  if constexpr (std::is_same_v<Type, bool>)
+    return 'b';
+  else if constexpr (std::is_floating_point_v<Type>)
+    return 'f';
+  else if constexpr (std::is_signed_v<Type>)
+    return 'i';
+  else
+    return 'u';
+}
+
+constexpr std::uint64_t binary_aligned(std::uint64_t offset) {
+  return (offset + binary_header::alignment - 1) /
+         binary_header::alignment * binary_header::alignment;
+}
+
+} // namespace detail
+
+/// Interval containers that can be stored in the binary format: Their
+/// domain and codomain are arithmetic types.
+template <typename Type>
+concept binary_serializable =
+    is_interval_container<Type>::value &&
+    std::is_arithmetic_v<typename Type::domain_type> &&
+    (!is_interval_map<Type>::value ||
+     std::is_arithmetic_v<typename Type::codomain_type>);
+
+namespace detail {
+
+/// The layout of the arrays of \c count segments of a \c Type
+template <typename Type>
+  requires binary_serializable<Type>
+binary_header binary_layout(std::uint64_t count) {
+  using domain_type = Type::domain_type;
+  using interval_type = Type::interval_type;
+
+  binary_header header{};
+  header.magic = binary_header::signature;
+  header.endian_tag = binary_header::byte_order;
+  header.version = binary_header::current_version;
+  header.container = is_interval_map<Type>::value ? binary_header::map_kind
+                                                  : binary_header::set_kind;
+  header.bounds = interval_bound_type<interval_type>::value;
+  header.domain_kind = binary_kind<domain_type>();
+  header.domain_size = sizeof(domain_type);
+  header.count = count;
+
+  std::uint64_t offset = detail::binary_aligned(sizeof(binary_header));
+  auto place = [&](std::uint64_t& array_offset, std::size_t element_size) {
+    array_offset = offset;
+    offset = detail::binary_aligned(offset + count * element_size);
+  };
+  place(header.lower_offset, sizeof(domain_type));
+  place(header.upper_offset, sizeof(domain_type));
+  if constexpr (has_dynamic_bounds<interval_type>::value)
+    place(header.bounds_offset, sizeof(bound_type));
+  if constexpr (is_interval_map<Type>::value) {
+    using codomain_type = Type::codomain_type;
+    header.codomain_kind = binary_kind<codomain_type>();
+    header.codomain_size = sizeof(codomain_type);
+    place(header.value_offset, sizeof(codomain_type));
+  }
+  header.file_size = offset;
+  return header;
+}
+
+/// Throws \c binary_format_error unless the byte order, the version and the
+/// type tags of \c header are those of \c Type on this machine
+template <typename Type>
+  requires binary_serializable<Type>
+void check_binary_tags(const binary_header& header) {
+  const binary_header expected = binary_layout<Type>(0);
+  if (header.endian_tag != binary_header::byte_order)
+    throw binary_format_error("foreign byte order");
+  if (header.version != binary_header::current_version)
+    throw binary_format_error("unsupported version " +
+                              std::to_string(header.version));
+  if (header.container != expected.container)
+    throw binary_format_error("container kind mismatch");
+  if (header.bounds != expected.bounds)
+    throw binary_format_error("interval bounds mismatch");
+  if (header.domain_kind != expected.domain_kind ||
+      header.domain_size != expected.domain_size)
+    throw binary_format_error("domain type mismatch");
+  if (header.codomain_kind != expected.codomain_kind ||
+      header.codomain_size != expected.codomain_size)
+    throw binary_format_error("codomain type mismatch");
+}
+
+/// Writes the arrays of the format through a buffer
+class binary_writer {
+public:
+  explicit binary_writer(std::ostream& stream) : _stream(stream) {}
+
+  void write(const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+      const std::size_t part = std::min(size, _buffer.size() - _used);
+      std::memcpy(_buffer.data() + _used, bytes, part);
+      _used += part;
+      bytes += part;
+      size -= part;
+      _position += part;
+      if (_used == _buffer.size())
+        flush();
+    }
+  }
+
+  /// Pads with zeros up to \c offset
+  void pad(std::uint64_t offset) {
+    static constexpr std::array<char, binary_header::alignment> zeros{};
+    while (_position < offset)
+      write(zeros.data(),
+            std::min<std::uint64_t>(zeros.size(), offset - _position));
+  }
+
+  void flush() {
+    _stream.write(_buffer.data(), static_cast<std::streamsize>(_used));
+    _used = 0;
+  }
+
+private:
+  std::ostream& _stream;
+  std::array<char, 1 << 16> _buffer;
+  std::size_t _used = 0;
+  std::uint64_t _position = 0;
+};
+
+} // namespace detail
+
+/** Writes \c object to \c stream in the binary format, that \c binary_view
+    reads. Failures are reported by the state of the stream. */
+template <typename Type>
+  requires binary_serializable<Type>
+std::ostream& write_binary(std::ostream& stream, const Type& object) {
+  using interval_type = Type::interval_type;
+
+  const binary_header header =
+      detail::binary_layout<Type>(object.iterative_size());
+  detail::binary_writer writer(stream);
+  writer.write(&header, sizeof(header));
+
+  auto write_array = [&](std::uint64_t offset, const auto& field) {
+    writer.pad(offset);
+    for (auto it_ = object.begin(); it_ != object.end(); ++it_) {
+      const auto value = field(it_);
+      writer.write(&value, sizeof(value));
+    }
+  };
+  write_array(header.lower_offset,
+              [](const auto& it_) { return icl::lower(key_value<Type>(it_)); });
+  write_array(header.upper_offset,
+              [](const auto& it_) { return icl::upper(key_value<Type>(it_)); });
+  if constexpr (has_dynamic_bounds<interval_type>::value)
+    write_array(header.bounds_offset, [](const auto& it_) {
+      return key_value<Type>(it_).bounds().bits();
+    });
+  if constexpr (is_interval_map<Type>::value)
+    write_array(header.value_offset,
+                [](const auto& it_) { return co_value<Type>(it_); });
+  writer.pad(header.file_size);
+  writer.flush();
+  return stream;
+}
+
+/** \brief A read-only view of an interval container of type \c Type, that
+    is stored in the binary format in a range of bytes, e.g. a mapped file.
+
+    The view reads the arrays in place: Construction checks the header and
+    the extent of the arrays, not the order of the segments, so it takes
+    constant time. Iterators yield the segments by value. Searches have the
+    semantics of those of \c Type. The bytes must outlive the view. */
+template <typename Type>
+  requires binary_serializable<Type>
+class binary_view {
+public:
+  /// The type of the container, that the view shows
+  using source_type = Type;
+  using domain_type = Type::domain_type;
+  using domain_compare = Type::domain_compare;
+  using codomain_type = Type::codomain_type;
+  using interval_type = Type::interval_type;
+  using key_compare = Type::key_compare;
+  using size_type = Type::size_type;
+  using difference_type = std::ptrdiff_t;
+  using segment_type = Type::segment_type;
+  using value_type = segment_type;
+
+  class const_iterator {
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = segment_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = segment_type;
+    using pointer = detail::arrow_proxy<segment_type>;
+
+    const_iterator() = default;
+
+    reference operator*() const { return _view->segment(_index); }
+    pointer operator->() const { return pointer{**this}; }
+    reference operator[](difference_type offset) const {
+      return *(*this + offset);
+    }
+
+    const_iterator& operator++() {
+      ++_index;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    const_iterator& operator--() {
+      --_index;
+      return *this;
+    }
+
+    const_iterator operator--(int) {
+      const_iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    const_iterator& operator+=(difference_type offset) {
+      _index += static_cast<std::size_t>(offset);
+      return *this;
+    }
+
+    const_iterator& operator-=(difference_type offset) {
+      return *this += -offset;
+    }
+
+    friend const_iterator operator+(const_iterator it_,
+                                    difference_type offset) {
+      return it_ += offset;
+    }
+
+    friend const_iterator operator+(difference_type offset,
+                                    const_iterator it_) {
+      return it_ += offset;
+    }
+
+    friend const_iterator operator-(const_iterator it_,
+                                    difference_type offset) {
+      return it_ -= offset;
+    }
+
+    difference_type operator-(const const_iterator& other) const {
+      return static_cast<difference_type>(_index - other._index);
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return _index == other._index;
+    }
+
+    std::strong_ordering operator<=>(const const_iterator& other) const {
+      return _index <=> other._index;
+    }
+
+  private:
+    friend class binary_view;
+
+    const_iterator(const binary_view* view, std::size_t index)
+        : _view(view), _index(index) {}
+
+    const binary_view* _view = nullptr;
+    std::size_t _index = 0;
+  };
+
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  binary_view() = default;
+
+  /** View of the container stored in \c bytes. Throws \c binary_format_error
+      if \c bytes do not hold a container of type \c Type in the byte order
+      of this machine, or are not aligned for its arrays. */
+  explicit binary_view(std::span<const std::byte> bytes) {
+    if (bytes.size() < sizeof(binary_header))
+      throw binary_format_error("truncated header");
+    binary_header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != binary_header::signature)
+      throw binary_format_error("bad signature");
+    detail::check_binary_tags<Type>(header);
+
+    // A count that does not fit the bytes would overflow the layout
+    if (header.count > bytes.size())
+      throw binary_format_error("truncated arrays");
+    const binary_header expected = detail::binary_layout<Type>(header.count);
+    if (header.lower_offset != expected.lower_offset ||
+        header.upper_offset != expected.upper_offset ||
+        header.bounds_offset != expected.bounds_offset ||
+        header.value_offset != expected.value_offset ||
+        header.file_size != expected.file_size ||
+        header.file_size > bytes.size())
+      throw binary_format_error("truncated arrays or inconsistent layout");
+
+    const auto count = static_cast<std::size_t>(header.count);
+    _lower = array<domain_type>(bytes, header.lower_offset, count);
+    _upper = array<domain_type>(bytes, header.upper_offset, count);
+    if constexpr (has_dynamic_bounds<interval_type>::value)
+      _bounds = array<bound_type>(bytes, header.bounds_offset, count);
+    if constexpr (is_interval_map<Type>::value)
+      _values = array<codomain_type>(bytes, header.value_offset, count);
+  }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, _upper.size()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  [[nodiscard]] bool empty() const { return _upper.empty(); }
+
+  /** Size of the iteration over the view */
+  [[nodiscard]] std::size_t iterative_size() const { return _upper.size(); }
+
+  //==========================================================================
+  //= Arrays
+  //==========================================================================
+
+  /// The lower bounds of the segments
+  std::span<const domain_type> lower_bounds() const { return _lower; }
+
+  /// The upper bounds of the segments
+  std::span<const domain_type> upper_bounds() const { return _upper; }
+
+  /// The values of the segments of a map
+  std::span<const codomain_type> values() const
+    requires is_interval_map<Type>::value
+  {
+    return _values;
+  }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+
+  /** Find the segment, that contains \c point */
+  const_iterator find(const domain_type& point) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    const interval_type key = Interval_Stabbing::probe<Type>(point);
+    std::size_t index;
+    if constexpr (std::is_same_v<domain_compare, std::less<domain_type>>)
+      index = Bound_Search::lower_bound(upper_bounds(), point);
+    else
+      index = lower_bound(key) - begin();
+    // A segment whose upper bound is point, but open, precedes it
+    while (index < _upper.size() && key_compare()(interval(index), key))
+      ++index;
+    return index < _upper.size() && !key_compare()(key, interval(index))
+               ? const_iterator(this, index)
+               : end();
+  }
+
+  /** Find the segment, that collides with interval \c key_interval */
+  const_iterator find(const interval_type& key_interval) const {
+    const const_iterator it_ = lower_bound(key_interval);
+    return it_ != end() && !key_compare()(key_interval, interval(it_._index))
+               ? it_
+               : end();
+  }
+
+  /** Total select function: The value that \c point is mapped to */
+  codomain_type operator()(const domain_type& point) const
+    requires(is_interval_map<Type>::value && Interval_Stabbing::stabbable<Type>)
+  {
+    const const_iterator it_ = find(point);
+    return it_ == end() ? identity_element<codomain_type>::value()
+                        : _values[it_._index];
+  }
+
+  /** The first segment, that does not precede \c key_interval */
+  const_iterator lower_bound(const interval_type& key_interval) const {
+    return search([&](std::size_t index) {
+      return key_compare()(interval(index), key_interval);
+    });
+  }
+
+  /** The first segment, that \c key_interval precedes */
+  const_iterator upper_bound(const interval_type& key_interval) const {
+    return search([&](std::size_t index) {
+      return !key_compare()(key_interval, interval(index));
+    });
+  }
+
+  /** The segments, that collide with \c key_interval */
+  std::pair<const_iterator, const_iterator>
+  equal_range(const interval_type& key_interval) const {
+    return std::pair<const_iterator, const_iterator>(
+        lower_bound(key_interval), upper_bound(key_interval));
+  }
+
+  //==========================================================================
+  //= Containedness
+  //==========================================================================
+
+  /** Does the view contain the element \c point? */
+  bool contains(const domain_type& point) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    if constexpr (is_total<Type>::value)
+      return true;
+    else
+      return find(point) != end();
+  }
+
+  /** Are all elements of \c inter_val contained? */
+  bool contains(const interval_type& inter_val) const {
+    if constexpr (is_total<Type>::value)
+      return true;
+    else {
+      if (icl::is_empty(inter_val))
+        return true;
+      const auto [first_, past_] = equal_range(inter_val);
+      if (first_ == past_)
+        return false;
+      const std::size_t last = past_._index - 1;
+      if (!icl::contains(hull(interval(first_._index), interval(last)),
+                         inter_val))
+        return false;
+      for (std::size_t index = first_._index; index != last; ++index)
+        if (!icl::touches(interval(index), interval(index + 1)))
+          return false;
+      return true;
+    }
+  }
+
+  /** Does the view contain the element \c point? */
+  bool intersects(const domain_type& point) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return contains(point);
+  }
+
+  /** Do \c inter_val and the view have elements in common? */
+  bool intersects(const interval_type& inter_val) const {
+    return !icl::is_empty(inter_val) && find(inter_val) != end();
+  }
+
+private:
+  template <typename Element>
+  static std::span<const Element> array(std::span<const std::byte> bytes,
+                                        std::uint64_t offset,
+                                        std::size_t count) {
+    const std::byte* first = bytes.data() + offset;
+    if (reinterpret_cast<std::uintptr_t>(first) % alignof(Element) != 0)
+      throw binary_format_error("misaligned array");
+    return std::span<const Element>(reinterpret_cast<const Element*>(first),
+                                    count);
+  }
+
+  /// The interval of the segment at \c index
+  interval_type interval(std::size_t index) const {
+    if constexpr (has_dynamic_bounds<interval_type>::value)
+      return dynamic_interval_traits<interval_type>::construct(
+          _lower[index], _upper[index], interval_bounds(_bounds[index]));
+    else
+      return interval_traits<interval_type>::construct(_lower[index],
+                                                       _upper[index]);
+  }
+
+  segment_type segment(std::size_t index) const {
+    if constexpr (is_interval_map<Type>::value)
+      return segment_type(interval(index), _values[index]);
+    else
+      return interval(index);
+  }
+
+  /// The first segment, that does not satisfy \c precedes
+  template <typename Precedes>
+  const_iterator search(const Precedes& precedes) const {
+    std::size_t first = 0;
+    std::size_t count = _upper.size();
+    while (count > 0) {
+      const std::size_t half = count / 2;
+      if (precedes(first + half)) {
+        first += half + 1;
+        count -= half + 1;
+      } else
+        count = half;
+    }
+    return const_iterator(this, first);
+  }
+
+  std::span<const domain_type> _lower;
+  std::span<const domain_type> _upper;
+  std::span<const bound_type> _bounds;
+  std::span<const codomain_type> _values;
+};
+
+/** Reads the container stored in \c bytes in the binary format into a
+    container of type \c Type. Throws like \c binary_view. */
+template <typename Type>
+  requires binary_serializable<Type>
+Type read_binary(std::span<const std::byte> bytes) {
+  const binary_view<Type> view(bytes);
+  Type object;
+  auto prior_ = object.end();
+  for (const auto& segment : view)
+    prior_ = object.add(prior_, segment);
+  return object;
+}
+
+} // namespace icl
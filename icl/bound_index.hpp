@@ -0,0 +1,123 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/detail/bound_search.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace icl {
+
+/// Interval containers that a \c bound_index can be built for
+template <typename Type>
+concept bound_indexable =
+    Interval_Stabbing::stabbable<Type> && Type::storage_type::is_contiguous &&
+    std::is_arithmetic_v<typename Type::domain_type> &&
+    std::same_as<typename Type::domain_compare,
+                 std::less<typename Type::domain_type>>;
+
+/** \brief A search index over the segments of an interval container on
+    contiguous storage, e.g. \c flat_interval_map.
+
+    The upper bounds of the segments are copied into one contiguous array,
+    so that points are located by the vector kernels of \c Bound_Search
+    instead of by comparisons of intervals. Lookups yield iterators of the
+    container with the semantics of its \c find. The \c find of the
+    container itself is unchanged, a binary search over its intervals; the
+    kernels are used by this index, \c binary_view and \c frozen only.
+
+    The index keeps positions in the container, any update of the container
+    invalidates it. Whether it is current is checked against the
+    \c modifications of the container, lookups assert that it is. */
+template <typename Type>
+  requires bound_indexable<Type>
+class bound_index {
+public:
+  using domain_type = Type::domain_type;
+  using interval_type = Type::interval_type;
+  using const_iterator = Type::const_iterator;
+  using allocator_type = std::allocator_traits<
+      typename Type::allocator_type>::template rebind_alloc<domain_type>;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  explicit bound_index(const Type& object)
+      : _object(&object), _upper(allocator_type(object.get_allocator())),
+        _modifications(object.modifications()) {
+    _upper.reserve(object.iterative_size());
+    for (const_iterator it_ = object.begin(); it_ != object.end(); ++it_)
+      _upper.push_back(icl::upper(key_value<Type>(it_)));
+  }
+
+  /// The number of segments of the container
+  [[nodiscard]] std::size_t size() const { return _upper.size(); }
+
+  /// Has the container not been changed since the index was built?
+  [[nodiscard]] bool is_current() const {
+    return _modifications == _object->modifications();
+  }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+
+  /** Find the segment of the container, that contains \c point */
+  const_iterator find(const domain_type& point) const {
+    assert(is_current());
+    return located(Bound_Search::lower_bound(upper_bounds(), point), point);
+  }
+
+  /** Batched find: Sets <tt>found[i]</tt> to the segment that contains
+      <tt>points[i]</tt>, or to the end of the container. The points are
+      searched in groups, that proceed in step. */
+  void find(std::span<const domain_type> points,
+            std::span<const_iterator> found) const {
+    assert(is_current() && found.size() >= points.size());
+    std::array<std::size_t, chunk> candidates;
+    for (std::size_t first = 0; first < points.size(); first += chunk) {
+      const std::span<const domain_type> part =
+          points.subspan(first, std::min(chunk, points.size() - first));
+      Bound_Search::lower_bound(upper_bounds(), part,
+                                std::span<std::size_t>(candidates));
+      for (std::size_t index = 0; index < part.size(); ++index)
+        found[first + index] = located(candidates[index], part[index]);
+    }
+  }
+
+  /// The upper bounds of the segments, in the order of the container
+  std::span<const domain_type> upper_bounds() const { return _upper; }
+
+private:
+  static constexpr std::size_t chunk = 256;
+
+  /// The segment that contains \c point, where \c candidate is the first
+  /// segment whose upper bound is not less than \c point
+  const_iterator located(std::size_t candidate,
+                         const domain_type& point) const {
+    using key_compare = Type::key_compare;
+
+    const interval_type key = Interval_Stabbing::probe<Type>(point);
+    const const_iterator end_ = _object->end();
+    const_iterator it_ =
+        _object->begin() + static_cast<std::ptrdiff_t>(candidate);
+    // A segment whose upper bound is point, but open, precedes it
+    while (it_ != end_ && key_compare()(key_value<Type>(it_), key))
+      ++it_;
+    return it_ != end_ && !key_compare()(key, key_value<Type>(it_)) ? it_
+                                                                    : end_;
+  }
+
+  const Type* _object;
+  std::vector<domain_type, allocator_type> _upper;
+  std::size_t _modifications;
+};
+
+} // namespace icl
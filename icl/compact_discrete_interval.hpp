@@ -0,0 +1,138 @@
+#pragma once
+
+#include "icl/concept/interval_bounds.hpp"
+#include "icl/interval_traits.hpp"
+#include "icl/type_traits/identity_element.hpp"
+#include "icl/type_traits/is_discrete.hpp"
+#include "icl/type_traits/is_interval.hpp"
+#include "icl/type_traits/succ_pred.hpp"
+#include "icl/type_traits/type_to_string.hpp"
+#include "icl/type_traits/value_size.hpp"
+#include <concepts>
+
+namespace icl {
+
+/** \brief A discrete interval in compact representation.
+
+    \c compact_discrete_interval offers the constructors and the
+    \c lower(), \c upper() and \c bounds() interface of
+    \c discrete_interval, but normalises every interval to right-open
+    bounds on construction: <tt>[1,5]</tt>, <tt>(0,5]</tt> and <tt>(0,6)</tt>
+    are all kept as <tt>[1,6)</tt>. As no bounds need to be stored, an
+    interval takes just the size of its two bounds, e.g. 16 bytes instead of
+    24 for \c std::int64_t, and interval containers compare intervals by
+    one comparison of their bounds. The upper bound of a right closed
+    interval must have a successor. */
+template <typename DomainT, template <typename> typename Compare = std::less>
+  requires std::default_initializable<DomainT> && std::totally_ordered<DomainT>
+class compact_discrete_interval {
+public:
+  using type = compact_discrete_interval;
+  using domain_type = DomainT;
+  using domain_compare = Compare<DomainT>;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  /** Default constructor; yields an empty interval <tt>[0,0)</tt>. */
+  compact_discrete_interval()
+      : _lwb(identity_element<DomainT>::value()),
+        _upb(identity_element<DomainT>::value()) {
+    static_assert(is_discrete<DomainT>::value);
+  }
+
+  // NOTE: Compiler generated copy constructor is used
+
+  /** Constructor for a singleton interval <tt>[val,val+1)</tt> */
+  explicit compact_discrete_interval(const DomainT& val)
+      : _lwb(val), _upb(successor<DomainT, domain_compare>::apply(val)) {
+    static_assert(is_discrete<DomainT>::value);
+  }
+
+  /** Interval from <tt>low</tt> to <tt>up</tt> with bounds <tt>bounds</tt>,
+      normalised to right-open bounds */
+  compact_discrete_interval(
+      const DomainT& low, const DomainT& up,
+      interval_bounds bounds = interval_bounds::right_open())
+      : _lwb(is_left_closed(bounds)
+                 ? low
+                 : successor<DomainT, domain_compare>::apply(low)),
+        _upb(is_right_closed(bounds)
+                 ? successor<DomainT, domain_compare>::apply(up)
+                 : up) {
+    static_assert(is_discrete<DomainT>::value);
+  }
+
+  domain_type lower() const { return _lwb; }
+  domain_type upper() const { return _upb; }
+  [[nodiscard]] interval_bounds bounds() const {
+    return interval_bounds::right_open();
+  }
+
+  static compact_discrete_interval open(const DomainT& lo, const DomainT& up) {
+    return compact_discrete_interval(lo, up, interval_bounds::open());
+  }
+  static compact_discrete_interval right_open(const DomainT& lo,
+                                              const DomainT& up) {
+    return compact_discrete_interval(lo, up, interval_bounds::right_open());
+  }
+  static compact_discrete_interval left_open(const DomainT& lo,
+                                             const DomainT& up) {
+    return compact_discrete_interval(lo, up, interval_bounds::left_open());
+  }
+  static compact_discrete_interval closed(const DomainT& lo,
+                                          const DomainT& up) {
+    return compact_discrete_interval(lo, up, interval_bounds::closed());
+  }
+
+private:
+  domain_type _lwb;
+  domain_type _upb;
+};
+
+//==============================================================================
+//=T compact_discrete_interval -> concept intervals
+//==============================================================================
+template <typename DomainT, template <typename> typename Compare>
+struct interval_traits<compact_discrete_interval<DomainT, Compare>> {
+  using type = interval_traits;
+  using domain_type = DomainT;
+  using domain_compare = Compare<DomainT>;
+  using interval_type = compact_discrete_interval<DomainT, Compare>;
+
+  static interval_type construct(const domain_type& lo, const domain_type& up) {
+    return interval_type(lo, up);
+  }
+
+  static domain_type lower(const interval_type& inter_val) {
+    return inter_val.lower();
+  }
+  static domain_type upper(const interval_type& inter_val) {
+    return inter_val.upper();
+  }
+};
+
+//==============================================================================
+//= Type traits
+//==============================================================================
+template <typename DomainT, template <typename> typename Compare>
+struct interval_bound_type<compact_discrete_interval<DomainT, Compare>> {
+  using type = interval_bound_type;
+  static constexpr bound_type value = interval_bounds::static_right_open;
+};
+
+template <typename DomainT, template <typename> typename Compare>
+struct type_to_string<compact_discrete_interval<DomainT, Compare>> {
+  static std::string apply() {
+    return "c[I)<" + type_to_string<DomainT>::apply() + ">";
+  }
+};
+
+template <typename DomainT, template <typename> typename Compare>
+struct value_size<compact_discrete_interval<DomainT, Compare>> {
+  static std::size_t apply(const compact_discrete_interval<DomainT, Compare>&) {
+    return 2;
+  }
+};
+
+} // namespace icl
@@ -25,6 +25,35 @@ void clear(Type& object) {
   object.erase(object.begin(), object.end());
 }
 
+//==============================================================================
+//= Allocation
+//==============================================================================
+
+/** An empty container that allocates from the allocator of \c object.
+    Temporaries that take the place of \c object are created this way, so
+    that stateful allocators reach them. */
+template <typename Type>
+  requires is_container<Type>
+Type empty_like(const Type& object) {
+  if constexpr (requires { object.get_allocator(); })
+    return Type(object.get_allocator());
+  else
+    return Type();
+}
+
+/** A copy of \c object that allocates from the allocator of \c object.
+    The copy constructor instead selects the allocator of the copy by
+    \c std::allocator_traits::select_on_container_copy_construction, which
+    is the default resource for \c std::pmr::polymorphic_allocator. */
+template <typename Type>
+  requires is_container<Type>
+Type copy_like(const Type& object) {
+  if constexpr (requires { object.get_allocator(); })
+    return Type(object, object.get_allocator());
+  else
+    return Type(object);
+}
+
 //==============================================================================
 //= Size
 //==============================================================================
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "icl/concept/container.hpp"
 #include "icl/concept/element_map.hpp"
 #include "icl/concept/element_set.hpp"
 #include "icl/detail/subset_comparer.hpp"
@@ -7,6 +8,7 @@
 #include "icl/type_traits/is_element_container.hpp"
 #include "icl/type_traits/is_key_container_of.hpp"
 #include <cstddef>
+#include <utility>
 
 namespace icl {
 
@@ -143,14 +145,28 @@ Type& operator+=(Type& object,
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator+(Type object, const typename Type::value_type& operand) {
-  return object += operand;
+Type operator+(const Type& object, const typename Type::value_type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp += operand);
 }
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator+(const typename Type::value_type& operand, Type object) {
-  return object += operand;
+Type operator+(Type&& object, const typename Type::value_type& operand) {
+  return std::move(object += operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator+(const typename Type::value_type& operand, const Type& object) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp += operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator+(const typename Type::value_type& operand, Type&& object) {
+  return std::move(object += operand);
 }
 
 template <typename Type>
@@ -169,8 +185,15 @@ Type& operator+=(Type& object, const Type& operand) {
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator+(Type object, const Type& operand) {
-  return object += operand;
+Type operator+(const Type& object, const Type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp += operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator+(Type&& object, const Type& operand) {
+  return std::move(object += operand);
 }
 
 //==============================================================================
@@ -183,14 +206,28 @@ Type& operator|=(Type& object,
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator|(Type object, const typename Type::value_type& operand) {
-  return object += operand;
+Type operator|(const Type& object, const typename Type::value_type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp += operand);
 }
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator|(const typename Type::value_type& operand, Type object) {
-  return object += operand;
+Type operator|(Type&& object, const typename Type::value_type& operand) {
+  return std::move(object += operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator|(const typename Type::value_type& operand, const Type& object) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp += operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator|(const typename Type::value_type& operand, Type&& object) {
+  return std::move(object += operand);
 }
 
 template <typename Type>
@@ -201,8 +238,15 @@ Type& operator|=(Type& object, const Type& operand) {
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator|(Type object, const Type& operand) {
-  return object += operand;
+Type operator|(const Type& object, const Type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp += operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator|(Type&& object, const Type& operand) {
+  return std::move(object += operand);
 }
 
 //==============================================================================
@@ -279,8 +323,15 @@ Type& operator-=(Type& object,
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator-(Type object, const typename Type::value_type& operand) {
-  return object -= operand;
+Type operator-(const Type& object, const typename Type::value_type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp -= operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator-(Type&& object, const typename Type::value_type& operand) {
+  return std::move(object -= operand);
 }
 
 template <typename Type>
@@ -295,8 +346,15 @@ Type& operator-=(Type& object, const Type& subtrahend) {
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator-(Type object, const Type& subtrahend) {
-  return object -= subtrahend;
+Type operator-(const Type& object, const Type& subtrahend) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp -= subtrahend);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator-(Type&& object, const Type& subtrahend) {
+  return std::move(object -= subtrahend);
 }
 
 //==============================================================================
@@ -340,7 +398,7 @@ add_intersection(Type& section, const Type& object,
 template <typename Type>
   requires is_associative_element_container<Type>::value
 Type& operator&=(Type& object, const typename Type::key_type& operand) {
-  Type section;
+  Type section = icl::empty_like(object);
   add_intersection(section, object, operand);
   object.swap(section);
   return object;
@@ -348,14 +406,28 @@ Type& operator&=(Type& object, const typename Type::key_type& operand) {
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator&(Type object, const typename Type::key_type& operand) {
-  return object &= operand;
+Type operator&(const Type& object, const typename Type::key_type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp &= operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator&(Type&& object, const typename Type::key_type& operand) {
+  return std::move(object &= operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator&(const typename Type::key_type& operand, const Type& object) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp &= operand);
 }
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator&(const typename Type::key_type& operand, Type object) {
-  return object &= operand;
+Type operator&(const typename Type::key_type& operand, Type&& object) {
+  return std::move(object &= operand);
 }
 
 template <typename Type>
@@ -363,7 +435,7 @@ template <typename Type>
 Type&
 operator&=(Type& object,
            const typename key_container_type_of<Type>::type& operand) {
-  Type section;
+  Type section = icl::empty_like(object);
   add_intersection(section, object, operand);
   object.swap(section);
   return object;
@@ -371,8 +443,15 @@ operator&=(Type& object,
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator&(Type object, const Type& operand) {
-  return object &= operand;
+Type operator&(const Type& object, const Type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp &= operand);
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator&(Type&& object, const Type& operand) {
+  return std::move(object &= operand);
 }
 //------------------------------------------------------------------------------
 
@@ -387,20 +466,41 @@ bool disjoint(const Type& left, const Type& right) {
 //==============================================================================
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator^(Type object, const typename Type::value_type& operand) {
-  return icl::flip(object, operand);
+Type operator^(const Type& object, const typename Type::value_type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(icl::flip(temp, operand));
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator^(Type&& object, const typename Type::value_type& operand) {
+  return std::move(icl::flip(object, operand));
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator^(const typename Type::value_type& operand, const Type& object) {
+  Type temp = icl::copy_like(object);
+  return std::move(icl::flip(temp, operand));
+}
+
+template <typename Type>
+  requires is_associative_element_container<Type>::value
+Type operator^(const typename Type::value_type& operand, Type&& object) {
+  return std::move(icl::flip(object, operand));
 }
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator^(const typename Type::value_type& operand, Type object) {
-  return icl::flip(object, operand);
+Type operator^(const Type& object, const Type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp ^= operand);
 }
 
 template <typename Type>
   requires is_associative_element_container<Type>::value
-Type operator^(Type object, const Type& operand) {
-  return object ^= operand;
+Type operator^(Type&& object, const Type& operand) {
+  return std::move(object ^= operand);
 }
 
 //==============================================================================
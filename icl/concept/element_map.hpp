@@ -1,5 +1,6 @@
 #pragma once
 
+#include "icl/concept/container.hpp"
 #include "icl/concept/map_value.hpp"
 #include "icl/detail/map_algo.hpp"
 #include "icl/detail/on_absorbtion.hpp"
@@ -8,6 +9,7 @@
 #include "icl/type_traits/is_element_container.hpp"
 #include "icl/type_traits/is_total.hpp"
 #include "icl/type_traits/unit_element.hpp"
+#include <utility>
 
 namespace icl {
 
@@ -158,8 +160,15 @@ Type& operator-=(Type& object, const typename Type::set_type& operand) {
 
 template <typename Type>
   requires is_element_map<Type>::value
-Type operator-(Type object, const typename Type::set_type& subtrahend) {
-  return object -= subtrahend;
+Type operator-(const Type& object, const typename Type::set_type& subtrahend) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp -= subtrahend);
+}
+
+template <typename Type>
+  requires is_element_map<Type>::value
+Type operator-(Type&& object, const typename Type::set_type& subtrahend) {
+  return std::move(object -= subtrahend);
 }
 
 //==============================================================================
@@ -197,7 +206,7 @@ void add_intersection(Type& section, const Type& object,
 template <typename Type>
   requires is_element_map<Type>::value
 void add_intersection(Type& section, const Type& object, const Type& operand) {
-  for (typename Type::const_iterator it_ = operand.bedin();
+  for (typename Type::const_iterator it_ = operand.begin();
        !(it_ == operand.end()); ++it_)
     icl::add_intersection(section, object, *it_);
 }
@@ -216,7 +225,7 @@ Type& operator&=(Type& object, const typename Type::element_type& operand) {
 template <typename Type>
   requires(is_element_map<Type>::value && !is_total<Type>::value)
 Type& operator&=(Type& object, const typename Type::element_type& operand) {
-  Type section;
+  Type section = icl::empty_like(object);
   icl::add_intersection(section, object, operand);
   object.swap(section);
   return object;
@@ -224,14 +233,28 @@ Type& operator&=(Type& object, const typename Type::element_type& operand) {
 
 template <typename Type>
   requires is_element_map<Type>::value
-Type operator&(Type object, const typename Type::element_type& operand) {
-  return object &= operand;
+Type operator&(const Type& object, const typename Type::element_type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp &= operand);
 }
 
 template <typename Type>
   requires is_element_map<Type>::value
-Type operator&(const typename Type::element_type& operand, Type object) {
-  return object &= operand;
+Type operator&(Type&& object, const typename Type::element_type& operand) {
+  return std::move(object &= operand);
+}
+
+template <typename Type>
+  requires is_element_map<Type>::value
+Type operator&(const typename Type::element_type& operand, const Type& object) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp &= operand);
+}
+
+template <typename Type>
+  requires is_element_map<Type>::value
+Type operator&(const typename Type::element_type& operand, Type&& object) {
+  return std::move(object &= operand);
 }
 
 template <typename Type>
@@ -244,7 +267,7 @@ Type& operator&=(Type& object, const Type& operand) {
 template <typename Type>
   requires(is_element_map<Type>::value && !is_total<Type>::value)
 Type& operator&=(Type& object, const Type& operand) {
-  Type section;
+  Type section = icl::empty_like(object);
   icl::add_intersection(section, object, operand);
   object.swap(section);
   return object;
@@ -252,14 +275,30 @@ Type& operator&=(Type& object, const Type& operand) {
 
 template <typename Type>
   requires is_element_map<Type>::value
-Type operator&(Type object, const typename Type::key_object_type& operand) {
-  return object &= operand;
+Type operator&(const Type& object,
+               const typename Type::key_object_type& operand) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp &= operand);
+}
+
+template <typename Type>
+  requires is_element_map<Type>::value
+Type operator&(Type&& object, const typename Type::key_object_type& operand) {
+  return std::move(object &= operand);
+}
+
+template <typename Type>
+  requires is_element_map<Type>::value
+Type operator&(const typename Type::key_object_type& operand,
+               const Type& object) {
+  Type temp = icl::copy_like(object);
+  return std::move(temp &= operand);
 }
 
 template <typename Type>
   requires is_element_map<Type>::value
-Type operator&(const typename Type::key_object_type& operand, Type object) {
-  return object &= operand;
+Type operator&(const typename Type::key_object_type& operand, Type&& object) {
+  return std::move(object &= operand);
 }
 
 //==============================================================================
@@ -289,7 +328,7 @@ template <typename Type>
   requires(is_element_map<Type>::value && !is_total<Type>::value)
 bool intersects(const Type& object,
                 const typename Type::element_type& operand) {
-  Type intersection;
+  Type intersection = icl::empty_like(object);
   icl::add_intersection(intersection, object, operand);
   return !intersection.empty();
 }
@@ -83,9 +83,9 @@ Type singleton(const typename interval_traits<Type>::domain_type& value) {
   // ASSERT: This always creates an interval with exactly one element
   using domain_type = interval_traits<Type>::domain_type;
   using domain_compare = interval_traits<Type>::domain_compare;
-  static_assert(
-      numeric_minimum<domain_type, domain_compare,
-                      is_numeric<domain_type>::value>::is_less_than(value));
+  assert(
+      (numeric_minimum<domain_type, domain_compare,
+                       is_numeric<domain_type>::value>::is_less_than(value)));
 
   return interval_traits<Type>::construct(domain_prior<Type>(value), value);
 }
@@ -96,9 +96,9 @@ Type singleton(const typename interval_traits<Type>::domain_type& value) {
   // ASSERT: This always creates an interval with exactly one element
   using domain_type = interval_traits<Type>::domain_type;
   using domain_compare = interval_traits<Type>::domain_compare;
-  static_assert(
-      numeric_minimum<domain_type, domain_compare,
-                      is_numeric<domain_type>::value>::is_less_than(value));
+  assert(
+      (numeric_minimum<domain_type, domain_compare,
+                       is_numeric<domain_type>::value>::is_less_than(value)));
 
   return interval_traits<Type>::construct(domain_prior<Type>(value),
                                           domain_next<Type>(value));
@@ -141,9 +141,9 @@ template <typename Type>
 Type unit_trail(const typename interval_traits<Type>::domain_type& value) {
   using domain_type = interval_traits<Type>::domain_type;
   using domain_compare = interval_traits<Type>::domain_compare;
-  static_assert(
-      numeric_minimum<domain_type, domain_compare,
-                      is_numeric<domain_type>::value>::is_less_than(value));
+  assert(
+      (numeric_minimum<domain_type, domain_compare,
+                       is_numeric<domain_type>::value>::is_less_than(value)));
 
   return interval_traits<Type>::construct(domain_prior<Type>(value), value);
 }
@@ -154,9 +154,9 @@ template <typename Type>
 Type unit_trail(const typename interval_traits<Type>::domain_type& value) {
   using domain_type = interval_traits<Type>::domain_type;
   using domain_compare = interval_traits<Type>::domain_compare;
-  static_assert(
-      numeric_minimum<domain_type, domain_compare,
-                      is_numeric<domain_type>::value>::is_less_than(value));
+  assert(
+      (numeric_minimum<domain_type, domain_compare,
+                       is_numeric<domain_type>::value>::is_less_than(value)));
 
   return interval_traits<Type>::construct(domain_prior<Type>(value),
                                           domain_next<Type>(value));
@@ -238,14 +238,14 @@ Type hull(const typename interval_traits<Type>::domain_type& left,
   using domain_type = interval_traits<Type>::domain_type;
   using domain_compare = interval_traits<Type>::domain_compare;
   if (domain_compare()(left, right)) {
-    static_assert(
-        numeric_minimum<domain_type, domain_compare,
-                        is_numeric<domain_type>::value>::is_less_than(left));
+    assert(
+        (numeric_minimum<domain_type, domain_compare,
+                         is_numeric<domain_type>::value>::is_less_than(left)));
     return construct<Type>(domain_prior<Type>(left), right);
   }
-  static_assert(
-      numeric_minimum<domain_type, domain_compare,
-                      is_numeric<domain_type>::value>::is_less_than(right));
+  assert(
+      (numeric_minimum<domain_type, domain_compare,
+                       is_numeric<domain_type>::value>::is_less_than(right)));
   return construct<Type>(domain_prior<Type>(right), left);
 }
 
@@ -267,14 +267,14 @@ Type hull(const typename interval_traits<Type>::domain_type& left,
   using domain_compare = interval_traits<Type>::domain_compare;
 
   if (domain_compare()(left, right)) {
-    static_assert(
-        numeric_minimum<domain_type, domain_compare,
-                        is_numeric<domain_type>::value>::is_less_than(left));
+    assert(
+        (numeric_minimum<domain_type, domain_compare,
+                         is_numeric<domain_type>::value>::is_less_than(left)));
     return construct<Type>(domain_prior<Type>(left), domain_next<Type>(right));
   }
-  static_assert(
-      numeric_minimum<domain_type, domain_compare,
-                      is_numeric<domain_type>::value>::is_less_than(right));
+  assert(
+      (numeric_minimum<domain_type, domain_compare,
+                       is_numeric<domain_type>::value>::is_less_than(right)));
   return construct<Type>(domain_prior<Type>(right), domain_next<Type>(left));
 }
 
@@ -338,9 +338,9 @@ template <typename Type>
 interval_traits<Type>::domain_type last(const Type& object) {
   using domain_type = interval_traits<Type>::domain_type;
   using domain_compare = interval_traits<Type>::domain_compare;
-  static_assert(numeric_minimum<
-                domain_type, domain_compare,
-                is_numeric<domain_type>::value>::is_less_than(upper(object)));
+  assert((numeric_minimum<domain_type, domain_compare,
+                          is_numeric<domain_type>::value>::is_less_than(
+      upper(object))));
 
   return domain_prior<Type>(upper(object));
 }
@@ -1185,38 +1185,38 @@ difference_type_of<interval_traits<Type>>::type distance(const Type& x1,
 //==============================================================================
 template <typename Type>
   requires(is_static_left_open<Type>::value || is_static_open<Type>::value)
-std::string left_bracket(const Type&) {
+const char* left_bracket(const Type&) {
   return "(";
 }
 
 template <typename Type>
   requires(is_static_right_open<Type>::value || is_static_closed<Type>::value)
-std::string left_bracket(const Type&) {
+const char* left_bracket(const Type&) {
   return "[";
 }
 
 template <typename Type>
   requires has_dynamic_bounds<Type>::value
-std::string left_bracket(const Type& object) {
+const char* left_bracket(const Type& object) {
   return left_bracket(object.bounds());
 }
 
 //------------------------------------------------------------------------------
 template <typename Type>
   requires(is_static_right_open<Type>::value || is_static_open<Type>::value)
-std::string right_bracket(const Type&) {
+const char* right_bracket(const Type&) {
   return ")";
 }
 
 template <typename Type>
   requires(is_static_left_open<Type>::value || is_static_closed<Type>::value)
-std::string right_bracket(const Type&) {
+const char* right_bracket(const Type&) {
   return "]";
 }
 
 template <typename Type>
   requires has_dynamic_bounds<Type>::value
-std::string right_bracket(const Type& object) {
+const char* right_bracket(const Type& object) {
   return right_bracket(object.bounds());
 }
 
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "icl/concept/container.hpp"
 #include "icl/concept/interval.hpp"
 #include "icl/concept/interval_map.hpp"
 #include "icl/concept/interval_set.hpp"
+#include "icl/detail/interval_merge_algo.hpp"
 #include "icl/detail/interval_set_algo.hpp"
 #include "icl/detail/map_algo.hpp"
 #include "icl/detail/set_algo.hpp"
@@ -11,6 +13,7 @@
 #include "icl/type_traits/is_combinable.hpp"
 #include <cstddef>
 #include <ranges>
+#include <utility>
 
 namespace icl {
 
@@ -101,6 +104,9 @@ template <typename Type>
 Type::size_type cardinality(const Type& object) {
   using size_type = Type::size_type;
 
+  if constexpr (requires { requires Type::caches_measure; })
+    return object.size(); // Running total
+
   size_type size = identity_element<size_type>::value();
   for (typename Type::const_iterator it = object.begin(); !(it == object.end());
        ++it)
@@ -137,6 +143,9 @@ template <typename Type>
 Type::difference_type length(const Type& object) {
   using difference_type = Type::difference_type;
   using const_iterator = Type::const_iterator;
+
+  if constexpr (requires { requires Type::caches_measure; })
+    return object.length(); // Running total
   difference_type length = identity_element<difference_type>::value();
   const_iterator it_ = object.begin();
 
@@ -248,16 +257,27 @@ Type& operator+=(Type& object, const OperandT& operand) {
   return icl::add(object, operand);
 }
 
+/** Addition of a segment, that is moved from, to an interval map. */
+template <typename Type>
+  requires is_interval_map<Type>::value
+Type& operator+=(Type& object, typename Type::segment_type&& operand) {
+  return icl::add(object, std::move(operand));
+}
+
 //------------------------------------------------------------------------------
 //- T& op +=(T&, c P&) T:{S}|{M} P:{S'}|{M'}
 //------------------------------------------------------------------------------
 /** \par \b Requires: \c OperandT is an interval container addable to \c Type.
     \b Effects: \c operand is added to \c object.
     \par \b Returns: A reference to \c object.
-    \b Complexity: loglinear */
+    \b Complexity: loglinear. Linear, if the sizes of \c object and
+    \c operand are comparable, since both are merged in one sweep then. */
 template <typename Type, typename OperandT>
   requires is_intra_combinable<Type, OperandT>::value
 Type& operator+=(Type& object, const OperandT& operand) {
+  if (Interval_Merge::is_preferable(object, operand))
+    return Interval_Merge::add(object, operand);
+
   typename Type::iterator prior_ = object.end();
   for (typename OperandT::const_iterator elem_ = operand.begin();
        !(elem_ == operand.end()); ++elem_)
@@ -269,7 +289,7 @@ Type& operator+=(Type& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_intra_combinable<Type, OperandT>::value
 Type operator+(const Type& object, const OperandT& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp += operand);
 }
 
@@ -282,7 +302,7 @@ Type operator+(Type&& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_intra_combinable<Type, OperandT>::value
 Type operator+(const OperandT& operand, const Type& object) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp += operand);
 }
 
@@ -295,7 +315,7 @@ Type operator+(const OperandT& operand, Type&& object) {
 template <typename Type>
   requires is_interval_container<Type>::value
 Type operator+(const Type& object, const Type& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp += operand);
 }
 
@@ -355,7 +375,7 @@ Type& operator|=(Type& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_intra_combinable<Type, OperandT>::value
 Type operator|(const Type& object, const OperandT& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp += operand);
 }
 
@@ -368,7 +388,7 @@ Type operator|(Type&& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_intra_combinable<Type, OperandT>::value
 Type operator|(const OperandT& operand, const Type& object) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp += operand);
 }
 
@@ -381,7 +401,7 @@ Type operator|(const OperandT& operand, Type&& object) {
 template <typename Type>
   requires is_interval_container<Type>::value
 Type operator|(const Type& object, const Type& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp += operand);
 }
 
@@ -472,10 +492,14 @@ For the subtraction of \em elements, \b segments and \b interval \b containers
 complexity is \b logarithmic, \b linear and \b loglinear respectively.
 For interval sets subtraction of segments
 is \b amortized \b logarithmic.
+Interval containers of comparable sizes are merged in one \b linear sweep.
 */
 template <typename Type, typename OperandT>
   requires is_concept_compatible<is_interval_map, Type, OperandT>::value
 Type& operator-=(Type& object, const OperandT& operand) {
+  if (Interval_Merge::is_preferable(object, operand))
+    return Interval_Merge::subtract(object, operand);
+
   for (typename OperandT::const_iterator elem_ = operand.begin();
        !(elem_ == operand.end()); ++elem_)
     icl::subtract(object, *elem_);
@@ -507,13 +531,16 @@ Type& operator-=(Type& object, const OperandT& operand) {
 template <typename Type, typename IntervalSetT>
   requires combines_right_to_interval_set<Type, IntervalSetT>::value
 Type& operator-=(Type& object, const IntervalSetT& operand) {
+  if (Interval_Merge::is_preferable(object, operand))
+    return Interval_Merge::erase(object, operand);
+
   return erase(object, operand);
 }
 
 template <typename Type, typename OperandT>
   requires is_right_inter_combinable<Type, OperandT>::value
 Type operator-(const Type& object, const OperandT& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp -= operand);
 }
 
@@ -554,7 +581,18 @@ void add_intersection(Type& section, const Type& object,
 template <typename Type, typename OperandT>
   requires is_right_inter_combinable<Type, OperandT>::value
 Type& operator&=(Type& object, const OperandT& operand) {
-  Type intersection;
+  Type intersection = icl::empty_like(object);
+  if constexpr (requires {
+                  Interval_Merge::add_intersection(intersection, object,
+                                                   operand);
+                }) {
+    if (Interval_Merge::is_preferable(object, operand)) {
+      Interval_Merge::add_intersection(intersection, object, operand);
+      object.swap(intersection);
+      return object;
+    }
+  }
+
   add_intersection(intersection, object, operand);
   object.swap(intersection);
   return object;
@@ -563,7 +601,7 @@ Type& operator&=(Type& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_inter_combinable<Type, OperandT>::value
 Type operator&(const Type& object, const OperandT& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp &= operand);
 }
 
@@ -576,7 +614,7 @@ Type operator&(Type&& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_inter_combinable<Type, OperandT>::value
 Type operator&(const OperandT& operand, const Type& object) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp &= operand);
 }
 
@@ -589,7 +627,7 @@ Type operator&(const OperandT& operand, Type&& object) {
 template <typename Type>
   requires is_interval_container<Type>::value
 Type operator&(const Type& object, const Type& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp &= operand);
 }
 
@@ -643,7 +681,7 @@ template <typename LeftT, typename RightT>
            (!(is_total<LeftT>::value || is_total<RightT>::value)))
 bool intersects(const LeftT& left, const RightT& right) {
   using const_iterator = RightT::const_iterator;
-  LeftT intersection;
+  LeftT intersection = icl::empty_like(left);
 
   const_iterator right_common_lower_, right_common_upper_;
   if (!Set::common_range(right_common_lower_, right_common_upper_, right, left))
@@ -662,7 +700,7 @@ template <typename LeftT, typename RightT>
   requires is_cross_combinable<LeftT, RightT>::value
 bool intersects(const LeftT& left, const RightT& right) {
   using const_iterator = RightT::const_iterator;
-  LeftT intersection;
+  LeftT intersection = icl::empty_like(left);
 
   if (icl::is_empty(left) || icl::is_empty(right))
     return false;
@@ -714,6 +752,11 @@ bool disjoint(const Type& left, const AssociateT& right) {
 template <typename Type, typename OperandT>
   requires is_intra_combinable<Type, OperandT>::value
 Type& operator^=(Type& object, const OperandT& operand) {
+  if constexpr (requires { Interval_Merge::flip(object, operand); }) {
+    if (Interval_Merge::is_preferable(object, operand))
+      return Interval_Merge::flip(object, operand);
+  }
+
   return icl::flip(object, operand);
 }
 
@@ -729,7 +772,7 @@ Type& operator^=(Type& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_intra_combinable<Type, OperandT>::value
 Type operator^(const Type& object, const OperandT& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp ^= operand);
 }
 
@@ -742,7 +785,7 @@ Type operator^(Type&& object, const OperandT& operand) {
 template <typename Type, typename OperandT>
   requires is_binary_intra_combinable<Type, OperandT>::value
 Type operator^(const OperandT& operand, const Type& object) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp ^= operand);
 }
 
@@ -755,7 +798,7 @@ Type operator^(const OperandT& operand, Type&& object) {
 template <typename Type>
   requires is_interval_container<Type>::value
 Type operator^(const Type& object, const Type& operand) {
-  Type temp = object;
+  Type temp = icl::copy_like(object);
   return std::move(temp ^= operand);
 }
 
@@ -95,6 +95,7 @@ template <typename Type>
 Type& join(Type& object) {
   using interval_type = Type::interval_type;
   using iterator = Type::iterator;
+  using segment_type = Type::segment_type;
 
   iterator it_ = object.begin();
   if (it_ == object.end())
@@ -117,10 +118,19 @@ Type& join(Type& object) {
       }
 
       // finally we arrive at the end of a sequence of joinable intervals,
-      // and it points to the last member of that sequence
-      const_cast<interval_type&>(key_value<Type>(it_)) =
+      // and it points to the last member of that sequence. The sequence is
+      // replaced by its hull through the public interface, which keeps
+      // the running totals of the container intact.
+      const interval_type hull_ =
           hull(key_value<Type>(it_), key_value<Type>(fst_mem));
-      object.erase(fst_mem, it_);
+      const segment_type joined = [&] {
+        if constexpr (is_map<Type>::value)
+          return segment_type(hull_, (*it_).second);
+        else
+          return segment_type(hull_);
+      }();
+      it_ = object.erase(fst_mem, next_);
+      it_ = object.insert(it_, joined);
 
       ++it_;
       next_ = it_;
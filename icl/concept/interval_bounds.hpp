@@ -88,11 +88,11 @@ inline bool is_right_closed(interval_bounds bounds) {
   return bounds.right().bits() == 1;
 }
 
-inline std::string left_bracket(interval_bounds bounds) {
+inline const char* left_bracket(interval_bounds bounds) {
   return is_left_closed(bounds) ? "[" : "(";
 }
 
-inline std::string right_bracket(interval_bounds bounds) {
+inline const char* right_bracket(interval_bounds bounds) {
   return is_right_closed(bounds) ? "]" : ")";
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "icl/concept/container.hpp"
 #include "icl/concept/interval.hpp"
 #include "icl/concept/interval_associator_base.hpp"
 #include "icl/concept/interval_set.hpp"
@@ -10,6 +11,8 @@
 #include "icl/type_traits/is_combinable.hpp"
 #include "icl/type_traits/is_interval_splitter.hpp"
 #include "icl/type_traits/segment_type_of.hpp"
+#include <iterator>
+#include <utility>
 
 namespace icl {
 
@@ -52,7 +55,7 @@ bool contains(const Type& super,
   if (exterior.first == exterior.second)
     return false;
 
-  const_iterator last_overlap = prior(exterior.second);
+  const_iterator last_overlap = std::prev(exterior.second);
 
   if (!(sub_segment.second == exterior.first->second))
     return false;
@@ -101,7 +104,7 @@ bool contains(const Type& super,
   if (exterior.first == exterior.second)
     return false;
 
-  const_iterator last_overlap = prior(exterior.second);
+  const_iterator last_overlap = std::prev(exterior.second);
 
   return icl::contains(hull(exterior.first->first, last_overlap->first),
                        sub_interval) &&
@@ -128,6 +131,12 @@ Type& add(Type& object, const typename Type::segment_type& operand) {
   return object.add(operand);
 }
 
+template <typename Type>
+  requires is_interval_map<Type>::value
+Type& add(Type& object, typename Type::segment_type&& operand) {
+  return object.add(std::move(operand));
+}
+
 template <typename Type>
   requires is_interval_map<Type>::value
 Type& add(Type& object, const typename Type::element_type& operand) {
@@ -144,6 +153,13 @@ Type::iterator add(Type& object, typename Type::iterator prior_,
   return object.add(prior_, operand);
 }
 
+template <typename Type>
+  requires is_interval_map<Type>::value
+Type::iterator add(Type& object, typename Type::iterator prior_,
+                   typename Type::segment_type&& operand) {
+  return object.add(prior_, std::move(operand));
+}
+
 //==============================================================================
 //= Insertion<IntervalMap>
 //==============================================================================
@@ -156,6 +172,12 @@ Type& insert(Type& object, const typename Type::segment_type& operand) {
   return object.insert(operand);
 }
 
+template <typename Type>
+  requires is_interval_map<Type>::value
+Type& insert(Type& object, typename Type::segment_type&& operand) {
+  return object.insert(std::move(operand));
+}
+
 template <typename Type>
   requires is_interval_map<Type>::value
 Type& insert(Type& object, const typename Type::element_type& operand) {
@@ -172,6 +194,13 @@ Type::iterator insert(Type& object, typename Type::iterator prior,
   return object.insert(prior, operand);
 }
 
+template <typename Type>
+  requires is_interval_map<Type>::value
+Type::iterator insert(Type& object, typename Type::iterator prior,
+                      typename Type::segment_type&& operand) {
+  return object.insert(prior, std::move(operand));
+}
+
 //==============================================================================
 //= Erasure<IntervalMap>
 //==============================================================================
@@ -252,6 +281,13 @@ Type& set_at(Type& object, const typename Type::segment_type& operand) {
   return icl::insert(object, operand);
 }
 
+template <typename Type>
+  requires is_interval_map<Type>::value
+Type& set_at(Type& object, typename Type::segment_type&& operand) {
+  icl::erase(object, operand.first);
+  return icl::insert(object, std::move(operand));
+}
+
 template <typename Type>
   requires is_interval_map<Type>::value
 Type& set_at(Type& object, const typename Type::element_type& operand) {
@@ -382,7 +418,7 @@ template <typename Type, typename OperandT>
   requires(is_interval_map<Type>::value && (!is_total<Type>::value) &&
            std::is_same_v<OperandT, typename segment_type_of<Type>::type>)
 bool intersects(const Type& object, const OperandT& operand) {
-  Type intersection;
+  Type intersection = icl::empty_like(object);
   icl::add_intersection(intersection, object, operand);
   return !icl::is_empty(intersection);
 }
@@ -430,15 +466,8 @@ template <typename Type, typename OperandT>
   requires(is_total<Type>::value && (!absorbs_identities<Type>::value) &&
            is_concept_compatible<is_interval_map, Type, OperandT>::value)
 Type& flip(Type& object, const OperandT& operand) {
-  using codomain_type = Type::codomain_type;
-
   object += operand;
-  for (typename Type::iterator it_ = object.begin(); it_ != object.end(); ++it_)
-    (*it_).second = identity_element<codomain_type>::value();
-
-  if constexpr (!is_interval_splitter<Type>::value)
-    icl::join(object);
-
+  Interval_Map::reset_values(object);
   return object;
 }
 
@@ -517,7 +546,7 @@ MapT& erase_if(const Predicate& pred, MapT& object) {
   typename MapT::iterator it_ = object.begin();
   while (it_ != object.end())
     if (pred(*it_))
-      object.erase(it_++);
+      it_ = object.erase(it_);
     else
       ++it_;
   return object;
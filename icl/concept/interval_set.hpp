@@ -202,15 +202,15 @@ Type& flip(Type& object, const typename Type::segment_type& segment) {
   // That which is not shall be added
   // So x has to be 'complementary added' or flipped
   interval_type span = segment;
-  std::pair<const_iterator, const_iterator> exterior = object.equal_range(span);
-
-  const_iterator fst_ = exterior.first;
-  const_iterator end_ = exterior.second;
-
   interval_type covered, left_over;
-  const_iterator it_ = fst_;
-  while (it_ != end_) {
-    covered = *it_++;
+  // The overlap is looked up anew in each step, because updates may
+  // invalidate iterators on contiguous storage.
+  while (!icl::is_empty(span)) {
+    const_iterator it_ = object.lower_bound(span);
+    if (it_ == object.end() || !icl::intersects(*it_, span))
+      break;
+
+    covered = *it_;
     //[a      ...  : span
     //     [b ...  : covered
     //[a  b)       : left_over
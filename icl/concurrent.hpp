@@ -0,0 +1,302 @@
+#pragma once
+
+#include "icl/concept/interval_associator.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/type_traits/identity_element.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace icl {
+namespace detail {
+
+/// The number of the calling thread, in the order of the first calls
+inline std::size_t reader_number() {
+  static std::atomic<std::size_t> readers{0};
+  thread_local const std::size_t number =
+      readers.fetch_add(1, std::memory_order_relaxed);
+  return number;
+}
+
+} // namespace detail
+
+/** \brief The interval container \c Type, shared by threads that read it
+    without locks while others update it.
+
+    Two copies of the container are kept (the left-right technique):
+    Readers query one of them, while a writer updates the other one. The
+    writer then directs new readers to the updated copy, waits for the
+    readers of the former one to leave it and applies the update to it as
+    well. Readers announce themselves by counters, that are spread over
+    cache lines by the threads using them, so they take no lock, never
+    wait and share no cache line with readers of other threads as long as
+    there are fewer than \c reader_shards threads. The copies live as long
+    as the shared container, so there is no memory to reclaim.
+
+    Writers are serialised by a mutex. An update takes twice the time it
+    takes on \c Type, plus the time readers take to leave the former copy.
+    Queries and updates have the semantics of those of \c Type. Queries do
+    not return iterators, because the segments they would refer to are
+    updated behind them: \c find yields a copy of the segment, and
+    \c read applies a function to the container, whose result must not
+    refer to it. */
+template <typename Type>
+  requires is_interval_container<Type>::value
+class concurrent {
+public:
+  /// The type of the container that is shared
+  using container_type = Type;
+  using domain_type = Type::domain_type;
+  using codomain_type = Type::codomain_type;
+  using interval_type = Type::interval_type;
+  using element_type = Type::element_type;
+  using segment_type = Type::segment_type;
+  using size_type = Type::size_type;
+
+  /// The number of reader counters per copy
+  static constexpr std::size_t reader_shards = 64;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  concurrent() = default;
+
+  /** Shares a copy of \c object */
+  explicit concurrent(const Type& object) : _instances{object, object} {}
+
+  concurrent(const concurrent&) = delete;
+  concurrent& operator=(const concurrent&) = delete;
+
+  //==========================================================================
+  //= Reading
+  //==========================================================================
+
+  /** The result of \c reader applied to the container. It must not refer
+      to the container, which is updated once \c read returns. */
+  template <typename Reader>
+    requires std::invocable<Reader&, const Type&>
+  auto read(Reader reader) const
+      -> std::decay_t<std::invoke_result_t<Reader&, const Type&>> {
+    const std::size_t version = _version.load();
+    std::atomic<std::size_t>& readers =
+        _readers[version][detail::reader_number() % reader_shards].count;
+    readers.fetch_add(1);
+    const struct depart {
+      std::atomic<std::size_t>& readers;
+      ~depart() { readers.fetch_sub(1); }
+    } guard{readers};
+    return reader(_instances[_readable.load()]);
+  }
+
+  /** A copy of the container */
+  Type snapshot() const {
+    return read([](const Type& object) { return object; });
+  }
+
+  [[nodiscard]] bool empty() const {
+    return read([](const Type& object) { return object.empty(); });
+  }
+
+  /** Number of segments of the container */
+  [[nodiscard]] std::size_t iterative_size() const {
+    return read([](const Type& object) { return object.iterative_size(); });
+  }
+
+  /** A copy of the segment that contains \c key, if there is one */
+  std::optional<segment_type> find(const domain_type& key) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return read([&](const Type& object) -> std::optional<segment_type> {
+      const auto it_ = object.find(key);
+      if (it_ == object.end())
+        return std::nullopt;
+      return *it_;
+    });
+  }
+
+  /** A copy of the first segment that collides with \c key_interval, if
+      there is one */
+  std::optional<segment_type> find(const interval_type& key_interval) const {
+    return read([&](const Type& object) -> std::optional<segment_type> {
+      const auto it_ = object.find(key_interval);
+      if (it_ == object.end())
+        return std::nullopt;
+      return *it_;
+    });
+  }
+
+  /** Total select function: The value that \c key is mapped to */
+  codomain_type operator()(const domain_type& key) const
+    requires(is_interval_map<Type>::value && Interval_Stabbing::stabbable<Type>)
+  {
+    return read([&](const Type& object) { return object(key); });
+  }
+
+  /** Does the container contain \c sub? */
+  template <typename CoType> bool contains(const CoType& sub) const {
+    return read(
+        [&](const Type& object) { return icl::contains(object, sub); });
+  }
+
+  /** Do \c operand and the container have elements in common? */
+  template <typename CoType> bool intersects(const CoType& operand) const {
+    return read(
+        [&](const Type& object) { return icl::intersects(object, operand); });
+  }
+
+  //==========================================================================
+  //= Writing
+  //==========================================================================
+
+  /** Applies \c writer to the container. It is applied to both copies in
+      turn, so it must update them alike, whatever it reads from them. If
+      it throws on the first copy, the container is left as it was, if it
+      throws on the second one, the update of the first one stands. */
+  template <typename Writer>
+    requires std::invocable<Writer&, Type&>
+  void write(Writer writer) {
+    update([&](Type& object, bool) { writer(object); });
+  }
+
+  concurrent& add(const element_type& operand) {
+    update([&](Type& object, bool) { object.add(operand); });
+    return *this;
+  }
+
+  concurrent& add(const segment_type& operand) {
+    update([&](Type& object, bool) { object.add(operand); });
+    return *this;
+  }
+
+  /** Adds \c operand, that is copied to the first copy and moved to the
+      second one */
+  concurrent& add(segment_type&& operand) {
+    update([&](Type& object, bool last) {
+      if (last)
+        object.add(std::move(operand));
+      else
+        object.add(std::as_const(operand));
+    });
+    return *this;
+  }
+
+  concurrent& subtract(const element_type& operand) {
+    update([&](Type& object, bool) { object.subtract(operand); });
+    return *this;
+  }
+
+  concurrent& subtract(const segment_type& operand) {
+    update([&](Type& object, bool) { object.subtract(operand); });
+    return *this;
+  }
+
+  concurrent& insert(const element_type& operand) {
+    update([&](Type& object, bool) { object.insert(operand); });
+    return *this;
+  }
+
+  concurrent& insert(const segment_type& operand) {
+    update([&](Type& object, bool) { object.insert(operand); });
+    return *this;
+  }
+
+  concurrent& erase(const element_type& operand) {
+    update([&](Type& object, bool) { object.erase(operand); });
+    return *this;
+  }
+
+  concurrent& erase(const segment_type& operand) {
+    update([&](Type& object, bool) { object.erase(operand); });
+    return *this;
+  }
+
+  /** Sets the values of the elements of \c operand to its value, as
+      \c set_at does */
+  concurrent& set(const element_type& operand)
+    requires is_interval_map<Type>::value
+  {
+    update([&](Type& object, bool) { object.set(operand); });
+    return *this;
+  }
+
+  concurrent& set(const segment_type& operand)
+    requires is_interval_map<Type>::value
+  {
+    update([&](Type& object, bool) { object.set(operand); });
+    return *this;
+  }
+
+  void clear() {
+    update([](Type& object, bool) { object.clear(); });
+  }
+
+  /** Replaces the container by a copy of \c object */
+  void assign(const Type& object) {
+    update([&](Type& instance, bool) { instance = object; });
+  }
+
+private:
+  /// A reader counter on a cache line of its own
+  struct alignas(64) reader_count {
+    std::atomic<std::size_t> count{0};
+  };
+
+  using reader_counts = std::array<reader_count, reader_shards>;
+
+  /** Applies \c updater to the copy that is not read, lets the readers
+      read it and applies \c updater to the former one, once its readers
+      left it. The second argument of \c updater tells the second call. */
+  template <typename Updater> void update(Updater updater) {
+    const std::scoped_lock lock(_writer);
+    const std::size_t readable = _readable.load();
+    const std::size_t written = 1 - readable;
+
+    try {
+      updater(_instances[written], false);
+    } catch (...) {
+      _instances[written] = _instances[readable];
+      throw;
+    }
+    _readable.store(written);
+    wait_for_readers();
+    try {
+      updater(_instances[readable], true);
+    } catch (...) {
+      _instances[readable] = _instances[written];
+      throw;
+    }
+  }
+
+  /// Waits until the readers, that may read the copy that is no longer
+  /// readable, left it. New readers count on the other counters meanwhile.
+  void wait_for_readers() {
+    const std::size_t previous = _version.load();
+    const std::size_t next = 1 - previous;
+    wait_for(_readers[next]);
+    _version.store(next);
+    wait_for(_readers[previous]);
+  }
+
+  static void wait_for(const reader_counts& counts) {
+    for (const reader_count& readers : counts)
+      while (readers.count.load() != 0)
+        std::this_thread::yield();
+  }
+
+  Type _instances[2];
+  /// The copy that readers read
+  std::atomic<std::size_t> _readable{0};
+  /// The counters that readers count on
+  std::atomic<std::size_t> _version{0};
+  mutable reader_counts _readers[2];
+  std::mutex _writer;
+};
+
+} // namespace icl
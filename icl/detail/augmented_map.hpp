@@ -0,0 +1,802 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace icl {
+namespace detail {
+
+/** \brief A sorted associative container that keeps a \c Summary of the
+    values of every subtree.
+
+    \c augmented_map models the part of the \c std::map interface that is
+    used by interval containers. It is a randomized balanced search tree
+    (treap), iterators are stable under insertion and erasure of other
+    values. A \c Summary is constructed from a key and its mapped value, the
+    summary of a following range is combined into it by \c append.
+
+    Insertion and erasure maintain the summaries. Values that are changed in
+    place through iterators have to be announced by \c refresh. The summary
+    of a range of values is computed in logarithmic time by \c summarize. */
+template <typename KeyT, typename DataT, typename Compare, typename Alloc,
+          typename Summary>
+class augmented_map {
+  struct node_base {
+    node_base* parent = nullptr;
+    node_base* left = nullptr;
+    node_base* right = nullptr;
+  };
+
+  struct node : node_base {
+    template <typename... Args>
+    explicit node(std::uint64_t priority_, Args&&... args)
+        : priority(priority_), value(std::forward<Args>(args)...),
+          summary(value.first, value.second) {}
+
+    std::uint64_t priority;
+    std::pair<const KeyT, DataT> value;
+    Summary summary;
+  };
+
+  using alloc_traits = std::allocator_traits<Alloc>;
+  using node_allocator = alloc_traits::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+public:
+  using key_type = KeyT;
+  using mapped_type = DataT;
+  using value_type = std::pair<const KeyT, DataT>;
+  using key_compare = Compare;
+  using allocator_type = Alloc;
+  using summary_type = Summary;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+
+  template <bool IsConst> class basic_iterator {
+    template <bool> friend class basic_iterator;
+    friend class augmented_map;
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = augmented_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<IsConst, const value_type&,
+                                         value_type&>;
+    using pointer = std::conditional_t<IsConst, const value_type*,
+                                       value_type*>;
+
+    basic_iterator() = default;
+
+    template <bool OtherConst>
+      requires(IsConst && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst>& other)
+        : _node(other._node) {}
+
+    reference operator*() const { return static_cast<node*>(_node)->value; }
+    pointer operator->() const { return &**this; }
+
+    basic_iterator& operator++() {
+      _node = successor(_node);
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    basic_iterator& operator--() {
+      _node = predecessor(_node);
+      return *this;
+    }
+
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    template <bool OtherConst>
+    bool operator==(const basic_iterator<OtherConst>& other) const {
+      return _node == other._node;
+    }
+
+  private:
+    explicit basic_iterator(const node_base* node_)
+        : _node(const_cast<node_base*>(node_)) {}
+
+    node_base* _node = nullptr;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  augmented_map() = default;
+
+  explicit augmented_map(const Compare& compare, const Alloc& alloc = Alloc())
+      : _compare(compare), _alloc(alloc) {}
+
+  explicit augmented_map(const Alloc& alloc) : _alloc(alloc) {}
+
+  template <typename InputIterator>
+  augmented_map(InputIterator first, InputIterator past) {
+    insert(first, past);
+  }
+
+  augmented_map(const augmented_map& src)
+      : _compare(src._compare),
+        _alloc(node_traits::select_on_container_copy_construction(
+            src._alloc)),
+        _seed(src._seed) {
+    adopt(clone(src.root(), &_header), src._size);
+  }
+
+  augmented_map(augmented_map&& src) noexcept
+      : _compare(src._compare), _alloc(std::move(src._alloc)),
+        _seed(src._seed) {
+    adopt(src.root(), src._size);
+    src.adopt(nullptr, 0);
+  }
+
+  /// Copy that allocates from \c alloc
+  augmented_map(const augmented_map& src, const Alloc& alloc)
+      : _compare(src._compare), _alloc(alloc), _seed(src._seed) {
+    adopt(clone(src.root(), &_header), src._size);
+  }
+
+  /** Move that allocates from \c alloc. The nodes of \c src are adopted,
+      if they were allocated by an equal allocator, and copied otherwise. */
+  augmented_map(augmented_map&& src, const Alloc& alloc)
+      : _compare(src._compare), _alloc(alloc), _seed(src._seed) {
+    if (_alloc == src._alloc) {
+      adopt(src.root(), src._size);
+      src.adopt(nullptr, 0);
+    } else
+      adopt(clone(src.root(), &_header), src._size);
+  }
+
+  augmented_map& operator=(const augmented_map& src) {
+    if (this == &src)
+      return *this;
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value)
+      take<true>(augmented_map(src, Alloc(src._alloc)));
+    else
+      take<false>(augmented_map(src, get_allocator()));
+    return *this;
+  }
+
+  augmented_map& operator=(augmented_map&& src) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value) {
+    if (this == &src)
+      return *this;
+    if constexpr (node_traits::propagate_on_container_move_assignment::value)
+      take<true>(std::move(src));
+    else
+      take<false>(augmented_map(std::move(src), get_allocator()));
+    return *this;
+  }
+
+  ~augmented_map() { destroy(root()); }
+
+  allocator_type get_allocator() const { return Alloc(_alloc); }
+  key_compare key_comp() const { return _compare; }
+
+  void swap(augmented_map& other) noexcept {
+    node_base* root_ = root();
+    const size_type size_ = _size;
+    adopt(other.root(), other._size);
+    other.adopt(root_, size_);
+    std::swap(_compare, other._compare);
+    std::swap(_seed, other._seed);
+    if constexpr (node_traits::propagate_on_container_swap::value)
+      std::swap(_alloc, other._alloc);
+  }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  [[nodiscard]] bool empty() const { return _size == 0; }
+  [[nodiscard]] size_type size() const { return _size; }
+  [[nodiscard]] size_type max_size() const {
+    return node_traits::max_size(_alloc);
+  }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  iterator begin() { return iterator(_leftmost); }
+  iterator end() { return iterator(&_header); }
+  const_iterator begin() const { return const_iterator(_leftmost); }
+  const_iterator end() const { return const_iterator(&_header); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+  iterator lower_bound(const key_type& key) {
+    return iterator(lower_node(key));
+  }
+  const_iterator lower_bound(const key_type& key) const {
+    return const_iterator(lower_node(key));
+  }
+  iterator upper_bound(const key_type& key) {
+    return iterator(upper_node(key));
+  }
+  const_iterator upper_bound(const key_type& key) const {
+    return const_iterator(upper_node(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  iterator find(const key_type& key) {
+    iterator it_ = lower_bound(key);
+    return it_ == end() || _compare(key, (*it_).first) ? end() : it_;
+  }
+
+  const_iterator find(const key_type& key) const {
+    const_iterator it_ = lower_bound(key);
+    return it_ == end() || _compare(key, (*it_).first) ? end() : it_;
+  }
+
+  bool contains(const key_type& key) const { return find(key) != end(); }
+
+  //==========================================================================
+  //= Summaries
+  //==========================================================================
+  /** The summary of the values in <tt>[first,past)</tt>, or nothing for an
+      empty range. Logarithmic time. */
+  std::optional<Summary> summarize(const_iterator first,
+                                   const_iterator past) const {
+    if (first == past)
+      return std::nullopt;
+    const key_type& lower = (*first).first;
+    const key_type& upper = (*std::prev(past)).first;
+
+    // The highest node within the range, all others are in its subtrees
+    const node_base* split_ = root();
+    while (true)
+      if (_compare(key(split_), lower))
+        split_ = split_->right;
+      else if (_compare(upper, key(split_)))
+        split_ = split_->left;
+      else
+        break;
+
+    // Values of the left subtree from the lower bound on, found from the
+    // right to the left
+    std::optional<Summary> front;
+    for (const node_base* x = split_->left; x != nullptr;)
+      if (_compare(key(x), lower))
+        x = x->right;
+      else {
+        Summary piece = own_summary(x);
+        if (x->right != nullptr)
+          piece.append(summary(x->right));
+        if (front)
+          piece.append(*front);
+        front = std::move(piece);
+        x = x->left;
+      }
+
+    std::optional<Summary> result = std::move(front);
+    append(result, own_summary(split_));
+
+    // Values of the right subtree up to the upper bound
+    for (const node_base* x = split_->right; x != nullptr;)
+      if (_compare(upper, key(x)))
+        x = x->left;
+      else {
+        if (x->left != nullptr)
+          append(result, summary(x->left));
+        append(result, own_summary(x));
+        x = x->right;
+      }
+    return result;
+  }
+
+  /** The first position from \c position on, whose value has a summary
+      that satisfies \c admits. The predicate has to hold for the summary of
+      a range, if it holds for any of its values, so subtrees whose
+      summaries are not admitted are skipped. */
+  template <typename Admits>
+  const_iterator find_admitted(const_iterator position, Admits admits) const {
+    const node_base* x = position._node;
+    if (x == &_header || admits(own_summary(x)))
+      return position;
+    if (x->right != nullptr && admits(summary(x->right)))
+      return const_iterator(first_admitted(x->right, admits));
+    // The successors of x beyond its right subtree are the ancestors that
+    // are reached from the left, followed by their right subtrees
+    for (const node_base* parent_ = x->parent; parent_ != &_header;
+         x = parent_, parent_ = parent_->parent)
+      if (parent_->left == x) {
+        if (admits(own_summary(parent_)))
+          return const_iterator(parent_);
+        if (parent_->right != nullptr && admits(summary(parent_->right)))
+          return const_iterator(first_admitted(parent_->right, admits));
+      }
+    return end();
+  }
+
+  /** Recomputes the summaries of the values with keys equivalent to \c key
+      after they have been changed in place. */
+  void refresh(const key_type& key) { refresh(root(), key); }
+
+  //==========================================================================
+  //= Insertion
+  //==========================================================================
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace(std::move(value));
+  }
+
+  /** Insertion with hint. The hint is not used, insertion is logarithmic
+      in any case. */
+  iterator insert(const_iterator, const value_type& value) {
+    return emplace(value).first;
+  }
+
+  iterator insert(const_iterator, value_type&& value) {
+    return emplace(std::move(value)).first;
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator past) {
+    for (; first != past; ++first)
+      emplace((*first).first, (*first).second);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert_node(create(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  /** Insertion that keeps values with keys equivalent to that of the new
+      value. The new value is placed behind them. */
+  template <typename... Args> iterator emplace_equal(Args&&... args) {
+    return insert_equal_node(create(std::forward<Args>(args)...));
+  }
+
+  /** Replaces the values by those of <tt>[first,past)</tt>, that are sorted
+      by their keys. Equivalent keys are kept in their order. The tree is
+      built in linear time, without rotations. */
+  template <typename InputIterator>
+  void assign_sorted(InputIterator first, InputIterator past) {
+    clear();
+    // The right spine of the tree built so far, from the root downwards
+    std::vector<node_base*> spine;
+    size_type size_ = 0;
+    try {
+      for (; first != past; ++first, ++size_) {
+        node* z = create(*first);
+        node_base* left_ = nullptr;
+        while (!spine.empty() && priority(spine.back()) < z->priority) {
+          left_ = spine.back();
+          spine.pop_back();
+        }
+        z->left = left_;
+        if (left_ != nullptr)
+          left_->parent = z;
+        if (!spine.empty()) {
+          spine.back()->right = z;
+          z->parent = spine.back();
+        }
+        spine.push_back(z);
+      }
+    } catch (...) {
+      if (!spine.empty())
+        destroy(spine.front());
+      throw;
+    }
+    if (spine.empty())
+      return;
+    update_subtree(spine.front());
+    adopt(spine.front(), size_);
+  }
+
+  //==========================================================================
+  //= Erasure
+  //==========================================================================
+  iterator erase(const_iterator position) {
+    node_base* next_ = successor(position._node);
+    erase_node(position._node);
+    return iterator(next_);
+  }
+
+  iterator erase(const_iterator first, const_iterator past) {
+    while (first != past)
+      first = erase(first);
+    return iterator(past._node);
+  }
+
+  void clear() {
+    destroy(root());
+    adopt(nullptr, 0);
+  }
+
+private:
+  static const KeyT& key(const node_base* x) {
+    return static_cast<const node*>(x)->value.first;
+  }
+
+  static const Summary& summary(const node_base* x) {
+    return static_cast<const node*>(x)->summary;
+  }
+
+  static Summary own_summary(const node_base* x) {
+    const value_type& value = static_cast<const node*>(x)->value;
+    return Summary(value.first, value.second);
+  }
+
+  static void append(std::optional<Summary>& result, const Summary& right) {
+    if (result)
+      result->append(right);
+    else
+      result = right;
+  }
+
+  /// The first node of the subtree \c x, whose summary is admitted
+  template <typename Admits>
+  static const node_base* first_admitted(const node_base* x, Admits& admits) {
+    while (true)
+      if (x->left != nullptr && admits(summary(x->left)))
+        x = x->left;
+      else if (admits(own_summary(x)))
+        return x;
+      else
+        x = x->right;
+  }
+
+  static node_base* leftmost(node_base* x) {
+    while (x->left != nullptr)
+      x = x->left;
+    return x;
+  }
+
+  static node_base* rightmost(node_base* x) {
+    while (x->right != nullptr)
+      x = x->right;
+    return x;
+  }
+
+  // The root is the left child of the header, which is the end position
+  static node_base* successor(node_base* x) {
+    if (x->right != nullptr)
+      return leftmost(x->right);
+    node_base* parent_ = x->parent;
+    while (x == parent_->right) {
+      x = parent_;
+      parent_ = parent_->parent;
+    }
+    return parent_;
+  }
+
+  static node_base* predecessor(node_base* x) {
+    if (x->left != nullptr)
+      return rightmost(x->left);
+    node_base* parent_ = x->parent;
+    while (x == parent_->left) {
+      x = parent_;
+      parent_ = parent_->parent;
+    }
+    return parent_;
+  }
+
+  node_base* root() const { return _header.left; }
+
+  /** Replaces the nodes by those of \c src. Its allocator is taken as well,
+      if it \c Propagates, and equals that of this map otherwise. */
+  template <bool Propagates> void take(augmented_map&& src) {
+    destroy(root());
+    adopt(src.root(), src._size);
+    src.adopt(nullptr, 0);
+    _compare = src._compare;
+    _seed = src._seed;
+    if constexpr (Propagates)
+      _alloc = src._alloc;
+  }
+
+  void adopt(node_base* root_, size_type size_) {
+    _header.left = root_;
+    _size = size_;
+    if (root_ == nullptr)
+      _leftmost = &_header;
+    else {
+      root_->parent = &_header;
+      _leftmost = leftmost(root_);
+    }
+  }
+
+  const node_base* lower_node(const key_type& key_) const {
+    const node_base* result = &_header;
+    for (const node_base* x = root(); x != nullptr;)
+      if (_compare(key(x), key_))
+        x = x->right;
+      else {
+        result = x;
+        x = x->left;
+      }
+    return result;
+  }
+
+  const node_base* upper_node(const key_type& key_) const {
+    const node_base* result = &_header;
+    for (const node_base* x = root(); x != nullptr;)
+      if (_compare(key_, key(x))) {
+        result = x;
+        x = x->left;
+      } else
+        x = x->right;
+    return result;
+  }
+
+  std::uint64_t next_priority() {
+    // splitmix64
+    std::uint64_t z = (_seed += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  template <typename... Args> node* create(Args&&... args) {
+    node* x = node_traits::allocate(_alloc, 1);
+    try {
+      node_traits::construct(_alloc, x, next_priority(),
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(_alloc, x, 1);
+      throw;
+    }
+    return x;
+  }
+
+  void destroy_node(node_base* x) {
+    node* node_ = static_cast<node*>(x);
+    node_traits::destroy(_alloc, node_);
+    node_traits::deallocate(_alloc, node_, 1);
+  }
+
+  void destroy(node_base* x) {
+    while (x != nullptr) {
+      destroy(x->right);
+      node_base* left_ = x->left;
+      destroy_node(x);
+      x = left_;
+    }
+  }
+
+  node_base* clone(const node_base* x, node_base* parent_) {
+    if (x == nullptr)
+      return nullptr;
+    const node* src = static_cast<const node*>(x);
+    node* copy = node_traits::allocate(_alloc, 1);
+    try {
+      node_traits::construct(_alloc, copy, *src);
+    } catch (...) {
+      node_traits::deallocate(_alloc, copy, 1);
+      throw;
+    }
+    copy->parent = parent_;
+    copy->left = copy->right = nullptr;
+    try {
+      copy->left = clone(x->left, copy);
+      copy->right = clone(x->right, copy);
+    } catch (...) {
+      destroy(copy);
+      throw;
+    }
+    return copy;
+  }
+
+  /// Recomputes the summary of \c x from its value and its children
+  static void update(node_base* x) {
+    Summary result = own_summary(x);
+    if (x->left != nullptr) {
+      Summary left_ = summary(x->left);
+      left_.append(result);
+      result = std::move(left_);
+    }
+    if (x->right != nullptr)
+      result.append(summary(x->right));
+    static_cast<node*>(x)->summary = std::move(result);
+  }
+
+  static void update_subtree(node_base* x) {
+    if (x == nullptr)
+      return;
+    update_subtree(x->left);
+    update_subtree(x->right);
+    update(x);
+  }
+
+  void update_path(node_base* x) {
+    for (; x != &_header; x = x->parent)
+      update(x);
+  }
+
+  void refresh(node_base* x, const key_type& key_) {
+    if (x == nullptr)
+      return;
+    if (!_compare(key(x), key_))
+      refresh(x->left, key_);
+    if (!_compare(key_, key(x)))
+      refresh(x->right, key_);
+    update(x);
+  }
+
+  /// Rotates \c x above its parent, which is updated
+  static void rotate_up(node_base* x) {
+    node_base* parent_ = x->parent;
+    node_base* grand_ = parent_->parent;
+    if (x == parent_->left) {
+      parent_->left = x->right;
+      if (x->right != nullptr)
+        x->right->parent = parent_;
+      x->right = parent_;
+    } else {
+      parent_->right = x->left;
+      if (x->left != nullptr)
+        x->left->parent = parent_;
+      x->left = parent_;
+    }
+    parent_->parent = x;
+    x->parent = grand_;
+    if (grand_->left == parent_)
+      grand_->left = x;
+    else
+      grand_->right = x;
+    update(parent_);
+  }
+
+  static std::uint64_t priority(const node_base* x) {
+    return static_cast<const node*>(x)->priority;
+  }
+
+  std::pair<iterator, bool> insert_node(node* z) {
+    node_base* parent_ = &_header;
+    node_base** link_ = &_header.left;
+    bool is_leftmost = true;
+    for (node_base* x = root(); x != nullptr;) {
+      parent_ = x;
+      if (_compare(z->value.first, key(x)))
+        link_ = &x->left;
+      else if (_compare(key(x), z->value.first)) {
+        link_ = &x->right;
+        is_leftmost = false;
+      } else {
+        destroy_node(z);
+        return {iterator(x), false};
+      }
+      x = *link_;
+    }
+    return {link_node(z, parent_, link_, is_leftmost), true};
+  }
+
+  iterator insert_equal_node(node* z) {
+    node_base* parent_ = &_header;
+    node_base** link_ = &_header.left;
+    bool is_leftmost = true;
+    for (node_base* x = root(); x != nullptr; x = *link_) {
+      parent_ = x;
+      if (_compare(z->value.first, key(x)))
+        link_ = &x->left;
+      else {
+        link_ = &x->right;
+        is_leftmost = false;
+      }
+    }
+    return link_node(z, parent_, link_, is_leftmost);
+  }
+
+  /// Links the new node \c z at \c link_ below \c parent_ and rebalances
+  iterator link_node(node* z, node_base* parent_, node_base** link_,
+                     bool is_leftmost) {
+    z->parent = parent_;
+    *link_ = z;
+    if (is_leftmost)
+      _leftmost = z;
+    ++_size;
+
+    while (z->parent != &_header && priority(z->parent) < z->priority)
+      rotate_up(z);
+    update_path(z);
+    return iterator(z);
+  }
+
+  void erase_node(node_base* z) {
+    if (z == _leftmost)
+      _leftmost = successor(z);
+
+    while (z->left != nullptr && z->right != nullptr)
+      rotate_up(priority(z->left) > priority(z->right) ? z->left : z->right);
+
+    node_base* child_ = z->left != nullptr ? z->left : z->right;
+    node_base* parent_ = z->parent;
+    if (child_ != nullptr)
+      child_->parent = parent_;
+    if (parent_->left == z)
+      parent_->left = child_;
+    else
+      parent_->right = child_;
+    --_size;
+    destroy_node(z);
+    update_path(parent_);
+  }
+
+  node_base _header;
+  node_base* _leftmost = &_header;
+  size_type _size = 0;
+  [[no_unique_address]] key_compare _compare;
+  [[no_unique_address]] node_allocator _alloc;
+  std::uint64_t _seed = 0;
+};
+
+/** \brief Keeps the summaries of a map up to date over an update of the
+    values equivalent to a key. Maps without summaries need no update. */
+template <typename MapT> class summary_scope {
+public:
+  template <typename KeyT> summary_scope(MapT&, const KeyT&) {}
+};
+
+template <typename KeyT, typename DataT, typename Compare, typename Alloc,
+          typename Summary>
+class summary_scope<augmented_map<KeyT, DataT, Compare, Alloc, Summary>> {
+  using map_type = augmented_map<KeyT, DataT, Compare, Alloc, Summary>;
+
+public:
+  summary_scope(map_type& object, const KeyT& key)
+      : object_(object), key_(key) {}
+
+  summary_scope(const summary_scope&) = delete;
+  summary_scope& operator=(const summary_scope&) = delete;
+
+  ~summary_scope() { object_.refresh(key_); }
+
+private:
+  map_type& object_;
+  KeyT key_;
+};
+
+} // namespace detail
+} // namespace icl
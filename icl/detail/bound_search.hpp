@@ -0,0 +1,492 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+// Kernels for AVX2 and AVX-512 are compiled for x86-64 with GCC and Clang,
+// unless ICL_NO_SIMD is defined. They are selected at runtime, so the code
+// needs no -m flags.
+#if !defined(ICL_NO_SIMD) && defined(__x86_64__) &&                           \
+    (defined(__GNUC__) || defined(__clang__))
+#define ICL_SIMD_X86 1
+// The intrinsics of GCC 12 leave registers undefined on purpose
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#define ICL_TARGET_AVX2 __attribute__((target("avx2")))
+#define ICL_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace icl {
+
+/** \brief Instruction sets that the kernels of \c Bound_Search are compiled
+    for. */
+enum class simd_level { portable, avx2, avx512 };
+
+/// The highest \c simd_level that the processor supports
+inline simd_level supported_simd_level() {
+  static const simd_level level = [] {
+#ifdef ICL_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return simd_level::avx512;
+    if (__builtin_cpu_supports("avx2"))
+      return simd_level::avx2;
+#endif
+    return simd_level::portable;
+  }();
+  return level;
+}
+
+/** Searches of sorted arrays of bounds. Like \c std::lower_bound, a search
+    yields the index of the first bound that is not less than the key.
+
+    All searches are branch-free binary searches. A single key is searched
+    down to a window of two vector registers, that is then compared with the
+    key at once. Batches of keys are searched in groups of four registers,
+    16 to 64 keys, one vector lane per key: Each step gathers the probed
+    bound of every lane, so the cache misses of a group overlap.
+    The kernels are selected by \c supported_simd_level(); bounds of other
+    than 4 or 8 bytes are searched by the portable kernels. */
+namespace Bound_Search {
+
+/// Bounds that the vector kernels support
+template <typename T>
+concept vectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                       (sizeof(T) == 4 || sizeof(T) == 8);
+
+inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  static_cast<void>(address);
+#endif
+}
+
+/** The first of at most \c window bounds, that the search for \c key is
+    narrowed to: The result is within <tt>[base, base + window]</tt>. As the
+    steps do not branch, nothing is loaded speculatively, so the bounds that
+    the next step may probe are prefetched. */
+template <typename T>
+std::size_t narrow(const T* bounds, std::size_t size, const T& key,
+                   std::size_t window) {
+  std::size_t base = 0;
+  for (; size > window; size -= size / 2) {
+    const std::size_t half = size / 2;
+    const std::size_t next = (size - half) / 2;
+    prefetch(bounds + base + next);
+    prefetch(bounds + base + half + next);
+    base += static_cast<std::size_t>(bounds[base + half - 1] < key) * half;
+  }
+  return base;
+}
+
+namespace portable {
+
+template <typename T>
+std::size_t lower_bound(const T* bounds, std::size_t size, const T& key) {
+  if (size == 0)
+    return 0;
+  const std::size_t base = narrow(bounds, size, key, 1);
+  return base + static_cast<std::size_t>(bounds[base] < key);
+}
+
+template <typename T>
+void lower_bound(const T* bounds, std::size_t size, const T* keys,
+                 std::size_t count, std::size_t* result) {
+  // The searches of a group take the same steps, so they interleave
+  constexpr std::size_t group = 8;
+  std::size_t index = 0;
+  if (size > 0)
+    for (; index + group <= count; index += group) {
+      std::size_t base[group] = {};
+      for (std::size_t left = size; left > 1; left -= left / 2) {
+        const std::size_t half = left / 2;
+        for (std::size_t lane = 0; lane < group; ++lane)
+          base[lane] += static_cast<std::size_t>(bounds[base[lane] + half - 1] <
+                                                 keys[index + lane]) *
+                        half;
+      }
+      for (std::size_t lane = 0; lane < group; ++lane)
+        result[index + lane] =
+            base[lane] +
+            static_cast<std::size_t>(bounds[base[lane]] < keys[index + lane]);
+    }
+  for (; index < count; ++index)
+    result[index] = lower_bound(bounds, size, keys[index]);
+}
+
+} // namespace portable
+
+#ifdef ICL_SIMD_X86
+
+/// Unsigned integers are compared as signed ones by flipping the sign bit
+template <typename T> std::make_signed_t<T> biased(T key) {
+  if constexpr (std::is_unsigned_v<T>)
+    return static_cast<std::make_signed_t<T>>(
+        key ^ (T(1) << (std::numeric_limits<T>::digits - 1)));
+  else
+    return key;
+}
+
+/// The largest array that vector lanes of 32 bit can index
+template <typename T> bool indexable(std::size_t size) {
+  return sizeof(T) == 8 ||
+         size <= static_cast<std::size_t>(std::numeric_limits<int>::max());
+}
+
+namespace avx2 {
+
+// Registers hold bounds and indices as integers of the size of T, floating
+// point bounds are cast.
+template <typename T> ICL_TARGET_AVX2 inline __m256i bias(__m256i values) {
+  if constexpr (std::is_unsigned_v<T> && sizeof(T) == 8)
+    return _mm256_xor_si256(
+        values, _mm256_set1_epi64x(std::numeric_limits<long long>::min()));
+  else if constexpr (std::is_unsigned_v<T>)
+    return _mm256_xor_si256(values,
+                            _mm256_set1_epi32(std::numeric_limits<int>::min()));
+  else
+    return values;
+}
+
+template <typename T> ICL_TARGET_AVX2 inline __m256i splat(T key) {
+  if constexpr (std::is_same_v<T, double>)
+    return _mm256_castpd_si256(_mm256_set1_pd(key));
+  else if constexpr (std::is_same_v<T, float>)
+    return _mm256_castps_si256(_mm256_set1_ps(key));
+  else if constexpr (sizeof(T) == 8)
+    return _mm256_set1_epi64x(static_cast<long long>(biased(key)));
+  else
+    return _mm256_set1_epi32(static_cast<int>(biased(key)));
+}
+
+/// Keys for \c less, loaded from \c keys
+template <typename T> ICL_TARGET_AVX2 inline __m256i load_keys(const T* keys) {
+  return bias<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)));
+}
+
+template <typename T>
+ICL_TARGET_AVX2 inline __m256i splat_index(std::size_t n) {
+  if constexpr (sizeof(T) == 8)
+    return _mm256_set1_epi64x(static_cast<long long>(n));
+  else
+    return _mm256_set1_epi32(static_cast<int>(n));
+}
+
+template <typename T>
+ICL_TARGET_AVX2 inline __m256i add(__m256i left, __m256i right) {
+  if constexpr (sizeof(T) == 8)
+    return _mm256_add_epi64(left, right);
+  else
+    return _mm256_add_epi32(left, right);
+}
+
+/// All bits of the lanes set, whose \c values are less than \c key
+template <typename T>
+ICL_TARGET_AVX2 inline __m256i less(__m256i values, __m256i key) {
+  if constexpr (std::is_same_v<T, double>)
+    return _mm256_castpd_si256(_mm256_cmp_pd(
+        _mm256_castsi256_pd(values), _mm256_castsi256_pd(key), _CMP_LT_OQ));
+  else if constexpr (std::is_same_v<T, float>)
+    return _mm256_castps_si256(_mm256_cmp_ps(
+        _mm256_castsi256_ps(values), _mm256_castsi256_ps(key), _CMP_LT_OQ));
+  else if constexpr (sizeof(T) == 8)
+    return _mm256_cmpgt_epi64(key, bias<T>(values));
+  else
+    return _mm256_cmpgt_epi32(key, bias<T>(values));
+}
+
+template <typename T>
+ICL_TARGET_AVX2 inline int count_less(const T* values, __m256i key) {
+  const __m256i mask = less<T>(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values)), key);
+  if constexpr (sizeof(T) == 8)
+    return std::popcount(static_cast<unsigned>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(mask))));
+  else
+    return std::popcount(static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(mask))));
+}
+
+template <typename T>
+ICL_TARGET_AVX2 inline __m256i gather(const T* bounds, __m256i index) {
+  if constexpr (std::is_same_v<T, double>)
+    return _mm256_castpd_si256(_mm256_i64gather_pd(bounds, index, 8));
+  else if constexpr (std::is_same_v<T, float>)
+    return _mm256_castps_si256(_mm256_i32gather_ps(bounds, index, 4));
+  else if constexpr (sizeof(T) == 8)
+    return _mm256_i64gather_epi64(reinterpret_cast<const long long*>(bounds),
+                                  index, 8);
+  else
+    return _mm256_i32gather_epi32(reinterpret_cast<const int*>(bounds), index,
+                                  4);
+}
+
+template <typename T>
+ICL_TARGET_AVX2 inline void store_index(std::size_t* result, __m256i index) {
+  if constexpr (sizeof(T) == 8)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result), index);
+  else {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result),
+                        _mm256_cvtepu32_epi64(_mm256_castsi256_si128(index)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(result + 4),
+        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(index, 1)));
+  }
+}
+
+template <typename T>
+ICL_TARGET_AVX2 std::size_t lower_bound(const T* bounds, std::size_t size,
+                                        const T& key) {
+  constexpr std::size_t lanes = 32 / sizeof(T);
+  constexpr std::size_t window = 2 * lanes;
+  if (size < window)
+    return portable::lower_bound(bounds, size, key);
+
+  // All bounds before the window are less than key, none after it
+  const std::size_t first =
+      std::min(narrow(bounds, size, key, window), size - window);
+  const __m256i key_ = splat(key);
+  return first + static_cast<std::size_t>(count_less(bounds + first, key_) +
+                                          count_less(bounds + first + lanes,
+                                                     key_));
+}
+
+template <typename T>
+ICL_TARGET_AVX2 void lower_bound(const T* bounds, std::size_t size,
+                                 const T* keys, std::size_t count,
+                                 std::size_t* result) {
+  constexpr std::size_t lanes = 32 / sizeof(T);
+  constexpr int registers = 4;
+  constexpr std::size_t group = registers * lanes;
+  std::size_t index = 0;
+  if (size > 0 && indexable<T>(size))
+    for (; index + group <= count; index += group) {
+      __m256i key[registers];
+      __m256i base[registers];
+      for (int reg = 0; reg < registers; ++reg) {
+        key[reg] = load_keys(keys + index + reg * lanes);
+        base[reg] = _mm256_setzero_si256();
+      }
+      for (std::size_t left = size; left > 1; left -= left / 2) {
+        const __m256i probe = splat_index<T>(left / 2 - 1);
+        const __m256i step = splat_index<T>(left / 2);
+        for (int reg = 0; reg < registers; ++reg)
+          base[reg] = add<T>(
+              base[reg],
+              _mm256_and_si256(
+                  less<T>(gather(bounds, add<T>(base[reg], probe)), key[reg]),
+                  step));
+      }
+      for (int reg = 0; reg < registers; ++reg) {
+        base[reg] = add<T>(base[reg],
+                           _mm256_and_si256(
+                               less<T>(gather(bounds, base[reg]), key[reg]),
+                               splat_index<T>(1)));
+        store_index<T>(result + index + reg * lanes, base[reg]);
+      }
+    }
+  portable::lower_bound(bounds, size, keys + index, count - index,
+                        result + index);
+}
+
+} // namespace avx2
+
+namespace avx512 {
+
+template <typename T> ICL_TARGET_AVX512 inline __m512i splat(T key) {
+  if constexpr (std::is_same_v<T, double>)
+    return _mm512_castpd_si512(_mm512_set1_pd(key));
+  else if constexpr (std::is_same_v<T, float>)
+    return _mm512_castps_si512(_mm512_set1_ps(key));
+  else if constexpr (sizeof(T) == 8)
+    return _mm512_set1_epi64(static_cast<long long>(key));
+  else
+    return _mm512_set1_epi32(static_cast<int>(key));
+}
+
+template <typename T> ICL_TARGET_AVX512 inline __m512i load(const T* values) {
+  return _mm512_loadu_si512(values);
+}
+
+template <typename T>
+ICL_TARGET_AVX512 inline __m512i splat_index(std::size_t n) {
+  if constexpr (sizeof(T) == 8)
+    return _mm512_set1_epi64(static_cast<long long>(n));
+  else
+    return _mm512_set1_epi32(static_cast<int>(n));
+}
+
+/// The mask of the lanes, whose \c values are less than \c key
+template <typename T>
+ICL_TARGET_AVX512 inline unsigned less(__m512i values, __m512i key) {
+  if constexpr (std::is_same_v<T, double>)
+    return _mm512_cmp_pd_mask(_mm512_castsi512_pd(values),
+                              _mm512_castsi512_pd(key), _CMP_LT_OQ);
+  else if constexpr (std::is_same_v<T, float>)
+    return _mm512_cmp_ps_mask(_mm512_castsi512_ps(values),
+                              _mm512_castsi512_ps(key), _CMP_LT_OQ);
+  else if constexpr (std::is_unsigned_v<T> && sizeof(T) == 8)
+    return _mm512_cmplt_epu64_mask(values, key);
+  else if constexpr (sizeof(T) == 8)
+    return _mm512_cmplt_epi64_mask(values, key);
+  else if constexpr (std::is_unsigned_v<T>)
+    return _mm512_cmplt_epu32_mask(values, key);
+  else
+    return _mm512_cmplt_epi32_mask(values, key);
+}
+
+template <typename T>
+ICL_TARGET_AVX512 inline __m512i add(__m512i left, __m512i right) {
+  if constexpr (sizeof(T) == 8)
+    return _mm512_add_epi64(left, right);
+  else
+    return _mm512_add_epi32(left, right);
+}
+
+/// Adds \c step to the lanes of \c base in \c mask
+template <typename T>
+ICL_TARGET_AVX512 inline __m512i advance(__m512i base, unsigned mask,
+                                         __m512i step) {
+  if constexpr (sizeof(T) == 8)
+    return _mm512_mask_add_epi64(base, static_cast<__mmask8>(mask), base, step);
+  else
+    return _mm512_mask_add_epi32(base, static_cast<__mmask16>(mask), base,
+                                 step);
+}
+
+template <typename T>
+ICL_TARGET_AVX512 inline __m512i gather(const T* bounds, __m512i index) {
+  if constexpr (std::is_same_v<T, double>)
+    return _mm512_castpd_si512(_mm512_i64gather_pd(index, bounds, 8));
+  else if constexpr (std::is_same_v<T, float>)
+    return _mm512_castps_si512(_mm512_i32gather_ps(index, bounds, 4));
+  else if constexpr (sizeof(T) == 8)
+    return _mm512_i64gather_epi64(index, bounds, 8);
+  else
+    return _mm512_i32gather_epi32(index, bounds, 4);
+}
+
+template <typename T>
+ICL_TARGET_AVX512 inline void store_index(std::size_t* result,
+                                          __m512i index) {
+  if constexpr (sizeof(T) == 8)
+    _mm512_storeu_si512(result, index);
+  else {
+    _mm512_storeu_si512(result,
+                        _mm512_cvtepu32_epi64(_mm512_castsi512_si256(index)));
+    _mm512_storeu_si512(
+        result + 8, _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(index, 1)));
+  }
+}
+
+template <typename T>
+ICL_TARGET_AVX512 std::size_t lower_bound(const T* bounds, std::size_t size,
+                                          const T& key) {
+  constexpr std::size_t lanes = 64 / sizeof(T);
+  constexpr std::size_t window = 2 * lanes;
+  if (size < window)
+    return portable::lower_bound(bounds, size, key);
+
+  // All bounds before the window are less than key, none after it
+  const std::size_t first =
+      std::min(narrow(bounds, size, key, window), size - window);
+  const __m512i key_ = splat(key);
+  return first +
+         static_cast<std::size_t>(
+             std::popcount(less<T>(load(bounds + first), key_)) +
+             std::popcount(less<T>(load(bounds + first + lanes), key_)));
+}
+
+template <typename T>
+ICL_TARGET_AVX512 void lower_bound(const T* bounds, std::size_t size,
+                                   const T* keys, std::size_t count,
+                                   std::size_t* result) {
+  constexpr std::size_t lanes = 64 / sizeof(T);
+  constexpr int registers = 4;
+  constexpr std::size_t group = registers * lanes;
+  std::size_t index = 0;
+  if (size > 0 && indexable<T>(size))
+    for (; index + group <= count; index += group) {
+      __m512i key[registers];
+      __m512i base[registers];
+      for (int reg = 0; reg < registers; ++reg) {
+        key[reg] = load(keys + index + reg * lanes);
+        base[reg] = _mm512_setzero_si512();
+      }
+      for (std::size_t left = size; left > 1; left -= left / 2) {
+        const __m512i probe = splat_index<T>(left / 2 - 1);
+        const __m512i step = splat_index<T>(left / 2);
+        for (int reg = 0; reg < registers; ++reg)
+          base[reg] = advance<T>(
+              base[reg],
+              less<T>(gather(bounds, add<T>(base[reg], probe)), key[reg]),
+              step);
+      }
+      for (int reg = 0; reg < registers; ++reg) {
+        base[reg] = advance<T>(base[reg],
+                               less<T>(gather(bounds, base[reg]), key[reg]),
+                               splat_index<T>(1));
+        store_index<T>(result + index + reg * lanes, base[reg]);
+      }
+    }
+  portable::lower_bound(bounds, size, keys + index, count - index,
+                        result + index);
+}
+
+} // namespace avx512
+
+#endif // ICL_SIMD_X86
+
+/** The index of the first of the ascending \c bounds, that is not less than
+    \c key. \c level selects the kernel, it must be supported by the
+    processor. */
+template <typename T>
+std::size_t lower_bound(std::span<const T> bounds, const T& key,
+                        simd_level level = supported_simd_level()) {
+  assert(level <= supported_simd_level());
+#ifdef ICL_SIMD_X86
+  if constexpr (vectorizable<T>) {
+    if (level == simd_level::avx512)
+      return avx512::lower_bound(bounds.data(), bounds.size(), key);
+    if (level == simd_level::avx2)
+      return avx2::lower_bound(bounds.data(), bounds.size(), key);
+  }
+#endif
+  static_cast<void>(level);
+  return portable::lower_bound(bounds.data(), bounds.size(), key);
+}
+
+/** Sets <tt>result[i]</tt> to the index of the first of the ascending
+    \c bounds, that is not less than <tt>keys[i]</tt>. */
+template <typename T>
+void lower_bound(std::span<const T> bounds, std::span<const T> keys,
+                 std::span<std::size_t> result,
+                 simd_level level = supported_simd_level()) {
+  assert(result.size() >= keys.size());
+  assert(level <= supported_simd_level());
+#ifdef ICL_SIMD_X86
+  if constexpr (vectorizable<T>) {
+    if (level == simd_level::avx512)
+      return avx512::lower_bound(bounds.data(), bounds.size(), keys.data(),
+                                 keys.size(), result.data());
+    if (level == simd_level::avx2)
+      return avx2::lower_bound(bounds.data(), bounds.size(), keys.data(),
+                               keys.size(), result.data());
+  }
+#endif
+  static_cast<void>(level);
+  portable::lower_bound(bounds.data(), bounds.size(), keys.data(),
+                        keys.size(), result.data());
+}
+
+} // namespace Bound_Search
+} // namespace icl
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "icl/concept/interval.hpp"
+#include <functional>
+#include <type_traits>
 
 namespace icl {
 
@@ -13,4 +15,31 @@ template <typename IntervalT> struct exclusive_less_than {
   }
 };
 
+namespace detail {
+
+/// Right-open intervals of an ascending integral domain
+template <typename IntervalT>
+concept integral_exclusive_less =
+    std::is_integral_v<typename interval_traits<IntervalT>::domain_type> &&
+    !std::is_same_v<typename interval_traits<IntervalT>::domain_type, bool> &&
+    std::is_same_v<
+        typename interval_traits<IntervalT>::domain_compare,
+        std::less<typename interval_traits<IntervalT>::domain_type>> &&
+    is_static_right_open<IntervalT>::value;
+
+} // namespace detail
+
+/** Right-open intervals of an integral domain are compared by their bounds
+    alone, without the emptiness assertion of the generic path. Intervals
+    with dynamic bounds keep the generic path: deriving the last and first
+    element from the bound bits was not measurably faster with an optimising
+    compiler, see bench_exclusive_less. */
+template <typename IntervalT>
+  requires detail::integral_exclusive_less<IntervalT>
+struct exclusive_less_than<IntervalT> {
+  bool operator()(const IntervalT& left, const IntervalT& right) const {
+    return icl::upper(left) <= icl::lower(right);
+  }
+};
+
 } // namespace icl
@@ -0,0 +1,423 @@
+#pragma once
+
+#include "icl/detail/modification_count.hpp"
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace icl {
+namespace detail {
+
+/// Pointer like wrapper for iterators that dereference to a proxy value
+template <typename Reference> struct arrow_proxy {
+  Reference ref;
+  Reference* operator->() { return &ref; }
+};
+
+/** \brief A sorted associative container that keeps keys and mapped values in
+    two separate contiguous arrays.
+
+    \c flat_map models the part of the \c std::map interface that is used by
+    interval containers. Lookups are binary searches over the key array.
+    Iterators dereference to a pair of references into both arrays. Insertion
+    and erasure invalidate all iterators at or behind the affected position. */
+template <typename KeyT, typename DataT, typename Compare, typename Alloc>
+class flat_map {
+  using alloc_traits = std::allocator_traits<Alloc>;
+
+public:
+  using key_type = KeyT;
+  using mapped_type = DataT;
+  using value_type = std::pair<const KeyT, DataT>;
+  using key_compare = Compare;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using key_container_type =
+      std::vector<KeyT, typename alloc_traits::template rebind_alloc<KeyT>>;
+  using mapped_container_type =
+      std::vector<DataT, typename alloc_traits::template rebind_alloc<DataT>>;
+
+  using reference = std::pair<const KeyT&, DataT&>;
+  using const_reference = std::pair<const KeyT&, const DataT&>;
+  using pointer = arrow_proxy<reference>;
+  using const_pointer = arrow_proxy<const_reference>;
+
+  template <bool IsConst> class basic_iterator {
+    template <bool> friend class basic_iterator;
+    friend class flat_map;
+
+    using data_pointer = std::conditional_t<IsConst, const DataT*, DataT*>;
+
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = flat_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<IsConst, flat_map::const_reference,
+                           flat_map::reference>;
+    using pointer = arrow_proxy<reference>;
+
+    basic_iterator() : _key(nullptr), _data(nullptr) {}
+
+    template <bool OtherConst>
+      requires(IsConst && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst>& other)
+        : _key(other._key), _data(other._data) {}
+
+    reference operator*() const { return reference(*_key, *_data); }
+    pointer operator->() const { return pointer{**this}; }
+    reference operator[](difference_type offset) const {
+      return *(*this + offset);
+    }
+
+    basic_iterator& operator++() {
+      ++_key;
+      ++_data;
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    basic_iterator& operator--() {
+      --_key;
+      --_data;
+      return *this;
+    }
+
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    basic_iterator& operator+=(difference_type offset) {
+      _key += offset;
+      _data += offset;
+      return *this;
+    }
+
+    basic_iterator& operator-=(difference_type offset) {
+      return *this += -offset;
+    }
+
+    friend basic_iterator operator+(basic_iterator it_,
+                                    difference_type offset) {
+      return it_ += offset;
+    }
+
+    friend basic_iterator operator+(difference_type offset,
+                                    basic_iterator it_) {
+      return it_ += offset;
+    }
+
+    friend basic_iterator operator-(basic_iterator it_,
+                                    difference_type offset) {
+      return it_ -= offset;
+    }
+
+    template <bool OtherConst>
+    difference_type operator-(const basic_iterator<OtherConst>& other) const {
+      return _key - other._key;
+    }
+
+    template <bool OtherConst>
+    bool operator==(const basic_iterator<OtherConst>& other) const {
+      return _key == other._key;
+    }
+
+    template <bool OtherConst>
+    std::strong_ordering
+    operator<=>(const basic_iterator<OtherConst>& other) const {
+      return _key <=> other._key;
+    }
+
+  private:
+    basic_iterator(const KeyT* key, data_pointer data)
+        : _key(key), _data(data) {}
+
+    const KeyT* _key;
+    data_pointer _data;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  flat_map() = default;
+
+  explicit flat_map(const Compare& compare, const Alloc& alloc = Alloc())
+      : _keys(alloc), _data(alloc), _compare(compare) {}
+
+  explicit flat_map(const Alloc& alloc) : _keys(alloc), _data(alloc) {}
+
+  /// Copy that allocates from \c alloc
+  flat_map(const flat_map& src, const Alloc& alloc)
+      : _keys(src._keys, alloc), _data(src._data, alloc),
+        _compare(src._compare) {}
+
+  /// Move that allocates from \c alloc, if it differs from that of \c src
+  flat_map(flat_map&& src, const Alloc& alloc)
+      : _keys(std::move(src._keys), alloc), _data(std::move(src._data), alloc),
+        _compare(src._compare) {}
+
+  template <typename InputIterator>
+  flat_map(InputIterator first, InputIterator past) {
+    insert(first, past);
+  }
+
+  allocator_type get_allocator() const { return Alloc(_keys.get_allocator()); }
+  key_compare key_comp() const { return _compare; }
+
+  void swap(flat_map& other) noexcept {
+    _keys.swap(other._keys);
+    _data.swap(other._data);
+    std::swap(_compare, other._compare);
+    _modifications.advance();
+    other._modifications.advance();
+  }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  [[nodiscard]] bool empty() const { return _keys.empty(); }
+  [[nodiscard]] size_type size() const { return _keys.size(); }
+  [[nodiscard]] size_type max_size() const { return _keys.max_size(); }
+  [[nodiscard]] size_type capacity() const { return _keys.capacity(); }
+
+  void reserve(size_type count) {
+    _keys.reserve(count);
+    _data.reserve(count);
+  }
+
+  void shrink_to_fit() {
+    _keys.shrink_to_fit();
+    _data.shrink_to_fit();
+  }
+
+  /** The sorted array of keys. */
+  const key_container_type& keys() const { return _keys; }
+  /** The array of mapped values, parallel to \c keys(). */
+  const mapped_container_type& values() const { return _data; }
+
+  /** The number of changes of the keys, see \c modification_count */
+  std::size_t modifications() const { return _modifications.value(); }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  iterator begin() { return iterator(_keys.data(), _data.data()); }
+  iterator end() { return begin() + static_cast<difference_type>(size()); }
+  const_iterator begin() const {
+    return const_iterator(_keys.data(), _data.data());
+  }
+  const_iterator end() const {
+    return begin() + static_cast<difference_type>(size());
+  }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+  iterator lower_bound(const key_type& key) {
+    return begin() + lower_index(key);
+  }
+  const_iterator lower_bound(const key_type& key) const {
+    return begin() + lower_index(key);
+  }
+  iterator upper_bound(const key_type& key) {
+    return begin() + upper_index(key);
+  }
+  const_iterator upper_bound(const key_type& key) const {
+    return begin() + upper_index(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  iterator find(const key_type& key) {
+    iterator it_ = lower_bound(key);
+    return it_ == end() || _compare(key, (*it_).first) ? end() : it_;
+  }
+
+  const_iterator find(const key_type& key) const {
+    const_iterator it_ = lower_bound(key);
+    return it_ == end() || _compare(key, (*it_).first) ? end() : it_;
+  }
+
+  bool contains(const key_type& key) const { return find(key) != end(); }
+
+  //==========================================================================
+  //= Insertion
+  //==========================================================================
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace_at(lower_index(value.first), value.first, value.second);
+  }
+
+  /** Insertion with hint: Constant amortized time, if \c value is to be
+      placed right before \c hint, e.g. when appending sorted values at
+      \c end(). */
+  iterator insert(const_iterator hint, const value_type& value) {
+    return emplace_at(hint_index(hint, value.first), value.first, value.second)
+        .first;
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator past) {
+    for (; first != past; ++first)
+      insert(end(), value_type((*first).first, (*first).second));
+  }
+
+  /** Replaces the values in <tt>[first,past)</tt> by the sorted sequence
+      <tt>[src_first,src_past)</tt>. Values are moved from an rvalue source.
+      The caller is responsible that the order of keys is maintained.
+      Returns an iterator to the first replacing value. */
+  template <typename InputIterator>
+  iterator replace(const_iterator first, const_iterator past,
+                   InputIterator src_first, InputIterator src_past) {
+    _modifications.advance();
+    const size_type pos = index_of(first);
+    size_type gap = index_of(past) - pos;
+    size_type idx = pos;
+
+    for (; src_first != src_past && gap > 0; ++src_first, ++idx, --gap) {
+      auto&& value = *src_first;
+      _keys[idx] = value.first;
+      _data[idx] = std::forward<decltype(value)>(value).second;
+    }
+
+    if (gap > 0) {
+      erase_at(idx, idx + gap);
+      return begin() + static_cast<difference_type>(pos);
+    }
+
+    // The other values are inserted by one call for each container, so
+    // that the tail is moved once, not once per value
+    key_container_type keys(_keys.get_allocator());
+    mapped_container_type data(_data.get_allocator());
+    for (; src_first != src_past; ++src_first) {
+      auto&& value = *src_first;
+      keys.push_back(value.first);
+      data.push_back(std::forward<decltype(value)>(value).second);
+    }
+    const auto dest = static_cast<difference_type>(idx);
+    _keys.insert(_keys.begin() + dest, std::make_move_iterator(keys.begin()),
+                 std::make_move_iterator(keys.end()));
+    try {
+      _data.insert(_data.begin() + dest,
+                   std::make_move_iterator(data.begin()),
+                   std::make_move_iterator(data.end()));
+    } catch (...) {
+      _keys.erase(_keys.begin() + dest,
+                  _keys.begin() + dest +
+                      static_cast<difference_type>(keys.size()));
+      throw;
+    }
+    return begin() + static_cast<difference_type>(pos);
+  }
+
+  //==========================================================================
+  //= Erasure
+  //==========================================================================
+  iterator erase(const_iterator position) {
+    const size_type pos = index_of(position);
+    erase_at(pos, pos + 1);
+    return begin() + static_cast<difference_type>(pos);
+  }
+
+  iterator erase(const_iterator first, const_iterator past) {
+    const size_type pos = index_of(first);
+    erase_at(pos, index_of(past));
+    return begin() + static_cast<difference_type>(pos);
+  }
+
+  void clear() {
+    _modifications.advance();
+    _keys.clear();
+    _data.clear();
+  }
+
+private:
+  size_type index_of(const_iterator it_) const {
+    return static_cast<size_type>(it_ - begin());
+  }
+
+  size_type lower_index(const key_type& key) const {
+    return static_cast<size_type>(
+        std::lower_bound(_keys.begin(), _keys.end(), key, _compare) -
+        _keys.begin());
+  }
+
+  size_type upper_index(const key_type& key) const {
+    return static_cast<size_type>(
+        std::upper_bound(_keys.begin(), _keys.end(), key, _compare) -
+        _keys.begin());
+  }
+
+  size_type hint_index(const_iterator hint, const key_type& key) const {
+    const size_type pos = index_of(hint);
+    if ((pos == size() || _compare(key, _keys[pos])) &&
+        (pos == 0 || _compare(_keys[pos - 1], key)))
+      return pos;
+    return lower_index(key);
+  }
+
+  template <typename DataArgT>
+  std::pair<iterator, bool> emplace_at(size_type pos, const key_type& key,
+                                       DataArgT&& data) {
+    if (pos != size() && !_compare(key, _keys[pos]))
+      return {begin() + static_cast<difference_type>(pos), false};
+
+    _modifications.advance();
+    _keys.insert(_keys.begin() + static_cast<difference_type>(pos), key);
+    _data.insert(_data.begin() + static_cast<difference_type>(pos),
+                 std::forward<DataArgT>(data));
+    return {begin() + static_cast<difference_type>(pos), true};
+  }
+
+  void erase_at(size_type first, size_type past) {
+    _modifications.advance();
+    _keys.erase(_keys.begin() + static_cast<difference_type>(first),
+                _keys.begin() + static_cast<difference_type>(past));
+    _data.erase(_data.begin() + static_cast<difference_type>(first),
+                _data.begin() + static_cast<difference_type>(past));
+  }
+
+  key_container_type _keys;
+  mapped_container_type _data;
+  [[no_unique_address]] key_compare _compare;
+  modification_count _modifications;
+};
+
+} // namespace detail
+} // namespace icl
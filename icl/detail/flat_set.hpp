@@ -0,0 +1,221 @@
+#pragma once
+
+#include "icl/detail/modification_count.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace icl {
+namespace detail {
+
+/** \brief A sorted associative container that keeps its keys in one
+    contiguous array.
+
+    \c flat_set models the part of the \c std::set interface that is used by
+    interval containers. Lookups are binary searches over the array. As for
+    \c std::set, iterators grant constant access only. Insertion and erasure
+    invalidate all iterators at or behind the affected position. */
+template <typename KeyT, typename Compare, typename Alloc> class flat_set {
+  using container_type = std::vector<KeyT, Alloc>;
+
+public:
+  using key_type = KeyT;
+  using value_type = KeyT;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  using reference = const KeyT&;
+  using const_reference = const KeyT&;
+  using pointer = const KeyT*;
+  using const_pointer = const KeyT*;
+
+  using iterator = container_type::const_iterator;
+  using const_iterator = container_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  flat_set() = default;
+
+  explicit flat_set(const Compare& compare, const Alloc& alloc = Alloc())
+      : _keys(alloc), _compare(compare) {}
+
+  explicit flat_set(const Alloc& alloc) : _keys(alloc) {}
+
+  /// Copy that allocates from \c alloc
+  flat_set(const flat_set& src, const Alloc& alloc)
+      : _keys(src._keys, alloc), _compare(src._compare) {}
+
+  /// Move that allocates from \c alloc, if it differs from that of \c src
+  flat_set(flat_set&& src, const Alloc& alloc)
+      : _keys(std::move(src._keys), alloc), _compare(src._compare) {}
+
+  template <typename InputIterator>
+  flat_set(InputIterator first, InputIterator past) {
+    insert(first, past);
+  }
+
+  allocator_type get_allocator() const { return _keys.get_allocator(); }
+  key_compare key_comp() const { return _compare; }
+  value_compare value_comp() const { return _compare; }
+
+  void swap(flat_set& other) noexcept {
+    _keys.swap(other._keys);
+    std::swap(_compare, other._compare);
+    _modifications.advance();
+    other._modifications.advance();
+  }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  [[nodiscard]] bool empty() const { return _keys.empty(); }
+  [[nodiscard]] size_type size() const { return _keys.size(); }
+  [[nodiscard]] size_type max_size() const { return _keys.max_size(); }
+  [[nodiscard]] size_type capacity() const { return _keys.capacity(); }
+
+  void reserve(size_type count) { _keys.reserve(count); }
+  void shrink_to_fit() { _keys.shrink_to_fit(); }
+
+  /** The sorted array of keys. */
+  const container_type& keys() const { return _keys; }
+
+  /** The number of changes of the keys, see \c modification_count */
+  std::size_t modifications() const { return _modifications.value(); }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  const_iterator begin() const { return _keys.begin(); }
+  const_iterator end() const { return _keys.end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+  const_iterator lower_bound(const key_type& key) const {
+    return std::lower_bound(_keys.begin(), _keys.end(), key, _compare);
+  }
+
+  const_iterator upper_bound(const key_type& key) const {
+    return std::upper_bound(_keys.begin(), _keys.end(), key, _compare);
+  }
+
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  const_iterator find(const key_type& key) const {
+    const_iterator it_ = lower_bound(key);
+    return it_ == end() || _compare(key, *it_) ? end() : it_;
+  }
+
+  bool contains(const key_type& key) const { return find(key) != end(); }
+
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  //==========================================================================
+  //= Insertion
+  //==========================================================================
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace_at(lower_bound(value), value);
+  }
+
+  /** Insertion with hint: Constant amortized time, if \c value is to be
+      placed right before \c hint, e.g. when appending sorted values at
+      \c end(). */
+  iterator insert(const_iterator hint, const value_type& value) {
+    if ((hint == end() || _compare(value, *hint)) &&
+        (hint == begin() || _compare(*std::prev(hint), value))) {
+      _modifications.advance();
+      return _keys.insert(hint, value);
+    }
+    return emplace_at(lower_bound(value), value).first;
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator past) {
+    for (; first != past; ++first)
+      insert(end(), *first);
+  }
+
+  /** Replaces the values in <tt>[first,past)</tt> by the sorted sequence
+      <tt>[src_first,src_past)</tt>. The caller is responsible that the
+      order of keys is maintained. Returns an iterator to the first
+      replacing value. */
+  template <typename InputIterator>
+  iterator replace(const_iterator first, const_iterator past,
+                   InputIterator src_first, InputIterator src_past) {
+    _modifications.advance();
+    const difference_type pos = first - begin();
+    auto dest_ = _keys.begin() + pos;
+    const auto dest_end = _keys.begin() + (past - begin());
+
+    for (; src_first != src_past && dest_ != dest_end; ++src_first, ++dest_)
+      *dest_ = *src_first;
+
+    if (dest_ != dest_end)
+      _keys.erase(dest_, dest_end);
+    else
+      _keys.insert(dest_, src_first, src_past);
+    return begin() + pos;
+  }
+
+  //==========================================================================
+  //= Erasure
+  //==========================================================================
+  iterator erase(const_iterator position) {
+    _modifications.advance();
+    return _keys.erase(position);
+  }
+
+  iterator erase(const_iterator first, const_iterator past) {
+    _modifications.advance();
+    return _keys.erase(first, past);
+  }
+
+  size_type erase(const key_type& key) {
+    const_iterator found_ = find(key);
+    if (found_ == end())
+      return 0;
+    _modifications.advance();
+    _keys.erase(found_);
+    return 1;
+  }
+
+  void clear() {
+    _modifications.advance();
+    _keys.clear();
+  }
+
+private:
+  std::pair<iterator, bool> emplace_at(const_iterator pos,
+                                       const value_type& value) {
+    if (pos != end() && !_compare(value, *pos))
+      return {pos, false};
+    _modifications.advance();
+    return {_keys.insert(pos, value), true};
+  }
+
+  container_type _keys;
+  [[no_unique_address]] key_compare _compare;
+  modification_count _modifications;
+};
+
+} // namespace detail
+} // namespace icl
@@ -0,0 +1,433 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/detail/interval_merge_algo.hpp"
+#include "icl/functors.hpp"
+#include "icl/type_traits/identity_element.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include "icl/type_traits/is_interval_splitter.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace icl {
+
+/** Construction of interval containers from unsorted ranges of segments.
+    The segments are sorted by their lower bounds and one sweep line pass
+    emits the final segments in ascending order. For sets, and for maps of
+    integral values added by \c inplace_plus, this takes O(n log n) steps
+    instead of the repeated splitting and joining of n single additions.
+    Other values are folded anew from the k contributions that overlap a
+    piece, in the order of addition, so that maps take O(n (log n + k))
+    steps. */
+namespace Interval_Bulk {
+
+template <typename Type> struct contribution {
+  typename Type::interval_type inter_val;
+  typename Type::codomain_type co_val;
+  std::size_t ordinal; // Position in the input, i.e. the order of addition
+};
+
+/** Values of overlapping contributions can be accumulated while the sweep
+    line passes, if contributions that end can be taken out again exactly. */
+template <typename Type>
+inline constexpr bool has_running_value =
+    std::is_integral_v<typename Type::codomain_type> &&
+    std::is_same_v<typename Type::codomain_combine,
+                   inplace_plus<typename Type::codomain_type>>;
+
+/** Collects the segments of the range <tt>[first,past)</tt>. Segments that
+    would not change the map are dropped. */
+template <typename Type, typename InputIterator>
+std::vector<contribution<Type>> collect_contributions(InputIterator first,
+                                                      InputIterator past) {
+  std::vector<contribution<Type>> contributions;
+  if constexpr (std::forward_iterator<InputIterator>)
+    contributions.reserve(
+        static_cast<std::size_t>(std::distance(first, past)));
+
+  for (std::size_t ordinal = 0; first != past; ++first, ++ordinal) {
+    const auto& segment = *first;
+    if (icl::is_empty(segment.first) ||
+        Interval_Merge::is_absorbable<Type>(segment.second))
+      continue;
+    contributions.push_back({segment.first, segment.second, ordinal});
+  }
+  return contributions;
+}
+
+/** Collects the non empty intervals of the range <tt>[first,past)</tt>. */
+template <typename Type, typename InputIterator>
+std::vector<typename Type::interval_type>
+collect_intervals(InputIterator first, InputIterator past) {
+  std::vector<typename Type::interval_type> intervals;
+  if constexpr (std::forward_iterator<InputIterator>)
+    intervals.reserve(static_cast<std::size_t>(std::distance(first, past)));
+
+  for (; first != past; ++first)
+    if (!icl::is_empty(*first))
+      intervals.push_back(*first);
+  return intervals;
+}
+
+/** Orders intervals and contributions by their lower bounds. Sorted stably,
+    contributions of equal lower bounds keep the order of addition. */
+template <typename Type> struct starts_before {
+  using interval_type = Type::interval_type;
+
+  bool operator()(const interval_type& lhs, const interval_type& rhs) const {
+    return icl::lower_less(lhs, rhs);
+  }
+
+  bool operator()(const contribution<Type>& lhs,
+                  const contribution<Type>& rhs) const {
+    return icl::lower_less(lhs.inter_val, rhs.inter_val);
+  }
+};
+
+/** Sweeps over the sorted contributions <tt>[first,past)</tt> and passes
+    the resulting segments to \c emit. The contributions in
+    \c carried started before \c first and are active at its lower bound,
+    where the sweep begins. The sweep stops at the lower bound of
+    \c sentinel, if given. */
+template <typename Type, typename Emit>
+void sweep(const contribution<Type>* first, const contribution<Type>* past,
+           const contribution<Type>* sentinel,
+           const std::vector<const contribution<Type>*>& carried, Emit emit) {
+  using interval_type = Type::interval_type;
+  using codomain_type = Type::codomain_type;
+  using codomain_combine = Type::codomain_combine;
+  using contribution_type = contribution<Type>;
+
+  // Active contributions on a heap, that yields the one which ends first
+  std::vector<const contribution_type*> active;
+  auto ends_later = [](const contribution_type* lhs,
+                       const contribution_type* rhs) {
+    return icl::upper_less(rhs->inter_val, lhs->inter_val);
+  };
+  // Active contributions in the order of addition, if values are folded.
+  // Combiners need not be associative, and absorbed values make the fold
+  // restart, so each piece folds all of them, in O(k) steps.
+  std::vector<const contribution_type*> in_order;
+  auto added_before = [](const contribution_type* lhs,
+                         const contribution_type* rhs) {
+    return lhs->ordinal < rhs->ordinal;
+  };
+  codomain_type running_value = identity_element<codomain_type>::value();
+
+  auto activate = [&](const contribution_type* added) {
+    active.push_back(added);
+    std::push_heap(active.begin(), active.end(), ends_later);
+    if constexpr (has_running_value<Type>)
+      running_value += added->co_val;
+    else
+      in_order.insert(std::upper_bound(in_order.begin(), in_order.end(),
+                                       added, added_before),
+                      added);
+  };
+
+  auto deactivate = [&]() {
+    const contribution_type* ended = active.front();
+    std::pop_heap(active.begin(), active.end(), ends_later);
+    active.pop_back();
+    if constexpr (has_running_value<Type>)
+      running_value -= ended->co_val;
+    else
+      in_order.erase(std::lower_bound(in_order.begin(), in_order.end(), ended,
+                                      added_before));
+  };
+
+  auto value_of_piece = [&]() {
+    std::optional<codomain_type> value;
+    if constexpr (has_running_value<Type>) {
+      if (!Interval_Merge::is_absorbable<Type>(running_value))
+        value = running_value;
+    } else
+      for (const contribution_type* added : in_order)
+        Interval_Merge::combine<Type, codomain_combine>(value, added->co_val);
+    return value;
+  };
+
+  interval_type cut; // The last piece that the sweep line passed
+  bool has_cut = false;
+  for (const contribution_type* added : carried) {
+    activate(added);
+    if (!has_cut && icl::lower_less(added->inter_val, first->inter_val)) {
+      cut = right_subtract(added->inter_val, first->inter_val);
+      has_cut = true;
+    }
+  }
+
+  std::optional<std::pair<interval_type, codomain_type>> joined;
+  const contribution_type* next_ = first;
+  for (;;) {
+    const contribution_type* upcoming = next_ != past ? next_ : sentinel;
+    if (active.empty()) {
+      if (next_ == past)
+        break;
+      activate(next_++);
+      continue;
+    }
+
+    const interval_type& ends_first = active.front()->inter_val;
+    interval_type piece =
+        has_cut ? left_subtract(ends_first, cut) : ends_first;
+    if (upcoming != nullptr) {
+      // Contributions that start with the piece are active on it
+      const interval_type before_next =
+          right_subtract(piece, upcoming->inter_val);
+      if (icl::is_empty(before_next)) {
+        if (next_ == past)
+          break;
+        activate(next_++);
+        continue;
+      }
+      piece = before_next;
+    }
+
+    if (std::optional<codomain_type> value = value_of_piece()) {
+      // Touching pieces of equal values are joined before they are emitted
+      if (joined && icl::touches(joined->first, piece) &&
+          joined->second == *value)
+        joined->first = hull(joined->first, piece);
+      else {
+        if (joined)
+          emit(joined->first, joined->second);
+        joined.emplace(piece, *value);
+      }
+    }
+
+    cut = piece;
+    has_cut = true;
+    while (!active.empty() &&
+           icl::is_empty(left_subtract(active.front()->inter_val, cut)))
+      deactivate();
+  }
+
+  if (joined)
+    emit(joined->first, joined->second);
+}
+
+/** Replaces the content of \c object by the sum of all segments in
+    <tt>[first,past)</tt>. The result equals the one of adding the segments
+    one by one in the order of the range. This holds for joining maps only,
+    since segment borders of splitting maps depend on the order of additions.
+ */
+template <typename Type, typename InputIterator>
+  requires is_interval_map<Type>::value
+Type& assign(Type& object, InputIterator first, InputIterator past) {
+  using interval_type = Type::interval_type;
+  using codomain_type = Type::codomain_type;
+  using value_type = Type::value_type;
+
+  std::vector<contribution<Type>> contributions =
+      collect_contributions<Type>(first, past);
+  std::stable_sort(contributions.begin(), contributions.end(),
+                   starts_before<Type>());
+
+  Type result = icl::empty_like(object);
+  sweep<Type>(contributions.data(),
+              contributions.data() + contributions.size(), nullptr, {},
+              [&](const interval_type& piece, const codomain_type& value) {
+                result.insert(result.end(), value_type(piece, value));
+              });
+
+  object.swap(result);
+  return object;
+}
+
+/** Passes the sorted intervals <tt>[first,past)</tt> to \c emit. Unless
+    \c Type splits intervals, overlapping intervals are joined beforehand,
+    so that each emitted interval can be appended to the set. */
+template <typename Type, typename Emit>
+void join_sorted(const typename Type::interval_type* first,
+                 const typename Type::interval_type* past, Emit emit) {
+  using interval_type = Type::interval_type;
+
+  while (first != past) {
+    interval_type joined = *first++;
+    if constexpr (!is_interval_splitter<Type>::value)
+      while (first != past && icl::intersects(joined, *first))
+        joined = hull(joined, *first++);
+    emit(joined);
+  }
+}
+
+/** Replaces the content of \c object by the union of all intervals in
+    <tt>[first,past)</tt>. Sorted by their lower bounds, the intervals are
+    added at the end of the set. */
+template <typename Type, typename InputIterator>
+  requires is_interval_set<Type>::value
+Type& assign(Type& object, InputIterator first, InputIterator past) {
+  using interval_type = Type::interval_type;
+
+  std::vector<interval_type> intervals = collect_intervals<Type>(first, past);
+  std::sort(intervals.begin(), intervals.end(), starts_before<Type>());
+
+  Type result = icl::empty_like(object);
+  join_sorted<Type>(intervals.data(), intervals.data() + intervals.size(),
+                    [&](const interval_type& joined) {
+                      result.add(result.end(), joined);
+                    });
+
+  object.swap(result);
+  return object;
+}
+
+//==============================================================================
+//= Parallel construction
+//==============================================================================
+/** The number of partitions of \c size inputs for parallel construction.
+    Partitions are smaller than the number of threads would suggest, so
+    uneven distributions of segments are balanced. */
+inline std::size_t partition_count(std::size_t size) {
+  constexpr std::size_t min_partition_size = 4096;
+  const std::size_t threads =
+      std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  return std::clamp<std::size_t>(size / min_partition_size, 1, 4 * threads);
+}
+
+/** Partition of sorted contributions. Its domain range begins at the lower
+    bound of its first contribution and ends at the one of the next
+    partition. */
+template <typename Type> struct map_partition {
+  using contribution_type = contribution<Type>;
+
+  const contribution_type* first;
+  const contribution_type* past;
+  const contribution_type* sentinel;
+  // Contributions of earlier partitions that are active at the beginning
+  std::vector<const contribution_type*> carried;
+  // Own contributions that are active at the end
+  std::vector<const contribution_type*> reaching;
+  std::vector<std::pair<typename Type::interval_type,
+                        typename Type::codomain_type>>
+      pieces;
+};
+
+/** Parallel version of \c assign for interval maps. The sorted segments are
+    partitioned by domain ranges. Each partition is swept independently, the
+    resulting pieces are stitched by inserting them in order, which joins
+    them at the partition borders. The result equals that of the sequential
+    version. */
+template <typename ExecutionPolicy, typename Type, typename InputIterator>
+  requires(std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+           is_interval_map<Type>::value)
+Type& assign(ExecutionPolicy&& policy, Type& object, InputIterator first,
+             InputIterator past) {
+  using partition_type = map_partition<Type>;
+  using value_type = Type::value_type;
+
+  std::vector<contribution<Type>> contributions =
+      collect_contributions<Type>(first, past);
+  std::stable_sort(policy, contributions.begin(), contributions.end(),
+                   starts_before<Type>());
+
+  const std::size_t size = contributions.size();
+  const std::size_t count = partition_count(size);
+  const contribution<Type>* data = contributions.data();
+
+  std::vector<partition_type> partitions(count);
+  for (std::size_t part = 0; part < count; ++part) {
+    partitions[part].first = data + size * part / count;
+    partitions[part].past = data + size * (part + 1) / count;
+    partitions[part].sentinel =
+        part + 1 < count ? partitions[part].past : nullptr;
+  }
+
+  // Contributions that reach into the next partition
+  std::for_each(policy, partitions.begin(), partitions.end(),
+                [](partition_type& partition) {
+                  if (partition.sentinel == nullptr)
+                    return;
+                  for (auto it_ = partition.first; it_ != partition.past; ++it_)
+                    if (icl::intersects(it_->inter_val,
+                                        partition.sentinel->inter_val))
+                      partition.reaching.push_back(it_);
+                });
+
+  // They are carried on as long as they reach
+  for (std::size_t part = 1; part < count; ++part) {
+    const partition_type& prior = partitions[part - 1];
+    partition_type& partition = partitions[part];
+    for (const auto* sources : {&prior.carried, &prior.reaching})
+      for (const contribution<Type>* added : *sources)
+        if (icl::intersects(added->inter_val, partition.first->inter_val))
+          partition.carried.push_back(added);
+  }
+
+  std::for_each(policy, partitions.begin(), partitions.end(),
+                [](partition_type& partition) {
+                  if (partition.first == partition.past)
+                    return;
+                  sweep<Type>(partition.first, partition.past,
+                              partition.sentinel, partition.carried,
+                              [&](const auto& piece, const auto& value) {
+                                partition.pieces.emplace_back(piece, value);
+                              });
+                });
+
+  Type result = icl::empty_like(object);
+  for (const partition_type& partition : partitions)
+    for (const auto& piece : partition.pieces)
+      result.insert(result.end(), value_type(piece.first, piece.second));
+
+  object.swap(result);
+  return object;
+}
+
+/** Parallel version of \c assign for interval sets. Overlapping intervals
+    are joined within partitions of the sorted intervals independently. The
+    results are stitched by adding them in order, which joins intervals
+    across partition borders. */
+template <typename ExecutionPolicy, typename Type, typename InputIterator>
+  requires(std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+           is_interval_set<Type>::value)
+Type& assign(ExecutionPolicy&& policy, Type& object, InputIterator first,
+             InputIterator past) {
+  using interval_type = Type::interval_type;
+
+  struct set_partition {
+    const interval_type* first;
+    const interval_type* past;
+    std::vector<interval_type> joined;
+  };
+
+  std::vector<interval_type> intervals = collect_intervals<Type>(first, past);
+  std::sort(policy, intervals.begin(), intervals.end(), starts_before<Type>());
+
+  const std::size_t size = intervals.size();
+  const std::size_t count = partition_count(size);
+  const interval_type* data = intervals.data();
+
+  std::vector<set_partition> partitions(count);
+  for (std::size_t part = 0; part < count; ++part) {
+    partitions[part].first = data + size * part / count;
+    partitions[part].past = data + size * (part + 1) / count;
+  }
+
+  std::for_each(policy, partitions.begin(), partitions.end(),
+                [](set_partition& partition) {
+                  join_sorted<Type>(partition.first, partition.past,
+                                    [&](const interval_type& joined) {
+                                      partition.joined.push_back(joined);
+                                    });
+                });
+
+  Type result = icl::empty_like(object);
+  for (const set_partition& partition : partitions)
+    for (const interval_type& joined : partition.joined)
+      result.add(result.end(), joined);
+
+  object.swap(result);
+  return object;
+}
+
+} // namespace Interval_Bulk
+} // namespace icl
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "icl/concept/container.hpp"
 #include "icl/concept/interval_set.hpp"
 #include "icl/type_traits/is_total.hpp"
+#include <iterator>
 
 namespace icl {
 namespace Interval_Map {
@@ -62,7 +64,7 @@ bool contains(const IntervalMapT& container,
   if (exterior.first == exterior.second)
     return false;
 
-  const_iterator last_overlap = prior(exterior.second);
+  const_iterator last_overlap = std::prev(exterior.second);
 
   return icl::contains(hull(exterior.first->first, last_overlap->first),
                        sub_interval) &&
@@ -116,7 +118,7 @@ bool contains(const IntervalMapT& container,
   if (exterior.first == exterior.second)
     return false;
 
-  const_iterator last_overlap = prior(exterior.second);
+  const_iterator last_overlap = std::prev(exterior.second);
 
   if (!(sub_segment.second == exterior.first->second))
     return false;
@@ -131,5 +133,21 @@ bool contains(const IntervalMapT& super, const IntervalMapT& sub) {
   return Interval_Set::within(sub, super);
 }
 
+/** Sets the values of all segments of \c object to the identity element.
+    The map is rebuilt rather than changed in place, so neighbours that
+    become equal are joined and aggregates of augmented storage are kept. */
+template <typename IntervalMapT> void reset_values(IntervalMapT& object) {
+  using codomain_type = IntervalMapT::codomain_type;
+  using segment_type = IntervalMapT::segment_type;
+
+  IntervalMapT reset = icl::empty_like(object);
+  for (typename IntervalMapT::const_iterator it_ = object.begin();
+       it_ != object.end(); ++it_)
+    reset.insert(reset.end(),
+                 segment_type((*it_).first,
+                              identity_element<codomain_type>::value()));
+  object.swap(reset);
+}
+
 } // namespace Interval_Map
 } // namespace icl
@@ -0,0 +1,429 @@
+#pragma once
+
+#include "icl/concept/container.hpp"
+#include "icl/concept/interval.hpp"
+#include "icl/concept/map_value.hpp"
+#include "icl/concept/set_value.hpp"
+#include "icl/detail/on_absorbtion.hpp"
+#include "icl/functors.hpp"
+#include "icl/type_traits/absorbs_identities.hpp"
+#include "icl/type_traits/has_set_semantics.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include "icl/type_traits/is_interval_separator.hpp"
+#include "icl/type_traits/is_total.hpp"
+#include <bit>
+#include <cstddef>
+#include <optional>
+
+namespace icl {
+
+/** Merging algorithms for the combination of two interval containers.
+    Both containers are swept simultaneously in the order of their segments
+    and the result is appended to a new container, which takes O(n+m) steps.
+    The results are equal to those of the segmentwise algorithms. */
+namespace Interval_Merge {
+
+/** Returns true, if combining \c object with \c operand by one merging sweep
+    is cheaper than \c m segmentwise updates of O(log(n+m)) each. */
+template <typename Type, typename OperandT>
+bool is_preferable(const Type& object, const OperandT& operand) {
+  const std::size_t n = object.iterative_size();
+  const std::size_t m = operand.iterative_size();
+  if (m < 2)
+    return false;
+  // Segmentwise updates of contiguous storage move the tail of the arrays
+  if constexpr (Type::storage_type::is_contiguous)
+    return true;
+  return m * static_cast<std::size_t>(std::bit_width(n + m)) >= n;
+}
+
+/** Visits the elementary pieces of the overlay of \c left and \c right in
+    ascending order. For each piece \c visit receives the iterators of the
+    segments that cover it, or \c end() of the container that does not.
+    Segments of \c right that satisfy \c is_skipped are ignored. */
+template <typename LeftT, typename RightT, typename Skip, typename Visit>
+void overlay(const LeftT& left, const RightT& right, Skip is_skipped,
+             Visit visit) {
+  using interval_type = LeftT::interval_type;
+  using left_iterator = LeftT::const_iterator;
+  using right_iterator = RightT::const_iterator;
+
+  auto skip_right = [&](right_iterator& it_) {
+    while (it_ != right.end() && is_skipped(it_))
+      ++it_;
+  };
+
+  left_iterator left_ = left.begin();
+  right_iterator right_ = right.begin();
+  skip_right(right_);
+
+  interval_type left_rest, right_rest;
+  if (left_ != left.end())
+    left_rest = key_value<LeftT>(left_);
+  if (right_ != right.end())
+    right_rest = key_value<RightT>(right_);
+
+  while (left_ != left.end() && right_ != right.end()) {
+    interval_type piece = right_subtract(left_rest, right_rest);
+    if (!icl::is_empty(piece)) {
+      //[piece  left_rest)
+      //        [right_rest)
+      visit(piece, left_, right.end());
+      left_rest = left_subtract(left_rest, piece);
+    } else if (piece = right_subtract(right_rest, left_rest);
+               !icl::is_empty(piece)) {
+      //        [left_rest)
+      //[piece right_rest)
+      visit(piece, left.end(), right_);
+      right_rest = left_subtract(right_rest, piece);
+    } else {
+      //[left_rest  )
+      //[right_rest   )
+      piece = left_rest & right_rest;
+      visit(piece, left_, right_);
+      left_rest = left_subtract(left_rest, piece);
+      right_rest = left_subtract(right_rest, piece);
+    }
+
+    if (icl::is_empty(left_rest) && ++left_ != left.end())
+      left_rest = key_value<LeftT>(left_);
+    if (icl::is_empty(right_rest)) {
+      skip_right(++right_);
+      if (right_ != right.end())
+        right_rest = key_value<RightT>(right_);
+    }
+  }
+
+  if (left_ != left.end()) {
+    visit(left_rest, left_, right.end());
+    while (++left_ != left.end())
+      visit(key_value<LeftT>(left_), left_, right.end());
+  }
+
+  if (right_ != right.end()) {
+    visit(right_rest, left.end(), right_);
+    skip_right(++right_);
+    for (; right_ != right.end(); skip_right(++right_))
+      visit(key_value<RightT>(right_), left.end(), right_);
+  }
+}
+
+template <typename Type>
+bool is_absorbable(const typename Type::codomain_type& co_val) {
+  return on_absorbtion<Type, typename Type::codomain_combine,
+                       absorbs_identities<Type>::value>::is_absorbable(co_val);
+}
+
+/** Applies \c Combiner with \c co_val to the \c value of an elementary piece
+    the way \c _add does. An empty \c value denotes a gap. */
+template <typename Type, typename Combiner>
+void combine(std::optional<typename Type::codomain_type>& value,
+             const typename Type::codomain_type& co_val) {
+  using on_absorbtion_ =
+      on_absorbtion<Type, Combiner, absorbs_identities<Type>::value>::type;
+
+  if (on_absorbtion_::is_absorbable(co_val))
+    return;
+
+  if (!value)
+    value = version<Combiner>()(co_val);
+  else {
+    Combiner()(*value, co_val);
+    if (on_absorbtion_::is_absorbable(*value))
+      value.reset();
+  }
+}
+
+/** Applies \c Combiner with \c co_val to the \c value of an elementary piece
+    the way \c _subtract does: Gaps are left untouched. */
+template <typename Type, typename Combiner>
+void combine_defined(std::optional<typename Type::codomain_type>& value,
+                     const typename Type::codomain_type& co_val) {
+  if (value)
+    combine<Type, Combiner>(value, co_val);
+}
+
+//==============================================================================
+//= Appending of results
+//==============================================================================
+template <typename Type>
+  requires is_interval_set<Type>::value
+void append(Type& result, const typename Type::interval_type& piece) {
+  result.add(result.end(), piece);
+}
+
+template <typename Type>
+  requires is_interval_map<Type>::value
+void append(Type& result, const typename Type::interval_type& piece,
+            const std::optional<typename Type::codomain_type>& value) {
+  if (value)
+    result.insert(result.end(), typename Type::value_type(piece, *value));
+}
+
+//==============================================================================
+//= Addition
+//==============================================================================
+template <typename Type, typename OperandT>
+  requires(is_interval_set<Type>::value && is_interval_set<OperandT>::value)
+Type& add(Type& object, const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+
+  Type result = icl::empty_like(object);
+  // Separating sets join overlapping intervals only. Pieces are overlapping
+  // parts of the same hull, if they share a covering interval.
+  interval_type pending;
+  const_iterator pending_left_ = object.end();
+  operand_iterator pending_right_ = operand.end();
+
+  overlay(
+      object, operand, [](operand_iterator) { return false; },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        if constexpr (is_interval_separator<Type>::value) {
+          if ((left_ != object.end() && left_ == pending_left_) ||
+              (right_ != operand.end() && right_ == pending_right_))
+            pending = hull(pending, piece);
+          else {
+            if (!icl::is_empty(pending))
+              append(result, pending);
+            pending = piece;
+          }
+          pending_left_ = left_;
+          pending_right_ = right_;
+        } else
+          append(result, piece);
+      });
+
+  if (!icl::is_empty(pending))
+    append(result, pending);
+
+  object.swap(result);
+  return object;
+}
+
+template <typename Type, typename OperandT, typename Combiner>
+  requires(is_interval_map<Type>::value && is_interval_map<OperandT>::value)
+Type& add(Type& object, const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using codomain_type = Type::codomain_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+  using on_absorbtion_ =
+      on_absorbtion<Type, Combiner, absorbs_identities<Type>::value>::type;
+
+  Type result = icl::empty_like(object);
+  overlay(
+      object, operand,
+      [](operand_iterator it_) {
+        return on_absorbtion_::is_absorbable((*it_).second);
+      },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        std::optional<codomain_type> value;
+        if (left_ != object.end())
+          value = (*left_).second;
+        if (right_ != operand.end())
+          combine<Type, Combiner>(value, (*right_).second);
+        append(result, piece, value);
+      });
+
+  object.swap(result);
+  return object;
+}
+
+template <typename Type, typename OperandT>
+  requires(is_interval_map<Type>::value && is_interval_map<OperandT>::value)
+Type& add(Type& object, const OperandT& operand) {
+  return add<Type, OperandT, typename Type::codomain_combine>(object, operand);
+}
+
+//==============================================================================
+//= Subtraction
+//==============================================================================
+template <typename Type, typename OperandT>
+  requires(is_interval_map<Type>::value && is_interval_map<OperandT>::value)
+Type& subtract(Type& object, const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using codomain_type = Type::codomain_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+  using inverse_codomain_combine = Type::inverse_codomain_combine;
+  using on_absorbtion_ =
+      on_absorbtion<Type, inverse_codomain_combine,
+                    absorbs_identities<Type>::value>::type;
+
+  // Total maps with invertible codomains subtract by adding the inverse
+  if constexpr (Type::is_total_invertible)
+    return add<Type, OperandT, inverse_codomain_combine>(object, operand);
+
+  Type result = icl::empty_like(object);
+  overlay(
+      object, operand,
+      [](operand_iterator it_) {
+        return on_absorbtion_::is_absorbable((*it_).second);
+      },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        if (left_ == object.end())
+          return;
+        std::optional<codomain_type> value = (*left_).second;
+        if (right_ != operand.end())
+          combine_defined<Type, inverse_codomain_combine>(value,
+                                                          (*right_).second);
+        append(result, piece, value);
+      });
+
+  object.swap(result);
+  return object;
+}
+
+//==============================================================================
+//= Erasure
+//==============================================================================
+template <typename Type, typename OperandT>
+  requires(is_interval_container<Type>::value &&
+           is_interval_set<OperandT>::value)
+Type& erase(Type& object, const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+
+  Type result = icl::empty_like(object);
+  overlay(
+      object, operand, [](operand_iterator) { return false; },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        if (left_ == object.end() || right_ != operand.end())
+          return;
+        if constexpr (is_interval_map<Type>::value)
+          append(result, piece,
+                 std::optional<typename Type::codomain_type>(
+                     (*left_).second));
+        else
+          append(result, piece);
+      });
+
+  object.swap(result);
+  return object;
+}
+
+//==============================================================================
+//= Intersection
+//==============================================================================
+template <typename Type, typename OperandT>
+  requires(is_interval_container<Type>::value &&
+           is_interval_set<OperandT>::value)
+void add_intersection(Type& section, const Type& object,
+                      const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+
+  overlay(
+      object, operand, [](operand_iterator) { return false; },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        if (left_ == object.end() || right_ == operand.end())
+          return;
+        if constexpr (is_interval_map<Type>::value) {
+          std::optional<typename Type::codomain_type> value;
+          combine<Type, typename Type::codomain_combine>(value,
+                                                         (*left_).second);
+          append(section, piece, value);
+        } else
+          append(section, piece);
+      });
+}
+
+template <typename Type, typename OperandT>
+  requires(is_interval_map<Type>::value && (!is_total<Type>::value) &&
+           is_interval_map<OperandT>::value)
+void add_intersection(Type& section, const Type& object,
+                      const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using codomain_type = Type::codomain_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+
+  overlay(
+      object, operand, [](operand_iterator) { return false; },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        if (left_ == object.end() || right_ == operand.end())
+          return;
+        std::optional<codomain_type> value;
+        combine<Type, typename Type::codomain_combine>(value, (*left_).second);
+        combine<Type, typename Type::codomain_intersect>(value,
+                                                         (*right_).second);
+        append(section, piece, value);
+      });
+}
+
+//==============================================================================
+//= Symmetric difference
+//==============================================================================
+template <typename Type, typename OperandT>
+  requires(is_interval_set<Type>::value && is_interval_set<OperandT>::value)
+Type& flip(Type& object, const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+
+  Type result = icl::empty_like(object);
+  overlay(
+      object, operand, [](operand_iterator) { return false; },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        if ((left_ == object.end()) != (right_ == operand.end()))
+          append(result, piece);
+      });
+
+  object.swap(result);
+  return object;
+}
+
+template <typename Type, typename OperandT>
+  requires(is_interval_map<Type>::value && (!is_total<Type>::value) &&
+           is_interval_map<OperandT>::value)
+Type& flip(Type& object, const OperandT& operand) {
+  using interval_type = Type::interval_type;
+  using codomain_type = Type::codomain_type;
+  using const_iterator = Type::const_iterator;
+  using operand_iterator = OperandT::const_iterator;
+  using codomain_combine = Type::codomain_combine;
+
+  Type result = icl::empty_like(object);
+  overlay(
+      object, operand, [](operand_iterator) { return false; },
+      [&](const interval_type& piece, const_iterator left_,
+          operand_iterator right_) {
+        std::optional<codomain_type> value;
+        if (right_ == operand.end())
+          value = (*left_).second;
+        else if (left_ == object.end())
+          combine<Type, codomain_combine>(value, (*right_).second);
+        else {
+          // That which is common is rewritten by its difference, which
+          // passes an intermediate intersection map as in _flip
+          codomain_type common_value = identity_element<codomain_type>::value();
+          if constexpr (has_set_semantics<codomain_type>::value) {
+            common_value = (*right_).second;
+            typename Type::inverse_codomain_intersect()(common_value,
+                                                        (*left_).second);
+          }
+          std::optional<codomain_type> section_value;
+          combine<Type, codomain_combine>(section_value, common_value);
+          if (section_value)
+            combine<Type, codomain_combine>(value, *section_value);
+        }
+        append(result, piece, value);
+      });
+
+  object.swap(result);
+  return object;
+}
+
+} // namespace Interval_Merge
+} // namespace icl
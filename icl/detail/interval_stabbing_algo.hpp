@@ -0,0 +1,150 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/concept/map_value.hpp"
+#include "icl/concept/set_value.hpp"
+#include "icl/type_traits/is_discrete.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace icl {
+
+/** \brief Tag for batched lookups: The points are sorted in ascending
+    order. */
+struct sorted_points_t {
+  explicit sorted_points_t() = default;
+};
+
+inline constexpr sorted_points_t sorted_points{};
+
+/** Batched stabbing queries: The segments of an interval container that
+    contain each of a sequence of points. Sorted points are resolved in one
+    forward walk over the segments, instead of one search per point. */
+namespace Interval_Stabbing {
+
+/// Domain types that batched lookups support: The same as those of \c find
+template <typename Type>
+concept stabbable =
+    is_discrete<typename Type::domain_type>::value ||
+    (is_continuous<typename Type::domain_type>::value &&
+     has_dynamic_bounds<typename Type::interval_type>::value);
+
+/// The interval that \c find searches for the point \c key_val
+template <typename Type>
+  requires stabbable<Type>
+Type::interval_type probe(const typename Type::domain_type& key_val) {
+  using interval_type = Type::interval_type;
+  if constexpr (is_discrete<typename Type::domain_type>::value)
+    return detail::unit_trail<interval_type>(key_val);
+  else
+    return icl::singleton<interval_type>(key_val);
+}
+
+/** The first segment from \c it_ on, that does not precede \c key. On
+    contiguous storage the segments are searched by galloping: steps of
+    doubling length followed by a binary search. Otherwise a few steps are
+    taken, before a search from the root is started. */
+template <typename Type>
+Type::const_iterator seek(const Type& object, typename Type::const_iterator it_,
+                          const typename Type::interval_type& key) {
+  using const_iterator = Type::const_iterator;
+  using key_compare = Type::key_compare;
+
+  const const_iterator end_ = object.end();
+  const auto precedes = [&](const const_iterator& pos_) {
+    return key_compare()(key_value<Type>(pos_), key);
+  };
+
+  if (it_ == end_ || !precedes(it_))
+    return it_;
+
+  if constexpr (std::random_access_iterator<const_iterator>) {
+    // *lo_ precedes key, hi_ does not or is the end
+    using difference_type = std::iter_difference_t<const_iterator>;
+    const_iterator lo_ = it_;
+    difference_type step = 1;
+    while (step < end_ - lo_ && precedes(lo_ + step)) {
+      lo_ += step;
+      step *= 2;
+    }
+    const_iterator hi_ = lo_ + std::min(step, end_ - lo_);
+    while (hi_ - lo_ > 1) {
+      const const_iterator mid_ = lo_ + (hi_ - lo_) / 2;
+      if (precedes(mid_))
+        lo_ = mid_;
+      else
+        hi_ = mid_;
+    }
+    return hi_;
+  } else {
+    constexpr int max_steps = 8;
+    for (int steps = 0; steps < max_steps; ++steps)
+      if (++it_ == end_ || !precedes(it_))
+        return it_;
+    return object.lower_bound(key);
+  }
+}
+
+/** Calls <tt>emit(i, found_)</tt> for each of the ascending \c points,
+    where \c found_ is the segment that contains <tt>points[i]</tt> or
+    \c end(). */
+template <typename Type, typename Emit>
+  requires stabbable<Type>
+void find_sorted(const Type& object,
+                 std::span<const typename Type::domain_type> points,
+                 Emit emit) {
+  using const_iterator = Type::const_iterator;
+  using interval_type = Type::interval_type;
+  using key_compare = Type::key_compare;
+
+  const const_iterator end_ = object.end();
+  const_iterator it_ = object.begin();
+  for (std::size_t index = 0; index < points.size(); ++index) {
+    const interval_type key = probe<Type>(points[index]);
+    it_ = seek(object, it_, key);
+    emit(index, it_ != end_ && !key_compare()(key, key_value<Type>(it_))
+                    ? it_
+                    : end_);
+  }
+}
+
+/** Calls <tt>emit(i, found_)</tt> for each of the \c points in any order.
+    Unless they are ascending already, the points are sorted along with
+    their positions, so that the results are emitted for their original
+    positions. */
+template <typename Type, typename Emit>
+  requires stabbable<Type>
+void find(const Type& object,
+          std::span<const typename Type::domain_type> points, Emit emit) {
+  using domain_type = Type::domain_type;
+  using domain_compare = Type::domain_compare;
+
+  if (std::is_sorted(points.begin(), points.end(), domain_compare()))
+    return find_sorted(object, points, emit);
+
+  std::vector<std::pair<domain_type, std::size_t>> indexed;
+  indexed.reserve(points.size());
+  for (std::size_t index = 0; index < points.size(); ++index)
+    indexed.emplace_back(points[index], index);
+  std::sort(indexed.begin(), indexed.end(),
+            [](const auto& left, const auto& right) {
+              return domain_compare()(left.first, right.first);
+            });
+
+  std::vector<domain_type> sorted;
+  sorted.reserve(points.size());
+  for (const auto& point : indexed)
+    sorted.push_back(point.first);
+
+  find_sorted(object, std::span<const domain_type>(sorted),
+              [&](std::size_t index, const auto& found_) {
+                emit(indexed[index].second, found_);
+              });
+}
+
+} // namespace Interval_Stabbing
+} // namespace icl
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace icl {
+namespace detail {
+
+/** \brief The number of changes of a container on contiguous storage.
+    Views that keep positions in the container, as \c bound_index, compare
+    it to find out that they are stale. Assigning the container changes it
+    as well, so the count is advanced on assignment instead of copied. */
+class modification_count {
+public:
+  modification_count() = default;
+  modification_count(const modification_count&) noexcept {}
+
+  modification_count& operator=(const modification_count&) noexcept {
+    ++_count;
+    return *this;
+  }
+
+  void advance() noexcept { ++_count; }
+
+  std::size_t value() const noexcept { return _count; }
+
+private:
+  std::size_t _count = 0;
+};
+
+} // namespace detail
+} // namespace icl
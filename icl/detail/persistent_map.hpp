@@ -0,0 +1,460 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace icl {
+namespace detail {
+
+/** \brief A sorted associative container, whose copies share their nodes.
+
+    \c persistent_map is a randomized balanced search tree (treap), whose
+    nodes are reference counted and never changed once they are shared.
+    A copy takes constant time: It refers to the root of the tree. An
+    update copies the nodes on the paths from the root to the positions it
+    changes, and leaves all other nodes to the versions that share them
+    (path copying), so it takes logarithmic time and space besides that of
+    the values it inserts. Nodes are freed by the last version that refers
+    to them. References are counted atomically, so versions may be read,
+    updated and destroyed by different threads, as long as a single
+    version is not updated while it is read.
+
+    The values are updated by \c replace, that replaces a range of values
+    by sorted ones. Iterators keep the path from the root to their values,
+    they are valid as long as the version they belong to is not updated. */
+template <typename KeyT, typename DataT, typename Compare, typename Alloc>
+class persistent_map {
+public:
+  using key_type = KeyT;
+  using mapped_type = DataT;
+  using value_type = std::pair<const KeyT, DataT>;
+  using key_compare = Compare;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+
+private:
+  struct node {
+    template <typename... Args>
+    explicit node(std::uint64_t priority_, Args&&... args)
+        : priority(priority_), value(std::forward<Args>(args)...) {}
+
+    std::atomic<std::size_t> references{1};
+    node* left = nullptr;
+    node* right = nullptr;
+    /// The number of nodes of the subtree
+    size_type count = 1;
+    std::uint64_t priority;
+    value_type value;
+  };
+
+  using alloc_traits = std::allocator_traits<Alloc>;
+  using node_allocator = alloc_traits::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+public:
+  /** \brief Bidirectional iterator over the values of a version. */
+  class const_iterator {
+    friend class persistent_map;
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = persistent_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+    const_iterator() = default;
+
+    reference operator*() const { return _path.back()->value; }
+    pointer operator->() const { return &_path.back()->value; }
+
+    const_iterator& operator++() {
+      const node* x = _path.back();
+      if (x->right != nullptr)
+        descend_left(x->right);
+      else {
+        // Up to the first ancestor reached from its left subtree
+        _path.pop_back();
+        while (!_path.empty() && _path.back()->right == x) {
+          x = _path.back();
+          _path.pop_back();
+        }
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    const_iterator& operator--() {
+      if (_path.empty())
+        descend_right(_root);
+      else if (_path.back()->left != nullptr)
+        descend_right(_path.back()->left);
+      else {
+        const node* x = _path.back();
+        _path.pop_back();
+        while (!_path.empty() && _path.back()->left == x) {
+          x = _path.back();
+          _path.pop_back();
+        }
+      }
+      return *this;
+    }
+
+    const_iterator operator--(int) {
+      const_iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return position() == other.position();
+    }
+
+  private:
+    explicit const_iterator(const node* root_) : _root(root_) {}
+
+    const node* position() const {
+      return _path.empty() ? nullptr : _path.back();
+    }
+
+    void descend_left(const node* x) {
+      for (; x != nullptr; x = x->left)
+        _path.push_back(x);
+    }
+
+    void descend_right(const node* x) {
+      for (; x != nullptr; x = x->right)
+        _path.push_back(x);
+    }
+
+    const node* _root = nullptr;
+    /// The nodes from the root down to the position, none for the end
+    std::vector<const node*> _path;
+  };
+
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  persistent_map() = default;
+
+  explicit persistent_map(const Alloc& alloc) : _alloc(alloc) {}
+
+  /** The sorted values <tt>[first,past)</tt>, built in linear time */
+  template <typename InputIterator>
+  persistent_map(InputIterator first, InputIterator past,
+                 const Alloc& alloc = Alloc())
+      : _alloc(alloc) {
+    _root = build(first, past);
+  }
+
+  /// A version that shares the nodes of \c src, in constant time
+  persistent_map(const persistent_map& src)
+      : _root(retain(src._root)), _compare(src._compare), _alloc(src._alloc),
+        _seed(src._seed) {}
+
+  persistent_map(persistent_map&& src) noexcept
+      : _root(std::exchange(src._root, nullptr)), _compare(src._compare),
+        _alloc(std::move(src._alloc)), _seed(src._seed) {}
+
+  persistent_map& operator=(const persistent_map& src) {
+    persistent_map(src).swap(*this);
+    return *this;
+  }
+
+  persistent_map& operator=(persistent_map&& src) noexcept {
+    persistent_map(std::move(src)).swap(*this);
+    return *this;
+  }
+
+  ~persistent_map() { release(_root); }
+
+  allocator_type get_allocator() const { return Alloc(_alloc); }
+  key_compare key_comp() const { return _compare; }
+
+  /// As for the standard containers, the allocators of the versions must
+  /// be equal, unless they propagate on swap
+  void swap(persistent_map& other) noexcept {
+    std::swap(_root, other._root);
+    std::swap(_compare, other._compare);
+    if constexpr (node_traits::propagate_on_container_swap::value)
+      std::swap(_alloc, other._alloc);
+    std::swap(_seed, other._seed);
+  }
+
+  /// Do both versions share all their nodes?
+  bool shares(const persistent_map& other) const {
+    return _root == other._root;
+  }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  [[nodiscard]] bool empty() const { return _root == nullptr; }
+  [[nodiscard]] size_type size() const { return count(_root); }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  const_iterator begin() const {
+    const_iterator it_(_root);
+    it_.descend_left(_root);
+    return it_;
+  }
+  const_iterator end() const { return const_iterator(_root); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+  /// The first value, whose key is not less than \c key_
+  const_iterator lower_bound(const key_type& key_) const {
+    return bound([&](const node* x) { return !_compare(key(x), key_); });
+  }
+
+  /// The first value, whose key is greater than \c key_
+  const_iterator upper_bound(const key_type& key_) const {
+    return bound([&](const node* x) { return _compare(key_, key(x)); });
+  }
+
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type& key_) const {
+    return {lower_bound(key_), upper_bound(key_)};
+  }
+
+  const_iterator find(const key_type& key_) const {
+    const const_iterator it_ = lower_bound(key_);
+    return it_ == end() || _compare(key_, (*it_).first) ? end() : it_;
+  }
+
+  //==========================================================================
+  //= Update
+  //==========================================================================
+  /** Replaces the values <tt>[first,past)</tt> by the values
+      <tt>[from,to)</tt>, that are sorted, and lie between the values in
+      front of \c first and those from \c past on. The iterators of the
+      version are invalidated. */
+  template <typename InputIterator>
+  void replace(const_iterator first, const_iterator past, InputIterator from,
+               InputIterator to) {
+    node* added = build(from, to);
+    node* rest = retain(_root);
+    node* front = nullptr;
+    if (first != end())
+      std::tie(front, rest) = split(rest, (*first).first);
+    else
+      std::swap(front, rest);
+    node* back = nullptr;
+    if (past != end())
+      std::tie(rest, back) = split(rest, (*past).first);
+    release(rest);
+    node* root_ = join(join(front, added), back);
+    release(std::exchange(_root, root_));
+  }
+
+  /** Replaces the values, whose keys are equivalent to \c key_, by the
+      values <tt>[from,to)</tt>, that are sorted, and lie between the
+      values of the lesser and of the greater keys. */
+  template <typename InputIterator>
+  void replace(const key_type& key_, InputIterator from, InputIterator to) {
+    node* added = build(from, to);
+    auto [front, rest] = split(retain(_root), key_);
+    auto [equivalent, back] = split(
+        rest, [&](const node* x) { return !_compare(key_, key(x)); });
+    release(equivalent);
+    node* root_ = join(join(front, added), back);
+    release(std::exchange(_root, root_));
+  }
+
+  void clear() { release(std::exchange(_root, nullptr)); }
+
+private:
+  static const KeyT& key(const node* x) { return x->value.first; }
+
+  static size_type count(const node* x) {
+    return x == nullptr ? 0 : x->count;
+  }
+
+  static void update(node* x) {
+    x->count = 1 + count(x->left) + count(x->right);
+  }
+
+  static node* retain(node* x) {
+    if (x != nullptr)
+      x->references.fetch_add(1, std::memory_order_relaxed);
+    return x;
+  }
+
+  void release(node* x) {
+    while (x != nullptr &&
+           x->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      release(x->left);
+      node* right_ = x->right;
+      node_traits::destroy(_alloc, x);
+      node_traits::deallocate(_alloc, x, 1);
+      x = right_;
+    }
+  }
+
+  template <typename... Args> node* create(Args&&... args) {
+    node* x = node_traits::allocate(_alloc, 1);
+    try {
+      node_traits::construct(_alloc, x, next_priority(),
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(_alloc, x, 1);
+      throw;
+    }
+    return x;
+  }
+
+  /** The node \c x, that is owned by the caller, for an update: \c x
+      itself, if no other version refers to it, or a copy that refers to
+      its children. */
+  node* own(node* x) {
+    if (x->references.load(std::memory_order_acquire) == 1)
+      return x;
+    node* copy = node_traits::allocate(_alloc, 1);
+    try {
+      node_traits::construct(_alloc, copy, x->priority, x->value);
+    } catch (...) {
+      node_traits::deallocate(_alloc, copy, 1);
+      release(x);
+      throw;
+    }
+    copy->left = retain(x->left);
+    copy->right = retain(x->right);
+    copy->count = x->count;
+    release(x);
+    return copy;
+  }
+
+  /// Splits the tree \c x, that is owned by the caller, into the trees of
+  /// the nodes, for which \c before holds, and of the others. \c before
+  /// holds for a prefix of the nodes.
+  template <typename Before>
+  std::pair<node*, node*> split(node* x, Before before) {
+    if (x == nullptr)
+      return {nullptr, nullptr};
+    x = own(x);
+    if (before(x)) {
+      auto [front, rest] = split(std::exchange(x->right, nullptr), before);
+      x->right = front;
+      update(x);
+      return {x, rest};
+    }
+    auto [front, rest] = split(std::exchange(x->left, nullptr), before);
+    x->left = rest;
+    update(x);
+    return {front, x};
+  }
+
+  /// Splits the tree \c x into the trees of the keys less than \c key_ and
+  /// of the others
+  std::pair<node*, node*> split(node* x, const key_type& key_) {
+    return split(x, [&](const node* y) { return _compare(key(y), key_); });
+  }
+
+  /// Joins the trees \c left and \c right, that are owned by the caller
+  /// and whose keys are all less in \c left
+  node* join(node* left, node* right) {
+    if (left == nullptr)
+      return right;
+    if (right == nullptr)
+      return left;
+    if (left->priority > right->priority) {
+      left = own(left);
+      left->right = join(std::exchange(left->right, nullptr), right);
+      update(left);
+      return left;
+    }
+    right = own(right);
+    right->left = join(left, std::exchange(right->left, nullptr));
+    update(right);
+    return right;
+  }
+
+  /// A tree of the sorted values <tt>[first,past)</tt>, in linear time
+  template <typename InputIterator>
+  node* build(InputIterator first, InputIterator past) {
+    // The right spine of the tree built so far, from the root downwards
+    std::vector<node*> spine;
+    try {
+      for (; first != past; ++first) {
+        node* z = create(*first);
+        node* left_ = nullptr;
+        while (!spine.empty() && spine.back()->priority < z->priority) {
+          left_ = spine.back();
+          update(left_);
+          spine.pop_back();
+        }
+        z->left = left_;
+        if (!spine.empty())
+          spine.back()->right = z;
+        spine.push_back(z);
+      }
+    } catch (...) {
+      if (!spine.empty())
+        release(spine.front());
+      throw;
+    }
+    for (auto it_ = spine.rbegin(); it_ != spine.rend(); ++it_)
+      update(*it_);
+    return spine.empty() ? nullptr : spine.front();
+  }
+
+  /// The first value in order, for which \c holds is true, that is false
+  /// for a prefix of the values
+  template <typename Holds> const_iterator bound(Holds holds) const {
+    const_iterator it_(_root);
+    std::size_t depth = 0;
+    for (const node* x = _root; x != nullptr;) {
+      it_._path.push_back(x);
+      if (holds(x)) {
+        depth = it_._path.size();
+        x = x->left;
+      } else
+        x = x->right;
+    }
+    it_._path.resize(depth);
+    return it_;
+  }
+
+  std::uint64_t next_priority() {
+    // splitmix64
+    std::uint64_t z = (_seed += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  node* _root = nullptr;
+  [[no_unique_address]] key_compare _compare;
+  [[no_unique_address]] node_allocator _alloc;
+  std::uint64_t _seed = 0;
+};
+
+} // namespace detail
+} // namespace icl
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include <concepts>
+#include <optional>
+
+namespace icl {
+namespace detail {
+
+/// Values of \c CodomainT can be weighted by lengths of type \c DiffT
+template <typename CodomainT, typename DiffT>
+concept weightable = requires(const CodomainT& value, const DiffT& length) {
+  { value * length } -> std::convertible_to<CodomainT>;
+};
+
+/** \brief Aggregate of a sequence of segments of an interval map.
+
+    The values are folded in the order of their intervals by the combine
+    functor of the map, e.g. summed for \c inplace_plus. Values that are
+    ordered keep their minimum and maximum as well. Values that can be
+    multiplied by lengths keep the fold of the values weighted by the
+    lengths of their intervals. */
+template <typename Interval, typename CodomainT, typename Combine>
+struct segment_aggregate {
+  using difference_type = difference_type_of<interval_traits<Interval>>::type;
+
+  static constexpr bool is_ordered = std::totally_ordered<CodomainT>;
+  static constexpr bool is_weightable =
+      weightable<CodomainT, difference_type>;
+
+  segment_aggregate(const Interval& inter_val, const CodomainT& value)
+      : combined(value), minimum(value), maximum(value), weighted(value) {
+    if constexpr (is_weightable)
+      weighted = static_cast<CodomainT>(value * icl::length(inter_val));
+  }
+
+  /// The aggregate of no segments
+  static CodomainT identity_element() { return Combine::identity_element(); }
+
+  /// Combines the aggregate of the segments that follow
+  void append(const segment_aggregate& right) {
+    Combine()(combined, right.combined);
+    if constexpr (is_ordered) {
+      if (right.minimum < minimum)
+        minimum = right.minimum;
+      if (maximum < right.maximum)
+        maximum = right.maximum;
+    }
+    if constexpr (is_weightable)
+      Combine()(weighted, right.weighted);
+  }
+
+  CodomainT combined;
+  CodomainT minimum;
+  CodomainT maximum;
+  CodomainT weighted;
+};
+
+} // namespace detail
+
+//==============================================================================
+//= Aggregations
+//==============================================================================
+/** \brief Aggregation: The values folded by the combine functor of the map,
+    e.g. their sum for \c inplace_plus. The identity element, if no segment
+    is aggregated. */
+struct aggregate_sum_t {
+  template <typename Aggregate>
+  auto operator()(const std::optional<Aggregate>& aggregate) const {
+    return aggregate ? aggregate->combined : Aggregate::identity_element();
+  }
+};
+
+/** \brief Aggregation: The values weighted by the lengths of their
+    intervals and folded by the combine functor of the map, e.g. the
+    integral of the map for \c inplace_plus. */
+struct aggregate_weighted_sum_t {
+  template <typename Aggregate>
+    requires Aggregate::is_weightable
+  auto operator()(const std::optional<Aggregate>& aggregate) const {
+    return aggregate ? aggregate->weighted : Aggregate::identity_element();
+  }
+};
+
+/// Aggregation: The least value, if any segment is aggregated.
+struct aggregate_min_t {
+  template <typename Aggregate>
+    requires Aggregate::is_ordered
+  auto operator()(const std::optional<Aggregate>& aggregate) const {
+    return aggregate ? std::optional(aggregate->minimum) : std::nullopt;
+  }
+};
+
+/// Aggregation: The greatest value, if any segment is aggregated.
+struct aggregate_max_t {
+  template <typename Aggregate>
+    requires Aggregate::is_ordered
+  auto operator()(const std::optional<Aggregate>& aggregate) const {
+    return aggregate ? std::optional(aggregate->maximum) : std::nullopt;
+  }
+};
+
+inline constexpr aggregate_sum_t aggregate_sum{};
+inline constexpr aggregate_weighted_sum_t aggregate_weighted_sum{};
+inline constexpr aggregate_min_t aggregate_min{};
+inline constexpr aggregate_max_t aggregate_max{};
+
+} // namespace icl
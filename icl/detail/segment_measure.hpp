@@ -0,0 +1,77 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/type_traits/identity_element.hpp"
+#include <exception>
+
+namespace icl {
+namespace detail {
+
+/** \brief Cardinality and length of a collection of disjoint intervals.
+
+    Both quantities are additive over disjoint intervals of a discrete
+    domain, so the totals of a container are the sums over its segments,
+    and pieces of segments can be accounted for separately. */
+template <typename SizeT, typename DiffT> struct segment_measure {
+  SizeT cardinality = identity_element<SizeT>::value();
+  DiffT length = identity_element<DiffT>::value();
+
+  template <typename Interval> void add(const Interval& inter_val) {
+    cardinality += icl::cardinality(inter_val);
+    length += icl::length(inter_val);
+  }
+
+  /// Replaces the part \c before of the totals by \c after.
+  void replace(const segment_measure& before, const segment_measure& after) {
+    cardinality = cardinality - before.cardinality + after.cardinality;
+    length = length - before.length + after.length;
+  }
+};
+
+/** \brief Running totals of an interval container, together with the
+    nesting depth of the updates in progress. */
+template <typename SizeT, typename DiffT>
+struct measure_cache : segment_measure<SizeT, DiffT> {
+  unsigned depth = 0;
+};
+
+/// Stands in for \c measure_cache in containers that keep no totals.
+struct no_measure_cache {};
+
+/** \brief Keeps the running totals of \c Type up to date over an update
+    that only changes the elements within \c span.
+
+    The part of the totals within \c span is measured before and after the
+    update, the difference is applied on destruction. Updates are built from
+    other updates, so nested scopes are accounted for by the outermost one
+    only. If the update throws, the totals are counted anew. */
+template <typename Type> class measure_scope {
+public:
+  using interval_type = Type::interval_type;
+
+  measure_scope(Type& object, const interval_type& span)
+      : object_(object), span_(span), before_(object.covered(span)),
+        exceptions_(std::uncaught_exceptions()) {
+    ++object_._measure.depth;
+  }
+
+  measure_scope(const measure_scope&) = delete;
+  measure_scope& operator=(const measure_scope&) = delete;
+
+  ~measure_scope() {
+    --object_._measure.depth;
+    if (std::uncaught_exceptions() > exceptions_)
+      object_.recount();
+    else
+      object_._measure.replace(before_, object_.covered(span_));
+  }
+
+private:
+  Type& object_;
+  interval_type span_;
+  typename Type::measure_type before_;
+  int exceptions_;
+};
+
+} // namespace detail
+} // namespace icl
@@ -0,0 +1,579 @@
+#pragma once
+
+#include "icl/concept/container.hpp"
+#include "icl/concept/interval_associator.hpp"
+#include "icl/concept/map_value.hpp"
+#include "icl/detail/interval_merge_algo.hpp"
+#include "icl/detail/on_absorbtion.hpp"
+#include "icl/interval_combining_style.hpp"
+#include "icl/type_traits/absorbs_identities.hpp"
+#include "icl/type_traits/has_set_semantics.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include "icl/type_traits/is_total.hpp"
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace icl {
+
+/** \brief An interval container as operand of an expression, see \c lazy.
+    The terminal refers to the container. */
+template <typename Type> class expression_terminal {
+public:
+  using result_type = Type;
+
+  explicit expression_terminal(const Type& object) : _object(&object) {}
+
+  const Type& object() const { return *_object; }
+
+private:
+  const Type* _object;
+};
+
+/** \brief The combination of two expressions by \c Operation. The type of
+    the result is that, which the operator on containers yields. */
+template <typename Operation, typename Left, typename Right>
+class expression_node {
+public:
+  using result_type = Operation::template result_type<
+      typename Left::result_type, typename Right::result_type>;
+
+  expression_node(const Left& left, const Right& right)
+      : _left(left), _right(right) {}
+
+  const Left& left() const { return _left; }
+  const Right& right() const { return _right; }
+
+  /// Evaluates the expression to a container of type \c Type, that
+  /// allocates from the allocator of the first operand
+  template <typename Type>
+    requires is_interval_container<Type>::value
+  operator Type() const;
+
+private:
+  Left _left;
+  Right _right;
+};
+
+template <typename Type> struct is_interval_expression {
+  using type = is_interval_expression;
+  static constexpr bool value = false;
+};
+
+template <typename Type>
+struct is_interval_expression<expression_terminal<Type>> {
+  using type = is_interval_expression;
+  static constexpr bool value = true;
+};
+
+template <typename Operation, typename Left, typename Right>
+struct is_interval_expression<expression_node<Operation, Left, Right>> {
+  using type = is_interval_expression;
+  static constexpr bool value = true;
+};
+
+namespace detail {
+
+//==============================================================================
+//= Pieces
+//==============================================================================
+/// The value of an elementary piece of an expression of type \c Type: The
+/// associated value of maps or whether sets contain it.
+template <typename Type> struct expression_value {
+  using type = bool;
+};
+
+template <typename Type>
+  requires is_interval_map<Type>::value
+struct expression_value<Type> {
+  using type = std::optional<typename Type::codomain_type>;
+};
+
+inline bool is_defined(bool value) { return value; }
+
+template <typename CodomainT>
+bool is_defined(const std::optional<CodomainT>& value) {
+  return value.has_value();
+}
+
+/** The state of a subexpression in the sweep: Its value on the current and
+    on the prior elementary piece, and whether its segmentation starts a new
+    segment on the current piece. The prior piece is undefined, if it does
+    not touch the current one. */
+template <typename Type> struct expression_state {
+  using value_type = expression_value<Type>::type;
+
+  value_type value{};
+  value_type prior{};
+  bool fresh = true;
+
+  bool is_defined() const { return detail::is_defined(value); }
+  bool was_defined() const { return detail::is_defined(prior); }
+
+  /// Does the segmentation have a border before the current piece?
+  bool cuts() const {
+    return is_defined() != was_defined() || (is_defined() && fresh);
+  }
+
+  /// Is the current piece in the segment of the prior one?
+  bool continues() const { return was_defined() && is_defined() && !fresh; }
+};
+
+/// Does \c state have a border before the current piece, if the values,
+/// that \c Combiner absorbs in \c Type are ignored, as the merging
+/// algorithms skip them?
+template <typename Type, typename Combiner, typename OperandT>
+bool cuts_defined(const expression_state<OperandT>& state) {
+  using on_absorbtion_ =
+      on_absorbtion<Type, Combiner, absorbs_identities<Type>::value>::type;
+  const bool was_defined =
+      state.prior && !on_absorbtion_::is_absorbable(*state.prior);
+  const bool is_defined =
+      state.value && !on_absorbtion_::is_absorbable(*state.value);
+  return was_defined != is_defined || (is_defined && state.fresh);
+}
+
+//==============================================================================
+//= Operations
+//==============================================================================
+// The operations compute the value of a piece from the values of the object
+// and the operand, the way the merging algorithms do, and return, whether
+// the operand or the object have a border, that splits the result.
+
+struct expression_add {
+  template <typename LeftT, typename RightT>
+  using result_type = std::remove_cvref_t<decltype(
+      std::declval<const LeftT&>() + std::declval<const RightT&>())>;
+
+  template <typename Type, typename ObjectT, typename OperandT>
+  static bool apply(expression_state<Type>& result,
+                    const expression_state<ObjectT>& object,
+                    const expression_state<OperandT>& operand) {
+    if constexpr (is_interval_set<Type>::value) {
+      result.value = object.value || operand.value;
+      // Separating sets join overlapping intervals only
+      if constexpr (is_interval_separator<Type>::value)
+        return !(object.continues() || operand.continues());
+      return object.cuts() || operand.cuts();
+    } else {
+      using codomain_combine = Type::codomain_combine;
+      result.value = object.value;
+      if (operand.value)
+        Interval_Merge::combine<Type, codomain_combine>(result.value,
+                                                        *operand.value);
+      return object.cuts() || cuts_defined<Type, codomain_combine>(operand);
+    }
+  }
+};
+
+struct expression_subtract {
+  template <typename LeftT, typename RightT>
+  using result_type = std::remove_cvref_t<decltype(
+      std::declval<const LeftT&>() - std::declval<const RightT&>())>;
+
+  template <typename Type, typename ObjectT, typename OperandT>
+  static bool apply(expression_state<Type>& result,
+                    const expression_state<ObjectT>& object,
+                    const expression_state<OperandT>& operand) {
+    if constexpr (is_interval_map<OperandT>::value) {
+      using inverse_codomain_combine = Type::inverse_codomain_combine;
+      result.value = object.value;
+      if (operand.value)
+        Interval_Merge::combine_defined<Type, inverse_codomain_combine>(
+            result.value, *operand.value);
+      return object.cuts() ||
+             cuts_defined<Type, inverse_codomain_combine>(operand);
+    } else {
+      if (operand.is_defined())
+        result.value = {};
+      else
+        result.value = object.value;
+      return object.cuts() || operand.cuts();
+    }
+  }
+};
+
+struct expression_intersect {
+  template <typename LeftT, typename RightT>
+  using result_type = std::remove_cvref_t<decltype(
+      std::declval<const LeftT&>() & std::declval<const RightT&>())>;
+
+  template <typename Type, typename ObjectT, typename OperandT>
+  static bool apply(expression_state<Type>& result,
+                    const expression_state<ObjectT>& object,
+                    const expression_state<OperandT>& operand) {
+    result.value = {};
+    if (object.is_defined() && operand.is_defined()) {
+      if constexpr (is_interval_set<Type>::value)
+        result.value = true;
+      else {
+        Interval_Merge::combine<Type, typename Type::codomain_combine>(
+            result.value, *object.value);
+        if constexpr (is_interval_map<OperandT>::value)
+          Interval_Merge::combine<Type, typename Type::codomain_intersect>(
+              result.value, *operand.value);
+      }
+    }
+    return object.cuts() || operand.cuts();
+  }
+};
+
+struct expression_flip {
+  template <typename LeftT, typename RightT>
+  using result_type = std::remove_cvref_t<decltype(
+      std::declval<const LeftT&>() ^ std::declval<const RightT&>())>;
+
+  template <typename Type, typename ObjectT, typename OperandT>
+  static bool apply(expression_state<Type>& result,
+                    const expression_state<ObjectT>& object,
+                    const expression_state<OperandT>& operand) {
+    if constexpr (is_interval_set<Type>::value)
+      result.value = object.value != operand.value;
+    else {
+      using codomain_type = Type::codomain_type;
+      using codomain_combine = Type::codomain_combine;
+      result.value = {};
+      if (!operand.value)
+        result.value = object.value;
+      else if (!object.value)
+        Interval_Merge::combine<Type, codomain_combine>(result.value,
+                                                        *operand.value);
+      else {
+        // That which is common is rewritten by its difference
+        codomain_type common_value = identity_element<codomain_type>::value();
+        if constexpr (has_set_semantics<codomain_type>::value) {
+          common_value = *operand.value;
+          typename Type::inverse_codomain_intersect()(common_value,
+                                                      *object.value);
+        }
+        std::optional<codomain_type> section_value;
+        Interval_Merge::combine<Type, codomain_combine>(section_value,
+                                                        common_value);
+        if (section_value)
+          Interval_Merge::combine<Type, codomain_combine>(result.value,
+                                                          *section_value);
+      }
+    }
+    return object.cuts() || operand.cuts();
+  }
+};
+
+//==============================================================================
+//= Evaluation
+//==============================================================================
+/** Sweeps the operands of an expression. Leaves track the rest of their
+    current segment. Each elementary piece starts at the lowest rest and
+    ends before the next border of any rest, so it is contained in or
+    disjoint to each of them. */
+template <typename Expression> class expression_evaluator;
+
+template <typename Type>
+class expression_evaluator<expression_terminal<Type>> {
+public:
+  using result_type = Type;
+  using interval_type = Type::interval_type;
+  using const_iterator = Type::const_iterator;
+
+  explicit expression_evaluator(const expression_terminal<Type>& expression)
+      : _object(&expression.object()), _it(_object->begin()) {
+    if (_it != _object->end())
+      _rest = key_value<Type>(_it);
+  }
+
+  /// Sets \c piece to the rest of the current segment, if it is lower
+  void lowest(std::optional<interval_type>& piece) const {
+    if (_it != _object->end() && (!piece || lower_less(_rest, *piece)))
+      piece = _rest;
+  }
+
+  /// Ends \c piece before the next border of the rest
+  void clip(interval_type& piece) const {
+    if (_it == _object->end())
+      return;
+    if (const interval_type before = right_subtract(piece, _rest);
+        !icl::is_empty(before))
+      piece = before;
+    else
+      piece = piece & _rest;
+  }
+
+  void step(const interval_type& piece) {
+    if (_it == _object->end() || exclusive_less(piece, _rest)) {
+      state.value = {};
+      return;
+    }
+    if constexpr (is_interval_map<Type>::value)
+      state.value = co_value<Type>(_it);
+    else
+      state.value = true;
+    state.fresh = _fresh;
+    _fresh = false;
+    _rest = left_subtract(_rest, piece);
+    if (icl::is_empty(_rest) && ++_it != _object->end()) {
+      _rest = key_value<Type>(_it);
+      _fresh = true;
+    }
+  }
+
+  void shift(bool touching) {
+    state.prior = touching ? state.value : decltype(state.value){};
+  }
+
+  expression_state<Type> state;
+
+private:
+  const Type* _object;
+  const_iterator _it;
+  interval_type _rest{};
+  bool _fresh = true;
+};
+
+template <typename Operation, typename Left, typename Right>
+class expression_evaluator<expression_node<Operation, Left, Right>> {
+public:
+  using result_type = expression_node<Operation, Left, Right>::result_type;
+  using interval_type = result_type::interval_type;
+
+  explicit expression_evaluator(
+      const expression_node<Operation, Left, Right>& expression)
+      : _left(expression.left()), _right(expression.right()) {}
+
+  void lowest(std::optional<interval_type>& piece) const {
+    _left.lowest(piece);
+    _right.lowest(piece);
+  }
+
+  void clip(interval_type& piece) const {
+    _left.clip(piece);
+    _right.clip(piece);
+  }
+
+  void step(const interval_type& piece) {
+    _left.step(piece);
+    _right.step(piece);
+
+    // The result is a copy of the operand of the same type, that the other
+    // one is combined to, like in the operators
+    bool cuts;
+    if constexpr (std::same_as<result_type, typename Left::result_type>)
+      cuts = Operation::apply(state, _left.state, _right.state);
+    else
+      cuts = Operation::apply(state, _right.state, _left.state);
+
+    if (!state.is_defined())
+      return;
+    if constexpr (result_type::fineness == interval_combine::joining) {
+      state.fresh = !state.was_defined();
+      if constexpr (is_interval_map<result_type>::value)
+        state.fresh = state.fresh || !(*state.prior == *state.value);
+    } else
+      state.fresh = !state.was_defined() || cuts;
+  }
+
+  void shift(bool touching) {
+    _left.shift(touching);
+    _right.shift(touching);
+    state.prior = touching ? state.value : decltype(state.value){};
+  }
+
+  expression_state<result_type> state;
+
+private:
+  expression_evaluator<Left> _left;
+  expression_evaluator<Right> _right;
+};
+
+template <typename Type>
+  requires is_interval_container<Type>::value
+expression_terminal<Type> to_expression(const Type& object) {
+  return expression_terminal<Type>(object);
+}
+
+template <typename Expression>
+  requires is_interval_expression<Expression>::value
+const Expression& to_expression(const Expression& expression) {
+  return expression;
+}
+
+template <typename Type>
+using expression_of =
+    std::remove_cvref_t<decltype(to_expression(std::declval<const Type&>()))>;
+
+/// Can \c Left and \c Right be combined by \c Operation in an expression?
+template <typename Operation, typename Left, typename Right>
+concept expression_combinable =
+    (is_interval_expression<Left>::value ||
+     is_interval_expression<Right>::value) &&
+    requires {
+      typename expression_node<Operation, expression_of<Left>,
+                               expression_of<Right>>::result_type;
+    };
+
+template <typename Operation, typename Left, typename Right>
+expression_node<Operation, expression_of<Left>, expression_of<Right>>
+make_expression(const Left& left, const Right& right) {
+  using node_type =
+      expression_node<Operation, expression_of<Left>, expression_of<Right>>;
+  static_assert(!is_total<typename node_type::result_type>::value,
+                "icl: expressions of total maps are not supported");
+  return node_type(to_expression(left), to_expression(right));
+}
+
+} // namespace detail
+
+/** \brief Starts an expression on \c object, e.g. <tt>lazy(a) + b - c & d</tt>.
+
+    The operators <tt>+ | - & ^</tt> on expressions capture the expression
+    tree instead of computing a container per operator. The expression is
+    evaluated on conversion to an interval container or by \c evaluate, in
+    one sweep over the segments of all operands without intermediate
+    containers. The result equals that of the operators on containers: Each
+    subexpression is segmented like the container, that its operator yields,
+    and thus respects the joining, separating or splitting style of its
+    operands. Expressions refer to their operands, that have to outlive
+    them. Total maps are not supported. */
+template <typename Type>
+  requires is_interval_container<Type>::value
+expression_terminal<Type> lazy(const Type& object) {
+  return expression_terminal<Type>(object);
+}
+
+namespace detail {
+
+/// The container of the leftmost operand of \c expression
+template <typename Type>
+const Type& first_operand(const expression_terminal<Type>& expression) {
+  return expression.object();
+}
+
+template <typename Operation, typename Left, typename Right>
+const auto&
+first_operand(const expression_node<Operation, Left, Right>& expression) {
+  return first_operand(expression.left());
+}
+
+/// An empty container for the value of \c expression, that allocates from
+/// the allocator of its first operand, if \c Type can
+template <typename Type, typename Expression>
+Type empty_result(const Expression& expression) {
+  const auto& operand = first_operand(expression);
+  if constexpr (requires { Type(operand.get_allocator()); })
+    return Type(operand.get_allocator());
+  else
+    return Type();
+}
+
+/// Inserts the segments of \c expression in ascending order into the empty
+/// container \c result, that must not be an operand of \c expression.
+template <typename Type, typename Expression>
+void evaluate_into(Type& result, const Expression& expression) {
+  using evaluator_type = expression_evaluator<Expression>;
+  using interval_type = evaluator_type::interval_type;
+
+  evaluator_type evaluator(expression);
+  typename Type::iterator prior_ = result.end();
+  std::optional<interval_type> segment;
+  typename expression_value<typename evaluator_type::result_type>::type
+      value{};
+  std::optional<interval_type> prior_piece;
+  auto flush = [&] {
+    if (!segment)
+      return;
+    if constexpr (is_interval_map<Type>::value)
+      prior_ = result.insert(prior_,
+                             typename Type::segment_type(*segment, *value));
+    else
+      prior_ = result.add(prior_, *segment);
+    segment.reset();
+  };
+
+  for (;;) {
+    std::optional<interval_type> piece;
+    evaluator.lowest(piece);
+    if (!piece)
+      break;
+    evaluator.clip(*piece);
+    evaluator.shift(prior_piece && icl::touches(*prior_piece, *piece));
+    evaluator.step(*piece);
+    if (!evaluator.state.is_defined() || evaluator.state.fresh)
+      flush();
+    if (evaluator.state.is_defined()) {
+      segment = segment ? hull(*segment, *piece) : *piece;
+      value = evaluator.state.value;
+    }
+    prior_piece = piece;
+  }
+  flush();
+}
+
+} // namespace detail
+
+/** Replaces the content of \c result by the value of \c expression. The
+    expression may refer to \c result, as in <tt>evaluate(a, lazy(a) + b)</tt>:
+    It is evaluated into a new container, that is swapped into \c result. */
+template <typename Type, typename Expression>
+  requires(is_interval_container<Type>::value &&
+           is_interval_expression<Expression>::value)
+Type& evaluate(Type& result, const Expression& expression) {
+  Type evaluated = icl::empty_like(result);
+  detail::evaluate_into(evaluated, expression);
+  result.swap(evaluated);
+  return result;
+}
+
+/// Evaluates \c expression to a container of the type, that the operators
+/// on containers yield. It allocates from the allocator of the first operand.
+template <typename Expression>
+  requires is_interval_expression<Expression>::value
+Expression::result_type evaluate(const Expression& expression) {
+  auto result =
+      detail::empty_result<typename Expression::result_type>(expression);
+  detail::evaluate_into(result, expression);
+  return result;
+}
+
+template <typename Operation, typename Left, typename Right>
+template <typename Type>
+  requires is_interval_container<Type>::value
+expression_node<Operation, Left, Right>::operator Type() const {
+  Type result = detail::empty_result<Type>(*this);
+  detail::evaluate_into(result, *this);
+  return result;
+}
+
+//==============================================================================
+//= Operators
+//==============================================================================
+template <typename Left, typename Right>
+  requires detail::expression_combinable<detail::expression_add, Left, Right>
+auto operator+(const Left& left, const Right& right) {
+  return detail::make_expression<detail::expression_add>(left, right);
+}
+
+template <typename Left, typename Right>
+  requires detail::expression_combinable<detail::expression_add, Left, Right>
+auto operator|(const Left& left, const Right& right) {
+  return detail::make_expression<detail::expression_add>(left, right);
+}
+
+template <typename Left, typename Right>
+  requires detail::expression_combinable<detail::expression_subtract, Left,
+                                         Right>
+auto operator-(const Left& left, const Right& right) {
+  return detail::make_expression<detail::expression_subtract>(left, right);
+}
+
+template <typename Left, typename Right>
+  requires detail::expression_combinable<detail::expression_intersect, Left,
+                                         Right>
+auto operator&(const Left& left, const Right& right) {
+  return detail::make_expression<detail::expression_intersect>(left, right);
+}
+
+template <typename Left, typename Right>
+  requires detail::expression_combinable<detail::expression_flip, Left, Right>
+auto operator^(const Left& left, const Right& right) {
+  return detail::make_expression<detail::expression_flip>(left, right);
+}
+
+} // namespace icl
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#ifdef __cpp_lib_format
+
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+namespace icl::detail {
+
+/// Parses \c spec, the whole format spec of one value, with \c formatter
+template <typename CharT, typename Formatter>
+constexpr void parse_format_spec(Formatter& formatter,
+                                 std::basic_string_view<CharT> spec) {
+  std::basic_format_parse_context<CharT> context(spec);
+  if (formatter.parse(context) != context.end())
+    throw std::format_error("icl: invalid format spec");
+}
+
+/// Writes \c object like \c operator<< does, its bounds with \c domain
+template <typename Type, typename DomainFormatter, typename FormatContext>
+FormatContext::iterator format_interval(const Type& object,
+                                        const DomainFormatter& domain,
+                                        FormatContext& context) {
+  using char_type = FormatContext::char_type;
+
+  const interval_bounds bounds = icl::bounds(object);
+  auto out = context.out();
+  *out++ = static_cast<char_type>(is_left_closed(bounds) ? '[' : '(');
+  if (!icl::is_empty(object)) {
+    context.advance_to(out);
+    out = domain.format(icl::lower(object), context);
+    *out++ = static_cast<char_type>(',');
+    context.advance_to(out);
+    out = domain.format(icl::upper(object), context);
+  }
+  *out++ = static_cast<char_type>(is_right_closed(bounds) ? ']' : ')');
+  return out;
+}
+
+} // namespace icl::detail
+
+namespace std {
+
+/** Formats the bounds of an interval as brackets, e.g. <tt>[)</tt> */
+template <typename CharT> struct formatter<icl::interval_bounds, CharT> {
+  constexpr auto parse(basic_format_parse_context<CharT>& context) {
+    auto it_ = context.begin();
+    if (it_ != context.end() && *it_ != '}')
+      throw format_error("icl: interval_bounds take no format spec");
+    return it_;
+  }
+
+  template <typename FormatContext>
+  auto format(icl::interval_bounds bounds, FormatContext& context) const {
+    auto out = context.out();
+    *out++ = static_cast<CharT>(icl::is_left_closed(bounds) ? '[' : '(');
+    *out++ = static_cast<CharT>(icl::is_right_closed(bounds) ? ']' : ')');
+    return out;
+  }
+};
+
+/** Formats an interval like \c operator<<, e.g. <tt>[1,5)</tt>. The format
+    spec is that of the domain type and applies to both bounds, e.g.
+    <tt>{:#x}</tt>. */
+template <typename Type, typename CharT>
+  requires icl::is_interval<Type>::value
+struct formatter<Type, CharT> {
+  constexpr auto parse(basic_format_parse_context<CharT>& context) {
+    return _domain.parse(context);
+  }
+
+  template <typename FormatContext>
+  auto format(const Type& object, FormatContext& context) const {
+    return icl::detail::format_interval(object, _domain, context);
+  }
+
+private:
+  formatter<typename icl::interval_traits<Type>::domain_type, CharT> _domain;
+};
+
+/** Formats an interval set like \c operator<<, e.g. <tt>{[1,5)[7,9]}</tt>.
+    The format spec is that of the domain type and applies to all bounds. */
+template <typename Type, typename CharT>
+  requires icl::is_interval_set<Type>::value
+struct formatter<Type, CharT> {
+  constexpr auto parse(basic_format_parse_context<CharT>& context) {
+    return _domain.parse(context);
+  }
+
+  template <typename FormatContext>
+  auto format(const Type& object, FormatContext& context) const {
+    auto out = context.out();
+    *out++ = static_cast<CharT>('{');
+    for (auto it_ = object.begin(); it_ != object.end(); ++it_) {
+      context.advance_to(out);
+      out = icl::detail::format_interval(*it_, _domain, context);
+    }
+    *out++ = static_cast<CharT>('}');
+    return out;
+  }
+
+private:
+  formatter<typename Type::domain_type, CharT> _domain;
+};
+
+/** Formats an interval map like \c operator<<, e.g.
+    <tt>{([1,5)->3)([7,9]->1)}</tt>. The format spec is the spec of the
+    domain type, that applies to all bounds, optionally followed by \c |
+    and the spec of the codomain type, e.g. <tt>{:#x|.2f}</tt>. The domain
+    spec can not use \c | as fill character nor nested replacement
+    fields. */
+template <typename Type, typename CharT>
+  requires icl::is_interval_map<Type>::value
+struct formatter<Type, CharT> {
+  constexpr auto parse(basic_format_parse_context<CharT>& context) {
+    auto split_ = context.begin();
+    while (split_ != context.end() && *split_ != '}' && *split_ != '|')
+      ++split_;
+    icl::detail::parse_format_spec<CharT>(
+        _domain, basic_string_view<CharT>(context.begin(), split_));
+    if (split_ != context.end() && *split_ == '|') {
+      context.advance_to(std::next(split_));
+      return _codomain.parse(context);
+    }
+    icl::detail::parse_format_spec<CharT>(_codomain,
+                                          basic_string_view<CharT>());
+    return split_;
+  }
+
+  template <typename FormatContext>
+  auto format(const Type& object, FormatContext& context) const {
+    auto out = context.out();
+    *out++ = static_cast<CharT>('{');
+    for (auto it_ = object.begin(); it_ != object.end(); ++it_) {
+      *out++ = static_cast<CharT>('(');
+      context.advance_to(out);
+      out = icl::detail::format_interval((*it_).first, _domain, context);
+      *out++ = static_cast<CharT>('-');
+      *out++ = static_cast<CharT>('>');
+      context.advance_to(out);
+      out = _codomain.format((*it_).second, context);
+      *out++ = static_cast<CharT>(')');
+    }
+    *out++ = static_cast<CharT>('}');
+    return out;
+  }
+
+private:
+  formatter<typename Type::domain_type, CharT> _domain;
+  formatter<typename Type::codomain_type, CharT> _codomain;
+};
+
+#ifdef __cpp_lib_format_ranges
+/// Interval containers are formatted by the formatters above, not as ranges
+template <ranges::input_range Type>
+  requires(same_as<Type, remove_cvref_t<Type>> &&
+           icl::is_interval_container<Type>::value)
+constexpr range_format format_kind<Type> = range_format::disabled;
+#endif
+
+} // namespace std
+
+#endif // __cpp_lib_format
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/detail/bound_search.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/type_traits/identity_element.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include "icl/type_traits/is_total.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace icl {
+
+/** \brief An immutable snapshot of the interval container \c Type, see
+    \c freeze() of interval maps and sets.
+
+    The segments are kept in one sorted array, that is iterated as the
+    segments of the container. Searches descend a second array of the
+    intervals of the segments in Eytzinger order: The children of node
+    \c k are the nodes <tt>2k</tt> and <tt>2k+1</tt>, so the top levels
+    share few cache lines, and the descendants of a node a few levels down
+    lie side by side, where they are prefetched. A descent takes no branch
+    on its comparisons.
+
+    Searches have the semantics of those of \c Type. A snapshot does not
+    refer to the container it is taken from. */
+template <typename Type>
+  requires is_interval_container<Type>::value
+class frozen {
+public:
+  /// The type of the container the snapshot is taken from
+  using source_type = Type;
+  using domain_type = Type::domain_type;
+  using domain_compare = Type::domain_compare;
+  using codomain_type = Type::codomain_type;
+  using interval_type = Type::interval_type;
+  using key_compare = Type::key_compare;
+  using size_type = Type::size_type;
+  using difference_type = Type::difference_type;
+  /// The segments: pairs of intervals and values for maps, intervals for
+  /// sets
+  using segment_type = Type::segment_type;
+  using value_type = segment_type;
+
+  using allocator_type = std::allocator_traits<
+      typename Type::allocator_type>::template rebind_alloc<segment_type>;
+
+private:
+  /// A node of the search tree: The interval of a segment and its index
+  struct node {
+    interval_type key;
+    std::size_t rank;
+  };
+
+  using segment_container = std::vector<segment_type, allocator_type>;
+  using node_container =
+      std::vector<node, typename std::allocator_traits<
+                            allocator_type>::template rebind_alloc<node>>;
+
+public:
+  using const_iterator = segment_container::const_iterator;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  frozen() = default;
+
+  /** Snapshot of \c object */
+  explicit frozen(const Type& object)
+      : _segments(object.begin(), object.end(),
+                  allocator_type(object.get_allocator())),
+        _nodes(_segments.size() + 1, node{interval_type(), 0},
+               _segments.get_allocator()),
+        _size(object.size()), _length(object.length()) {
+    place(0, 1);
+  }
+
+  allocator_type get_allocator() const { return _segments.get_allocator(); }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  const_iterator begin() const { return _segments.begin(); }
+  const_iterator end() const { return _segments.end(); }
+  const_reverse_iterator rbegin() const { return _segments.rbegin(); }
+  const_reverse_iterator rend() const { return _segments.rend(); }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  [[nodiscard]] bool empty() const { return _segments.empty(); }
+
+  /** The cardinality of the container, as its \c size() */
+  size_type size() const { return _size; }
+
+  /** The sum of the lengths of the intervals */
+  difference_type length() const { return _length; }
+
+  /** Size of the iteration over the snapshot */
+  [[nodiscard]] std::size_t iterative_size() const { return _segments.size(); }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+
+  /** Find the segment, that contains \c point */
+  const_iterator find(const domain_type& point) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return find(Interval_Stabbing::probe<Type>(point));
+  }
+
+  /** Find the segment, that collides with interval \c key_interval */
+  const_iterator find(const interval_type& key_interval) const {
+    const std::size_t found = search([&](const interval_type& key) {
+      return key_compare()(key, key_interval);
+    });
+    return found != 0 && !key_compare()(key_interval, _nodes[found].key)
+               ? at(found)
+               : end();
+  }
+
+  /** Total select function: The value that \c point is mapped to */
+  codomain_type operator()(const domain_type& point) const
+    requires(is_interval_map<Type>::value && Interval_Stabbing::stabbable<Type>)
+  {
+    const const_iterator it_ = find(point);
+    return it_ == end() ? identity_element<codomain_type>::value()
+                        : it_->second;
+  }
+
+  /** The first segment, that does not precede \c key_interval */
+  const_iterator lower_bound(const interval_type& key_interval) const {
+    return at(search([&](const interval_type& key) {
+      return key_compare()(key, key_interval);
+    }));
+  }
+
+  /** The first segment, that \c key_interval precedes */
+  const_iterator upper_bound(const interval_type& key_interval) const {
+    return at(search([&](const interval_type& key) {
+      return !key_compare()(key_interval, key);
+    }));
+  }
+
+  /** The segments, that collide with \c key_interval */
+  std::pair<const_iterator, const_iterator>
+  equal_range(const interval_type& key_interval) const {
+    return std::pair<const_iterator, const_iterator>(
+        lower_bound(key_interval), upper_bound(key_interval));
+  }
+
+  //==========================================================================
+  //= Containedness
+  //==========================================================================
+
+  /** Does the snapshot contain the element \c point? */
+  bool contains(const domain_type& point) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    if constexpr (is_total<Type>::value)
+      return true;
+    else
+      return find(point) != end();
+  }
+
+  /** Are all elements of \c inter_val contained? */
+  bool contains(const interval_type& inter_val) const {
+    if constexpr (is_total<Type>::value)
+      return true;
+    else {
+      if (icl::is_empty(inter_val))
+        return true;
+      const auto [first_, past_] = equal_range(inter_val);
+      if (first_ == past_)
+        return false;
+      const const_iterator last_ = std::prev(past_);
+      if (!icl::contains(hull(key_of(*first_), key_of(*last_)), inter_val))
+        return false;
+      for (const_iterator it_ = first_; it_ != last_; ++it_)
+        if (!icl::touches(key_of(*it_), key_of(*std::next(it_))))
+          return false;
+      return true;
+    }
+  }
+
+  /** Does the snapshot contain the element \c point? */
+  bool intersects(const domain_type& point) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return contains(point);
+  }
+
+  /** Do \c inter_val and the snapshot have elements in common? */
+  bool intersects(const interval_type& inter_val) const {
+    return !icl::is_empty(inter_val) && find(inter_val) != end();
+  }
+
+private:
+  /// The levels below a node, whose nodes are prefetched: Those of the
+  /// fourth level take four cache lines, if nodes take 16 bytes.
+  static constexpr int lookahead = sizeof(node) <= 16 ? 4 : 3;
+  static constexpr std::size_t line_size = 64;
+
+  static const interval_type& key_of(const segment_type& segment) {
+    if constexpr (is_interval_map<Type>::value)
+      return segment.first;
+    else
+      return segment;
+  }
+
+  /// Lays out the segments from \c index on in the subtree of \c slot, in
+  /// order. Yields the index of the first segment that is not placed.
+  std::size_t place(std::size_t index, std::size_t slot) {
+    if (slot < _nodes.size()) {
+      index = place(index, 2 * slot);
+      _nodes[slot] = node{key_of(_segments[index]), index};
+      ++index;
+      index = place(index, 2 * slot + 1);
+    }
+    return index;
+  }
+
+  /// The segment of the node at \c slot, or the end for slot 0
+  const_iterator at(std::size_t slot) const {
+    return slot == 0 ? end()
+                     : begin() + static_cast<std::ptrdiff_t>(_nodes[slot].rank);
+  }
+
+  /// The slot of the node of the first segment, that does not satisfy
+  /// \c precedes, or 0 if all segments do
+  template <typename Precedes>
+  std::size_t search(const Precedes& precedes) const {
+    const std::size_t count = _segments.size();
+    std::size_t slot = 1;
+    while (slot <= count) {
+      const std::size_t ahead = slot << lookahead;
+      if (ahead <= count) {
+        const auto* first = reinterpret_cast<const char*>(&_nodes[ahead]);
+        const std::size_t bytes = std::min(std::size_t(1) << lookahead,
+                                           count + 1 - ahead) *
+                                  sizeof(node);
+        for (std::size_t line = 0; line < bytes; line += line_size)
+          Bound_Search::prefetch(first + line);
+      }
+      slot = 2 * slot + static_cast<std::size_t>(precedes(_nodes[slot].key));
+    }
+    // Strips the right turns after the last left turn, and that turn: The
+    // last node that was left to the left is the first that does not precede
+    return slot >> (std::countr_one(slot) + 1);
+  }
+
+  segment_container _segments;
+  /// The nodes of the segments in Eytzinger order, from slot 1 on
+  node_container _nodes;
+  size_type _size{};
+  difference_type _length{};
+};
+
+} // namespace icl
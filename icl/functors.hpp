@@ -4,6 +4,7 @@
 #include "icl/type_traits/identity_element.hpp"
 #include "icl/type_traits/unit_element.hpp"
 #include <type_traits>
+#include <utility>
 
 namespace icl {
 
@@ -407,6 +408,9 @@ template <typename Combiner> struct conversion {
   // (0 o= x) == x;
   // Example += :  (0 += x) == x
   static argument_type proversion(const argument_type& value) { return value; }
+  static argument_type proversion(argument_type&& value) {
+    return std::move(value);
+  }
 
   // The inversion of an op-assign functor o= inverts the value x
   // to it's inverse element -x
@@ -427,6 +431,9 @@ template <typename Combiner> struct version : public conversion<Combiner> {
   argument_type operator()(const argument_type& value) {
     return base_type::proversion(value);
   }
+  argument_type operator()(argument_type&& value) {
+    return base_type::proversion(std::move(value));
+  }
 };
 
 template <> struct version<inplace_minus<short>> {
@@ -6,17 +6,29 @@
 #include "icl/concept/interval_map.hpp"
 #include "icl/detail/element_iterator.hpp"
 #include "icl/detail/exclusive_less_than.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
 #include "icl/detail/on_absorbtion.hpp"
+#include "icl/detail/segment_measure.hpp"
 #include "icl/map.hpp"
+#include "icl/storage_policy.hpp"
 #include "icl/type_traits/has_set_semantics.hpp"
 #include "icl/type_traits/interval_type_default.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
 #include "icl/type_traits/is_interval_splitter.hpp"
 #include <cassert>
 #include <concepts>
+#include <iterator>
+#include <optional>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 namespace icl {
 
+template <typename Type>
+  requires is_interval_container<Type>::value
+class frozen;
+
 template <typename DomainT, typename CodomainT> struct mapping_pair {
   DomainT key;
   CodomainT data;
@@ -37,7 +49,8 @@ template <typename SubType, typename DomainT, typename CodomainT,
           template <typename> typename Combine = inplace_plus,
           template <typename> typename Section = inter_section,
           typename Interval = interval_type_default<DomainT, Compare>::type,
-          template <typename> typename Alloc = std::allocator>
+          template <typename> typename Alloc = std::allocator,
+          typename Storage = tree_storage>
   requires std::default_initializable<DomainT> &&
            std::totally_ordered<DomainT> &&
            std::default_initializable<CodomainT> &&
@@ -125,9 +138,13 @@ public:
   /// The allocator type of the set
   using allocator_type = Alloc<std::pair<const interval_type, codomain_type>>;
 
+  /// The storage policy of the map
+  using storage_type = Storage;
+
   /// Container type for the implementation
   using ImplMapT =
-      std::map<interval_type, codomain_type, key_compare, allocator_type>;
+      storage_map<Storage, interval_type, codomain_type, key_compare,
+                  allocator_type, codomain_combine>::type;
 
   /// key type of the implementing container
   using key_type = ImplMapT::key_type;
@@ -172,6 +189,17 @@ public:
 
   static constexpr int fineness = 0;
 
+  /// Whether cardinality and length are kept as running totals
+  static constexpr bool caches_measure =
+      Storage::caches_measure && is_discrete<DomainT>::value;
+
+  /// Cardinality and length of a part of the map
+  using measure_type = detail::segment_measure<size_type, difference_type>;
+
+  /// Aggregate of the values of a part of the map, see \c aggregate
+  using aggregate_type =
+      detail::segment_aggregate<interval_type, codomain_type, codomain_combine>;
+
   //==========================================================================
   //= Construct, copy, destruct
   //==========================================================================
@@ -179,7 +207,15 @@ public:
   interval_base_map() = default;
 
   /** Copy constructor */
-  interval_base_map(const interval_base_map& src) : _map(src._map) {}
+  interval_base_map(const interval_base_map& src)
+      : _map(src._map), _measure(src._measure) {}
+
+  /** Constructor for the empty object that allocates from \c alloc */
+  explicit interval_base_map(const allocator_type& alloc) : _map(alloc) {}
+
+  /** Copy constructor that allocates from \c alloc */
+  interval_base_map(const interval_base_map& src, const allocator_type& alloc)
+      : _map(src._map, alloc), _measure(src._measure) {}
 
   //==========================================================================
   //= Move semantics
@@ -187,19 +223,35 @@ public:
 
   /** Move constructor */
   interval_base_map(interval_base_map&& src) noexcept
-      : _map(std::move(src._map)) {}
+      : _map(std::move(src._map)), _measure(std::exchange(src._measure, {})) {}
+
+  /** Move constructor that allocates from \c alloc. If it differs from the
+      allocator of \c src, the segments are moved one by one. */
+  interval_base_map(interval_base_map&& src, const allocator_type& alloc)
+      : _map(std::move(src._map), alloc),
+        _measure(std::exchange(src._measure, {})) {
+    src._map.clear();
+  }
 
   /** Move assignment operator */
   interval_base_map& operator=(
       interval_base_map src) { // call by value sice 'src' is a "sink value"
     this->_map = std::move(src._map);
+    this->_measure = src._measure;
     return *this;
   }
 
   //==========================================================================
 
-  /** swap the content of containers */
-  void swap(interval_base_map& object) noexcept { _map.swap(object._map); }
+  /** The allocator of the container */
+  allocator_type get_allocator() const { return _map.get_allocator(); }
+
+  /** swap the content of containers. As for standard containers, their
+      allocators shall compare equal, unless they propagate on swap. */
+  void swap(interval_base_map& object) noexcept {
+    _map.swap(object._map);
+    std::swap(_measure, object._measure);
+  }
 
   //==========================================================================
   //= Containedness
@@ -213,12 +265,35 @@ public:
   //==========================================================================
   //= Size
   //==========================================================================
-  /** An interval map's size is it's cardinality */
-  size_type size() const { return icl::cardinality(*that()); }
+  /** An interval map's size is it's cardinality. Constant time, unless
+      the map keeps no running totals, see \c caches_measure. */
+  size_type size() const {
+    if constexpr (caches_measure)
+      return _measure.cardinality;
+    else
+      return icl::cardinality(*that());
+  }
+
+  /** The sum of the lengths of the intervals of the map */
+  difference_type length() const {
+    if constexpr (caches_measure)
+      return _measure.length;
+    else
+      return icl::length(*that());
+  }
 
   /** Size of the iteration over this container */
   [[nodiscard]] std::size_t iterative_size() const { return _map.size(); }
 
+  /** The number of changes of the segments on contiguous storage. Views
+      that keep positions in the map, as \c bound_index, compare it to find
+      out that they are stale. */
+  [[nodiscard]] std::size_t modifications() const
+    requires Storage::is_contiguous
+  {
+    return _map.modifications();
+  }
+
   //==========================================================================
   //= Selection
   //==========================================================================
@@ -236,9 +311,99 @@ public:
 
   /** Total select function. */
   codomain_type operator()(const domain_type& key_value) const {
-    const_iterator it_ = icl::find(*this, key_value);
-    return it_ == end() ? identity_element<codomain_type>::value()
-                        : (*it_).second;
+    return selected(icl::find(*this, key_value));
+  }
+
+  /** Batched find: Sets <tt>found[i]</tt> to the interval value pair that
+      contains <tt>points[i]</tt>, or to \c end(). The points are sorted
+      internally, so the segments are visited in one forward walk instead
+      of being searched for each point. */
+  void find(std::span<const domain_type> points,
+            std::span<const_iterator> found) const
+    requires Interval_Stabbing::stabbable<interval_base_map>
+  {
+    assert(found.size() >= points.size());
+    Interval_Stabbing::find(*this, points,
+                            [&](std::size_t index, const_iterator it_) {
+                              found[index] = it_;
+                            });
+  }
+
+  /** Batched find for ascending \c points. */
+  void find(sorted_points_t, std::span<const domain_type> points,
+            std::span<const_iterator> found) const
+    requires Interval_Stabbing::stabbable<interval_base_map>
+  {
+    assert(found.size() >= points.size());
+    Interval_Stabbing::find_sorted(*this, points,
+                                   [&](std::size_t index, const_iterator it_) {
+                                     found[index] = it_;
+                                   });
+  }
+
+  /** Batched total select: Sets <tt>values[i]</tt> to the value that
+      <tt>points[i]</tt> is mapped to, see the batched \c find. */
+  void select(std::span<const domain_type> points,
+              std::span<codomain_type> values) const
+    requires Interval_Stabbing::stabbable<interval_base_map>
+  {
+    assert(values.size() >= points.size());
+    Interval_Stabbing::find(*this, points,
+                            [&](std::size_t index, const_iterator it_) {
+                              values[index] = selected(it_);
+                            });
+  }
+
+  /** Batched total select for ascending \c points. */
+  void select(sorted_points_t, std::span<const domain_type> points,
+              std::span<codomain_type> values) const
+    requires Interval_Stabbing::stabbable<interval_base_map>
+  {
+    assert(values.size() >= points.size());
+    Interval_Stabbing::find_sorted(*this, points,
+                                   [&](std::size_t index, const_iterator it_) {
+                                     values[index] = selected(it_);
+                                   });
+  }
+
+  /** An immutable snapshot of the map, whose searches touch fewer cache
+      lines, see \c frozen in icl/frozen.hpp, that callers include. */
+  frozen<SubType> freeze() const { return frozen<SubType>(*that()); }
+
+  //==========================================================================
+  //= Aggregation
+  //==========================================================================
+
+  /** Aggregates the values of the segments that overlap \c inter_val, e.g.
+      <tt>aggregate(inter_val, aggregate_max)</tt>, see \c aggregate_sum,
+      \c aggregate_weighted_sum, \c aggregate_min and \c aggregate_max.
+      Segments are weighted by the length of their overlap with
+      \c inter_val. Logarithmic time, requires \c augmented_storage. */
+  template <typename Aggregation>
+    requires Storage::is_augmented
+  auto aggregate(const interval_type& inter_val,
+                 Aggregation aggregation) const {
+    std::optional<aggregate_type> result;
+    if (icl::is_empty(inter_val))
+      return aggregation(result);
+
+    const std::pair<const_iterator, const_iterator> exterior =
+        equal_range(inter_val);
+    if (exterior.first == exterior.second)
+      return aggregation(result);
+
+    // Only the first and the last segment can exceed inter_val
+    const_iterator first_ = exterior.first,
+                   last_ = std::prev(exterior.second);
+    result.emplace((*first_).first & inter_val, (*first_).second);
+    if (first_ != last_) {
+      if (std::optional<aggregate_type> inner =
+              _map.summarize(std::next(first_), last_))
+        result->append(*inner);
+      result->append(
+          aggregate_type((*last_).first & inter_val, (*last_).second));
+    }
+    return aggregation(result);
   }
 
   //==========================================================================
@@ -263,6 +428,22 @@ public:
     return this->_add<codomain_combine>(prior_, interval_value_pair);
   }
 
+  /** Addition of an interval value pair, that is moved from. The codomain
+      value is moved into the map, if \c interval_value_pair does not
+      collide with segments of the map, or into the gap behind the last
+      collision. */
+  SubType& add(segment_type&& interval_value_pair) {
+    this->_add<codomain_combine>(std::move(interval_value_pair));
+    return *that();
+  }
+
+  /** Addition of an interval value pair, that is moved from, with the hint
+      \c prior_. */
+  iterator add(iterator prior_, segment_type&& interval_value_pair) {
+    return this->_add<codomain_combine>(prior_,
+                                        std::move(interval_value_pair));
+  }
+
   //==========================================================================
   //= Subtraction
   //==========================================================================
@@ -298,6 +479,19 @@ public:
     return _insert(prior, interval_value_pair);
   }
 
+  /** Insertion of an \c interval_value_pair, that is moved from. The
+      codomain value is moved into the last gap, that is filled. */
+  SubType& insert(segment_type&& interval_value_pair) {
+    _insert(std::move(interval_value_pair));
+    return *that();
+  }
+
+  /** Insertion of an \c interval_value_pair, that is moved from, with the
+      hint \c prior. */
+  iterator insert(iterator prior, segment_type&& interval_value_pair) {
+    return _insert(prior, std::move(interval_value_pair));
+  }
+
   /** With <tt>key_value_pair = (k,v)</tt> set value \c v for key \c k */
   SubType& set(const element_type& key_value_pair) {
     return icl::set_at(*that(), key_value_pair);
@@ -309,6 +503,11 @@ public:
     return icl::set_at(*that(), interval_value_pair);
   }
 
+  /** Sets the value of \c interval_value_pair, that is moved into the map. */
+  SubType& set(segment_type&& interval_value_pair) {
+    return icl::set_at(*that(), std::move(interval_value_pair));
+  }
+
   //==========================================================================
   //= Erasure
   //==========================================================================
@@ -320,6 +519,168 @@ public:
 
   /** Erase an \c interval_value_pair from the map. */
   SubType& erase(const segment_type& interval_value_pair) {
+    measured(interval_value_pair.first,
+             [&] { _erase(interval_value_pair); });
+    return *that();
+  }
+
+  /** Erase a key value pair for \c key. */
+  SubType& erase(const domain_type& key) { return icl::erase(*that(), key); }
+
+  /** Erase all value pairs within the range of the
+      interval <tt>inter_val</tt> from the map.   */
+  SubType& erase(const interval_type& inter_val) {
+    measured(inter_val, [&] { _erase(inter_val); });
+    return *that();
+  }
+
+  /** Erase all value pairs within the range of the interval that iterator
+      \c position points to. Returns the iterator following the erased one. */
+  iterator erase(iterator position) {
+    return measured((*position).first,
+                    [&] { return this->_map.erase(position); });
+  }
+
+  /** Erase all value pairs for a range of iterators <tt>[first,past)</tt>.
+      Returns the iterator following the erased range. */
+  iterator erase(iterator first, iterator past) {
+    if (first == past)
+      return this->_map.erase(first, past);
+    return measured(hull((*first).first, (*std::prev(past)).first),
+                    [&] { return this->_map.erase(first, past); });
+  }
+
+  //==========================================================================
+  //= Intersection
+  //==========================================================================
+  /** The intersection of \c interval_value_pair and \c *this map is added to \c
+   * section. */
+  void add_intersection(SubType& section,
+                        const segment_type& interval_value_pair) const {
+    on_definedness<SubType, Traits::is_total>::add_intersection(
+        section, *that(), interval_value_pair);
+  }
+
+  //==========================================================================
+  //= Symmetric difference
+  //==========================================================================
+  /** If \c *this map contains \c key_value_pair it is erased, otherwise it is
+   * added. */
+  SubType& flip(const element_type& key_value_pair) {
+    return icl::flip(*that(), key_value_pair);
+  }
+
+  /** If \c *this map contains \c interval_value_pair it is erased, otherwise it
+   * is added. */
+  SubType& flip(const segment_type& interval_value_pair) {
+    if constexpr (Storage::is_contiguous && !Traits::is_total)
+      measured(interval_value_pair.first, [&] {
+        edit_window(interval_value_pair.first, [&](auto& window) {
+          window.flip(interval_value_pair);
+          return window.end();
+        });
+      });
+    else
+      on_total_absorbable<SubType, Traits::is_total,
+                          Traits::absorbs_identities>::flip(
+          *that(), interval_value_pair);
+    return *that();
+  }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+
+  iterator lower_bound(const key_type& interval) {
+    return _map.lower_bound(interval);
+  }
+
+  iterator upper_bound(const key_type& interval) {
+    return _map.upper_bound(interval);
+  }
+
+  const_iterator lower_bound(const key_type& interval) const {
+    return _map.lower_bound(interval);
+  }
+
+  const_iterator upper_bound(const key_type& interval) const {
+    return _map.upper_bound(interval);
+  }
+
+  std::pair<iterator, iterator> equal_range(const key_type& interval) {
+    return std::pair<iterator, iterator>(lower_bound(interval),
+                                         upper_bound(interval));
+  }
+
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type& interval) const {
+    return std::pair<const_iterator, const_iterator>(lower_bound(interval),
+                                                     upper_bound(interval));
+  }
+
+  iterator begin() { return _map.begin(); }
+  iterator end() { return _map.end(); }
+  const_iterator begin() const { return _map.begin(); }
+  const_iterator end() const { return _map.end(); }
+  reverse_iterator rbegin() { return _map.rbegin(); }
+  reverse_iterator rend() { return _map.rend(); }
+  const_reverse_iterator rbegin() const { return _map.rbegin(); }
+  const_reverse_iterator rend() const { return _map.rend(); }
+
+private:
+  // Segments are forwarded down to the first node or gap, that is created
+  // from them, so a segment that is an rvalue gives its codomain value away.
+  template <typename Combiner, typename Segment>
+  iterator _add(Segment&& interval_value_pair) {
+    return measured(interval_value_pair.first, [&] {
+      return _add_segment<Combiner>(
+          this->_map.end(), std::forward<Segment>(interval_value_pair));
+    });
+  }
+
+  template <typename Combiner, typename Segment>
+  iterator _add(iterator prior_, Segment&& interval_value_pair) {
+    return measured(interval_value_pair.first, [&] {
+      return _add_segment<Combiner>(
+          prior_, std::forward<Segment>(interval_value_pair));
+    });
+  }
+
+  template <typename Combiner>
+  void _subtract(const segment_type& interval_value_pair) {
+    measured(interval_value_pair.first, [&] {
+      _subtract_segment<Combiner>(interval_value_pair);
+    });
+  }
+
+  template <typename Segment> iterator _insert(Segment&& interval_value_pair) {
+    return measured(interval_value_pair.first, [&] {
+      return _insert_segment(this->_map.end(),
+                             std::forward<Segment>(interval_value_pair));
+    });
+  }
+
+  template <typename Segment>
+  iterator _insert(iterator prior_, Segment&& interval_value_pair) {
+    return measured(interval_value_pair.first, [&] {
+      return _insert_segment(prior_,
+                             std::forward<Segment>(interval_value_pair));
+    });
+  }
+
+  SubType& _erase(const segment_type& interval_value_pair)
+    requires Storage::is_contiguous
+  {
+    edit_window(interval_value_pair.first, [&](auto& window) {
+      window.erase(interval_value_pair);
+      return window.end();
+    });
+    return *that();
+  }
+
+  SubType& _erase(const segment_type& interval_value_pair)
+    requires(!Storage::is_contiguous)
+  {
     interval_type inter_val = interval_value_pair.first;
     if (icl::is_empty(inter_val))
       return *that();
@@ -371,12 +732,19 @@ public:
     return *that();
   }
 
-  /** Erase a key value pair for \c key. */
-  SubType& erase(const domain_type& key) { return icl::erase(*that(), key); }
+  SubType& _erase(const interval_type& inter_val)
+    requires Storage::is_contiguous
+  {
+    edit_window(inter_val, [&](auto& window) {
+      window.erase(inter_val);
+      return window.end();
+    });
+    return *that();
+  }
 
-  /** Erase all value pairs within the range of the
-      interval <tt>inter_val</tt> from the map.   */
-  SubType& erase(const interval_type& inter_val) {
+  SubType& _erase(const interval_type& inter_val)
+    requires(!Storage::is_contiguous)
+  {
     if (icl::is_empty(inter_val))
       return *that();
 
@@ -419,116 +787,35 @@ public:
     return *that();
   }
 
-  /** Erase all value pairs within the range of the interval that iterator
-      \c position points to. */
-  void erase(iterator position) { this->_map.erase(position); }
-
-  /** Erase all value pairs for a range of iterators <tt>[first,past)</tt>. */
-  void erase(iterator first, iterator past) { this->_map.erase(first, past); }
-
-  //==========================================================================
-  //= Intersection
-  //==========================================================================
-  /** The intersection of \c interval_value_pair and \c *this map is added to \c
-   * section. */
-  void add_intersection(SubType& section,
-                        const segment_type& interval_value_pair) const {
-    on_definedness<SubType, Traits::is_total>::add_intersection(
-        section, *that(), interval_value_pair);
-  }
-
-  //==========================================================================
-  //= Symmetric difference
-  //==========================================================================
-  /** If \c *this map contains \c key_value_pair it is erased, otherwise it is
-   * added. */
-  SubType& flip(const element_type& key_value_pair) {
-    return icl::flip(*that(), key_value_pair);
-  }
-
-  /** If \c *this map contains \c interval_value_pair it is erased, otherwise it
-   * is added. */
-  SubType& flip(const segment_type& interval_value_pair) {
-    on_total_absorbable<SubType, Traits::is_total,
-                        Traits::absorbs_identities>::flip(*that(),
-                                                          interval_value_pair);
-    return *that();
-  }
-
-  //==========================================================================
-  //= Iterator related
-  //==========================================================================
-
-  iterator lower_bound(const key_type& interval) {
-    return _map.lower_bound(interval);
-  }
-
-  iterator upper_bound(const key_type& interval) {
-    return _map.upper_bound(interval);
-  }
-
-  const_iterator lower_bound(const key_type& interval) const {
-    return _map.lower_bound(interval);
-  }
-
-  const_iterator upper_bound(const key_type& interval) const {
-    return _map.upper_bound(interval);
-  }
-
-  std::pair<iterator, iterator> equal_range(const key_type& interval) {
-    return std::pair<iterator, iterator>(lower_bound(interval),
-                                         upper_bound(interval));
-  }
-
-  std::pair<const_iterator, const_iterator>
-  equal_range(const key_type& interval) const {
-    return std::pair<const_iterator, const_iterator>(lower_bound(interval),
-                                                     upper_bound(interval));
+  template <typename Combiner, typename Segment>
+    requires Storage::is_contiguous
+  iterator _add_segment(iterator, Segment&& interval_value_pair) {
+    return edit_window(interval_value_pair.first, [&](auto& window) {
+      return window.template _add<Combiner>(
+          std::forward<Segment>(interval_value_pair));
+    });
   }
 
-  iterator begin() { return _map.begin(); }
-  iterator end() { return _map.end(); }
-  const_iterator begin() const { return _map.begin(); }
-  const_iterator end() const { return _map.end(); }
-  reverse_iterator rbegin() { return _map.rbegin(); }
-  reverse_iterator rend() { return _map.rend(); }
-  const_reverse_iterator rbegin() const { return _map.rbegin(); }
-  const_reverse_iterator rend() const { return _map.rend(); }
-
-private:
   template <typename Combiner>
-  iterator _add(const segment_type& interval_value_pair) {
-    using on_absorbtion_ =
-        on_absorbtion<type, Combiner, absorbs_identities<type>::value>::type;
-
-    const interval_type& inter_val = interval_value_pair.first;
-    if (icl::is_empty(inter_val))
-      return this->_map.end();
-
-    const codomain_type& co_val = interval_value_pair.second;
-    if (on_absorbtion_::is_absorbable(co_val))
-      return this->_map.end();
-
-    std::pair<iterator, bool> insertion =
-        this->_map.insert(value_type(inter_val, version<Combiner>()(co_val)));
-
-    if (insertion.second)
-      return that()->handle_inserted(insertion.first);
-    // Detect the first and the end iterator of the collision sequence
-    iterator first_ = this->_map.lower_bound(inter_val),
-             last_ = prior(this->_map.upper_bound(inter_val));
-    // assert(end_ == this->_map.upper_bound(inter_val));
-    iterator it_ = first_;
-    interval_type rest_interval = inter_val;
+    requires Storage::is_contiguous
+  void _subtract_segment(const segment_type& interval_value_pair) {
+    edit_window(interval_value_pair.first, [&](auto& window) {
+      window.template _subtract<Combiner>(interval_value_pair);
+      return window.end();
+    });
+  }
 
-    add_front(rest_interval, it_);
-    add_main<Combiner>(rest_interval, co_val, it_, last_);
-    add_rear<Combiner>(rest_interval, co_val, it_);
-    return it_;
+  template <typename Segment>
+    requires Storage::is_contiguous
+  iterator _insert_segment(iterator, Segment&& interval_value_pair) {
+    return edit_window(interval_value_pair.first, [&](auto& window) {
+      return window._insert(std::forward<Segment>(interval_value_pair));
+    });
   }
 
-  template <typename Combiner>
-  iterator _add(iterator prior_, const segment_type& interval_value_pair) {
+  template <typename Combiner, typename Segment>
+    requires(!Storage::is_contiguous)
+  iterator _add_segment(iterator prior_, Segment&& interval_value_pair) {
     using on_absorbtion_ =
         on_absorbtion<type, Combiner, absorbs_identities<type>::value>::type;
 
@@ -540,24 +827,24 @@ private:
     if (on_absorbtion_::is_absorbable(co_val))
       return prior_;
 
-    std::pair<iterator, bool> insertion =
-        add_at<Combiner>(prior_, inter_val, co_val);
-
-    if (insertion.second)
-      return that()->handle_inserted(insertion.first);
-    // Detect the first and the end iterator of the collision sequence
-    std::pair<iterator, iterator> overlap = equal_range(inter_val);
-    iterator it_ = overlap.first, last_ = prior(overlap.second);
+    iterator it_ = hinted_lower_bound(prior_, inter_val);
+    if (!overlaps(it_, inter_val))
+      return that()->handle_inserted(this->template gap_insert<Combiner>(
+          it_, inter_val, std::forward<Segment>(interval_value_pair).second));
+    // Detect the end iterator of the collision sequence
+    iterator last_ = prior(this->_map.upper_bound(inter_val));
     interval_type rest_interval = inter_val;
 
     add_front(rest_interval, it_);
     add_main<Combiner>(rest_interval, co_val, it_, last_);
-    add_rear<Combiner>(rest_interval, co_val, it_);
+    add_rear<Combiner>(rest_interval,
+                       std::forward<Segment>(interval_value_pair).second, it_);
     return it_;
   }
 
   template <typename Combiner>
-  void _subtract(const segment_type& interval_value_pair) {
+    requires(!Storage::is_contiguous)
+  void _subtract_segment(const segment_type& interval_value_pair) {
     interval_type inter_val = interval_value_pair.first;
     if (icl::is_empty(inter_val))
       return;
@@ -578,49 +865,49 @@ private:
     subtract_rear<Combiner>(inter_val, co_val, it_);
   }
 
-  iterator _insert(const segment_type& interval_value_pair) {
+  template <typename Segment>
+    requires(!Storage::is_contiguous)
+  iterator _insert_segment(iterator prior_, Segment&& interval_value_pair) {
     interval_type inter_val = interval_value_pair.first;
     if (icl::is_empty(inter_val))
-      return this->_map.end();
+      return prior_;
 
     const codomain_type& co_val = interval_value_pair.second;
     if (on_codomain_absorbtion::is_absorbable(co_val))
-      return this->_map.end();
+      return prior_;
 
-    std::pair<iterator, bool> insertion =
-        this->_map.insert(interval_value_pair);
-
-    if (insertion.second)
-      return that()->handle_inserted(insertion.first);
-    // Detect the first and the end iterator of the collision sequence
-    iterator first_ = this->_map.lower_bound(inter_val),
-             last_ = prior(this->_map.upper_bound(inter_val));
-    // assert((++last_) == this->_map.upper_bound(inter_val));
-    iterator it_ = first_;
-    insert_main(inter_val, co_val, it_, last_);
+    iterator it_ = hinted_lower_bound(prior_, inter_val);
+    if (!overlaps(it_, inter_val))
+      return that()->handle_inserted(this->_map.insert(
+          it_, value_type(inter_val,
+                          std::forward<Segment>(interval_value_pair).second)));
+    // Detect the end iterator of the collision sequence
+    iterator last_ = prior(this->_map.upper_bound(inter_val));
+    insert_main(inter_val, std::forward<Segment>(interval_value_pair).second,
+                it_, last_);
     return it_;
   }
 
-  iterator _insert(iterator prior_, const segment_type& interval_value_pair) {
-    interval_type inter_val = interval_value_pair.first;
-    if (icl::is_empty(inter_val))
+  /** The first segment, that is not less than \c inter_val. The hint
+      \c prior_ and its successor are tried before the map is searched. */
+  iterator hinted_lower_bound(iterator prior_, const interval_type& inter_val) {
+    const auto is_lower_bound = [&](iterator it_) {
+      return (it_ == this->_map.end() ||
+              !this->_map.key_comp()((*it_).first, inter_val)) &&
+             (it_ == this->_map.begin() ||
+              this->_map.key_comp()((*std::prev(it_)).first, inter_val));
+    };
+    if (is_lower_bound(prior_))
       return prior_;
+    if (prior_ != this->_map.end() && is_lower_bound(std::next(prior_)))
+      return std::next(prior_);
+    return this->_map.lower_bound(inter_val);
+  }
 
-    const codomain_type& co_val = interval_value_pair.second;
-    if (on_codomain_absorbtion::is_absorbable(co_val))
-      return prior_;
-
-    std::pair<iterator, bool> insertion = insert_at(prior_, inter_val, co_val);
-
-    if (insertion.second)
-      return that()->handle_inserted(insertion.first);
-    {
-      // Detect the first and the end iterator of the collision sequence
-      std::pair<iterator, iterator> overlap = equal_range(inter_val);
-      iterator it_ = overlap.first, last_ = prior(overlap.second);
-      insert_main(inter_val, co_val, it_, last_);
-      return it_;
-    }
+  /// Does the lower bound \c it_ of \c inter_val overlap it?
+  bool overlaps(iterator it_, const interval_type& inter_val) const {
+    return it_ != this->_map.end() &&
+           !this->_map.key_comp()(inter_val, (*it_).first);
   }
 
 private:
@@ -654,8 +941,8 @@ private:
     }
   }
 
-  template <typename Combiner>
-  void add_rear(const interval_type& inter_val, const CodomainT& co_val,
+  template <typename Combiner, typename CoValT>
+  void add_rear(const interval_type& inter_val, CoValT&& co_val,
                 iterator& it_) {
     iterator prior_ = cyclic_prior(*that(), it_);
     interval_type cur_itv = (*it_).first;
@@ -673,7 +960,9 @@ private:
       // [----------------end_gap)
       //  . . . -- it_ --)
       Combiner()((*it_).second, co_val);
-      that()->template gap_insert_at<Combiner>(it_, prior_, end_gap, co_val);
+      // The end gap is the last use of the value, so it can take it
+      that()->template gap_insert_at<Combiner>(it_, prior_, end_gap,
+                                               std::forward<CoValT>(co_val));
     } else {
       // only for the last there can be a right_resid: a part of *it_ right of x
       interval_type right_resid = left_subtract(cur_itv, inter_val);
@@ -769,7 +1058,8 @@ private:
   }
 
 private:
-  void insert_main(const interval_type& inter_val, const CodomainT& co_val,
+  template <typename CoValT>
+  void insert_main(const interval_type& inter_val, CoValT&& co_val,
                    iterator& it_, const iterator& last_) {
     iterator end_ = std::next(last_);
     iterator prior_ = cyclic_prior(*this, it_), inserted_;
@@ -781,7 +1071,13 @@ private:
       left_gap = right_subtract(rest_interval, cur_itv);
 
       if (!icl::is_empty(left_gap)) {
-        inserted_ = this->_map.insert(prior_, value_type(left_gap, co_val));
+        if (it_ == last_ &&
+            icl::is_empty(left_subtract(rest_interval, cur_itv)))
+          // The last gap takes the value
+          inserted_ = this->_map.insert(
+              prior_, value_type(left_gap, std::forward<CoValT>(co_val)));
+        else
+          inserted_ = this->_map.insert(prior_, value_type(left_gap, co_val));
         it_ = that()->handle_inserted(inserted_);
       }
 
@@ -794,7 +1090,8 @@ private:
     // insert_rear(rest_interval, co_val, last_):
     if (interval_type end_gap = left_subtract(rest_interval, last_interval);
         !icl::is_empty(end_gap)) {
-      inserted_ = this->_map.insert(prior_, value_type(end_gap, co_val));
+      inserted_ = this->_map.insert(
+          prior_, value_type(end_gap, std::forward<CoValT>(co_val)));
       it_ = that()->handle_inserted(inserted_);
     } else
       it_ = prior_;
@@ -853,48 +1150,121 @@ private:
   }
 
 protected:
-  template <typename Combiner>
+  template <typename Combiner, typename CoValT>
   iterator gap_insert(iterator prior_, const interval_type& inter_val,
-                      const codomain_type& co_val) {
+                      CoValT&& co_val) {
     // inter_val is not conained in this map. Insertion will be successful
     assert(!this->_map.contains(inter_val));
     assert((!on_absorbtion<type, Combiner,
                            Traits::absorbs_identities>::is_absorbable(co_val)));
     return this->_map.insert(
-        prior_, value_type(inter_val, version<Combiner>()(co_val)));
+        prior_, value_type(inter_val, version<Combiner>()(
+                                          std::forward<CoValT>(co_val))));
   }
 
-  template <typename Combiner>
-  std::pair<iterator, bool> add_at(const iterator& prior_,
-                                   const interval_type& inter_val,
-                                   const codomain_type& co_val) {
-    // Never try to insert an identity element into an identity element absorber
-    // here:
-    assert((!on_absorbtion<type, Combiner,
-                           Traits::absorbs_identities>::is_absorbable(co_val)));
+  /** Updates on contiguous storage are staged on a node based \e window.
+      The window holds the segments overlapping \c span and one neighbour on
+      either side, so joins across its borders are found. The function
+      \c edit runs the regular tree algorithms on the window, the result
+      replaces the window range in one step. Returns the position of the
+      segment that \c edit points to, or \c end(). */
+  template <typename Edit>
+  iterator edit_window(const interval_type& span, Edit edit) {
+    using window_type =
+        SubType::template rebind_storage<uncached<tree_storage>>;
+
+    if (icl::is_empty(span))
+      return this->_map.end();
 
-    iterator inserted_ = this->_map.insert(
-        prior_, value_type(inter_val, Combiner::identity_element()));
+    iterator first_ = this->_map.end();
+    iterator past_ = this->_map.end();
+    if (this->_map.empty() ||
+        this->_map.key_comp()((*std::prev(past_)).first, span)) {
+      // Appending behind the last segment needs no search
+      if (first_ != this->_map.begin())
+        --first_;
+    } else {
+      first_ = this->_map.lower_bound(span);
+      past_ = this->_map.upper_bound(span);
+      if (first_ != this->_map.begin())
+        --first_;
+      if (past_ != this->_map.end())
+        ++past_;
+    }
 
-    if ((*inserted_).first == inter_val &&
-        (*inserted_).second == Combiner::identity_element()) {
-      Combiner()((*inserted_).second, co_val);
-      return std::pair<iterator, bool>(inserted_, true);
+    window_type window(this->get_allocator());
+    for (iterator it_ = first_; it_ != past_; ++it_)
+      window._map.emplace_hint(window._map.end(), (*it_).first,
+                               std::move((*it_).second));
+
+    auto splice = [&] {
+      return this->_map.replace(first_, past_,
+                                std::make_move_iterator(window._map.begin()),
+                                std::make_move_iterator(window._map.end()));
+    };
+    typename window_type::iterator edited_;
+    try {
+      edited_ = edit(window);
+    } catch (...) {
+      // The values were moved into the window. If the edit fails, the
+      // window is left valid as a tree map would be, and takes the place
+      // of the range again. Should that fail too, the range is dropped, so
+      // that no moved from values are left in the map.
+      try {
+        splice();
+      } catch (...) {
+        this->_map.erase(first_, past_);
+      }
+      throw;
     }
-    return std::pair<iterator, bool>(inserted_, false);
+    const bool at_end = edited_ == window.end();
+    const auto offset = std::distance(window.begin(), edited_);
+
+    iterator spliced_ = splice();
+    return at_end ? this->_map.end() : std::next(spliced_, offset);
   }
 
-  std::pair<iterator, bool> insert_at(const iterator& prior_,
-                                      const interval_type& inter_val,
-                                      const codomain_type& co_val) {
-    iterator inserted_ =
-        this->_map.insert(prior_, value_type(inter_val, co_val));
+  /** Runs \c update, that changes the segments of the map within \c span
+      only, and keeps the running totals and the aggregates of augmented
+      storage up to date. */
+  template <typename Update>
+  decltype(auto) measured(const interval_type& span, Update update) {
+    detail::summary_scope<ImplMapT> summaries(_map, span);
+    if constexpr (caches_measure) {
+      if (_measure.depth == 0) {
+        detail::measure_scope<interval_base_map> scope(*this, span);
+        return update();
+      }
+    }
+    return update();
+  }
+
+  /// The value of the segment \c it_, or the identity element for \c end()
+  codomain_type selected(const_iterator it_) const {
+    return it_ == end() ? identity_element<codomain_type>::value()
+                        : (*it_).second;
+  }
 
-    if (inserted_ == prior_)
-      return std::pair<iterator, bool>(inserted_, false);
-    if ((*inserted_).first == inter_val)
-      return std::pair<iterator, bool>(inserted_, true);
-    return std::pair<iterator, bool>(inserted_, false);
+  /// The measure of the part of the map within \c span
+  measure_type covered(const interval_type& span) const {
+    measure_type measure;
+    if (icl::is_empty(span) || _map.empty() ||
+        _map.key_comp()((*std::prev(_map.end())).first, span))
+      return measure; // Nothing to search behind the last segment
+
+    for (const_iterator it_ = _map.lower_bound(span);
+         it_ != _map.end() && icl::intersects((*it_).first, span); ++it_)
+      measure.add((*it_).first & span);
+    return measure;
+  }
+
+  /// Counts the running totals anew
+  void recount() {
+    if constexpr (caches_measure) {
+      _measure = {};
+      for (const_iterator it_ = _map.begin(); it_ != _map.end(); ++it_)
+        _measure.add((*it_).first);
+    }
   }
 
   sub_type* that() { return static_cast<sub_type*>(this); }
@@ -902,6 +1272,24 @@ protected:
 
   ImplMapT _map;
 
+  [[no_unique_address]] std::conditional_t<
+      caches_measure, detail::measure_cache<size_type, difference_type>,
+      detail::no_measure_cache> _measure;
+
+private:
+  // Maps of other storage policies act as update windows for each other
+  template <typename SubT, typename DomT, typename CodomT, typename TraitsT,
+            template <typename> typename CompareT,
+            template <typename> typename CombineT,
+            template <typename> typename SectionT, typename IntervalT,
+            template <typename> typename AllocT, typename StorageT>
+    requires std::default_initializable<DomT> && std::totally_ordered<DomT> &&
+             std::default_initializable<CodomT> &&
+             std::equality_comparable<CodomT>
+  friend class interval_base_map;
+
+  friend class detail::measure_scope<interval_base_map>;
+
 private:
   //--------------------------------------------------------------------------
   template <typename Type, bool is_total_invertible> struct on_invertible;
@@ -998,16 +1386,10 @@ private:
 
   template <typename Type> struct on_total_absorbable<Type, true, false> {
     using segment_type = Type::segment_type;
-    using codomain_type = Type::codomain_type;
 
     static void flip(Type& object, const segment_type& operand) {
       object += operand;
-      for (typename Type::iterator it_ = object.begin(); it_ != object.end();
-           ++it_)
-        (*it_).second = identity_element<codomain_type>::value();
-
-      if constexpr (!is_interval_splitter<Type>::value)
-        icl::join(object);
+      Interval_Map::reset_values(object);
     }
   };
 
@@ -1036,8 +1418,9 @@ private:
       const codomain_type& x_value = interval_value_pair.second;
       const_iterator it_ = first_;
 
-      set_type eraser;
-      Type intersection;
+      set_type eraser(
+          typename set_type::allocator_type(object.get_allocator()));
+      Type intersection = icl::empty_like(object);
 
       while (it_ != end_) {
         const codomain_type& co_value = (*it_).second;
@@ -1087,9 +1470,9 @@ template <typename SubType, typename DomainT, typename CodomainT,
           typename Traits, template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_map<interval_base_map<SubType, DomainT, CodomainT, Traits, Compare,
-                                Combine, Section, Interval, Alloc>> {
+                                Combine, Section, Interval, Alloc, Storage>> {
   using type = is_map;
   static constexpr bool value = true;
 };
@@ -1098,10 +1481,10 @@ template <typename SubType, typename DomainT, typename CodomainT,
           typename Traits, template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct has_inverse<
     interval_base_map<SubType, DomainT, CodomainT, Traits, Compare, Combine,
-                      Section, Interval, Alloc>> {
+                      Section, Interval, Alloc, Storage>> {
   using type = has_inverse;
   static constexpr bool value = has_inverse<CodomainT>::value;
 };
@@ -1110,10 +1493,10 @@ template <typename SubType, typename DomainT, typename CodomainT,
           typename Traits, template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_interval_container<
     interval_base_map<SubType, DomainT, CodomainT, Traits, Compare, Combine,
-                      Section, Interval, Alloc>> {
+                      Section, Interval, Alloc, Storage>> {
   using type = is_interval_container;
   static constexpr bool value = true;
 };
@@ -1122,10 +1505,10 @@ template <typename SubType, typename DomainT, typename CodomainT,
           typename Traits, template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct absorbs_identities<
     interval_base_map<SubType, DomainT, CodomainT, Traits, Compare, Combine,
-                      Section, Interval, Alloc>> {
+                      Section, Interval, Alloc, Storage>> {
   using type = absorbs_identities;
   static constexpr bool value = Traits::absorbs_identities;
 };
@@ -1134,9 +1517,9 @@ template <typename SubType, typename DomainT, typename CodomainT,
           typename Traits, template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_total<interval_base_map<SubType, DomainT, CodomainT, Traits, Compare,
-                                  Combine, Section, Interval, Alloc>> {
+                                  Combine, Section, Interval, Alloc, Storage>> {
   using type = is_total;
   static constexpr bool value = Traits::is_total;
 };
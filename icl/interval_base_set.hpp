@@ -7,16 +7,30 @@
 #include "icl/concept/interval_set.hpp"
 #include "icl/detail/element_iterator.hpp"
 #include "icl/detail/exclusive_less_than.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/detail/segment_measure.hpp"
+#include "icl/storage_policy.hpp"
 #include "icl/type_traits/interval_type_default.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include <cassert>
+#include <iterator>
 #include <set>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 namespace icl {
 
+template <typename Type>
+  requires is_interval_container<Type>::value
+class frozen;
+
 /** \brief Implements a set as a set of intervals (base class) */
 template <typename SubType, typename DomainT,
           template <typename> typename Compare = std::less,
           typename Interval = interval_type_default<DomainT, Compare>::type,
-          template <typename> typename Alloc = std::allocator>
+          template <typename> typename Alloc = std::allocator,
+          typename Storage = tree_storage>
   requires std::default_initializable<DomainT> && std::totally_ordered<DomainT>
 class interval_base_set {
 public:
@@ -85,8 +99,12 @@ public:
   /// allocator type of the corresponding element set
   using domain_allocator_type = Alloc<DomainT>;
 
+  /// The storage policy of the set
+  using storage_type = Storage;
+
   /// Container type for the implementation
-  using ImplSetT = std::set<interval_type, key_compare, allocator_type>;
+  using ImplSetT =
+      Storage::template set_type<interval_type, key_compare, allocator_type>;
 
   /// key type of the implementing container
   using key_type = ImplSetT::key_type;
@@ -125,6 +143,13 @@ public:
 
   static constexpr int fineness = 0;
 
+  /// Whether cardinality and length are kept as running totals
+  static constexpr bool caches_measure =
+      Storage::caches_measure && is_discrete<DomainT>::value;
+
+  /// Cardinality and length of a part of the set
+  using measure_type = detail::segment_measure<size_type, difference_type>;
+
   //==========================================================================
   //= Construct, copy, destruct
   //==========================================================================
@@ -132,7 +157,15 @@ public:
   interval_base_set() = default;
 
   /** Copy constructor */
-  interval_base_set(const interval_base_set& src) : _set(src._set) {}
+  interval_base_set(const interval_base_set& src)
+      : _set(src._set), _measure(src._measure) {}
+
+  /** Constructor for the empty object that allocates from \c alloc */
+  explicit interval_base_set(const allocator_type& alloc) : _set(alloc) {}
+
+  /** Copy constructor that allocates from \c alloc */
+  interval_base_set(const interval_base_set& src, const allocator_type& alloc)
+      : _set(src._set, alloc), _measure(src._measure) {}
 
   //==========================================================================
   //= Move semantics
@@ -140,19 +173,35 @@ public:
 
   /** Move constructor */
   interval_base_set(interval_base_set&& src) noexcept
-      : _set(std::move(src._set)) {}
+      : _set(std::move(src._set)), _measure(std::exchange(src._measure, {})) {}
+
+  /** Move constructor that allocates from \c alloc. If it differs from the
+      allocator of \c src, the segments are moved one by one. */
+  interval_base_set(interval_base_set&& src, const allocator_type& alloc)
+      : _set(std::move(src._set), alloc),
+        _measure(std::exchange(src._measure, {})) {
+    src._set.clear();
+  }
 
   /** Move assignment operator */
   interval_base_set& operator=(
       interval_base_set src) { // call by value since 'src' is a "sink value"
     this->_set = std::move(src._set);
+    this->_measure = src._measure;
     return *this;
   }
 
   //==========================================================================
 
-  /** swap the content of containers */
-  void swap(interval_base_set& operand) noexcept { _set.swap(operand._set); }
+  /** The allocator of the container */
+  allocator_type get_allocator() const { return _set.get_allocator(); }
+
+  /** swap the content of containers. As for standard containers, their
+      allocators shall compare equal, unless they propagate on swap. */
+  void swap(interval_base_set& operand) noexcept {
+    _set.swap(operand._set);
+    std::swap(_measure, operand._measure);
+  }
 
   //==========================================================================
   //= Containedness
@@ -165,12 +214,35 @@ public:
   //==========================================================================
   //= Size
   //==========================================================================
-  /** An interval set's size is it's cardinality */
-  size_type size() const { return icl::cardinality(*that()); }
+  /** An interval set's size is it's cardinality. Constant time, unless
+      the set keeps no running totals, see \c caches_measure. */
+  size_type size() const {
+    if constexpr (caches_measure)
+      return _measure.cardinality;
+    else
+      return icl::cardinality(*that());
+  }
+
+  /** The sum of the lengths of the intervals of the set */
+  difference_type length() const {
+    if constexpr (caches_measure)
+      return _measure.length;
+    else
+      return icl::length(*that());
+  }
 
   /** Size of the iteration over this container */
   [[nodiscard]] std::size_t iterative_size() const { return _set.size(); }
 
+  /** The number of changes of the segments on contiguous storage. Views
+      that keep positions in the set, as \c bound_index, compare it to find
+      out that they are stale. */
+  [[nodiscard]] std::size_t modifications() const
+    requires Storage::is_contiguous
+  {
+    return _set.modifications();
+  }
+
   //==========================================================================
   //= Selection
   //==========================================================================
@@ -185,6 +257,37 @@ public:
     return this->_set.find(key_interval);
   }
 
+  /** Batched find: Sets <tt>found[i]</tt> to the interval that contains
+      <tt>points[i]</tt>, or to \c end(). The points are sorted internally,
+      so the intervals are visited in one forward walk instead of being
+      searched for each point. */
+  void find(std::span<const element_type> points,
+            std::span<const_iterator> found) const
+    requires Interval_Stabbing::stabbable<interval_base_set>
+  {
+    assert(found.size() >= points.size());
+    Interval_Stabbing::find(*this, points,
+                            [&](std::size_t index, const_iterator it_) {
+                              found[index] = it_;
+                            });
+  }
+
+  /** Batched find for ascending \c points. */
+  void find(sorted_points_t, std::span<const element_type> points,
+            std::span<const_iterator> found) const
+    requires Interval_Stabbing::stabbable<interval_base_set>
+  {
+    assert(found.size() >= points.size());
+    Interval_Stabbing::find_sorted(*this, points,
+                                   [&](std::size_t index, const_iterator it_) {
+                                     found[index] = it_;
+                                   });
+  }
+
+  /** An immutable snapshot of the set, whose searches touch fewer cache
+      lines, see \c frozen in icl/frozen.hpp, that callers include. */
+  frozen<SubType> freeze() const { return frozen<SubType>(*that()); }
+
   //==========================================================================
   //= Addition
   //==========================================================================
@@ -216,30 +319,7 @@ public:
 
   /** Subtract an interval of elements \c inter_val from the set */
   SubType& subtract(const segment_type& inter_val) {
-    if (icl::is_empty(inter_val))
-      return *that();
-
-    std::pair<iterator, iterator> exterior = equal_range(inter_val);
-    if (exterior.first == exterior.second)
-      return *that();
-
-    iterator first_ = exterior.first;
-    iterator end_ = exterior.second;
-    iterator last_ = prior(end_);
-
-    interval_type left_resid = right_subtract(*first_, inter_val);
-    interval_type right_resid;
-    if (first_ != end_)
-      right_resid = left_subtract(*last_, inter_val);
-
-    this->_set.erase(first_, end_);
-
-    if (!icl::is_empty(left_resid))
-      this->_set.insert(left_resid);
-
-    if (!icl::is_empty(right_resid))
-      this->_set.insert(right_resid);
-
+    measured(inter_val, [&] { _subtract(inter_val); });
     return *that();
   }
 
@@ -268,11 +348,20 @@ public:
   /** Erase an interval of elements \c inter_val from the set */
   SubType& erase(const segment_type& inter_val) { return subtract(inter_val); }
 
-  /** Erase the interval that iterator \c position points to. */
-  void erase(iterator position) { _set.erase(position); }
+  /** Erase the interval that iterator \c position points to. Returns the
+      iterator following the erased one. */
+  iterator erase(iterator position) {
+    return measured(*position, [&] { return _set.erase(position); });
+  }
 
-  /** Erase all intervals in the range <tt>[first,past)</tt> of iterators. */
-  void erase(iterator first, iterator past) { _set.erase(first, past); }
+  /** Erase all intervals in the range <tt>[first,past)</tt> of iterators.
+      Returns the iterator following the erased range. */
+  iterator erase(iterator first, iterator past) {
+    if (first == past)
+      return _set.erase(first, past);
+    return measured(hull(*first, *std::prev(past)),
+                    [&] { return _set.erase(first, past); });
+  }
 
   //==========================================================================
   //= Symmetric difference
@@ -283,7 +372,9 @@ public:
   /** If \c *this set contains \c inter_val it is erased, otherwise it is added.
    */
   SubType& flip(const segment_type& inter_val) {
-    return icl::flip(*that(), inter_val);
+    return measured(inter_val, [&]() -> SubType& {
+      return icl::flip(*that(), inter_val);
+    });
   }
 
   //==========================================================================
@@ -328,7 +419,56 @@ public:
 
 private:
   iterator _add(const segment_type& addend) {
-    using iterator = iterator;
+    return measured(addend, [&] { return _add_segment(addend); });
+  }
+
+  iterator _add(iterator prior_, const segment_type& addend) {
+    return measured(addend, [&] { return _add_segment(prior_, addend); });
+  }
+
+  void _subtract(const segment_type& inter_val) {
+    if (icl::is_empty(inter_val))
+      return;
+
+    std::pair<iterator, iterator> exterior = equal_range(inter_val);
+    if (exterior.first == exterior.second)
+      return;
+
+    iterator first_ = exterior.first;
+    iterator end_ = exterior.second;
+    iterator last_ = prior(end_);
+
+    interval_type left_resid = right_subtract(*first_, inter_val);
+    interval_type right_resid;
+    if (first_ != end_)
+      right_resid = left_subtract(*last_, inter_val);
+
+    this->_set.erase(first_, end_);
+
+    if (!icl::is_empty(left_resid))
+      this->_set.insert(left_resid);
+
+    if (!icl::is_empty(right_resid))
+      this->_set.insert(right_resid);
+  }
+
+  iterator _add_segment(const segment_type& addend)
+    requires Storage::is_contiguous
+  {
+    return edit_window(addend, [&](auto& window) {
+      return window._add(addend);
+    });
+  }
+
+  iterator _add_segment(iterator, const segment_type& addend)
+    requires Storage::is_contiguous
+  {
+    return _add_segment(addend);
+  }
+
+  iterator _add_segment(const segment_type& addend)
+    requires(!Storage::is_contiguous)
+  {
     if (icl::is_empty(addend))
       return this->_set.end();
 
@@ -340,7 +480,9 @@ private:
     return that()->add_over(addend, last_);
   }
 
-  iterator _add(iterator prior_, const segment_type& addend) {
+  iterator _add_segment(iterator prior_, const segment_type& addend)
+    requires(!Storage::is_contiguous)
+  {
     if (icl::is_empty(addend))
       return prior_;
 
@@ -428,10 +570,100 @@ protected:
     }
   }
 
+  /** Updates on contiguous storage are staged on a node based \e window.
+      The window holds the intervals overlapping \c span and one neighbour on
+      either side, so joins across its borders are found. The function
+      \c edit runs the regular tree algorithms on the window, the result
+      replaces the window range in one step. Returns the position of the
+      interval that \c edit points to, or \c end(). */
+  template <typename Edit>
+  iterator edit_window(const interval_type& span, Edit edit) {
+    using window_type =
+        SubType::template rebind_storage<uncached<tree_storage>>;
+
+    if (icl::is_empty(span))
+      return this->_set.end();
+
+    iterator first_ = this->_set.end();
+    iterator past_ = this->_set.end();
+    if (this->_set.empty() || this->_set.key_comp()(*std::prev(past_), span)) {
+      // Appending behind the last interval needs no search
+      if (first_ != this->_set.begin())
+        --first_;
+    } else {
+      first_ = this->_set.lower_bound(span);
+      past_ = this->_set.upper_bound(span);
+      if (first_ != this->_set.begin())
+        --first_;
+      if (past_ != this->_set.end())
+        ++past_;
+    }
+
+    window_type window(this->get_allocator());
+    window._set.insert(first_, past_);
+
+    typename window_type::iterator edited_ = edit(window);
+    const bool at_end = edited_ == window.end();
+    const auto offset = std::distance(window.begin(), edited_);
+
+    iterator spliced_ = this->_set.replace(
+        first_, past_, window._set.begin(), window._set.end());
+    return at_end ? this->_set.end() : std::next(spliced_, offset);
+  }
+
+  /** Runs \c update, that changes the elements of the set within \c span
+      only, and keeps the running totals up to date. */
+  template <typename Update>
+  decltype(auto) measured(const interval_type& span, Update update) {
+    if constexpr (caches_measure) {
+      if (_measure.depth == 0) {
+        detail::measure_scope<interval_base_set> scope(*this, span);
+        return update();
+      }
+    }
+    return update();
+  }
+
+  /// The measure of the part of the set within \c span
+  measure_type covered(const interval_type& span) const {
+    measure_type measure;
+    if (icl::is_empty(span) || _set.empty() ||
+        _set.key_comp()(*std::prev(_set.end()), span))
+      return measure; // Nothing to search behind the last interval
+
+    for (const_iterator it_ = _set.lower_bound(span);
+         it_ != _set.end() && icl::intersects(*it_, span); ++it_)
+      measure.add(*it_ & span);
+    return measure;
+  }
+
+  /// Counts the running totals anew
+  void recount() {
+    if constexpr (caches_measure) {
+      _measure = {};
+      for (const interval_type& inter_val : _set)
+        _measure.add(inter_val);
+    }
+  }
+
   sub_type* that() { return static_cast<sub_type*>(this); }
   const sub_type* that() const { return static_cast<const sub_type*>(this); }
 
   ImplSetT _set;
+
+  [[no_unique_address]] std::conditional_t<
+      caches_measure, detail::measure_cache<size_type, difference_type>,
+      detail::no_measure_cache> _measure;
+
+private:
+  // Sets of other storage policies act as update windows for each other
+  template <typename SubT, typename DomT, template <typename> typename CompareT,
+            typename IntervalT, template <typename> typename AllocT,
+            typename StorageT>
+    requires std::default_initializable<DomT> && std::totally_ordered<DomT>
+  friend class interval_base_set;
+
+  friend class detail::measure_scope<interval_base_set>;
 };
 
 //-----------------------------------------------------------------------------
@@ -439,18 +671,18 @@ protected:
 //-----------------------------------------------------------------------------
 template <typename SubType, typename DomainT,
           template <typename> typename Compare, typename Interval,
-          template <typename> typename Alloc>
-struct is_set<
-    icl::interval_base_set<SubType, DomainT, Compare, Interval, Alloc>> {
+          template <typename> typename Alloc, typename Storage>
+struct is_set<icl::interval_base_set<SubType, DomainT, Compare, Interval, Alloc,
+                                     Storage>> {
   using type = is_set;
   static constexpr bool value = true;
 };
 
 template <typename SubType, typename DomainT,
           template <typename> typename Compare, typename Interval,
-          template <typename> typename Alloc>
-struct is_interval_container<
-    icl::interval_base_set<SubType, DomainT, Compare, Interval, Alloc>> {
+          template <typename> typename Alloc, typename Storage>
+struct is_interval_container<icl::interval_base_set<
+    SubType, DomainT, Compare, Interval, Alloc, Storage>> {
   using type = is_interval_container;
   static constexpr bool value = true;
 };
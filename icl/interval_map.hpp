@@ -1,9 +1,11 @@
 #pragma once
 
+#include "icl/detail/interval_bulk_algo.hpp"
 #include "icl/interval_base_map.hpp"
 #include "icl/interval_set.hpp"
 #include "icl/type_traits/interval_type_default.hpp"
 #include "icl/type_traits/is_map.hpp"
+#include <memory_resource>
 
 namespace icl {
 
@@ -11,7 +13,7 @@ template <typename DomainT, typename CodomainT, class Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 class split_interval_map;
 
 /** \brief implements a map as a map of intervals - on insertion
@@ -23,21 +25,25 @@ template <typename DomainT, typename CodomainT,
           template <typename> typename Section = icl::inter_section,
           typename Interval =
               typename icl::interval_type_default<DomainT, Compare>::type,
-          template <typename> typename Alloc = std::allocator>
+          template <typename> typename Alloc = std::allocator,
+          typename Storage = tree_storage>
 class interval_map
-    : public interval_base_map<interval_map<DomainT, CodomainT, Traits, Compare,
-                                            Combine, Section, Interval, Alloc>,
-                               DomainT, CodomainT, Traits, Compare, Combine,
-                               Section, Interval, Alloc> {
+    : public interval_base_map<
+          interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                       Interval, Alloc, Storage>,
+          DomainT, CodomainT, Traits, Compare, Combine, Section, Interval,
+          Alloc, Storage> {
 public:
   using traits = Traits;
   using type = interval_map;
-  using split_type = split_interval_map<DomainT, CodomainT, Traits, Compare,
-                                        Combine, Section, Interval, Alloc>;
+  using split_type =
+      split_interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                         Interval, Alloc, Storage>;
   using overloadable_type = type;
   using joint_type = type;
-  using base_type = interval_base_map<type, DomainT, CodomainT, Traits, Compare,
-                                      Combine, Section, Interval, Alloc>;
+  using base_type =
+      interval_base_map<type, DomainT, CodomainT, Traits, Compare, Combine,
+                        Section, Interval, Alloc, Storage>;
 
   using interval_type = Interval;
   using iterator = typename base_type::iterator;
@@ -49,6 +55,8 @@ public:
   using domain_mapping_type = typename base_type::domain_mapping_type;
   using interval_mapping_type = typename base_type::interval_mapping_type;
   using ImplMapT = typename base_type::ImplMapT;
+  using storage_type = typename base_type::storage_type;
+  using allocator_type = typename base_type::allocator_type;
 
   using size_type = typename base_type::size_type;
   using codomain_combine = typename base_type::codomain_combine;
@@ -68,11 +76,19 @@ public:
   /// Copy constructor
   interval_map(const interval_map& src) : base_type(src) {}
 
-  /// Copy constructor for base_type
-  template <typename SubType>
+  /// Constructor for the empty object that allocates from \c alloc
+  explicit interval_map(const allocator_type& alloc) : base_type(alloc) {}
+
+  /// Copy constructor that allocates from \c alloc
+  interval_map(const interval_map& src, const allocator_type& alloc)
+      : base_type(src, alloc) {}
+
+  /// Copy constructor for base_type of any storage policy
+  template <typename SubType, typename SrcStorage>
   explicit interval_map(
       const interval_base_map<SubType, DomainT, CodomainT, Traits, Compare,
-                              Combine, Section, Interval, Alloc>& src) {
+                              Combine, Section, Interval, Alloc, SrcStorage>&
+          src) {
     this->assign(src);
   }
 
@@ -84,14 +100,32 @@ public:
     this->add(value_pair);
   }
 
+  /** Bulk construction: The segments of the unsorted range
+      <tt>[first,past)</tt> are added in one sweep, see \c assign. */
+  template <std::input_iterator InputIterator>
+  interval_map(InputIterator first, InputIterator past) : base_type() {
+    this->assign(first, past);
+  }
+
+  /** Parallel bulk construction: The range <tt>[first,past)</tt> is
+      partitioned and swept under the execution \c policy, see \c assign. */
+  template <typename ExecutionPolicy, std::input_iterator InputIterator>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+  interval_map(ExecutionPolicy&& policy, InputIterator first,
+               InputIterator past)
+      : base_type() {
+    this->assign(std::forward<ExecutionPolicy>(policy), first, past);
+  }
+
   /// Assignment from a base interval_map.
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   void
   assign(const interval_base_map<SubType, DomainT, CodomainT, Traits, Compare,
-                                 Combine, Section, Interval, Alloc>& src) {
+                                 Combine, Section, Interval, Alloc, SrcStorage>&
+             src) {
     using base_map_type =
         interval_base_map<SubType, DomainT, CodomainT, Traits, Compare, Combine,
-                          Section, Interval, Alloc>;
+                          Section, Interval, Alloc, SrcStorage>;
     this->clear();
     iterator prior_ = this->_map.end();
     for (typename base_map_type::const_iterator it_ = src.begin();
@@ -99,11 +133,35 @@ public:
       prior_ = this->add(prior_, *it_);
   }
 
+  /** Replaces the content of the map by the sum of the segments in the
+      unsorted range <tt>[first,past)</tt>. The segments are sorted and
+      combined in one sweep line pass in O(n log n), or in O(n (log n + k))
+      for values, that are not integral or not combined by \c inplace_plus,
+      where k segments overlap. The result equals that of adding the
+      segments one by one. */
+  template <std::input_iterator InputIterator>
+  void assign(InputIterator first, InputIterator past) {
+    Interval_Bulk::assign(*this, first, past);
+  }
+
+  /** Parallel version of the bulk assignment. Partitions of the sorted
+      segments are swept concurrently under the execution \c policy and
+      joined at their borders. The result equals that of the sequential
+      version. */
+  template <typename ExecutionPolicy, std::input_iterator InputIterator>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+  void assign(ExecutionPolicy&& policy, InputIterator first,
+              InputIterator past) {
+    Interval_Bulk::assign(std::forward<ExecutionPolicy>(policy), *this, first,
+                          past);
+  }
+
   /// Assignment operator for base type
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   interval_map& operator=(
       const interval_base_map<SubType, DomainT, CodomainT, Traits, Compare,
-                              Combine, Section, Interval, Alloc>& src) {
+                              Combine, Section, Interval, Alloc, SrcStorage>&
+          src) {
     this->assign(src);
     return *this;
   }
@@ -115,6 +173,10 @@ public:
   /// Move constructor
   interval_map(interval_map&& src) noexcept : base_type(std::move(src)) {}
 
+  /// Move constructor that allocates from \c alloc
+  interval_map(interval_map&& src, const allocator_type& alloc)
+      : base_type(std::move(src), alloc) {}
+
   /// Move assignment operator
   interval_map& operator=(interval_map src) {
     base_type::operator=(std::move(src));
@@ -126,7 +188,14 @@ public:
 private:
   // Private functions that shall be accessible by the baseclass:
   friend class interval_base_map<interval_map, DomainT, CodomainT, Traits,
-                                 Compare, Combine, Section, Interval, Alloc>;
+                                 Compare, Combine, Section, Interval, Alloc,
+                                 Storage>;
+
+  /// The same map type on a different storage policy
+  template <typename OtherStorage>
+  using rebind_storage = interval_map<DomainT, CodomainT, Traits, Compare,
+                                      Combine, Section, Interval, Alloc,
+                                      OtherStorage>;
 
   iterator handle_inserted(iterator it_) {
     return segmental::join_neighbours(*this, it_);
@@ -182,25 +251,71 @@ private:
     segmental::join_right(*this, insertion_);
   }
 
-  template <typename Combiner>
+  template <typename Combiner, typename CoValT>
   void gap_insert_at(iterator& it_, iterator prior_,
-                     const interval_type& end_gap,
-                     const codomain_type& co_val) {
+                     const interval_type& end_gap, CoValT&& co_val) {
     if (on_absorbtion<type, Combiner,
                       Traits::absorbs_identities>::is_absorbable((*it_)
                                                                      .second)) {
       this->_map.erase(it_);
-      it_ = this->template gap_insert<Combiner>(prior_, end_gap, co_val);
+      it_ = this->template gap_insert<Combiner>(prior_, end_gap,
+                                                std::forward<CoValT>(co_val));
       segmental::join_right(*this, it_);
     } else {
       segmental::join_left(*this, it_);
-      iterator inserted_ =
-          this->template gap_insert<Combiner>(it_, end_gap, co_val);
+      iterator inserted_ = this->template gap_insert<Combiner>(
+          it_, end_gap, std::forward<CoValT>(co_val));
       it_ = segmental::join_neighbours(*this, inserted_);
     }
   }
 };
 
+/** \brief An interval_map on contiguous storage: Intended for maps that
+    are built once and queried often. */
+template <typename DomainT, typename CodomainT,
+          typename Traits = icl::partial_absorber,
+          template <typename> typename Compare = std::less,
+          template <typename> typename Combine = icl::inplace_plus,
+          template <typename> typename Section = icl::inter_section,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          template <typename> typename Alloc = std::allocator>
+using flat_interval_map =
+    interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                 Interval, Alloc, flat_storage>;
+
+/** \brief An interval_map that aggregates its values: Intervals are
+    queried for the sum, the minimum, the maximum or the length weighted sum
+    of their values in logarithmic time, see \c aggregate. */
+template <typename DomainT, typename CodomainT,
+          typename Traits = icl::partial_absorber,
+          template <typename> typename Compare = std::less,
+          template <typename> typename Combine = icl::inplace_plus,
+          template <typename> typename Section = icl::inter_section,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          template <typename> typename Alloc = std::allocator>
+using augmented_interval_map =
+    interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                 Interval, Alloc, augmented_storage>;
+
+namespace pmr {
+/** \brief An interval_map that allocates from a
+    \c std::pmr::memory_resource. Results of its operations allocate from the
+    resource of their left operand. */
+template <typename DomainT, typename CodomainT,
+          typename Traits = icl::partial_absorber,
+          template <typename> typename Compare = std::less,
+          template <typename> typename Combine = icl::inplace_plus,
+          template <typename> typename Section = icl::inter_section,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          typename Storage = tree_storage>
+using interval_map =
+    icl::interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                      Interval, std::pmr::polymorphic_allocator, Storage>;
+} // namespace pmr
+
 //-----------------------------------------------------------------------------
 // type traits
 //-----------------------------------------------------------------------------
@@ -208,9 +323,9 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_map<icl::interval_map<DomainT, CodomainT, Traits, Compare, Combine,
-                                Section, Interval, Alloc>> {
+                                Section, Interval, Alloc, Storage>> {
   using type = is_map;
   static constexpr bool value = true;
 };
@@ -219,9 +334,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct has_inverse<icl::interval_map<DomainT, CodomainT, Traits, Compare,
-                                     Combine, Section, Interval, Alloc>> {
+                                     Combine, Section, Interval, Alloc,
+                                     Storage>> {
   using type = has_inverse;
   static constexpr bool value = has_inverse<CodomainT>::value;
 };
@@ -230,9 +346,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_interval_container<icl::interval_map<
-    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc>> {
+    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc,
+    Storage>> {
   using type = is_interval_container;
   static constexpr bool value = true;
 };
@@ -241,9 +358,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct absorbs_identities<icl::interval_map<
-    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc>> {
+    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc,
+    Storage>> {
   using type = absorbs_identities;
   static constexpr bool value = Traits::absorbs_identities;
 };
@@ -252,9 +370,9 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_total<icl::interval_map<DomainT, CodomainT, Traits, Compare, Combine,
-                                  Section, Interval, Alloc>> {
+                                  Section, Interval, Alloc, Storage>> {
   using type = is_total;
   static constexpr bool value = Traits::is_total;
 };
@@ -266,9 +384,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct type_to_string<icl::interval_map<DomainT, CodomainT, Traits, Compare,
-                                        Combine, Section, Interval, Alloc>> {
+                                        Combine, Section, Interval, Alloc,
+                                        Storage>> {
   static std::string apply() {
     return "itv_map<" + type_to_string<DomainT>::apply() + "," +
            type_to_string<CodomainT>::apply() + "," +
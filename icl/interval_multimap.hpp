@@ -0,0 +1,340 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/detail/augmented_map.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/type_traits/interval_type_default.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace icl {
+namespace detail {
+
+/** \brief Summary of a sequence of intervals in an interval tree: The
+    interval that reaches farthest to the right. */
+template <typename Interval> struct upper_reach {
+  template <typename CodomainT>
+  upper_reach(const Interval& inter_val, const CodomainT&)
+      : reach(inter_val) {}
+
+  /// Combines the summary of the intervals that follow
+  void append(const upper_reach& right) {
+    if (icl::upper_less(reach, right.reach))
+      reach = right.reach;
+  }
+
+  Interval reach;
+};
+
+/// Orders intervals by their lower bounds, then by their upper bounds
+template <typename Interval> struct lower_upper_less {
+  bool operator()(const Interval& left, const Interval& right) const {
+    return icl::lower_less(left, right) ||
+           (icl::lower_equal(left, right) && icl::upper_less(left, right));
+  }
+};
+
+} // namespace detail
+
+/** \brief A multimap of intervals: Intervals are stored as distinct
+    records, that are neither joined nor split, so overlapping and equal
+    intervals are kept along with their values.
+
+    The records are ordered by the lower, then the upper bounds of their
+    intervals and kept in a balanced tree, whose nodes know the interval
+    that reaches farthest to the right within their subtrees (an augmented
+    interval tree). The records that overlap an interval or contain a point
+    are visited by \c overlapping, that skips the subtrees without overlaps.
+    Finding the first overlap takes logarithmic time, every step to the
+    next one at most logarithmic time.
+
+    Empty intervals overlap nothing, they are not stored. */
+template <typename DomainT, typename CodomainT,
+          template <typename> typename Compare = std::less,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          template <typename> typename Alloc = std::allocator>
+class interval_multimap {
+public:
+  using type = interval_multimap;
+  using domain_type = DomainT;
+  using codomain_type = CodomainT;
+  using interval_type = Interval;
+  /// The records of the multimap
+  using value_type = std::pair<const interval_type, codomain_type>;
+  /// Records that can be sorted before they are inserted in bulk
+  using segment_type = std::pair<interval_type, codomain_type>;
+  using key_compare = detail::lower_upper_less<interval_type>;
+  using allocator_type = Alloc<value_type>;
+  using summary_type = detail::upper_reach<interval_type>;
+  using tree_type = detail::augmented_map<interval_type, codomain_type,
+                                          key_compare, allocator_type,
+                                          summary_type>;
+
+  using size_type = typename tree_type::size_type;
+  using difference_type = typename tree_type::difference_type;
+  using reference = typename tree_type::reference;
+  using const_reference = typename tree_type::const_reference;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = typename tree_type::reverse_iterator;
+  using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+
+  /** \brief Forward iterator over the records, that overlap an interval, in
+      the order of the multimap. */
+  class overlap_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = interval_multimap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+
+    overlap_iterator() = default;
+
+    reference operator*() const { return *_position; }
+    pointer operator->() const { return &*_position; }
+
+    overlap_iterator& operator++() {
+      _position = _tree->find_admitted(std::next(_position), admits());
+      settle();
+      return *this;
+    }
+
+    overlap_iterator operator++(int) {
+      overlap_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const overlap_iterator& other) const {
+      return _position == other._position;
+    }
+
+    /// The position of the record in the multimap, e.g. to erase it
+    const_iterator base() const { return _position; }
+
+  private:
+    friend class interval_multimap;
+
+    overlap_iterator(const tree_type& tree, const interval_type& query,
+                     const_iterator position)
+        : _tree(&tree), _query(query), _position(position) {}
+
+    /// Subtrees reaching no farther than the lower bound of the query
+    /// are skipped
+    auto admits() const {
+      return [this](const summary_type& summary) {
+        return !icl::exclusive_less(summary.reach, _query);
+      };
+    }
+
+    /// The records are ordered by their lower bounds, the first one behind
+    /// the query ends the walk
+    void settle() {
+      if (_position != _tree->end() &&
+          icl::exclusive_less(_query, (*_position).first))
+        _position = _tree->end();
+    }
+
+    const tree_type* _tree = nullptr;
+    interval_type _query;
+    const_iterator _position;
+  };
+
+  using overlap_range = std::ranges::subrange<overlap_iterator>;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  /// Default constructor for the empty object
+  interval_multimap() = default;
+
+  /// Constructor for the empty object that allocates from \c alloc
+  explicit interval_multimap(const allocator_type& alloc) : _tree(alloc) {}
+
+  /// Constructor from the records <tt>[first,past)</tt>, built in bulk
+  template <typename InputIterator>
+  interval_multimap(InputIterator first, InputIterator past) {
+    insert(first, past);
+  }
+
+  /// Constructor from a list of records, built in bulk
+  interval_multimap(std::initializer_list<segment_type> records) {
+    insert(records.begin(), records.end());
+  }
+
+  allocator_type get_allocator() const { return _tree.get_allocator(); }
+  key_compare key_comp() const { return _tree.key_comp(); }
+
+  void swap(interval_multimap& object) noexcept { _tree.swap(object._tree); }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  bool empty() const { return _tree.empty(); }
+  size_type size() const { return _tree.size(); }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  iterator begin() { return _tree.begin(); }
+  iterator end() { return _tree.end(); }
+  const_iterator begin() const { return _tree.begin(); }
+  const_iterator end() const { return _tree.end(); }
+  reverse_iterator rbegin() { return _tree.rbegin(); }
+  reverse_iterator rend() { return _tree.rend(); }
+  const_reverse_iterator rbegin() const { return _tree.rbegin(); }
+  const_reverse_iterator rend() const { return _tree.rend(); }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+  /// The records whose intervals equal \c inter_val
+  std::pair<iterator, iterator> equal_range(const interval_type& inter_val) {
+    return _tree.equal_range(inter_val);
+  }
+
+  std::pair<const_iterator, const_iterator>
+  equal_range(const interval_type& inter_val) const {
+    return _tree.equal_range(inter_val);
+  }
+
+  /// The first record whose interval equals \c inter_val, or \c end()
+  iterator find(const interval_type& inter_val) {
+    const iterator it_ = _tree.lower_bound(inter_val);
+    return it_ != end() && !key_comp()(inter_val, (*it_).first) ? it_ : end();
+  }
+
+  const_iterator find(const interval_type& inter_val) const {
+    const const_iterator it_ = _tree.lower_bound(inter_val);
+    return it_ != end() && !key_comp()(inter_val, (*it_).first) ? it_ : end();
+  }
+
+  /// The number of records whose intervals equal \c inter_val
+  size_type count(const interval_type& inter_val) const {
+    const auto range = equal_range(inter_val);
+    return static_cast<size_type>(std::distance(range.first, range.second));
+  }
+
+  /** The records whose intervals overlap \c query, in the order of the
+      multimap. */
+  overlap_range overlapping(const interval_type& query) const {
+    const overlap_iterator past(_tree, query, _tree.end());
+    if (icl::is_empty(query))
+      return {past, past};
+    overlap_iterator first(_tree, query, _tree.begin());
+    first._position = _tree.find_admitted(_tree.begin(), first.admits());
+    first.settle();
+    return {first, past};
+  }
+
+  /// The records whose intervals contain the point \c key_val
+  overlap_range overlapping(const domain_type& key_val) const
+    requires Interval_Stabbing::stabbable<interval_multimap>
+  {
+    return overlapping(Interval_Stabbing::probe<interval_multimap>(key_val));
+  }
+
+  //==========================================================================
+  //= Insertion, erasure
+  //==========================================================================
+  /** Inserts the record \c value behind the records with equal intervals.
+      Returns its position, or \c end() for an empty interval. */
+  iterator insert(const value_type& value) {
+    if (icl::is_empty(value.first))
+      return end();
+    return _tree.emplace_equal(value);
+  }
+
+  iterator insert(value_type&& value) {
+    if (icl::is_empty(value.first))
+      return end();
+    return _tree.emplace_equal(std::move(value));
+  }
+
+  /** Inserts the records <tt>[first,past)</tt>. Records with equal
+      intervals are kept in the order of their insertion. Unless there are
+      few of them compared to the size of the multimap, they are sorted and
+      merged with its records, and the tree is rebuilt in linear time. */
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator past) {
+    std::vector<segment_type> added;
+    for (; first != past; ++first)
+      if (!icl::is_empty((*first).first))
+        added.emplace_back((*first).first, (*first).second);
+
+    if (added.size() * bulk_ratio < size()) {
+      for (segment_type& record : added)
+        _tree.emplace_equal(std::move(record.first),
+                            std::move(record.second));
+      return;
+    }
+
+    const key_compare less = key_comp();
+    const auto by_interval = [&](const segment_type& left,
+                                 const segment_type& right) {
+      return less(left.first, right.first);
+    };
+    std::stable_sort(added.begin(), added.end(), by_interval);
+
+    std::vector<segment_type> records;
+    records.reserve(size() + added.size());
+    for (value_type& record : _tree)
+      records.emplace_back(record.first, std::move(record.second));
+    const auto middle = records.insert(records.end(),
+                                       std::make_move_iterator(added.begin()),
+                                       std::make_move_iterator(added.end()));
+    std::inplace_merge(records.begin(), middle, records.end(), by_interval);
+    _tree.assign_sorted(std::make_move_iterator(records.begin()),
+                        std::make_move_iterator(records.end()));
+  }
+
+  iterator erase(const_iterator position) { return _tree.erase(position); }
+
+  iterator erase(const_iterator first, const_iterator past) {
+    return _tree.erase(first, past);
+  }
+
+  /// Erases the records whose intervals equal \c inter_val
+  size_type erase(const interval_type& inter_val) {
+    const auto range = _tree.equal_range(inter_val);
+    const size_type erased =
+        static_cast<size_type>(std::distance(range.first, range.second));
+    _tree.erase(range.first, range.second);
+    return erased;
+  }
+
+  void clear() { _tree.clear(); }
+
+  friend bool operator==(const interval_multimap& left,
+                         const interval_multimap& right) {
+    return left.size() == right.size() && std::equal(left.begin(), left.end(),
+                                                     right.begin());
+  }
+
+private:
+  /// Bulk insertion rebuilds the tree, unless fewer than one record per
+  /// \c bulk_ratio records of the multimap are inserted
+  static constexpr size_type bulk_ratio = 8;
+
+  tree_type _tree;
+};
+
+template <typename DomainT, typename CodomainT,
+          template <typename> typename Compare, typename Interval,
+          template <typename> typename Alloc>
+void swap(interval_multimap<DomainT, CodomainT, Compare, Interval, Alloc>& left,
+          interval_multimap<DomainT, CodomainT, Compare, Interval, Alloc>&
+              right) noexcept {
+  left.swap(right);
+}
+
+} // namespace icl
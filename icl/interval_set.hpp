@@ -1,8 +1,11 @@
 #pragma once
 
+#include "icl/compact_discrete_interval.hpp"
+#include "icl/detail/interval_bulk_algo.hpp"
 #include "icl/detail/interval_set_algo.hpp"
 #include "icl/interval_base_set.hpp"
 #include "icl/type_traits/is_interval_joiner.hpp"
+#include <memory_resource>
 
 namespace icl {
 
@@ -11,15 +14,18 @@ namespace icl {
 template <typename DomainT, template <typename> typename Compare = std::less,
           typename Interval =
               typename icl::interval_type_default<DomainT, Compare>::type,
-          template <typename> typename Alloc = std::allocator>
+          template <typename> typename Alloc = std::allocator,
+          typename Storage = tree_storage>
 class interval_set
-    : public interval_base_set<interval_set<DomainT, Compare, Interval, Alloc>,
-                               DomainT, Compare, Interval, Alloc> {
+    : public interval_base_set<
+          interval_set<DomainT, Compare, Interval, Alloc, Storage>, DomainT,
+          Compare, Interval, Alloc, Storage> {
 public:
-  using type = interval_set<DomainT, Compare, Interval, Alloc>;
+  using type = interval_set<DomainT, Compare, Interval, Alloc, Storage>;
 
   /// The base_type of this class
-  using base_type = interval_base_set<type, DomainT, Compare, Interval, Alloc>;
+  using base_type =
+      interval_base_set<type, DomainT, Compare, Interval, Alloc, Storage>;
 
   using overloadable_type = type;
 
@@ -58,6 +64,9 @@ public:
   /// elements
   using atomized_type = typename base_type::atomized_type;
 
+  /// The storage policy of the set
+  using storage_type = typename base_type::storage_type;
+
   /// Container type for the implementation
   using ImplSetT = typename base_type::ImplSetT;
 
@@ -85,10 +94,18 @@ public:
   /// Copy constructor
   interval_set(const interval_set& src) : base_type(src) {}
 
-  /// Copy constructor for base_type
-  template <typename SubType>
+  /// Constructor for the empty object that allocates from \c alloc
+  explicit interval_set(const allocator_type& alloc) : base_type(alloc) {}
+
+  /// Copy constructor that allocates from \c alloc
+  interval_set(const interval_set& src, const allocator_type& alloc)
+      : base_type(src, alloc) {}
+
+  /// Copy constructor for base_type of any storage policy
+  template <typename SubType, typename SrcStorage>
   explicit interval_set(const interval_base_set<SubType, DomainT, Compare,
-                                                Interval, Alloc>& src) {
+                                                Interval, Alloc, SrcStorage>&
+                            src) {
     this->assign(src);
   }
 
@@ -102,12 +119,29 @@ public:
     this->add(itv);
   }
 
+  /** Bulk construction: The intervals of the unsorted range
+      <tt>[first,past)</tt> are united in one pass, see \c assign. */
+  template <std::input_iterator InputIterator>
+  interval_set(InputIterator first, InputIterator past) : base_type() {
+    this->assign(first, past);
+  }
+
+  /** Parallel bulk construction: The range <tt>[first,past)</tt> is
+      partitioned and united under the execution \c policy, see \c assign. */
+  template <typename ExecutionPolicy, std::input_iterator InputIterator>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+  interval_set(ExecutionPolicy&& policy, InputIterator first,
+               InputIterator past)
+      : base_type() {
+    this->assign(std::forward<ExecutionPolicy>(policy), first, past);
+  }
+
   /// Assignment from a base interval_set.
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   void assign(const interval_base_set<SubType, DomainT, Compare, Interval,
-                                      Alloc>& src) {
-    using base_set_type =
-        interval_base_set<SubType, DomainT, Compare, Interval, Alloc>;
+                                      Alloc, SrcStorage>& src) {
+    using base_set_type = interval_base_set<SubType, DomainT, Compare,
+                                            Interval, Alloc, SrcStorage>;
     this->clear();
     // Has to be implemented via add. there might be touching borders to be
     // joined
@@ -117,10 +151,30 @@ public:
       prior_ = this->add(prior_, *it_);
   }
 
+  /** Replaces the content of the set by the union of the intervals in the
+      unsorted range <tt>[first,past)</tt>. The intervals are sorted and
+      added in ascending order in O(n log n). */
+  template <std::input_iterator InputIterator>
+  void assign(InputIterator first, InputIterator past) {
+    Interval_Bulk::assign(*this, first, past);
+  }
+
+  /** Parallel version of the bulk assignment. Partitions of the sorted
+      intervals are united concurrently under the execution \c policy and
+      joined at their borders. */
+  template <typename ExecutionPolicy, std::input_iterator InputIterator>
+    requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+  void assign(ExecutionPolicy&& policy, InputIterator first,
+              InputIterator past) {
+    Interval_Bulk::assign(std::forward<ExecutionPolicy>(policy), *this, first,
+                          past);
+  }
+
   /// Assignment operator for base type
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   interval_set& operator=(const interval_base_set<SubType, DomainT, Compare,
-                                                  Interval, Alloc>& src) {
+                                                  Interval, Alloc, SrcStorage>&
+                              src) {
     this->assign(src);
     return *this;
   }
@@ -131,6 +185,10 @@ public:
   /// Move constructor
   interval_set(interval_set&& src) : base_type(std::move(src)) {}
 
+  /// Move constructor that allocates from \c alloc
+  interval_set(interval_set&& src, const allocator_type& alloc)
+      : base_type(std::move(src), alloc) {}
+
   /// Move assignment operator
   interval_set& operator=(interval_set src) {
     base_type::operator=(std::move(src));
@@ -140,8 +198,13 @@ public:
 private:
   // Private functions that shall be accessible by the baseclass:
   friend class interval_base_set<
-      interval_set<DomainT, Compare, Interval, Alloc>, DomainT, Compare,
-      Interval, Alloc>;
+      interval_set<DomainT, Compare, Interval, Alloc, Storage>, DomainT,
+      Compare, Interval, Alloc, Storage>;
+
+  /// The same set type on a different storage policy
+  template <typename OtherStorage>
+  using rebind_storage =
+      interval_set<DomainT, Compare, Interval, Alloc, OtherStorage>;
 
   iterator handle_inserted(iterator it_) {
     return segmental::join_neighbours(*this, it_);
@@ -158,31 +221,67 @@ private:
   }
 };
 
+/** \brief An interval_set on contiguous storage: Intended for sets that
+    are built once and queried often. The array holds whole intervals, with
+    the default \c discrete_interval these are two bounds and their bound
+    type, 24 bytes for \c std::int64_t. */
+template <typename DomainT, template <typename> typename Compare = std::less,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          template <typename> typename Alloc = std::allocator>
+using flat_interval_set =
+    interval_set<DomainT, Compare, Interval, Alloc, flat_storage>;
+
+/** \brief A flat_interval_set of \c compact_discrete_interval: Every
+    segment takes the size of two domain values, 16 bytes for
+    \c std::int64_t, so more segments share a cache line than with
+    \c flat_interval_set. Intervals are kept right-open, the set is meant
+    for discrete domains. */
+template <typename DomainT, template <typename> typename Compare = std::less,
+          template <typename> typename Alloc = std::allocator>
+using flat_compact_interval_set =
+    interval_set<DomainT, Compare, compact_discrete_interval<DomainT, Compare>,
+                 Alloc, flat_storage>;
+
+namespace pmr {
+/** \brief An interval_set that allocates from a
+    \c std::pmr::memory_resource. Results of its operations allocate from the
+    resource of their left operand. */
+template <typename DomainT, template <typename> typename Compare = std::less,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          typename Storage = tree_storage>
+using interval_set =
+    icl::interval_set<DomainT, Compare, Interval,
+                      std::pmr::polymorphic_allocator, Storage>;
+} // namespace pmr
+
 //-----------------------------------------------------------------------------
 // type traits
 //-----------------------------------------------------------------------------
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
-struct is_set<icl::interval_set<DomainT, Compare, Interval, Alloc>> {
-  using type = is_set<icl::interval_set<DomainT, Compare, Interval, Alloc>>;
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
+struct is_set<icl::interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
+  using type = is_set;
   static constexpr bool value = true;
 };
 
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
 struct is_interval_container<
-    icl::interval_set<DomainT, Compare, Interval, Alloc>> {
-  using type = is_interval_container<
-      icl::interval_set<DomainT, Compare, Interval, Alloc>>;
+    icl::interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
+  using type = is_interval_container;
   static constexpr bool value = true;
 };
 
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
 struct is_interval_joiner<
-    icl::interval_set<DomainT, Compare, Interval, Alloc>> {
-  using type =
-      is_interval_joiner<icl::interval_set<DomainT, Compare, Interval, Alloc>>;
+    icl::interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
+  using type = is_interval_joiner;
   static constexpr bool value = true;
 };
 
@@ -190,8 +289,10 @@ struct is_interval_joiner<
 // type representation
 //-----------------------------------------------------------------------------
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
-struct type_to_string<icl::interval_set<DomainT, Compare, Interval, Alloc>> {
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
+struct type_to_string<
+    icl::interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
   static std::string apply() {
     return "itv_set<" + type_to_string<DomainT>::apply() + ">";
   }
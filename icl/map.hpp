@@ -11,6 +11,7 @@
 #include "icl/type_traits/is_map.hpp"
 #include "icl/type_traits/is_total.hpp"
 #include <map>
+#include <memory_resource>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -94,8 +95,8 @@ public:
   using element_compare = Compare<element_type>;
   using inverse_codomain_combine = inverse<codomain_combine>::type;
   using codomain_intersect =
-      std::conditional<has_set_semantics<codomain_type>::value,
-                       Section<CodomainT>, codomain_combine>;
+      std::conditional_t<has_set_semantics<codomain_type>::value,
+                         Section<CodomainT>, codomain_combine>;
   using inverse_codomain_intersect = inverse<codomain_intersect>::type;
   using value_compare = base_type::value_compare;
 
@@ -142,6 +143,10 @@ public:
 
   map(const map& src) : base_type(src) {}
 
+  explicit map(const allocator_type& alloc) : base_type(alloc) {}
+
+  map(const map& src, const allocator_type& alloc) : base_type(src, alloc) {}
+
   explicit map(const element_type& key_value_pair) : base_type::map() {
     insert(key_value_pair);
   }
@@ -152,6 +157,9 @@ public:
 
   map(map&& src) noexcept : base_type(std::move(src)) {}
 
+  map(map&& src, const allocator_type& alloc)
+      : base_type(std::move(src), alloc) {}
+
   map& operator=(map src) {
     base_type::operator=(std::move(src));
     return *this;
@@ -172,6 +180,7 @@ public:
   using base_type::max_size;
   using base_type::size;
 
+  using base_type::get_allocator;
   using base_type::key_comp;
   using base_type::value_comp;
 
@@ -568,6 +577,18 @@ map<DomainT, CodomainT, Traits, Compare, Combine, Section, Alloc>::_subtract(
   return *this;
 }
 
+namespace pmr {
+/** \brief A map that allocates from a \c std::pmr::memory_resource.
+    Results of its operations allocate from the resource of their left
+    operand. */
+template <typename DomainT, typename CodomainT, class Traits = partial_absorber,
+          template <typename> typename Compare = std::less,
+          template <typename> typename Combine = inplace_plus,
+          template <typename> typename Section = inter_section>
+using map = icl::map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                     std::pmr::polymorphic_allocator>;
+} // namespace pmr
+
 //-----------------------------------------------------------------------------
 // type traits
 //-----------------------------------------------------------------------------
@@ -598,7 +619,7 @@ template <
 struct absorbs_identities<
     map<DomainT, CodomainT, Traits, Compare, Combine, Section, Alloc>> {
   using type = absorbs_identities;
-  static constexpr int value = Traits::absorbs_identities;
+  static constexpr bool value = Traits::absorbs_identities;
 };
 
 template <
@@ -608,7 +629,7 @@ template <
 struct is_total<
     map<DomainT, CodomainT, Traits, Compare, Combine, Section, Alloc>> {
   using type = is_total;
-  static constexpr int value = Traits::is_total;
+  static constexpr bool value = Traits::is_total;
 };
 
 template <
@@ -0,0 +1,109 @@
+#pragma once
+
+#if __has_include(<sys/mman.h>)
+
+#include "icl/binary_format.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace icl {
+
+/** \brief A file mapped read-only into memory.
+
+    Pages are read on first access, so mapping takes constant time. The
+    mapping keeps its address when the object is moved. */
+class mapped_file {
+public:
+  mapped_file() = default;
+
+  /** Maps the file at \c path. Throws \c std::system_error if it cannot be
+      opened or mapped. */
+  explicit mapped_file(const std::filesystem::path& path) {
+    const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+      throw std::system_error(errno, std::generic_category(),
+                              "icl::mapped_file: open " + path.string());
+    struct ::stat status;
+    if (::fstat(descriptor, &status) != 0) {
+      const int error = errno;
+      ::close(descriptor);
+      throw std::system_error(error, std::generic_category(),
+                              "icl::mapped_file: stat " + path.string());
+    }
+    _size = static_cast<std::size_t>(status.st_size);
+    if (_size > 0) {
+      void* address =
+          ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (address == MAP_FAILED) {
+        const int error = errno;
+        ::close(descriptor);
+        throw std::system_error(error, std::generic_category(),
+                                "icl::mapped_file: mmap " + path.string());
+      }
+      _data = static_cast<const std::byte*>(address);
+    }
+    // The mapping outlives the descriptor
+    ::close(descriptor);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  mapped_file(mapped_file&& other) noexcept
+      : _data(std::exchange(other._data, nullptr)),
+        _size(std::exchange(other._size, 0)) {}
+
+  mapped_file& operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      _data = std::exchange(other._data, nullptr);
+      _size = std::exchange(other._size, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_file() { unmap(); }
+
+  /// The contents of the file
+  std::span<const std::byte> bytes() const { return {_data, _size}; }
+
+private:
+  void unmap() {
+    if (_data != nullptr)
+      ::munmap(const_cast<std::byte*>(_data), _size);
+  }
+
+  const std::byte* _data = nullptr;
+  std::size_t _size = 0;
+};
+
+/** \brief A \c binary_view of an interval container of type \c Type, that
+    owns the mapping of the file it reads.
+
+    Opening takes constant time in the size of the container, its arrays
+    are paged in as they are searched. */
+template <typename Type>
+  requires binary_serializable<Type>
+class mapped_view : private mapped_file, public binary_view<Type> {
+public:
+  /** Maps the file at \c path. Throws \c std::system_error if it cannot be
+      mapped, \c binary_format_error if it does not hold a \c Type. */
+  explicit mapped_view(const std::filesystem::path& path)
+      : mapped_file(path), binary_view<Type>(mapped_file::bytes()) {}
+
+  /// The contents of the file
+  std::span<const std::byte> bytes() const { return mapped_file::bytes(); }
+};
+
+} // namespace icl
+
+#endif // __has_include(<sys/mman.h>)
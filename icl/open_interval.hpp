@@ -3,6 +3,7 @@
 #include "icl/type_traits/succ_pred.hpp"
 #include "icl/type_traits/type_to_string.hpp"
 #include "icl/type_traits/value_size.hpp"
+#include <cassert>
 
 namespace icl {
 
@@ -30,9 +31,9 @@ public:
     // Only for discrete types this ctor creates an interval containing
     // a single element only.
     static_assert(is_discrete<DomainT>::value);
-    static_assert(
-        numeric_minimum<DomainT, domain_compare,
-                        is_numeric<DomainT>::value>::is_less_than(val));
+    assert(
+        (numeric_minimum<DomainT, domain_compare,
+                         is_numeric<DomainT>::value>::is_less_than(val)));
   }
 
   /** Interval from <tt>low</tt> to <tt>up</tt> with bounds<tt></tt> */
@@ -0,0 +1,353 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/concept/interval_associator.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/detail/persistent_map.hpp"
+#include "icl/type_traits/identity_element.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace icl {
+
+template <typename Type>
+  requires is_interval_map<Type>::value
+class versioned;
+
+/** \brief The interval map \c Type as a persistent container: Copies are
+    snapshots that take constant time, and share their segments with the
+    map and with each other.
+
+    The segments are kept in a tree of reference counted nodes, that are
+    never changed once they are shared, see \c detail::persistent_map. An
+    update copies the nodes on the paths to the segments it changes, so it
+    takes logarithmic time besides the time for the segments it changes,
+    and the snapshots taken before are left as they were. The segments
+    that an update changes are gathered into a \c Type, together with
+    their neighbours, the update is applied to it, and its segments
+    replace those in the tree. So updates have the semantics of those of
+    \c Type, whose joins and absorbtions only reach to the neighbours of
+    the segments they change.
+
+    A snapshot of a map may be taken by \c snapshot or by copying the map,
+    while another thread updates it, the update takes a lock only to
+    publish its result. All other members must not be called while the map
+    is updated. Snapshots are read without locks, and threads that read
+    them never keep others from updating the map. */
+template <typename Type>
+  requires is_interval_map<Type>::value
+class persistent {
+public:
+  /// The type of the map, whose updates are applied
+  using container_type = Type;
+  using domain_type = Type::domain_type;
+  using codomain_type = Type::codomain_type;
+  using interval_type = Type::interval_type;
+  using element_type = Type::element_type;
+  using segment_type = Type::segment_type;
+  using key_compare = Type::key_compare;
+  using allocator_type = Type::allocator_type;
+  using tree_type = detail::persistent_map<interval_type, codomain_type,
+                                           key_compare, allocator_type>;
+  using value_type = tree_type::value_type;
+  using size_type = tree_type::size_type;
+  using iterator = tree_type::const_iterator;
+  using const_iterator = tree_type::const_iterator;
+  using reverse_iterator = tree_type::const_reverse_iterator;
+  using const_reverse_iterator = tree_type::const_reverse_iterator;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  persistent() = default;
+
+  /** The segments of \c object, in linear time */
+  explicit persistent(const Type& object)
+      : _tree(object.begin(), object.end(), object.get_allocator()) {}
+
+  /// A snapshot of \c src, in constant time
+  persistent(const persistent& src) : _tree(src.published()) {}
+
+  persistent& operator=(const persistent& src) {
+    if (this != &src)
+      publish(src.published());
+    return *this;
+  }
+
+  /** A snapshot of the map, in constant time */
+  persistent snapshot() const { return *this; }
+
+  /** The map as a \c Type */
+  Type container() const { return gather(begin(), end()); }
+
+  /// Do the maps share all their segments, as a map and its snapshot do
+  /// until one of them is updated?
+  bool shares(const persistent& other) const {
+    return _tree.shares(other._tree);
+  }
+
+  //==========================================================================
+  //= Iterator related
+  //==========================================================================
+  const_iterator begin() const { return _tree.begin(); }
+  const_iterator end() const { return _tree.end(); }
+  const_reverse_iterator rbegin() const { return _tree.rbegin(); }
+  const_reverse_iterator rend() const { return _tree.rend(); }
+
+  //==========================================================================
+  //= Size
+  //==========================================================================
+  [[nodiscard]] bool empty() const { return _tree.empty(); }
+
+  /** Number of segments, in constant time */
+  [[nodiscard]] std::size_t iterative_size() const { return _tree.size(); }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+
+  /** Find the segment, that contains \c key */
+  const_iterator find(const domain_type& key) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return _tree.find(Interval_Stabbing::probe<Type>(key));
+  }
+
+  /** Find the segment, that collides with \c key_interval */
+  const_iterator find(const interval_type& key_interval) const {
+    return _tree.find(key_interval);
+  }
+
+  /** Total select function: The value that \c key is mapped to */
+  codomain_type operator()(const domain_type& key) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    const const_iterator it_ = find(key);
+    return it_ == end() ? identity_element<codomain_type>::value()
+                        : (*it_).second;
+  }
+
+  //==========================================================================
+  //= Containedness
+  //==========================================================================
+
+  /** Does the map contain the element \c key? */
+  bool contains(const domain_type& key) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return icl::contains(local(Interval_Stabbing::probe<Type>(key)), key);
+  }
+
+  /** Are all elements of \c inter_val contained? */
+  bool contains(const interval_type& inter_val) const {
+    return icl::contains(local(inter_val), inter_val);
+  }
+
+  /** Are all elements of \c segment contained with its value? */
+  bool contains(const segment_type& segment) const {
+    return icl::contains(local(segment.first), segment);
+  }
+
+  /** Does the map contain the element \c key? */
+  bool intersects(const domain_type& key) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return contains(key);
+  }
+
+  /** Do \c inter_val and the map have elements in common? */
+  bool intersects(const interval_type& inter_val) const {
+    return icl::intersects(local(inter_val), inter_val);
+  }
+
+  /** Do \c segment and the map have elements with equal values in
+      common? */
+  bool intersects(const segment_type& segment) const {
+    return icl::intersects(local(segment.first), segment);
+  }
+
+  //==========================================================================
+  //= Addition, subtraction, insertion, erasure
+  //==========================================================================
+
+  persistent& add(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.add(key_value_pair); });
+  }
+
+  persistent& add(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.add(interval_value_pair);
+    });
+  }
+
+  persistent& subtract(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.subtract(key_value_pair); });
+  }
+
+  persistent& subtract(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.subtract(interval_value_pair);
+    });
+  }
+
+  persistent& insert(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.insert(key_value_pair); });
+  }
+
+  persistent& insert(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.insert(interval_value_pair);
+    });
+  }
+
+  /** Sets the values of the elements of \c key_value_pair to its value, as
+      \c set_at does */
+  persistent& set(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.set(key_value_pair); });
+  }
+
+  persistent& set(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.set(interval_value_pair);
+    });
+  }
+
+  persistent& erase(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.erase(key_value_pair); });
+  }
+
+  persistent& erase(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.erase(interval_value_pair);
+    });
+  }
+
+  /** Erases the elements of \c key */
+  persistent& erase(const domain_type& key)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key),
+                  [&](Type& object) { object.erase(key); });
+  }
+
+  /** Erases the elements of \c inter_val */
+  persistent& erase(const interval_type& inter_val) {
+    return update(inter_val, [&](Type& object) { object.erase(inter_val); });
+  }
+
+  persistent& operator+=(const segment_type& interval_value_pair) {
+    return add(interval_value_pair);
+  }
+
+  persistent& operator-=(const segment_type& interval_value_pair) {
+    return subtract(interval_value_pair);
+  }
+
+  void clear() { publish(tree_type(_tree.get_allocator())); }
+
+  friend bool operator==(const persistent& left, const persistent& right) {
+    return left.shares(right) ||
+           (left.iterative_size() == right.iterative_size() &&
+            std::equal(left.begin(), left.end(), right.begin()));
+  }
+
+private:
+  friend class versioned<Type>;
+
+  /** The segments of the map, that collide with \c span, with their
+      neighbours */
+  static std::pair<const_iterator, const_iterator>
+  neighbourhood(const tree_type& tree, const interval_type& span) {
+    auto [first_, past_] = tree.equal_range(span);
+    if (first_ != tree.begin())
+      --first_;
+    if (past_ != tree.end())
+      ++past_;
+    return {first_, past_};
+  }
+
+  /// The segments <tt>[first,past)</tt> in a \c Type
+  static Type gather(const_iterator first, const_iterator past) {
+    Type object;
+    auto prior_ = object.end();
+    for (; first != past; ++first)
+      prior_ = object.insert(prior_, segment_type(*first));
+    return object;
+  }
+
+  /// The segments of the map, that collide with \c span, in a \c Type
+  Type local(const interval_type& span) const {
+    if (icl::is_empty(span))
+      return Type();
+    const auto [first_, past_] = _tree.equal_range(span);
+    return gather(first_, past_);
+  }
+
+  /** Applies \c updater to the segments that collide with \c span and
+      their neighbours, and replaces them by the result. */
+  template <typename Updater>
+  persistent& update(const interval_type& span, Updater updater) {
+    return update(span, updater, [](const_iterator, const_iterator) {});
+  }
+
+  /// As \c update, and passes the segments that are replaced to \c record
+  template <typename Updater, typename Recorder>
+  persistent& update(const interval_type& span, Updater updater,
+                     Recorder record) {
+    if (icl::is_empty(span))
+      return *this;
+    tree_type tree = _tree;
+    const auto [first_, past_] = neighbourhood(tree, span);
+    Type object = gather(first_, past_);
+    updater(object);
+    record(first_, past_);
+    tree.replace(first_, past_, object.begin(), object.end());
+    publish(std::move(tree));
+    return *this;
+  }
+
+  /** Replaces the segments that collide with \c region by the segments
+      <tt>[first,past)</tt>, that lie within \c region. */
+  template <typename Iterator>
+  void restore(const interval_type& region, Iterator first, Iterator past) {
+    tree_type tree = _tree;
+    tree.replace(region, first, past);
+    publish(std::move(tree));
+  }
+
+  /// A version of the tree, that is not updated while it is copied
+  tree_type published() const {
+    const std::scoped_lock lock(_publish);
+    return _tree;
+  }
+
+  /// Replaces the tree by \c tree. The former one is released by the
+  /// caller, after the lock is released.
+  void publish(tree_type tree) {
+    const std::scoped_lock lock(_publish);
+    _tree.swap(tree);
+  }
+
+  tree_type _tree;
+  mutable std::mutex _publish;
+};
+
+} // namespace icl
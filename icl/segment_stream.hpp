@@ -0,0 +1,401 @@
+#pragma once
+
+#include "icl/binary_format.hpp"
+#include "icl/concept/interval.hpp"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace icl {
+
+/** \brief The stream format of interval containers, see \c segment_writer
+    and \c segment_reader.
+
+    A stream starts with a \c binary_header, that carries the signature
+    \c segment_stream_signature, the type tags, and in \c count the largest
+    number of segments of a block. Blocks of segments follow: The number of
+    their segments as 64-bit integer, then the arrays of their lower
+    bounds, upper bounds, values, if the container is a map, and bound bits,
+    if the intervals have dynamic bounds. A block of no segments ends the
+    stream. Streams are written and read front to back, so that they can be
+    piped, and a reader or writer holds one block at a time. */
+inline constexpr std::array<char, 4> segment_stream_signature = {'I', 'C', 'L',
+                                                                 'S'};
+
+/// The default number of segments of a block
+inline constexpr std::size_t segment_stream_chunk = std::size_t(1) << 14;
+
+namespace detail {
+
+/// The bytes a segment of a \c Type takes in a block
+template <typename Type>
+  requires binary_serializable<Type>
+constexpr std::size_t segment_record_size() {
+  std::size_t size = 2 * sizeof(typename Type::domain_type);
+  if constexpr (is_interval_map<Type>::value)
+    size += sizeof(typename Type::codomain_type);
+  if constexpr (has_dynamic_bounds<typename Type::interval_type>::value)
+    size += sizeof(bound_type);
+  return size;
+}
+
+template <typename Type>
+typename Type::interval_type&
+segment_key(typename Type::segment_type& segment) {
+  if constexpr (is_interval_map<Type>::value)
+    return segment.first;
+  else
+    return segment;
+}
+
+} // namespace detail
+
+/** \brief Writes the segments of an interval container of type \c Type in
+    the stream format, as they are pushed.
+
+    Segments must be pushed in ascending order and must not overlap, like
+    the segments of a \c Type. They are written in blocks of \c chunk
+    segments, so that the writer holds one block at most. Failures are
+    reported by the state of the stream. */
+template <typename Type>
+  requires binary_serializable<Type>
+class segment_writer {
+public:
+  using interval_type = Type::interval_type;
+  using key_compare = Type::key_compare;
+  using segment_type = Type::segment_type;
+
+  explicit segment_writer(std::ostream& stream,
+                          std::size_t chunk = segment_stream_chunk)
+      : _writer(stream), _chunk(chunk) {
+    assert(chunk > 0);
+    binary_header header = detail::binary_layout<Type>(chunk);
+    header.magic = segment_stream_signature;
+    header.lower_offset = header.upper_offset = 0;
+    header.bounds_offset = header.value_offset = header.file_size = 0;
+    _writer.write(&header, sizeof(header));
+    _block.reserve(chunk);
+  }
+
+  segment_writer(const segment_writer&) = delete;
+  segment_writer& operator=(const segment_writer&) = delete;
+
+  /// Ends the stream, unless \c finish() did
+  ~segment_writer() {
+    if (!_finished)
+      finish();
+  }
+
+  /** Appends \c segment, that must succeed the segments pushed before */
+  void push(const segment_type& segment) {
+    assert(!_finished);
+    assert(!icl::is_empty(key_of(segment)));
+    assert(_count == 0 || key_compare()(_last, key_of(segment)));
+    _block.push_back(segment);
+    _last = key_of(segment);
+    ++_count;
+    if (_block.size() == _chunk)
+      write_block();
+  }
+
+  /** Writes the pending segments and the end of the stream */
+  void finish() {
+    write_block();
+    const std::uint64_t end = 0;
+    _writer.write(&end, sizeof(end));
+    _writer.flush();
+    _finished = true;
+  }
+
+  /// The number of segments pushed
+  [[nodiscard]] std::uint64_t count() const { return _count; }
+
+private:
+  static const interval_type& key_of(const segment_type& segment) {
+    if constexpr (is_interval_map<Type>::value)
+      return segment.first;
+    else
+      return segment;
+  }
+
+  void write_block() {
+    if (_block.empty())
+      return;
+    const std::uint64_t size = _block.size();
+    _writer.write(&size, sizeof(size));
+    auto write_array = [&](const auto& field) {
+      for (const segment_type& segment : _block) {
+        const auto value = field(segment);
+        _writer.write(&value, sizeof(value));
+      }
+    };
+    write_array([](const segment_type& segment) {
+      return icl::lower(key_of(segment));
+    });
+    write_array([](const segment_type& segment) {
+      return icl::upper(key_of(segment));
+    });
+    if constexpr (is_interval_map<Type>::value)
+      write_array([](const segment_type& segment) { return segment.second; });
+    if constexpr (has_dynamic_bounds<interval_type>::value)
+      write_array([](const segment_type& segment) {
+        return key_of(segment).bounds().bits();
+      });
+    _block.clear();
+  }
+
+  detail::binary_writer _writer;
+  std::size_t _chunk;
+  std::vector<segment_type> _block;
+  interval_type _last{};
+  std::uint64_t _count = 0;
+  bool _finished = false;
+};
+
+/** Writes the segments of \c object to \c stream in the stream format */
+template <typename Type>
+  requires binary_serializable<Type>
+std::ostream& write_segments(std::ostream& stream, const Type& object,
+                             std::size_t chunk = segment_stream_chunk) {
+  segment_writer<Type> writer(stream, chunk);
+  for (auto it_ = object.begin(); it_ != object.end(); ++it_)
+    writer.push(*it_);
+  writer.finish();
+  return stream;
+}
+
+/** \brief Reads the segments of an interval container of type \c Type from
+    a stream in the stream format, as an input range.
+
+    Segments are read block by block as the range is iterated, so that the
+    reader holds one block at a time. Throws \c binary_format_error if the
+    stream is not in the stream format of \c Type or ends early. */
+template <typename Type>
+  requires binary_serializable<Type>
+class segment_reader {
+public:
+  using domain_type = Type::domain_type;
+  using codomain_type = Type::codomain_type;
+  using interval_type = Type::interval_type;
+  using segment_type = Type::segment_type;
+
+  class iterator {
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = segment_type;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    const segment_type& operator*() const { return _reader->_segment; }
+    const segment_type* operator->() const { return &_reader->_segment; }
+
+    iterator& operator++() {
+      _reader->advance();
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator& it_, std::default_sentinel_t) {
+      return it_.done();
+    }
+
+  private:
+    friend class segment_reader;
+
+    bool done() const { return _reader->_done; }
+
+    explicit iterator(segment_reader* reader) : _reader(reader) {}
+
+    segment_reader* _reader = nullptr;
+  };
+
+  /** Reads the header from \c stream and the first segment */
+  explicit segment_reader(std::istream& stream) : _stream(stream) {
+    binary_header header;
+    read(&header, sizeof(header), "truncated header");
+    if (header.magic != segment_stream_signature)
+      throw binary_format_error("bad signature");
+    detail::check_binary_tags<Type>(header);
+    _chunk = header.count;
+    advance();
+  }
+
+  segment_reader(const segment_reader&) = delete;
+  segment_reader& operator=(const segment_reader&) = delete;
+
+  /// The range can be iterated once
+  iterator begin() { return iterator(this); }
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+private:
+  static constexpr std::size_t record_size =
+      detail::segment_record_size<Type>();
+
+  void read(void* data, std::size_t size, const char* what) {
+    _stream.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    if (static_cast<std::size_t>(_stream.gcount()) != size)
+      throw binary_format_error(what);
+  }
+
+  template <typename Element>
+  Element element(std::size_t array, std::size_t element_size) const {
+    Element value;
+    std::memcpy(&value,
+                _block.data() + array * _size * element_size +
+                    _index * element_size,
+                sizeof(value));
+    return value;
+  }
+
+  /// Decodes the next segment, reading the next block if needed
+  void advance() {
+    if (++_index >= _size) {
+      std::uint64_t size;
+      read(&size, sizeof(size), "truncated stream");
+      if (size == 0) {
+        _done = true;
+        return;
+      }
+      if (size > _chunk)
+        throw binary_format_error("oversized block");
+      _size = static_cast<std::size_t>(size);
+      _index = 0;
+      _block.resize(_size * record_size);
+      read(_block.data(), _block.size(), "truncated block");
+    }
+
+    const std::size_t domain_size = sizeof(domain_type);
+    const auto lower = element<domain_type>(0, domain_size);
+    const auto upper = element<domain_type>(1, domain_size);
+    // Values follow the bounds, the bits follow all of them
+    std::size_t offset = 2 * _size * domain_size;
+    interval_type inter_val;
+    if constexpr (has_dynamic_bounds<interval_type>::value) {
+      std::size_t bits_offset = offset;
+      if constexpr (is_interval_map<Type>::value)
+        bits_offset += _size * sizeof(codomain_type);
+      const auto bits = static_cast<bound_type>(_block[bits_offset + _index]);
+      inter_val = dynamic_interval_traits<interval_type>::construct(
+          lower, upper, interval_bounds(bits));
+    } else
+      inter_val = interval_traits<interval_type>::construct(lower, upper);
+
+    if constexpr (is_interval_map<Type>::value) {
+      codomain_type value;
+      std::memcpy(&value,
+                  _block.data() + offset + _index * sizeof(codomain_type),
+                  sizeof(value));
+      _segment = segment_type(inter_val, value);
+    } else
+      _segment = inter_val;
+  }
+
+  std::istream& _stream;
+  std::uint64_t _chunk = 0;
+  std::vector<std::byte> _block;
+  std::size_t _size = 0;
+  std::size_t _index = 0;
+  segment_type _segment{};
+  bool _done = false;
+};
+
+/** Merges the streams \c left and \c right of segments of \c Type into
+    \c out, in the stream format: The result has the segments of
+    <tt>l += r</tt>, where \c l and \c r are the containers of \c left and
+    \c right, so maps combine the values of overlapping segments with their
+    \c codomain_combine functor.
+
+    The merge holds a number of segments in the order of \c chunk, however
+    long the streams are: Both streams are read a block ahead. Their
+    segments, that lie before the block end that comes first, are added to
+    a window container, the segments of \c left first, those of \c right
+    after. Segments that straddle the block end are cut there, the rest is
+    added in the next round. All segments of the window but the last are
+    then final and are written. */
+template <typename Type>
+  requires binary_serializable<Type>
+std::ostream& merge_segments(std::istream& left, std::istream& right,
+                             std::ostream& out,
+                             std::size_t chunk = segment_stream_chunk) {
+  using interval_type = Type::interval_type;
+  using segment_type = Type::segment_type;
+  using reader_type = segment_reader<Type>;
+
+  assert(chunk >= 2);
+  reader_type left_reader(left);
+  reader_type right_reader(right);
+  std::array<reader_type*, 2> readers = {&left_reader, &right_reader};
+  std::array<typename reader_type::iterator, 2> next = {left_reader.begin(),
+                                                        right_reader.begin()};
+  std::array<std::deque<segment_type>, 2> pending;
+  segment_writer<Type> writer(out, chunk);
+  Type window;
+
+  while (true) {
+    for (std::size_t side = 0; side < 2; ++side)
+      for (; pending[side].size() < chunk && next[side] != readers[side]->end();
+           ++next[side])
+        pending[side].push_back(*next[side]);
+    if (pending[0].empty() && pending[1].empty())
+      break;
+
+    // Segments of a stream, that are not read yet, lie behind the last one
+    // read. Only parts before both of those are final.
+    std::optional<interval_type> cut;
+    for (std::size_t side = 0; side < 2; ++side)
+      if (next[side] != readers[side]->end()) {
+        const interval_type& last =
+            detail::segment_key<Type>(pending[side].back());
+        if (!cut || icl::lower_less(last, *cut))
+          cut = last;
+      }
+
+    for (std::size_t side = 0; side < 2; ++side)
+      while (!pending[side].empty()) {
+        segment_type& head = pending[side].front();
+        interval_type& key = detail::segment_key<Type>(head);
+        if (!cut || icl::exclusive_less(key, *cut)) {
+          // The segments of left are placed, not combined, like those of
+          // the left operand of +=
+          if (side == 0)
+            window.insert(head);
+          else
+            window.add(head);
+          pending[side].pop_front();
+          continue;
+        }
+        const interval_type before = icl::right_subtract(key, *cut);
+        if (!icl::is_empty(before)) {
+          segment_type part = head;
+          detail::segment_key<Type>(part) = before;
+          if (side == 0)
+            window.insert(part);
+          else
+            window.add(part);
+          key = icl::left_subtract(key, before);
+        }
+        break;
+      }
+
+    // The last segment of the window may still join with the next one
+    auto past_ = cut && !window.empty() ? std::prev(window.end())
+                                        : window.end();
+    for (auto it_ = window.begin(); it_ != past_; ++it_)
+      writer.push(*it_);
+    window.erase(window.begin(), past_);
+  }
+  writer.finish();
+  return out;
+}
+
+} // namespace icl
@@ -0,0 +1,470 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/concept/interval_associator.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include "icl/type_traits/is_interval_separator.hpp"
+#include "icl/type_traits/is_interval_splitter.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace icl {
+
+/** \brief The interval container \c Type, partitioned into shards of
+    contiguous key ranges, that are updated by threads in parallel.
+
+    The domain is cut at ascending bounds <tt>b_1 < ... < b_{n-1}</tt> into
+    \c n shards: The keys below \c b_1, those from \c b_i to below
+    <tt>b_{i+1}</tt>, and those from <tt>b_{n-1}</tt> on. Every shard is a
+    container of its own with a lock of its own, so updates of different
+    shards do not wait for each other. Segments that span several shards
+    are cut at the bounds by \c right_subtract and \c left_subtract, and
+    their parts are updated in all of these shards at once, that are locked
+    in ascending order.
+
+    Segments are joined across the bounds when they are read: \c find and
+    \c iterative_size see the segments of \c Type, and \c snapshot yields
+    the joined container, that is iterated and combined with other
+    containers. Queries on elements, \c contains, \c intersects and
+    <tt>operator()</tt>, are answered by the shards that hold them.
+    Containers that keep the borders of their segments, splitting and
+    separating ones, cannot be sharded, because the bounds would add
+    borders to them. */
+template <typename Type>
+  requires(is_interval_container<Type>::value &&
+           !is_interval_splitter<Type>::value &&
+           !is_interval_separator<Type>::value &&
+           Interval_Stabbing::stabbable<Type>)
+class sharded {
+public:
+  /// The type of the shards
+  using container_type = Type;
+  using domain_type = Type::domain_type;
+  using domain_compare = Type::domain_compare;
+  using codomain_type = Type::codomain_type;
+  using interval_type = Type::interval_type;
+  using element_type = Type::element_type;
+  using segment_type = Type::segment_type;
+  using size_type = Type::size_type;
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+
+  /** Empty container with the shards between \c bounds, that are sorted
+      and made unique */
+  explicit sharded(std::vector<domain_type> bounds)
+      : _bounds(std::move(bounds)) {
+    std::sort(_bounds.begin(), _bounds.end(), domain_compare());
+    _bounds.erase(std::unique(_bounds.begin(), _bounds.end(),
+                              [](const domain_type& left,
+                                 const domain_type& right) {
+                                return !domain_compare()(left, right);
+                              }),
+                  _bounds.end());
+    _shards = std::vector<shard>(_bounds.size() + 1);
+  }
+
+  /** The segments of \c object, in shards between \c bounds */
+  sharded(const Type& object, std::vector<domain_type> bounds)
+      : sharded(std::move(bounds)) {
+    for (const auto& segment : object)
+      cut(key_of(segment), [&](std::size_t index, const interval_type& part) {
+        Type& shard_object = _shards[index].object;
+        shard_object.add(shard_object.end(), with_key(segment, part));
+      });
+  }
+
+  /// The number of shards
+  std::size_t shard_count() const { return _shards.size(); }
+
+  /// The shard that holds \c key
+  std::size_t shard_of(const domain_type& key) const {
+    return static_cast<std::size_t>(
+        std::upper_bound(_bounds.begin(), _bounds.end(), key,
+                         domain_compare()) -
+        _bounds.begin());
+  }
+
+  //==========================================================================
+  //= Reading
+  //==========================================================================
+
+  /** The joined container of the segments of all shards */
+  Type snapshot() const {
+    const auto locks = lock_shared(0, _shards.size() - 1);
+    Type object;
+    auto prior_ = object.end();
+    for (const shard& part : _shards)
+      for (const auto& segment : part.object)
+        prior_ = object.add(prior_, segment);
+    return object;
+  }
+
+  [[nodiscard]] bool empty() const {
+    const auto locks = lock_shared(0, _shards.size() - 1);
+    return std::ranges::all_of(
+        _shards, [](const shard& part) { return part.object.empty(); });
+  }
+
+  /** Number of segments of the joined container */
+  [[nodiscard]] std::size_t iterative_size() const {
+    const auto locks = lock_shared(0, _shards.size() - 1);
+    std::size_t size = 0;
+    const Type* previous = nullptr;
+    for (const shard& part : _shards) {
+      if (part.object.empty())
+        continue;
+      size += part.object.iterative_size();
+      if (previous != nullptr &&
+          joinable(*std::prev(previous->end()), *part.object.begin()))
+        --size;
+      previous = &part.object;
+    }
+    return size;
+  }
+
+  /** A copy of the segment of the joined container, that contains \c key,
+      if there is one */
+  std::optional<segment_type> find(const domain_type& key) const {
+    const std::size_t home = shard_of(key);
+    std::size_t first = home;
+    std::size_t last = home;
+    // The shards, that the segment spans, are locked, or the locked range
+    // is widened and locked again
+    for (;;) {
+      const auto locks = lock_shared(first, last);
+      const Type& object = _shards[home].object;
+      const auto it_ = object.find(key);
+      if (it_ == object.end())
+        return std::nullopt;
+      segment_type found = *it_;
+
+      std::size_t index = home;
+      while (index > first && joins_left(_shards[index - 1].object, found))
+        --index;
+      const bool widen_left = index == first && is_first(index, found);
+      index = home;
+      while (index < last && joins_right(found, _shards[index + 1].object))
+        ++index;
+      const bool widen_right = index == last && is_last(index, found);
+
+      if (!widen_left && !widen_right)
+        return found;
+      first -= widen_left;
+      last += widen_right;
+    }
+  }
+
+  /** Total select function: The value that \c key is mapped to */
+  codomain_type operator()(const domain_type& key) const
+    requires is_interval_map<Type>::value
+  {
+    const std::size_t index = shard_of(key);
+    const std::shared_lock lock(_shards[index].mutex);
+    return _shards[index].object(key);
+  }
+
+  /** Does the container contain the element \c key? */
+  bool contains(const domain_type& key) const {
+    const std::size_t index = shard_of(key);
+    const std::shared_lock lock(_shards[index].mutex);
+    return icl::contains(_shards[index].object, key);
+  }
+
+  /** Are all elements of \c inter_val contained? */
+  bool contains(const interval_type& inter_val) const {
+    return all_parts(inter_val, [](const Type& object, const auto& part) {
+      return icl::contains(object, part);
+    });
+  }
+
+  /** Are all elements of \c segment contained with its value? */
+  bool contains(const segment_type& segment) const
+    requires is_interval_map<Type>::value
+  {
+    return all_parts(segment, [](const Type& object, const auto& part) {
+      return icl::contains(object, part);
+    });
+  }
+
+  /** Does the container contain the element \c key? */
+  bool intersects(const domain_type& key) const { return contains(key); }
+
+  /** Do \c inter_val and the container have elements in common? */
+  bool intersects(const interval_type& inter_val) const {
+    return !all_parts(inter_val, [](const Type& object, const auto& part) {
+      return !icl::intersects(object, part);
+    });
+  }
+
+  //==========================================================================
+  //= Writing
+  //==========================================================================
+
+  sharded& add(const element_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.add(part);
+    });
+  }
+
+  sharded& add(const segment_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.add(part);
+    });
+  }
+
+  sharded& subtract(const element_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.subtract(part);
+    });
+  }
+
+  sharded& subtract(const segment_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.subtract(part);
+    });
+  }
+
+  sharded& insert(const element_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.insert(part);
+    });
+  }
+
+  sharded& insert(const segment_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.insert(part);
+    });
+  }
+
+  sharded& erase(const element_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.erase(part);
+    });
+  }
+
+  sharded& erase(const segment_type& operand) {
+    return update(operand, [](Type& object, const auto& part) {
+      object.erase(part);
+    });
+  }
+
+  /** Sets the values of the elements of \c operand to its value, as
+      \c set_at does */
+  sharded& set(const element_type& operand)
+    requires is_interval_map<Type>::value
+  {
+    return update(operand, [](Type& object, const auto& part) {
+      object.set(part);
+    });
+  }
+
+  sharded& set(const segment_type& operand)
+    requires is_interval_map<Type>::value
+  {
+    return update(operand, [](Type& object, const auto& part) {
+      object.set(part);
+    });
+  }
+
+  /** Adds the segments of \c operand */
+  sharded& operator+=(const Type& operand) {
+    for (const auto& segment : operand)
+      add(segment_type(segment));
+    return *this;
+  }
+
+  /** Subtracts the segments of \c operand */
+  sharded& operator-=(const Type& operand) {
+    for (const auto& segment : operand)
+      subtract(segment_type(segment));
+    return *this;
+  }
+
+  void clear() {
+    const auto locks = lock(0, _shards.size() - 1);
+    for (shard& part : _shards)
+      part.object.clear();
+  }
+
+private:
+  /// A shard on cache lines of its own
+  struct alignas(64) shard {
+    mutable std::shared_mutex mutex;
+    Type object;
+  };
+
+  /// The interval of a segment or an interval
+  template <typename Segment>
+  static const interval_type& key_of(const Segment& segment) {
+    if constexpr (std::is_same_v<Segment, interval_type>)
+      return segment;
+    else
+      return segment.first;
+  }
+
+  /// The part \c part of a segment or an interval
+  template <typename Segment>
+  static Segment with_key(const Segment& segment, const interval_type& part) {
+    if constexpr (std::is_same_v<Segment, interval_type>)
+      return part;
+    else
+      return Segment(part, segment.second);
+  }
+
+  /// Do \c left and the following \c right join to one segment?
+  template <typename Left, typename Right>
+  static bool joinable(const Left& left, const Right& right) {
+    if (!icl::touches(key_of(left), key_of(right)))
+      return false;
+    if constexpr (is_interval_map<Type>::value)
+      return left.second == right.second;
+    else
+      return true;
+  }
+
+  /// Does \c segment of shard \c index begin at its lower bound?
+  bool is_first(std::size_t index, const segment_type& segment) const {
+    return index > 0 &&
+           icl::contains(key_of(segment),
+                         Interval_Stabbing::probe<Type>(_bounds[index - 1]));
+  }
+
+  /// Does \c segment of shard \c index end at its upper bound?
+  bool is_last(std::size_t index, const segment_type& segment) const {
+    return index < _bounds.size() &&
+           icl::touches(key_of(segment),
+                        Interval_Stabbing::probe<Type>(_bounds[index]));
+  }
+
+  /// Joins the last segment of \c object to \c segment, if they join
+  static bool joins_left(const Type& object, segment_type& segment) {
+    if (object.empty())
+      return false;
+    const segment_type last = *std::prev(object.end());
+    if (!joinable(last, segment))
+      return false;
+    segment = with_key(segment, icl::hull(key_of(last), key_of(segment)));
+    return true;
+  }
+
+  /// Joins \c segment to the first segment of \c object, if they join
+  static bool joins_right(segment_type& segment, const Type& object) {
+    if (object.empty())
+      return false;
+    const segment_type first = *object.begin();
+    if (!joinable(segment, first))
+      return false;
+    segment = with_key(segment, icl::hull(key_of(segment), key_of(first)));
+    return true;
+  }
+
+  /** Calls <tt>visit(index, part)</tt> for the nonempty parts of
+      \c inter_val in the shards \c index, in ascending order. */
+  template <typename Visit>
+  void cut(const interval_type& inter_val, Visit visit) const {
+    if (icl::is_empty(inter_val))
+      return;
+    // The part of an interval below a bound
+    const auto below = [](const interval_type& rest,
+                          const domain_type& bound) {
+      return icl::right_subtract(rest, Interval_Stabbing::probe<Type>(bound));
+    };
+    // The first shard is that of the first bound, that has a part of
+    // inter_val below it
+    const auto bound_ = std::partition_point(
+        _bounds.begin(), _bounds.end(), [&](const domain_type& bound) {
+          return icl::is_empty(below(inter_val, bound));
+        });
+    std::size_t index = static_cast<std::size_t>(bound_ - _bounds.begin());
+    interval_type rest = inter_val;
+    for (; index < _bounds.size(); ++index) {
+      const interval_type part = below(rest, _bounds[index]);
+      if (icl::is_empty(part))
+        continue;
+      visit(index, part);
+      rest = icl::left_subtract(rest, part);
+      if (icl::is_empty(rest))
+        return;
+    }
+    visit(index, rest);
+  }
+
+  /// Applies \c updater to the parts of \c operand in their shards
+  template <typename Operand, typename Updater>
+  sharded& update(const Operand& operand, Updater updater) {
+    if constexpr (std::is_same_v<Operand, element_type> &&
+                  !std::is_same_v<element_type, segment_type>) {
+      const std::size_t index = shard_of(key_of_element(operand));
+      const std::unique_lock guard(_shards[index].mutex);
+      updater(_shards[index].object, operand);
+    } else {
+      std::vector<std::pair<std::size_t, interval_type>> parts;
+      cut(key_of(operand), [&](std::size_t index, const interval_type& part) {
+        parts.emplace_back(index, part);
+      });
+      if (parts.empty())
+        return *this;
+      const auto locks = lock(parts.front().first, parts.back().first);
+      for (const auto& [index, part] : parts)
+        updater(_shards[index].object, with_key(operand, part));
+    }
+    return *this;
+  }
+
+  static const domain_type& key_of_element(const element_type& operand) {
+    if constexpr (is_interval_map<Type>::value)
+      return operand.key;
+    else
+      return operand;
+  }
+
+  /// Is \c test true for the parts of \c operand in their shards?
+  template <typename Operand, typename Test>
+  bool all_parts(const Operand& operand, Test test) const {
+    std::vector<std::pair<std::size_t, interval_type>> parts;
+    cut(key_of(operand), [&](std::size_t index, const interval_type& part) {
+      parts.emplace_back(index, part);
+    });
+    if (parts.empty())
+      return true;
+    const auto locks = lock_shared(parts.front().first, parts.back().first);
+    return std::ranges::all_of(parts, [&](const auto& indexed) {
+      return test(_shards[indexed.first].object,
+                  with_key(operand, indexed.second));
+    });
+  }
+
+  /// Locks the shards <tt>[first,last]</tt> in ascending order
+  std::vector<std::unique_lock<std::shared_mutex>> lock(std::size_t first,
+                                                        std::size_t last) {
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    locks.reserve(last - first + 1);
+    for (std::size_t index = first; index <= last; ++index)
+      locks.emplace_back(_shards[index].mutex);
+    return locks;
+  }
+
+  std::vector<std::shared_lock<std::shared_mutex>>
+  lock_shared(std::size_t first, std::size_t last) const {
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(last - first + 1);
+    for (std::size_t index = first; index <= last; ++index)
+      locks.emplace_back(_shards[index].mutex);
+    return locks;
+  }
+
+  /// The lower bounds of the shards but the first one
+  std::vector<domain_type> _bounds;
+  std::vector<shard> _shards;
+};
+
+} // namespace icl
@@ -4,6 +4,7 @@
 #include "icl/interval_map.hpp"
 #include "icl/interval_set.hpp"
 #include "icl/type_traits/interval_type_default.hpp"
+#include <memory_resource>
 
 namespace icl {
 
@@ -14,22 +15,24 @@ template <typename DomainT, typename CodomainT, class Traits = partial_absorber,
           template <typename> typename Combine = inplace_plus,
           template <typename> typename Section = inter_section,
           typename Interval = interval_type_default<DomainT, Compare>::type,
-          template <typename> typename Alloc = std::allocator>
+          template <typename> typename Alloc = std::allocator,
+          typename Storage = tree_storage>
 class split_interval_map
     : public interval_base_map<
           split_interval_map<DomainT, CodomainT, Traits, Compare, Combine,
-                             Section, Interval, Alloc>,
+                             Section, Interval, Alloc, Storage>,
           DomainT, CodomainT, Traits, Compare, Combine, Section, Interval,
-          Alloc> {
+          Alloc, Storage> {
 public:
   using traits = Traits;
   using type = split_interval_map;
   using joint_type = interval_map<DomainT, CodomainT, Traits, Compare, Combine,
-                                  Section, Interval, Alloc>;
+                                  Section, Interval, Alloc, Storage>;
   using overloadable_type = type;
 
-  using base_type = interval_base_map<type, DomainT, CodomainT, Traits, Compare,
-                                      Combine, Section, Interval, Alloc>;
+  using base_type =
+      interval_base_map<type, DomainT, CodomainT, Traits, Compare, Combine,
+                        Section, Interval, Alloc, Storage>;
 
   using domain_type = DomainT;
   using codomain_type = CodomainT;
@@ -41,6 +44,8 @@ public:
   using domain_mapping_type = typename base_type::domain_mapping_type;
   using interval_mapping_type = typename base_type::interval_mapping_type;
   using ImplMapT = typename base_type::ImplMapT;
+  using storage_type = typename base_type::storage_type;
+  using allocator_type = typename base_type::allocator_type;
 
   using codomain_combine = typename base_type::codomain_combine;
 
@@ -60,6 +65,13 @@ public:
   /// Copy constructor
   split_interval_map(const split_interval_map& src) : base_type(src) {}
 
+  /// Constructor for the empty object that allocates from \c alloc
+  explicit split_interval_map(const allocator_type& alloc) : base_type(alloc) {}
+
+  /// Copy constructor that allocates from \c alloc
+  split_interval_map(const split_interval_map& src, const allocator_type& alloc)
+      : base_type(src, alloc) {}
+
   explicit split_interval_map(const domain_mapping_type& base_pair)
       : base_type() {
     this->add(base_pair);
@@ -70,19 +82,22 @@ public:
   }
 
   /// Assignment from a base interval_map.
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   void
   assign(const interval_base_map<SubType, DomainT, CodomainT, Traits, Compare,
-                                 Combine, Section, Interval, Alloc>& src) {
+                                 Combine, Section, Interval, Alloc, SrcStorage>&
+             src) {
     this->clear();
     this->_map.insert(src.begin(), src.end());
+    this->recount();
   }
 
   /// Assignment operator for base type
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   split_interval_map& operator=(
       const interval_base_map<SubType, DomainT, CodomainT, Traits, Compare,
-                              Combine, Section, Interval, Alloc>& src) {
+                              Combine, Section, Interval, Alloc, SrcStorage>&
+          src) {
     this->assign(src);
     return *this;
   }
@@ -94,6 +109,10 @@ public:
   /// Move constructor
   split_interval_map(split_interval_map&& src) : base_type(std::move(src)) {}
 
+  /// Move constructor that allocates from \c alloc
+  split_interval_map(split_interval_map&& src, const allocator_type& alloc)
+      : base_type(std::move(src), alloc) {}
+
   /// Move assignment operator
   split_interval_map& operator=(split_interval_map src) {
     base_type::operator=(std::move(src));
@@ -106,8 +125,15 @@ private:
   // Private functions that shall be accessible by the baseclass:
   friend class interval_base_map<
       split_interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
-                         Interval, Alloc>,
-      DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc>;
+                         Interval, Alloc, Storage>,
+      DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc,
+      Storage>;
+
+  /// The same map type on a different storage policy
+  template <typename OtherStorage>
+  using rebind_storage =
+      split_interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                         Interval, Alloc, OtherStorage>;
 
   iterator handle_inserted(iterator it_) const { return it_; }
   void handle_inserted(iterator, iterator) const {}
@@ -143,20 +169,49 @@ private:
 
   void handle_reinserted(iterator) {}
 
-  template <typename Combiner>
+  template <typename Combiner, typename CoValT>
   void gap_insert_at(iterator& it_, iterator prior_,
-                     const interval_type& end_gap,
-                     const codomain_type& co_val) {
+                     const interval_type& end_gap, CoValT&& co_val) {
     if (on_absorbtion<type, Combiner,
                       Traits::absorbs_identities>::is_absorbable((*it_)
                                                                      .second)) {
       this->_map.erase(it_);
-      it_ = this->template gap_insert<Combiner>(prior_, end_gap, co_val);
+      it_ = this->template gap_insert<Combiner>(prior_, end_gap,
+                                                std::forward<CoValT>(co_val));
     } else
-      it_ = this->template gap_insert<Combiner>(it_, end_gap, co_val);
+      it_ = this->template gap_insert<Combiner>(it_, end_gap,
+                                                std::forward<CoValT>(co_val));
   }
 };
 
+/** \brief A split_interval_map on contiguous storage: Intended for maps
+    that are built once and queried often. */
+template <typename DomainT, typename CodomainT, class Traits = partial_absorber,
+          template <typename> typename Compare = std::less,
+          template <typename> typename Combine = inplace_plus,
+          template <typename> typename Section = inter_section,
+          typename Interval = interval_type_default<DomainT, Compare>::type,
+          template <typename> typename Alloc = std::allocator>
+using flat_split_interval_map =
+    split_interval_map<DomainT, CodomainT, Traits, Compare, Combine, Section,
+                       Interval, Alloc, flat_storage>;
+
+namespace pmr {
+/// A split_interval_map that allocates from a \c std::pmr::memory_resource
+template <typename DomainT, typename CodomainT,
+          typename Traits = icl::partial_absorber,
+          template <typename> typename Compare = std::less,
+          template <typename> typename Combine = icl::inplace_plus,
+          template <typename> typename Section = icl::inter_section,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          typename Storage = tree_storage>
+using split_interval_map =
+    icl::split_interval_map<DomainT, CodomainT, Traits, Compare, Combine,
+                            Section, Interval, std::pmr::polymorphic_allocator,
+                            Storage>;
+} // namespace pmr
+
 //-----------------------------------------------------------------------------
 // type traits
 //-----------------------------------------------------------------------------
@@ -164,9 +219,9 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_map<split_interval_map<DomainT, CodomainT, Traits, Compare, Combine,
-                                 Section, Interval, Alloc>> {
+                                 Section, Interval, Alloc, Storage>> {
   using type = is_map;
   static constexpr bool value = true;
 };
@@ -175,9 +230,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct has_inverse<split_interval_map<DomainT, CodomainT, Traits, Compare,
-                                      Combine, Section, Interval, Alloc>> {
+                                      Combine, Section, Interval, Alloc,
+                                      Storage>> {
   using type = has_inverse;
   static constexpr bool value = has_inverse<CodomainT>::value;
 };
@@ -186,9 +242,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_interval_container<split_interval_map<
-    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc>> {
+    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc,
+    Storage>> {
   using type = is_interval_container;
   static constexpr bool value = true;
 };
@@ -197,9 +254,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_interval_splitter<split_interval_map<
-    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc>> {
+    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc,
+    Storage>> {
   using type = is_interval_splitter;
   static constexpr bool value = true;
 };
@@ -208,9 +266,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct absorbs_identities<split_interval_map<
-    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc>> {
+    DomainT, CodomainT, Traits, Compare, Combine, Section, Interval, Alloc,
+    Storage>> {
   using type = absorbs_identities;
   static constexpr bool value = Traits::absorbs_identities;
 };
@@ -219,9 +278,9 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct is_total<split_interval_map<DomainT, CodomainT, Traits, Compare, Combine,
-                                   Section, Interval, Alloc>> {
+                                   Section, Interval, Alloc, Storage>> {
   using type = is_total;
   static constexpr bool value = Traits::is_total;
 };
@@ -230,9 +289,10 @@ template <typename DomainT, typename CodomainT, typename Traits,
           template <typename> typename Compare,
           template <typename> typename Combine,
           template <typename> typename Section, typename Interval,
-          template <typename> typename Alloc>
+          template <typename> typename Alloc, typename Storage>
 struct type_to_string<split_interval_map<DomainT, CodomainT, Traits, Compare,
-                                         Combine, Section, Interval, Alloc>> {
+                                         Combine, Section, Interval, Alloc,
+                                         Storage>> {
   static std::string apply() {
     return "sp_itv_map<" + type_to_string<DomainT>::apply() + "," +
            type_to_string<CodomainT>::apply() + "," +
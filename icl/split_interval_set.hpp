@@ -4,6 +4,7 @@
 #include "icl/interval_set.hpp"
 #include "icl/type_traits/interval_type_default.hpp"
 #include "icl/type_traits/is_interval_splitter.hpp"
+#include <memory_resource>
 
 namespace icl {
 
@@ -12,16 +13,18 @@ namespace icl {
 template <typename DomainT, template <typename> typename Compare = std::less,
           typename Interval =
               typename icl::interval_type_default<DomainT, Compare>::type,
-          template <typename> typename Alloc = std::allocator>
+          template <typename> typename Alloc = std::allocator,
+          typename Storage = tree_storage>
 class split_interval_set
     : public interval_base_set<
-          split_interval_set<DomainT, Compare, Interval, Alloc>, DomainT,
-          Compare, Interval, Alloc> {
+          split_interval_set<DomainT, Compare, Interval, Alloc, Storage>,
+          DomainT, Compare, Interval, Alloc, Storage> {
 public:
-  using type = split_interval_set<DomainT, Compare, Interval, Alloc>;
-  using base_type = interval_base_set<type, DomainT, Compare, Interval, Alloc>;
+  using type = split_interval_set<DomainT, Compare, Interval, Alloc, Storage>;
+  using base_type =
+      interval_base_set<type, DomainT, Compare, Interval, Alloc, Storage>;
 
-  using joint_type = interval_set<DomainT, Compare, Interval, Alloc>;
+  using joint_type = interval_set<DomainT, Compare, Interval, Alloc, Storage>;
   using overloadable_type = type;
   using key_object_type = type;
 
@@ -55,6 +58,9 @@ public:
   /// elements
   using atomized_type = typename base_type::atomized_type;
 
+  /// The storage policy of the set
+  using storage_type = typename base_type::storage_type;
+
   /// Container type for the implementation
   using ImplSetT = typename base_type::ImplSetT;
 
@@ -82,10 +88,18 @@ public:
   /// Copy constructor
   split_interval_set(const split_interval_set& src) : base_type(src) {}
 
-  /// Copy constructor for base_type
-  template <typename SubType>
+  /// Constructor for the empty object that allocates from \c alloc
+  explicit split_interval_set(const allocator_type& alloc) : base_type(alloc) {}
+
+  /// Copy constructor that allocates from \c alloc
+  split_interval_set(const split_interval_set& src, const allocator_type& alloc)
+      : base_type(src, alloc) {}
+
+  /// Copy constructor for base_type of any storage policy
+  template <typename SubType, typename SrcStorage>
   split_interval_set(const interval_base_set<SubType, DomainT, Compare,
-                                             Interval, Alloc>& src) {
+                                             Interval, Alloc, SrcStorage>&
+                         src) {
     this->assign(src);
   }
 
@@ -99,18 +113,19 @@ public:
   }
 
   /// Assignment from a base interval_set.
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   void assign(const interval_base_set<SubType, DomainT, Compare, Interval,
-                                      Alloc>& src) {
+                                      Alloc, SrcStorage>& src) {
     this->clear();
     this->_set.insert(src.begin(), src.end());
+    this->recount();
   }
 
   /// Assignment operator for base type
-  template <typename SubType>
+  template <typename SubType, typename SrcStorage>
   split_interval_set&
-  operator=(const interval_base_set<SubType, DomainT, Compare, Interval, Alloc>&
-                src) {
+  operator=(const interval_base_set<SubType, DomainT, Compare, Interval, Alloc,
+                                    SrcStorage>& src) {
     this->assign(src);
     return *this;
   }
@@ -122,6 +137,10 @@ public:
   /// Move constructor
   split_interval_set(split_interval_set&& src) : base_type(std::move(src)) {}
 
+  /// Move constructor that allocates from \c alloc
+  split_interval_set(split_interval_set&& src, const allocator_type& alloc)
+      : base_type(std::move(src), alloc) {}
+
   /// Move assignment operator
   split_interval_set& operator=(split_interval_set src) {
     base_type::operator=(std::move(src));
@@ -132,8 +151,13 @@ public:
 private:
   // Private functions that shall be accessible by the baseclass:
   friend class interval_base_set<
-      split_interval_set<DomainT, Compare, Interval, Alloc>, DomainT, Compare,
-      Interval, Alloc>;
+      split_interval_set<DomainT, Compare, Interval, Alloc, Storage>, DomainT,
+      Compare, Interval, Alloc, Storage>;
+
+  /// The same set type on a different storage policy
+  template <typename OtherStorage>
+  using rebind_storage =
+      split_interval_set<DomainT, Compare, Interval, Alloc, OtherStorage>;
 
   iterator handle_inserted(iterator inserted_) { return inserted_; }
 
@@ -166,32 +190,53 @@ private:
   }
 };
 
+/** \brief A split_interval_set on contiguous storage: Intended for sets
+    that are built once and queried often. */
+template <typename DomainT, template <typename> typename Compare = std::less,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          template <typename> typename Alloc = std::allocator>
+using flat_split_interval_set =
+    split_interval_set<DomainT, Compare, Interval, Alloc, flat_storage>;
+
+namespace pmr {
+/// A split_interval_set that allocates from a \c std::pmr::memory_resource
+template <typename DomainT, template <typename> typename Compare = std::less,
+          typename Interval =
+              typename icl::interval_type_default<DomainT, Compare>::type,
+          typename Storage = tree_storage>
+using split_interval_set =
+    icl::split_interval_set<DomainT, Compare, Interval,
+                            std::pmr::polymorphic_allocator, Storage>;
+} // namespace pmr
+
 //-----------------------------------------------------------------------------
 // type traits
 //-----------------------------------------------------------------------------
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
-struct is_set<icl::split_interval_set<DomainT, Compare, Interval, Alloc>> {
-  using type =
-      is_set<icl::split_interval_set<DomainT, Compare, Interval, Alloc>>;
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
+struct is_set<
+    icl::split_interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
+  using type = is_set;
   static constexpr bool value = true;
 };
 
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
 struct is_interval_container<
-    icl::split_interval_set<DomainT, Compare, Interval, Alloc>> {
-  using type = is_interval_container<
-      icl::split_interval_set<DomainT, Compare, Interval, Alloc>>;
+    icl::split_interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
+  using type = is_interval_container;
   static constexpr bool value = true;
 };
 
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
 struct is_interval_splitter<
-    icl::split_interval_set<DomainT, Compare, Interval, Alloc>> {
-  using type = is_interval_splitter<
-      icl::split_interval_set<DomainT, Compare, Interval, Alloc>>;
+    icl::split_interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
+  using type = is_interval_splitter;
   static constexpr bool value = true;
 };
 
@@ -199,9 +244,10 @@ struct is_interval_splitter<
 // type representation
 //-----------------------------------------------------------------------------
 template <typename DomainT, template <typename> typename Compare,
-          typename Interval, template <typename> typename Alloc>
+          typename Interval, template <typename> typename Alloc,
+          typename Storage>
 struct type_to_string<
-    icl::split_interval_set<DomainT, Compare, Interval, Alloc>> {
+    icl::split_interval_set<DomainT, Compare, Interval, Alloc, Storage>> {
   static std::string apply() {
     return "sp_itv_set<" + type_to_string<DomainT>::apply() + ">";
   }
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "icl/detail/augmented_map.hpp"
+#include "icl/detail/flat_map.hpp"
+#include "icl/detail/flat_set.hpp"
+#include "icl/detail/segment_aggregate.hpp"
+#include <map>
+#include <set>
+
+namespace icl {
+
+/** \brief Storage policy: Segments of an interval container are nodes of a
+    balanced tree. Updates are logarithmic, iterators are stable. */
+struct tree_storage {
+  static constexpr bool is_contiguous = false;
+  static constexpr bool caches_measure = true;
+  static constexpr bool is_augmented = false;
+
+  template <typename KeyT, typename DataT, typename Compare, typename Alloc>
+  using map_type = std::map<KeyT, DataT, Compare, Alloc>;
+
+  template <typename KeyT, typename Compare, typename Alloc>
+  using set_type = std::set<KeyT, Compare, Alloc>;
+};
+
+/** \brief Storage policy: Segments of an interval container are kept in
+    sorted contiguous arrays. Lookups are binary searches over cache resident
+    arrays. Updates move the tail of the arrays, so this policy is intended
+    for containers that are built once and queried often. Iterators are
+    invalidated by updates. */
+struct flat_storage {
+  static constexpr bool is_contiguous = true;
+  static constexpr bool caches_measure = true;
+  static constexpr bool is_augmented = false;
+
+  template <typename KeyT, typename DataT, typename Compare, typename Alloc>
+  using map_type = detail::flat_map<KeyT, DataT, Compare, Alloc>;
+
+  template <typename KeyT, typename Compare, typename Alloc>
+  using set_type = detail::flat_set<KeyT, Compare, Alloc>;
+};
+
+/** \brief Storage policy: Segments of an interval map are nodes of a
+    balanced tree, every node keeps the aggregate of the values of its
+    subtree, see \c segment_aggregate. Maps answer \c aggregate queries over
+    any interval in logarithmic time. Updates refresh the aggregates of the
+    segments they change and of their ancestors. Sets are stored as with
+    \c tree_storage.
+
+    Mapped values must be changed through the interface of the map only,
+    values that are assigned through iterators leave stale aggregates. */
+struct augmented_storage {
+  static constexpr bool is_contiguous = false;
+  static constexpr bool caches_measure = true;
+  static constexpr bool is_augmented = true;
+
+  template <typename KeyT, typename DataT, typename Compare, typename Alloc,
+            typename Combine>
+  using map_type =
+      detail::augmented_map<KeyT, DataT, Compare, Alloc,
+                            detail::segment_aggregate<KeyT, DataT, Combine>>;
+
+  template <typename KeyT, typename Compare, typename Alloc>
+  using set_type = std::set<KeyT, Compare, Alloc>;
+};
+
+/** \brief Storage policy adaptor: Containers on \c Storage keep no running
+    totals of their cardinality and length.
+
+    By default, interval containers over discrete domains update these
+    totals with every change, so that \c size(), \c cardinality and
+    \c length are constant time. Containers whose sizes are never queried
+    can save the bookkeeping with \c uncached<Storage>, the queries then
+    iterate over all segments. */
+template <typename Storage> struct uncached : Storage {
+  static constexpr bool caches_measure = false;
+};
+
+/** \brief The implementing map of an interval map on \c Storage. Augmented
+    policies aggregate the mapped values by the combine functor of the map,
+    so they are passed \c Combine as well. */
+template <typename Storage, typename KeyT, typename DataT, typename Compare,
+          typename Alloc, typename Combine>
+struct storage_map {
+  using type = Storage::template map_type<KeyT, DataT, Compare, Alloc>;
+};
+
+template <typename Storage, typename KeyT, typename DataT, typename Compare,
+          typename Alloc, typename Combine>
+  requires Storage::is_augmented
+struct storage_map<Storage, KeyT, DataT, Compare, Alloc, Combine> {
+  using type =
+      Storage::template map_type<KeyT, DataT, Compare, Alloc, Combine>;
+};
+
+} // namespace icl
@@ -9,10 +9,8 @@ template <typename Type> struct identity_element {
   Type operator()() const { return value(); }
 };
 
-template <typename Type> Type identity_element<Type>::value() {
-  static Type _value;
-  return _value;
-}
+// The identity is returned as a prvalue, so absorbtion checks do not copy
+template <typename Type> Type identity_element<Type>::value() { return Type(); }
 
 template <>
 inline std::string unary_template_to_string<identity_element>::apply() {
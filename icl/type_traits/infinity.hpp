@@ -14,14 +14,15 @@ template <typename Type> struct has_std_infinity {
   using type = has_std_infinity;
   static constexpr bool value =
       std::conjunction_v<is_numeric<Type>,
-                         typename std::numeric_limits<Type>::has_infinity>;
+                         std::bool_constant<
+                             std::numeric_limits<Type>::has_infinity>>;
 };
 
 template <typename Type> struct has_max_infinity {
   using type = has_max_infinity;
   static constexpr bool value = std::conjunction_v<
-      is_numeric<Type>,
-      std::negation<typename std::numeric_limits<Type>::has_infinity>>;
+      is_numeric<Type>, std::negation<std::bool_constant<
+                            std::numeric_limits<Type>::has_infinity>>>;
 };
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,378 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/detail/interval_stabbing_algo.hpp"
+#include "icl/persistent.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace icl {
+
+/** \brief The interval map \c Type with its history: Each update makes a
+    new version of the map, and the versions within the retention may be
+    queried by \c find_at, rebuilt by \c at and compared by \c diff.
+
+    An update records a change, that holds the segments the update
+    replaced, and the region of the map, they were all of. So a change is
+    as small as the update, and undoing it gives the version before. Every
+    \c checkpoint_interval versions, the map is kept as a snapshot of the
+    \c persistent map, that shares its nodes with the other versions. A
+    version is found from the first checkpoint at or after it, by undoing
+    the changes between them, so queries of old versions take time for at
+    most \c checkpoint_interval changes.
+
+    The versions older than the retention are dropped by \c compact, which
+    updates call when the dropped versions amount to a checkpoint
+    interval. */
+template <typename Type>
+  requires is_interval_map<Type>::value
+class versioned {
+public:
+  using container_type = Type;
+  using domain_type = Type::domain_type;
+  using codomain_type = Type::codomain_type;
+  using interval_type = Type::interval_type;
+  using element_type = Type::element_type;
+  using segment_type = Type::segment_type;
+  using persistent_type = persistent<Type>;
+  using version_type = std::uint64_t;
+  using size_type = std::size_t;
+
+  /// Versions between snapshots of the map
+  static constexpr size_type checkpoint_interval = 16;
+
+  /// The retention that keeps all versions
+  static constexpr size_type all_versions =
+      std::numeric_limits<size_type>::max();
+
+  /** The elements that two versions map to different values, see \c diff */
+  struct difference {
+    /// The segments of the first version, with the values it had
+    Type removed;
+    /// The segments of the second version, with the values it has
+    Type added;
+  };
+
+  //==========================================================================
+  //= Construct, copy, destruct
+  //==========================================================================
+  versioned() : versioned(Type()) {}
+
+  /** \c object as version 0 */
+  explicit versioned(const Type& object) : _current(object) {
+    _checkpoints.push_back(_current);
+  }
+
+  //==========================================================================
+  //= Versions
+  //==========================================================================
+
+  /** The version of the map, that is the number of its updates */
+  version_type version() const { return _version; }
+
+  /** The oldest version that may be queried */
+  version_type oldest_version() const { return _oldest; }
+
+  /** The number of versions before the current one, that are kept */
+  size_type retention() const { return _retention; }
+
+  /** Keeps the last \c versions versions before the current one. Older
+      versions are dropped, those within the former retention at once. */
+  versioned& retain(size_type versions) {
+    _retention = versions;
+    compact();
+    return *this;
+  }
+
+  /** Drops the versions older than the retention */
+  void compact() {
+    if (_version - _oldest <= _retention)
+      return;
+    const version_type oldest = _version - _retention;
+    _changes.erase(_changes.begin(),
+                   _changes.begin() +
+                       static_cast<std::ptrdiff_t>(oldest - _oldest));
+    _oldest = oldest;
+    while (checkpoint_version(0) < _oldest) {
+      _checkpoints.pop_front();
+      ++_first_checkpoint;
+    }
+  }
+
+  /** The current version of the map */
+  const persistent_type& current() const { return _current; }
+
+  //==========================================================================
+  //= Selection
+  //==========================================================================
+
+  /** The value of the segment of version \c at, that holds \c key, if
+      there is one. It takes time for at most \c checkpoint_interval
+      changes. */
+  std::optional<codomain_type> find_at(version_type at,
+                                       const domain_type& key) const
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    assert(_oldest <= at && at <= _version);
+    const version_type checkpoint = checkpoint_after(at);
+    // The first change after the version, whose region holds the key, had
+    // the value of the version
+    for (version_type next = at + 1; next <= checkpoint; ++next) {
+      const change& changed = change_to(next);
+      if (!icl::contains(changed.region, key))
+        continue;
+      const auto it_ = std::partition_point(
+          changed.replaced.begin(), changed.replaced.end(),
+          [&](const segment_type& segment) {
+            return icl::exclusive_less(segment.first,
+                                       Interval_Stabbing::probe<Type>(key));
+          });
+      if (it_ != changed.replaced.end() && icl::contains(it_->first, key))
+        return it_->second;
+      return std::nullopt;
+    }
+    const persistent_type& object = version_at(checkpoint);
+    const auto it_ = object.find(key);
+    if (it_ == object.end())
+      return std::nullopt;
+    return (*it_).second;
+  }
+
+  /** Version \c at of the map. It takes time for at most
+      \c checkpoint_interval changes. */
+  persistent_type at(version_type at) const {
+    assert(_oldest <= at && at <= _version);
+    const version_type checkpoint = checkpoint_after(at);
+    persistent_type object = version_at(checkpoint);
+    for (version_type next = checkpoint; next > at; --next) {
+      const change& changed = change_to(next);
+      if (!icl::is_empty(changed.region))
+        object.restore(changed.region, changed.replaced.begin(),
+                       changed.replaced.end());
+    }
+    return object;
+  }
+
+  /** The elements that versions \c first and \c second map to different
+      values, or that only one of them maps. Only the regions of the
+      changes between the versions are compared, so it takes time for
+      these changes and for at most \c checkpoint_interval others. */
+  difference diff(version_type first, version_type second) const {
+    const version_type older = std::min(first, second);
+    const version_type newer = std::max(first, second);
+    const persistent_type to = at(newer);
+    persistent_type from = to;
+    std::vector<interval_type> regions;
+    for (version_type next = newer; next > older; --next) {
+      const change& changed = change_to(next);
+      if (icl::is_empty(changed.region))
+        continue;
+      from.restore(changed.region, changed.replaced.begin(),
+                   changed.replaced.end());
+      regions.push_back(changed.region);
+    }
+
+    Type left;
+    Type right;
+    for (const interval_type& region : joined(std::move(regions))) {
+      restrict(left, from, region);
+      restrict(right, to, region);
+    }
+    if (first > second)
+      std::swap(left, right);
+    difference result{left, right};
+    for (const auto& segment : right)
+      result.removed.erase(segment_type(segment));
+    for (const auto& segment : left)
+      result.added.erase(segment_type(segment));
+    return result;
+  }
+
+  //==========================================================================
+  //= Addition, subtraction, insertion, erasure
+  //==========================================================================
+
+  versioned& add(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.add(key_value_pair); });
+  }
+
+  versioned& add(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.add(interval_value_pair);
+    });
+  }
+
+  versioned& subtract(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.subtract(key_value_pair); });
+  }
+
+  versioned& subtract(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.subtract(interval_value_pair);
+    });
+  }
+
+  versioned& insert(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.insert(key_value_pair); });
+  }
+
+  versioned& insert(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.insert(interval_value_pair);
+    });
+  }
+
+  /** Sets the values of the elements of \c key_value_pair to its value, as
+      \c set_at does */
+  versioned& set(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.set(key_value_pair); });
+  }
+
+  versioned& set(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.set(interval_value_pair);
+    });
+  }
+
+  versioned& erase(const element_type& key_value_pair)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key_value_pair.key),
+                  [&](Type& object) { object.erase(key_value_pair); });
+  }
+
+  versioned& erase(const segment_type& interval_value_pair) {
+    return update(interval_value_pair.first, [&](Type& object) {
+      object.erase(interval_value_pair);
+    });
+  }
+
+  /** Erases the elements of \c key */
+  versioned& erase(const domain_type& key)
+    requires Interval_Stabbing::stabbable<Type>
+  {
+    return update(Interval_Stabbing::probe<Type>(key),
+                  [&](Type& object) { object.erase(key); });
+  }
+
+  /** Erases the elements of \c inter_val */
+  versioned& erase(const interval_type& inter_val) {
+    return update(inter_val, [&](Type& object) { object.erase(inter_val); });
+  }
+
+private:
+  /** The change of an update: The segments it replaced, that were the
+      segments of the map within \c region */
+  struct change {
+    interval_type region;
+    std::vector<segment_type> replaced;
+  };
+
+  /// The change that made version \c next
+  const change& change_to(version_type next) const {
+    return _changes[static_cast<size_type>(next - _oldest - 1)];
+  }
+
+  version_type checkpoint_version(size_type index) const {
+    return (_first_checkpoint + index) * checkpoint_interval;
+  }
+
+  /// The first version at or after \c at, that is kept as a whole
+  version_type checkpoint_after(version_type at) const {
+    const version_type next =
+        (at + checkpoint_interval - 1) / checkpoint_interval *
+        checkpoint_interval;
+    return std::min(next, _version);
+  }
+
+  /// Version \c checkpoint, that is kept as a whole
+  const persistent_type& version_at(version_type checkpoint) const {
+    if (checkpoint == _version)
+      return _current;
+    return _checkpoints[static_cast<size_type>(
+        checkpoint / checkpoint_interval - _first_checkpoint)];
+  }
+
+  /// Sets the segments of \c object within \c region in \c local
+  static void restrict(Type& local, const persistent_type& object,
+                       const interval_type& region) {
+    if (icl::is_empty(region))
+      return;
+    const auto [first_, past_] = object._tree.equal_range(region);
+    for (auto it_ = first_; it_ != past_; ++it_)
+      local.set(segment_type((*it_).first & region, (*it_).second));
+  }
+
+  /// The union of \c regions, as disjoint intervals in ascending order
+  static std::vector<interval_type> joined(std::vector<interval_type> regions) {
+    std::sort(regions.begin(), regions.end(),
+              [](const interval_type& left, const interval_type& right) {
+                return icl::lower_less(left, right);
+              });
+    std::vector<interval_type> result;
+    for (const interval_type& region : regions)
+      if (!result.empty() && (icl::intersects(result.back(), region) ||
+                              icl::touches(result.back(), region)))
+        result.back() = icl::hull(result.back(), region);
+      else
+        result.push_back(region);
+    return result;
+  }
+
+  template <typename Updater>
+  versioned& update(const interval_type& span, Updater updater) {
+    _changes.push_back(change{span, {}});
+    try {
+      change& changed = _changes.back();
+      _current.update(span, updater, [&](auto first, auto past) {
+        for (; first != past; ++first) {
+          changed.region = icl::hull(changed.region, (*first).first);
+          changed.replaced.emplace_back((*first).first, (*first).second);
+        }
+      });
+    } catch (...) {
+      _changes.pop_back();
+      throw;
+    }
+    ++_version;
+    if (_version % checkpoint_interval == 0)
+      _checkpoints.push_back(_current);
+    if (_version - _oldest > _retention &&
+        _version - _oldest - _retention >= checkpoint_interval)
+      compact();
+    return *this;
+  }
+
+  persistent_type _current;
+  version_type _version = 0;
+  version_type _oldest = 0;
+  size_type _retention = all_versions;
+  /// The changes to the versions after the oldest one
+  std::deque<change> _changes;
+  /// The versions at multiples of \c checkpoint_interval, from the first
+  /// one at or after the oldest version
+  std::deque<persistent_type> _checkpoints;
+  size_type _first_checkpoint = 0;
+};
+
+} // namespace icl
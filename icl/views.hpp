@@ -0,0 +1,317 @@
+#pragma once
+
+#include "icl/concept/interval.hpp"
+#include "icl/interval_combining_style.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace icl {
+
+/// Ranges of ascending, disjoint intervals, e.g. interval sets
+template <typename Range>
+concept interval_range =
+    std::ranges::forward_range<Range> &&
+    is_interval<std::ranges::range_value_t<Range>>::value;
+
+namespace detail {
+
+/// The interval combining style of the segments of \c Range: That of an
+/// interval container or a set operation view, or joining
+template <typename Range> constexpr int fineness_of() {
+  if constexpr (requires { Range::fineness; })
+    return static_cast<int>(Range::fineness);
+  else
+    return interval_combine::joining;
+}
+
+struct select_intersection {
+  constexpr bool operator()(bool in_left, bool in_right) const {
+    return in_left && in_right;
+  }
+};
+
+struct select_union {
+  constexpr bool operator()(bool in_left, bool in_right) const {
+    return in_left || in_right;
+  }
+};
+
+struct select_difference {
+  constexpr bool operator()(bool in_left, bool in_right) const {
+    return in_left && !in_right;
+  }
+};
+
+struct select_symmetric_difference {
+  constexpr bool operator()(bool in_left, bool in_right) const {
+    return in_left != in_right;
+  }
+};
+
+} // namespace detail
+
+/** \brief A lazy view of the combination of two ranges of ascending,
+    disjoint intervals, that \c Select decides for each elementary piece by
+    whether the ranges cover it.
+
+    The view yields the segments of the interval set of the fineness
+    \c Fineness, that the combination would produce, see \c views. Both
+    ranges are swept in step as the view is iterated. The view holds the
+    ranges, iterators hold their positions and the pieces in progress, so
+    that nothing is allocated. */
+template <typename Select, std::ranges::view Left, std::ranges::view Right,
+          int Fineness>
+  requires(interval_range<Left> && interval_range<Right> &&
+           std::same_as<std::ranges::range_value_t<Left>,
+                        std::ranges::range_value_t<Right>>)
+class set_operation_view
+    : public std::ranges::view_interface<
+          set_operation_view<Select, Left, Right, Fineness>> {
+public:
+  using interval_type = std::ranges::range_value_t<Left>;
+  static constexpr int fineness = Fineness;
+
+  /// Iterates the view, and the ranges as \c const if \c Const is true
+  template <bool Const> class basic_iterator {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = interval_type;
+    using difference_type = std::ptrdiff_t;
+
+    basic_iterator() = default;
+
+    interval_type operator*() const { return _segment; }
+
+    basic_iterator& operator++() {
+      advance();
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      advance();
+      return tmp;
+    }
+
+    bool operator==(const basic_iterator& other) const {
+      return _rank == other._rank && _done == other._done;
+    }
+
+    bool operator==(std::default_sentinel_t) const { return _done; }
+
+  private:
+    friend class set_operation_view;
+
+    using parent_type =
+        std::conditional_t<Const, const set_operation_view, set_operation_view>;
+    using left_iterator =
+        std::ranges::iterator_t<std::conditional_t<Const, const Left, Left>>;
+    using right_iterator =
+        std::ranges::iterator_t<std::conditional_t<Const, const Right, Right>>;
+
+    /// An elementary piece of the overlay of the ranges, and the ordinals
+    /// of the segments that cover it, or none
+    struct piece_type {
+      interval_type key;
+      std::size_t left = none;
+      std::size_t right = none;
+    };
+
+    static constexpr std::size_t none = ~std::size_t(0);
+
+    explicit basic_iterator(parent_type* view)
+        : _view(view), _left(std::ranges::begin(view->_left)),
+          _right(std::ranges::begin(view->_right)) {
+      if (_left != std::ranges::end(_view->_left))
+        _left_rest = *_left;
+      if (_right != std::ranges::end(_view->_right))
+        _right_rest = *_right;
+      advance();
+      _rank = 0;
+    }
+
+    /// Sets \c piece to the next piece, that a range covers
+    bool next_piece(piece_type& piece) {
+      const bool left_ends = _left == std::ranges::end(_view->_left);
+      const bool right_ends = _right == std::ranges::end(_view->_right);
+      if (left_ends && right_ends)
+        return false;
+
+      piece = piece_type{};
+      if (right_ends) {
+        piece.key = _left_rest;
+        piece.left = _left_ordinal;
+        _left_rest = interval_type();
+      } else if (left_ends) {
+        piece.key = _right_rest;
+        piece.right = _right_ordinal;
+        _right_rest = interval_type();
+      } else if (piece.key = right_subtract(_left_rest, _right_rest);
+                 !icl::is_empty(piece.key)) {
+        //[piece  left_rest)
+        //        [right_rest)
+        piece.left = _left_ordinal;
+        _left_rest = left_subtract(_left_rest, piece.key);
+      } else if (piece.key = right_subtract(_right_rest, _left_rest);
+                 !icl::is_empty(piece.key)) {
+        //        [left_rest)
+        //[piece right_rest)
+        piece.right = _right_ordinal;
+        _right_rest = left_subtract(_right_rest, piece.key);
+      } else {
+        //[left_rest  )
+        //[right_rest   )
+        piece.key = _left_rest & _right_rest;
+        piece.left = _left_ordinal;
+        piece.right = _right_ordinal;
+        _left_rest = left_subtract(_left_rest, piece.key);
+        _right_rest = left_subtract(_right_rest, piece.key);
+      }
+
+      if (!left_ends && icl::is_empty(_left_rest) &&
+          ++_left != std::ranges::end(_view->_left)) {
+        _left_rest = *_left;
+        ++_left_ordinal;
+      }
+      if (!right_ends && icl::is_empty(_right_rest) &&
+          ++_right != std::ranges::end(_view->_right)) {
+        _right_rest = *_right;
+        ++_right_ordinal;
+      }
+      return true;
+    }
+
+    /// Sets \c _next to the next piece, that \c Select takes
+    bool pull() {
+      while (next_piece(_next))
+        if (Select()(_next.left != none, _next.right != none))
+          return true;
+      return false;
+    }
+
+    /// Can \c piece be joined to the current segment?
+    bool joins(const piece_type& piece) const {
+      if constexpr (Fineness == interval_combine::joining)
+        return icl::touches(_segment, piece.key);
+      else if constexpr (Fineness == interval_combine::separating &&
+                         std::same_as<Select, detail::select_union>)
+        // Separating sets join overlapping intervals on addition only, so
+        // the pieces of a common covering segment
+        return (piece.left != none && piece.left == _segment_left) ||
+               (piece.right != none && piece.right == _segment_right);
+      else
+        return false;
+    }
+
+    void advance() {
+      ++_rank;
+      if (!_buffered && !pull()) {
+        _done = true;
+        return;
+      }
+      _segment = _next.key;
+      _segment_left = _next.left;
+      _segment_right = _next.right;
+      _buffered = false;
+      while (pull()) {
+        if (!joins(_next)) {
+          _buffered = true;
+          return;
+        }
+        _segment = hull(_segment, _next.key);
+        _segment_left = _next.left;
+        _segment_right = _next.right;
+      }
+    }
+
+    parent_type* _view = nullptr;
+    left_iterator _left{};
+    right_iterator _right{};
+    interval_type _left_rest{};
+    interval_type _right_rest{};
+    std::size_t _left_ordinal = 0;
+    std::size_t _right_ordinal = 0;
+    /// The segment, that the iterator points to
+    interval_type _segment{};
+    std::size_t _segment_left = none;
+    std::size_t _segment_right = none;
+    /// A piece pulled behind the segment
+    piece_type _next{};
+    bool _buffered = false;
+    bool _done = false;
+    std::size_t _rank = 0;
+  };
+
+  set_operation_view(Left left, Right right)
+      : _left(std::move(left)), _right(std::move(right)) {}
+
+  /// Ranges that are not iterable as \c const, e.g. those filtered by
+  /// \c std::views::filter, are iterated by the view, that is not \c const
+  basic_iterator<false> begin()
+    requires(!(interval_range<const Left> && interval_range<const Right>))
+  {
+    return basic_iterator<false>(this);
+  }
+
+  basic_iterator<true> begin() const
+    requires(interval_range<const Left> && interval_range<const Right>)
+  {
+    return basic_iterator<true>(this);
+  }
+
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+  Left base_left() const { return _left; }
+  Right base_right() const { return _right; }
+
+private:
+  Left _left;
+  Right _right;
+};
+
+namespace detail {
+
+template <typename Select> struct set_operation_fn {
+  template <std::ranges::viewable_range Left,
+            std::ranges::viewable_range Right>
+    requires(interval_range<std::views::all_t<Left>> &&
+             interval_range<std::views::all_t<Right>>)
+  auto operator()(Left&& left, Right&& right) const {
+    return set_operation_view<Select, std::views::all_t<Left>,
+                              std::views::all_t<Right>,
+                              fineness_of<std::remove_cvref_t<Left>>()>(
+        std::views::all(std::forward<Left>(left)),
+        std::views::all(std::forward<Right>(right)));
+  }
+};
+
+} // namespace detail
+
+/** \brief Lazy set operations on interval sets and other ranges of
+    ascending, disjoint intervals.
+
+    <tt>views::intersection(a, b)</tt> yields the segments, that \c a has
+    after \c a&=b, \c union_ those after \c a|=b, \c difference those
+    after \c a-=b and \c symmetric_difference those after \c a^=b, in the
+    fineness of \c a: Joining sets join touching segments, separating sets
+    added overlapping ones and splitting sets keep all pieces apart. Views
+    can be operands of views, their segments have the fineness of their left
+    operand, and compose with the adaptors of \c std::views. */
+namespace views {
+
+inline constexpr detail::set_operation_fn<detail::select_intersection>
+    intersection{};
+inline constexpr detail::set_operation_fn<detail::select_union> union_{};
+inline constexpr detail::set_operation_fn<detail::select_difference>
+    difference{};
+inline constexpr detail::set_operation_fn<detail::select_symmetric_difference>
+    symmetric_difference{};
+
+} // namespace views
+} // namespace icl
@@ -0,0 +1,73 @@
+#pragma once
+
+// Random interval containers for the tests, that compare operations to
+// other algorithms or containers on many inputs.
+#include "icl/interval_bounds.hpp"
+#include "icl/interval_traits.hpp"
+#include "icl/type_traits/is_interval.hpp"
+#include "icl/type_traits/is_interval_container.hpp"
+#include <random>
+#include <utility>
+
+namespace icl_test {
+
+/// The intervals start in [0, domain] and are [min_length, max_length]
+/// long, mapped values are in [min_value, max_value]. Intervals with
+/// dynamic bounds get random bounds, unless they are to be right open.
+struct random_shape {
+  int domain = 1000;
+  int min_length = 0;
+  int max_length = 30;
+  int min_value = 1;
+  int max_value = 3;
+  bool right_open = false;
+};
+
+template <typename IntervalT>
+IntervalT random_interval(std::mt19937& gen, const random_shape& shape = {}) {
+  using domain_type = icl::interval_traits<IntervalT>::domain_type;
+  std::uniform_int_distribution<int> pos(0, shape.domain);
+  std::uniform_int_distribution<int> len(shape.min_length, shape.max_length);
+  std::uniform_int_distribution<int> bound(0, 3);
+
+  const auto lo = static_cast<domain_type>(pos(gen));
+  const auto up = static_cast<domain_type>(lo + len(gen));
+  if constexpr (icl::has_dynamic_bounds<IntervalT>::value)
+    if (!shape.right_open)
+      return IntervalT(
+          lo, up,
+          icl::interval_bounds(static_cast<icl::bound_type>(bound(gen))));
+  return IntervalT(lo, up);
+}
+
+/// An interval of the set \c Type, or an interval value pair of the map
+template <typename Type>
+Type::segment_type random_segment(std::mt19937& gen,
+                                  const random_shape& shape = {}) {
+  using interval_type = Type::interval_type;
+  if constexpr (icl::is_interval_map<Type>::value) {
+    std::uniform_int_distribution<int> val(shape.min_value, shape.max_value);
+    interval_type key = random_interval<interval_type>(gen, shape);
+    return {key, static_cast<typename Type::codomain_type>(val(gen))};
+  } else
+    return random_interval<interval_type>(gen, shape);
+}
+
+/// The container of \c count random segments added in random order
+template <typename Type>
+Type random_container(std::mt19937& gen, int count,
+                      const random_shape& shape = {}) {
+  Type object;
+  for (int i = 0; i < count; ++i)
+    object.add(random_segment<Type>(gen, shape));
+  return object;
+}
+
+template <typename Type>
+Type random_container(unsigned seed, int count,
+                      const random_shape& shape = {}) {
+  std::mt19937 gen(seed);
+  return random_container<Type>(gen, count, shape);
+}
+
+} // namespace icl_test
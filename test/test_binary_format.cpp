@@ -0,0 +1,201 @@
+#include "random_container.hpp"
+#include "icl/binary_format.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/mapped_file.hpp"
+#include "icl/right_open_interval.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Bytes at an address aligned for any element type of the format
+struct aligned_bytes {
+  explicit aligned_bytes(const std::string& data, std::size_t shift = 0)
+      : storage((data.size() + shift) / sizeof(std::uint64_t) + 1) {
+    std::memcpy(reinterpret_cast<char*>(storage.data()) + shift, data.data(),
+                data.size());
+    bytes = std::span<const std::byte>(
+        reinterpret_cast<const std::byte*>(storage.data()) + shift,
+        data.size());
+  }
+
+  std::vector<std::uint64_t> storage;
+  std::span<const std::byte> bytes;
+};
+
+template <typename Type> std::string serialized(const Type& object) {
+  std::ostringstream stream(std::ios::binary);
+  icl::write_binary(stream, object);
+  return stream.str();
+}
+
+} // namespace
+
+// A view must show the segments of the container that was written, and
+// every search must yield the segment at the position of the search of the
+// container.
+template <typename Type> void run_binary_format() {
+  using interval_type = typename Type::interval_type;
+  using domain_type = typename Type::domain_type;
+
+  for (const int count : {0, 1, 2, 7, 100, 400}) {
+    const Type source =
+        icl_test::random_container<Type>(count, count, {.max_length = 20});
+    const std::string data = serialized(source);
+    REQUIRE(data.size() % icl::binary_header::alignment == 0);
+    const aligned_bytes buffer(data);
+    const icl::binary_view<Type> view(buffer.bytes);
+
+    REQUIRE(view.iterative_size() == source.iterative_size());
+    REQUIRE(view.empty() == source.empty());
+    REQUIRE(std::equal(view.begin(), view.end(), source.begin(), source.end(),
+                       [](const auto& left, const auto& right) {
+                         if constexpr (icl::is_interval_map<Type>::value)
+                           return left.first == right.first &&
+                                  left.second == right.second;
+                         else
+                           return left == right;
+                       }));
+    REQUIRE(std::distance(view.rbegin(), view.rend()) ==
+            static_cast<std::ptrdiff_t>(source.iterative_size()));
+    REQUIRE(icl::read_binary<Type>(buffer.bytes) == source);
+
+    auto position = [](const auto& container, const auto& it_) {
+      return std::distance(container.begin(), it_);
+    };
+    for (int point = -2; point <= 1030; ++point) {
+      const auto key = static_cast<domain_type>(point);
+      REQUIRE(position(view, view.find(key)) ==
+              position(source, source.find(key)));
+      REQUIRE(view.contains(key) == icl::contains(source, key));
+      REQUIRE(view.intersects(key) == icl::intersects(source, key));
+      if constexpr (icl::is_interval_map<Type>::value)
+        REQUIRE(view(key) == source(key));
+    }
+
+    const Type probes = icl_test::random_container<Type>(
+        count + 500, count + 500, {.max_length = 20});
+    for (auto it_ = probes.begin(); it_ != probes.end(); ++it_) {
+      const interval_type& inter_val = icl::key_value<Type>(it_);
+      REQUIRE(position(view, view.find(inter_val)) ==
+              position(source, source.find(inter_val)));
+      REQUIRE(position(view, view.lower_bound(inter_val)) ==
+              position(source, source.lower_bound(inter_val)));
+      REQUIRE(position(view, view.upper_bound(inter_val)) ==
+              position(source, source.upper_bound(inter_val)));
+      REQUIRE(view.contains(inter_val) == icl::contains(source, inter_val));
+      REQUIRE(view.intersects(inter_val) ==
+              icl::intersects(source, inter_val));
+    }
+  }
+}
+
+TEST_CASE("Test Binary Format Interval Sets", "[binary_format]") {
+  run_binary_format<icl::interval_set<int>>();
+  run_binary_format<icl::separate_interval_set<std::int64_t>>();
+  run_binary_format<icl::split_interval_set<unsigned>>();
+  run_binary_format<icl::flat_interval_set<int>>();
+  run_binary_format<
+      icl::interval_set<int, std::less, icl::right_open_interval<int>>>();
+  run_binary_format<icl::interval_set<double, std::less,
+                                      icl::continuous_interval<double>>>();
+}
+
+TEST_CASE("Test Binary Format Interval Maps", "[binary_format]") {
+  run_binary_format<icl::interval_map<int, int>>();
+  run_binary_format<icl::split_interval_map<std::int64_t, double>>();
+  run_binary_format<icl::flat_interval_map<int, std::uint8_t>>();
+  run_binary_format<icl::interval_map<int, int, icl::total_absorber>>();
+  run_binary_format<icl::interval_map<double, int, icl::partial_absorber,
+                                      std::less, icl::inplace_plus,
+                                      icl::inter_section,
+                                      icl::continuous_interval<double>>>();
+}
+
+TEST_CASE("Test Binary Format Mapped File", "[binary_format]") {
+  using map_type = icl::interval_map<std::int64_t, int>;
+
+  const map_type source =
+      icl_test::random_container<map_type>(1000, 1000, {.max_length = 20});
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "icl_test_binary_format.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    icl::write_binary(file, source);
+    REQUIRE(file.good());
+  }
+  {
+    icl::mapped_view<map_type> view(path);
+    REQUIRE(view.bytes().size() == std::filesystem::file_size(path));
+    REQUIRE(view.iterative_size() == source.iterative_size());
+    for (std::int64_t point = 0; point <= 1030; ++point)
+      REQUIRE(view(point) == source(point));
+
+    const icl::mapped_view<map_type> moved(std::move(view));
+    REQUIRE(icl::read_binary<map_type>(moved.bytes()) == source);
+  }
+  std::filesystem::remove(path);
+  REQUIRE_THROWS_AS(icl::mapped_view<map_type>(path), std::system_error);
+}
+
+TEST_CASE("Test Binary Format Errors", "[binary_format]") {
+  using set_type = icl::interval_set<int>;
+  using map_type = icl::interval_map<int, int>;
+
+  const set_type source =
+      icl_test::random_container<set_type>(50, 50, {.max_length = 20});
+  const std::string data = serialized(source);
+
+  auto rejects = [](const std::string& bytes, std::size_t shift = 0) {
+    const aligned_bytes buffer(bytes, shift);
+    REQUIRE_THROWS_AS(icl::binary_view<set_type>(buffer.bytes),
+                      icl::binary_format_error);
+  };
+  auto patched = [&](std::size_t offset, const auto& value) {
+    std::string bytes = data;
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+    return bytes;
+  };
+
+  REQUIRE_NOTHROW(icl::binary_view<set_type>(aligned_bytes(data).bytes));
+  rejects(std::string());
+  rejects(data.substr(0, sizeof(icl::binary_header)));
+  rejects(data.substr(0, data.size() - 1));
+  rejects(patched(offsetof(icl::binary_header, magic), 'X'));
+  rejects(patched(offsetof(icl::binary_header, endian_tag),
+                  std::uint32_t(0x04030201)));
+  rejects(patched(offsetof(icl::binary_header, version), std::uint16_t(2)));
+  rejects(patched(offsetof(icl::binary_header, count),
+                  std::uint64_t(1) << 62));
+  rejects(patched(offsetof(icl::binary_header, upper_offset),
+                  std::uint64_t(8)));
+  rejects(data, 1);
+
+  const aligned_bytes buffer(data);
+  REQUIRE_THROWS_AS(icl::binary_view<map_type>(buffer.bytes),
+                    icl::binary_format_error);
+  REQUIRE_THROWS_AS(icl::binary_view<icl::interval_set<unsigned>>(buffer.bytes),
+                    icl::binary_format_error);
+  REQUIRE_THROWS_AS(icl::binary_view<icl::interval_set<std::int64_t>>(
+                        buffer.bytes),
+                    icl::binary_format_error);
+  REQUIRE_THROWS_AS((icl::binary_view<icl::interval_set<
+                         int, std::less, icl::right_open_interval<int>>>(
+                        buffer.bytes)),
+                    icl::binary_format_error);
+}
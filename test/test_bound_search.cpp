@@ -0,0 +1,143 @@
+#include "random_container.hpp"
+#include "icl/bound_index.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/detail/bound_search.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Every kernel that the processor supports must agree with std::lower_bound,
+// for keys within, between and beyond the bounds.
+std::vector<icl::simd_level> supported_levels() {
+  std::vector<icl::simd_level> levels = {icl::simd_level::portable};
+  if (icl::supported_simd_level() >= icl::simd_level::avx2)
+    levels.push_back(icl::simd_level::avx2);
+  if (icl::supported_simd_level() >= icl::simd_level::avx512)
+    levels.push_back(icl::simd_level::avx512);
+  return levels;
+}
+
+template <typename T> void run_bound_search() {
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int> spread(0, 3);
+  std::uniform_int_distribution<std::size_t> any(0, 5);
+
+  // Values near both ends of the domain, and of the sign bit of unsigned T
+  const T low = std::numeric_limits<T>::lowest();
+  const T high = std::numeric_limits<T>::max();
+  const T middle = std::is_unsigned_v<T> ? T(high / 2) : T(0);
+  auto random_value = [&] {
+    std::uniform_int_distribution<int> offset(0, 200);
+    switch (spread(gen)) {
+    case 0:
+      return static_cast<T>(low + static_cast<T>(offset(gen)));
+    case 1:
+      return static_cast<T>(high - static_cast<T>(offset(gen)));
+    default:
+      return static_cast<T>(middle + static_cast<T>(offset(gen) - 100));
+    }
+  };
+
+  for (const std::size_t size : {0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 64,
+                                 100, 1000, 4097}) {
+    std::vector<T> bounds(size);
+    for (T& bound : bounds)
+      bound = random_value();
+    std::sort(bounds.begin(), bounds.end());
+
+    std::vector<T> keys(67);
+    for (T& key : keys)
+      key = size > 0 && any(gen) == 0 ? bounds[any(gen) % size]
+                                      : random_value();
+    keys.push_back(low);
+    keys.push_back(high);
+
+    std::vector<std::size_t> expected;
+    for (const T& key : keys)
+      expected.push_back(static_cast<std::size_t>(
+          std::lower_bound(bounds.begin(), bounds.end(), key) -
+          bounds.begin()));
+
+    for (const icl::simd_level level : supported_levels()) {
+      for (std::size_t index = 0; index < keys.size(); ++index)
+        REQUIRE(icl::Bound_Search::lower_bound(std::span<const T>(bounds),
+                                               keys[index], level) ==
+                expected[index]);
+
+      std::vector<std::size_t> result(keys.size());
+      icl::Bound_Search::lower_bound(std::span<const T>(bounds),
+                                     std::span<const T>(keys),
+                                     std::span<std::size_t>(result), level);
+      REQUIRE(result == expected);
+    }
+  }
+}
+
+TEST_CASE("Test Bound Search Kernels", "[bound_search]") {
+  run_bound_search<std::int32_t>();
+  run_bound_search<std::uint32_t>();
+  run_bound_search<std::int64_t>();
+  run_bound_search<std::uint64_t>();
+  run_bound_search<float>();
+  run_bound_search<double>();
+  run_bound_search<std::int16_t>();
+}
+
+// Lookups through the index must equal those of the container.
+template <typename Type> void run_bound_index() {
+  using interval_type = typename Type::interval_type;
+  using domain_type = typename Type::domain_type;
+  using const_iterator = typename Type::const_iterator;
+
+  std::mt19937 gen(42);
+  Type object = icl_test::random_container<Type>(
+      gen, 300, {.domain = 2000, .max_value = 5});
+
+  const icl::bound_index<Type> index(object);
+  REQUIRE(index.size() == object.iterative_size());
+
+  std::vector<domain_type> points;
+  for (int point = -5; point <= 2040; ++point) {
+    points.push_back(static_cast<domain_type>(point));
+    if constexpr (std::is_floating_point_v<domain_type>)
+      points.push_back(static_cast<domain_type>(point) + domain_type(0.5));
+  }
+  std::shuffle(points.begin(), points.end(), gen);
+
+  std::vector<const_iterator> found(points.size());
+  index.find(points, found);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    REQUIRE(index.find(points[i]) == object.find(points[i]));
+    REQUIRE(found[i] == object.find(points[i]));
+  }
+
+  // Any update of the container, assignment included, invalidates the index
+  REQUIRE(index.is_current());
+  const Type copied = object;
+  if constexpr (icl::is_interval_map<Type>::value)
+    object.add(std::make_pair(interval_type(0, 5000), 1));
+  else
+    object.add(interval_type(0, 5000));
+  REQUIRE(!index.is_current());
+  const icl::bound_index<Type> rebuilt(object);
+  REQUIRE(rebuilt.is_current());
+  object = copied;
+  REQUIRE(!rebuilt.is_current());
+}
+
+TEST_CASE("Test Bound Index", "[bound_search]") {
+  run_bound_index<icl::flat_interval_set<std::int64_t>>();
+  run_bound_index<icl::flat_interval_map<std::int64_t, int>>();
+  run_bound_index<icl::flat_interval_map<std::uint32_t, int>>();
+  run_bound_index<icl::flat_interval_map<
+      double, int, icl::partial_absorber, std::less, icl::inplace_plus,
+      icl::inter_section, icl::continuous_interval<double>>>();
+  run_bound_index<icl::flat_interval_set<
+      float, std::less, icl::continuous_interval<float>>>();
+}
@@ -0,0 +1,136 @@
+#include "icl/compact_discrete_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+using compact_type = icl::compact_discrete_interval<std::int64_t>;
+
+static_assert(sizeof(compact_type) == 2 * sizeof(std::int64_t));
+static_assert(sizeof(compact_type) <
+              sizeof(icl::discrete_interval<std::int64_t>));
+static_assert(icl::is_static_right_open<compact_type>::value);
+
+// Containers of compact intervals must hold the same elements as those of
+// discrete intervals, that keep their bounds.
+template <typename CompactT, typename DiscreteT>
+bool same_segments(const CompactT& compact, const DiscreteT& discrete) {
+  auto it_ = compact.begin();
+  auto other_ = discrete.begin();
+  for (; it_ != compact.end() && other_ != discrete.end(); ++it_, ++other_) {
+    const auto& inter_val = icl::key_value<CompactT>(it_);
+    const auto& other_val = icl::key_value<DiscreteT>(other_);
+    if (inter_val.lower() != icl::first(other_val) ||
+        inter_val.upper() != icl::last(other_val) + 1)
+      return false;
+    if constexpr (icl::is_interval_map<CompactT>::value)
+      if ((*it_).second != (*other_).second)
+        return false;
+  }
+  return it_ == compact.end() && other_ == discrete.end();
+}
+
+template <typename CompactT, typename DiscreteT> void run_compact_updates() {
+  using compact_interval = typename CompactT::interval_type;
+  using discrete_interval = typename DiscreteT::interval_type;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 400);
+  std::uniform_int_distribution<int> len(0, 30);
+  std::uniform_int_distribution<int> bound(0, 3);
+  std::uniform_int_distribution<int> val(1, 3);
+  std::uniform_int_distribution<int> op(0, 3);
+
+  CompactT compact, compact_other;
+  DiscreteT discrete, discrete_other;
+  for (int step = 0; step < 2000; ++step) {
+    const std::int64_t lo = pos(gen);
+    const std::int64_t up = lo + len(gen);
+    const icl::interval_bounds bounds(
+        static_cast<icl::bound_type>(bound(gen)));
+    const compact_interval compact_val(lo, up, bounds);
+    const discrete_interval discrete_val(lo, up, bounds);
+    const int value = val(gen);
+    const int choice = op(gen);
+
+    auto update = [&](auto& object, const auto& inter_val) {
+      if constexpr (icl::is_interval_map<CompactT>::value) {
+        const auto segment = std::make_pair(inter_val, value);
+        if (choice == 0)
+          object.subtract(segment);
+        else if (choice == 1)
+          object.erase(inter_val);
+        else
+          object.add(segment);
+      } else {
+        if (choice == 0)
+          object.subtract(inter_val);
+        else
+          object.add(inter_val);
+      }
+    };
+    if (step % 2 == 0) {
+      update(compact, compact_val);
+      update(discrete, discrete_val);
+    } else {
+      update(compact_other, compact_val);
+      update(discrete_other, discrete_val);
+    }
+    REQUIRE(icl::contains(compact, up) == icl::contains(discrete, up));
+  }
+
+  REQUIRE(same_segments(compact, discrete));
+  REQUIRE(same_segments(compact + compact_other, discrete + discrete_other));
+  REQUIRE(same_segments(compact & compact_other, discrete & discrete_other));
+  REQUIRE(same_segments(compact - compact_other, discrete - discrete_other));
+  REQUIRE(icl::cardinality(compact) == icl::cardinality(discrete));
+  REQUIRE(icl::length(compact) == icl::length(discrete));
+}
+
+TEST_CASE("Test Compact Discrete Interval Normalisation", "[compact]") {
+  REQUIRE(compact_type::closed(1, 5).lower() == 1);
+  REQUIRE(compact_type::closed(1, 5).upper() == 6);
+  REQUIRE(compact_type::closed(1, 5).bounds() ==
+          icl::interval_bounds::right_open());
+  REQUIRE(compact_type::open(0, 6) == compact_type::closed(1, 5));
+  REQUIRE(compact_type::left_open(0, 5) == compact_type::right_open(1, 6));
+  REQUIRE(compact_type(7) == compact_type::closed(7, 7));
+  REQUIRE(icl::is_empty(compact_type::open(3, 4)));
+  REQUIRE(icl::contains(compact_type::closed(1, 5), 5));
+  REQUIRE(!icl::contains(compact_type::closed(1, 5), 6));
+  REQUIRE(icl::cardinality(compact_type::closed(1, 5)) == 5);
+}
+
+TEST_CASE("Test Compact Discrete Interval Containers", "[compact]") {
+  using discrete_type = icl::discrete_interval<std::int64_t>;
+
+  run_compact_updates<
+      icl::interval_map<std::int64_t, int, icl::partial_absorber, std::less,
+                        icl::inplace_plus, icl::inter_section, compact_type>,
+      icl::interval_map<std::int64_t, int>>();
+  run_compact_updates<
+      icl::split_interval_map<std::int64_t, int, icl::partial_absorber,
+                              std::less, icl::inplace_plus, icl::inter_section,
+                              compact_type>,
+      icl::split_interval_map<std::int64_t, int>>();
+  run_compact_updates<
+      icl::flat_interval_map<std::int64_t, int, icl::partial_absorber,
+                             std::less, icl::inplace_plus, icl::inter_section,
+                             compact_type>,
+      icl::flat_interval_map<std::int64_t, int>>();
+  run_compact_updates<icl::interval_set<std::int64_t, std::less, compact_type>,
+                      icl::interval_set<std::int64_t, std::less,
+                                        discrete_type>>();
+  run_compact_updates<
+      icl::separate_interval_set<std::int64_t, std::less, compact_type>,
+      icl::separate_interval_set<std::int64_t>>();
+  run_compact_updates<
+      icl::split_interval_set<std::int64_t, std::less, compact_type>,
+      icl::split_interval_set<std::int64_t>>();
+}
@@ -0,0 +1,204 @@
+#include "random_container.hpp"
+#include "icl/concurrent.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using interval_type = icl::discrete_interval<int>;
+
+// The sum of the values of the elements of \c object
+template <typename MapT> std::int64_t volume(const MapT& object) {
+  std::int64_t sum = 0;
+  for (const auto& [inter_val, value] : object)
+    sum += static_cast<std::int64_t>(value) * icl::length(inter_val);
+  return sum;
+}
+
+} // namespace
+
+// Updates of a shared map must have the effects of those of the map, and
+// its queries the results of the queries of the map.
+template <typename MapT> void run_map_semantics() {
+  icl::concurrent<MapT> shared;
+  MapT expected;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> op(0, 5);
+
+  for (int i = 0; i < 500; ++i) {
+    const auto segment = icl_test::random_segment<MapT>(
+        gen, {.domain = 200, .max_value = 4, .right_open = true});
+    switch (op(gen)) {
+    case 0:
+      shared.add(segment);
+      expected.add(segment);
+      break;
+    case 1: {
+      typename MapT::segment_type moved = segment;
+      shared.add(std::move(moved));
+      expected.add(segment);
+      break;
+    }
+    case 2:
+      shared.subtract(segment);
+      expected.subtract(segment);
+      break;
+    case 3:
+      shared.insert(segment);
+      expected.insert(segment);
+      break;
+    case 4:
+      shared.erase(segment);
+      expected.erase(segment);
+      break;
+    default:
+      shared.set(segment);
+      expected.set(segment);
+    }
+    REQUIRE(shared.snapshot() == expected);
+
+    const int key = i % 230;
+    const auto found = shared.find(key);
+    const auto it_ = expected.find(key);
+    REQUIRE(found.has_value() == (it_ != expected.end()));
+    if (found)
+      REQUIRE((found->first == it_->first && found->second == it_->second));
+    REQUIRE(shared(key) == expected(key));
+    REQUIRE(shared.contains(key) == icl::contains(expected, key));
+    const interval_type probe = icl_test::random_interval<interval_type>(
+        gen, {.domain = 200, .max_length = 10, .right_open = true});
+    REQUIRE(shared.contains(probe) == icl::contains(expected, probe));
+    REQUIRE(shared.intersects(probe) == icl::intersects(expected, probe));
+  }
+  REQUIRE(shared.iterative_size() == expected.iterative_size());
+  shared.clear();
+  REQUIRE(shared.empty());
+}
+
+TEST_CASE("Test Concurrent Map Semantics", "[concurrent]") {
+  run_map_semantics<icl::interval_map<int, int>>();
+  run_map_semantics<icl::split_interval_map<int, int>>();
+  run_map_semantics<icl::flat_interval_map<int, int>>();
+}
+
+TEST_CASE("Test Concurrent Set And Writers", "[concurrent]") {
+  using set_type = icl::interval_set<int>;
+  icl::concurrent<set_type> shared(set_type(interval_type::right_open(0, 10)));
+  shared.add(interval_type::right_open(20, 30)).subtract(5);
+  REQUIRE(shared.snapshot() == set_type(interval_type::right_open(0, 5)) +
+                                   interval_type::right_open(6, 10) +
+                                   interval_type::right_open(20, 30));
+  REQUIRE(shared.find(25) == interval_type::right_open(20, 30));
+  REQUIRE(!shared.find(15));
+  REQUIRE(shared.intersects(interval_type::right_open(8, 22)));
+  REQUIRE(!shared.contains(interval_type::right_open(8, 22)));
+
+  // A batch of updates takes effect as a whole
+  shared.write([](set_type& object) {
+    object.add(interval_type::right_open(10, 20));
+    object.add(5);
+  });
+  REQUIRE(shared.snapshot() == set_type(interval_type::right_open(0, 30)));
+
+  // A writer that throws leaves the container as it was
+  REQUIRE_THROWS_AS(shared.write([](set_type& object) {
+    object.clear();
+    throw std::runtime_error("failed");
+  }),
+                    std::runtime_error);
+  REQUIRE(shared.snapshot() == set_type(interval_type::right_open(0, 30)));
+  REQUIRE(shared.read([](const set_type& object) {
+    return object.iterative_size();
+  }) == 1);
+}
+
+// Readers must see the effects of batches of updates as a whole, while
+// writers update the map, and all updates must take effect in the end.
+TEST_CASE("Test Concurrent Readers And Writers", "[concurrent]") {
+  using map_type = icl::interval_map<int, int>;
+  constexpr int total = 100 * 1000;
+  icl::concurrent<map_type> shared(
+      map_type({interval_type::right_open(0, 1000), 100}));
+
+  constexpr int writers = 3;
+  constexpr int updates = 400;
+  std::vector<std::vector<map_type::segment_type>> moves(writers);
+  std::vector<std::vector<map_type::segment_type>> marks(writers);
+  std::atomic<int> running{writers};
+  std::atomic<bool> consistent{true};
+
+  std::vector<std::thread> threads;
+  for (int writer = 0; writer < writers; ++writer)
+    threads.emplace_back([&, writer] {
+      std::mt19937 gen(writer);
+      for (int i = 0; i < updates; ++i) {
+        // Moves a unit of the values from one interval of [0,1000) to
+        // another one of the same length
+        const interval_type from = icl_test::random_interval<interval_type>(
+            gen, {.domain = 960, .max_length = 40, .right_open = true});
+        const int to = std::uniform_int_distribution<int>(0, 960)(gen);
+        const map_type::segment_type taken(from, 1);
+        const map_type::segment_type given(
+            interval_type::right_open(to, to + icl::length(from)), 1);
+        shared.write([&](map_type& object) {
+          object.subtract(taken);
+          object.add(given);
+        });
+        moves[writer].push_back(taken);
+        moves[writer].push_back(given);
+
+        // Single updates behind [0,1000)
+        const map_type::segment_type mark(
+            interval_type::right_open(1000 + 10 * writer + i % 7,
+                                      1010 + 10 * writer + i % 13),
+            1);
+        shared.add(mark);
+        marks[writer].push_back(mark);
+      }
+      --running;
+    });
+
+  for (int reader = 0; reader < 4; ++reader)
+    threads.emplace_back([&, reader] {
+      std::mt19937 gen(100 + reader);
+      while (running > 0) {
+        const std::int64_t units = shared.read([](const map_type& object) {
+          return volume(object & interval_type::right_open(0, 1000));
+        });
+        const int key = std::uniform_int_distribution<int>(0, 1100)(gen);
+        const int value = shared(key);
+        const auto found = shared.find(key);
+        if (units != total || (key >= 1000 && value < 0) ||
+            (found && !icl::contains(found->first, key)) ||
+            (key >= 1000 && shared.contains(key) &&
+             !shared.intersects(interval_type::right_open(key, key + 1))))
+          consistent = false;
+      }
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+  REQUIRE(consistent);
+
+  // Additions and subtractions commute, so the updates sum up alike in
+  // any order
+  map_type expected({interval_type::right_open(0, 1000), 100});
+  for (int writer = 0; writer < writers; ++writer) {
+    for (std::size_t i = 0; i < moves[writer].size(); i += 2) {
+      expected.subtract(moves[writer][i]);
+      expected.add(moves[writer][i + 1]);
+    }
+    for (const map_type::segment_type& mark : marks[writer])
+      expected.add(mark);
+  }
+  REQUIRE(shared.snapshot() == expected);
+  REQUIRE(volume(shared.snapshot() & interval_type::right_open(0, 1000)) ==
+          total);
+}
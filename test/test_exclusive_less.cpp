@@ -0,0 +1,69 @@
+#include "icl/compact_discrete_interval.hpp"
+#include "icl/detail/exclusive_less_than.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/right_open_interval.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <random>
+
+static_assert(icl::detail::integral_exclusive_less<
+              icl::compact_discrete_interval<unsigned>>);
+static_assert(!icl::detail::integral_exclusive_less<
+              icl::discrete_interval<std::int64_t>>);
+static_assert(
+    icl::detail::integral_exclusive_less<icl::right_open_interval<int>>);
+static_assert(!icl::detail::integral_exclusive_less<
+              icl::discrete_interval<int, std::greater>>);
+static_assert(!icl::detail::integral_exclusive_less<
+              icl::discrete_interval<double>>);
+
+// exclusive_less_than must order non empty intervals as
+// non_empty::exclusive_less does, on the fast path and off it.
+template <typename IntervalT, typename DomainT> void run_exclusive_less() {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(1, 40);
+  std::uniform_int_distribution<int> len(0, 6);
+  std::uniform_int_distribution<int> bound(0, 3);
+
+  auto random_interval = [&] {
+    for (;;) {
+      const auto lo = static_cast<DomainT>(pos(gen));
+      const auto up = static_cast<DomainT>(lo + len(gen));
+      const IntervalT inter_val(
+          lo, up,
+          icl::interval_bounds(static_cast<icl::bound_type>(bound(gen))));
+      if (!icl::is_empty(inter_val))
+        return inter_val;
+    }
+  };
+
+  const icl::exclusive_less_than<IntervalT> less;
+  for (int step = 0; step < 5000; ++step) {
+    const IntervalT left = random_interval();
+    const IntervalT right = random_interval();
+    REQUIRE(less(left, right) == icl::non_empty::exclusive_less(left, right));
+  }
+}
+
+TEST_CASE("Test Exclusive Less Than Fast Path", "[exclusive_less]") {
+  run_exclusive_less<icl::discrete_interval<std::int64_t>, std::int64_t>();
+  run_exclusive_less<icl::discrete_interval<int>, int>();
+  run_exclusive_less<icl::discrete_interval<unsigned>, unsigned>();
+  run_exclusive_less<icl::discrete_interval<std::uint8_t>, std::uint8_t>();
+  run_exclusive_less<icl::compact_discrete_interval<std::int64_t>,
+                     std::int64_t>();
+  run_exclusive_less<icl::compact_discrete_interval<unsigned>, unsigned>();
+}
+
+TEST_CASE("Test Exclusive Less Than Domain Limits", "[exclusive_less]") {
+  using interval_type = icl::discrete_interval<unsigned>;
+  const icl::exclusive_less_than<interval_type> less;
+
+  REQUIRE(less(interval_type::closed(0, 0), interval_type::closed(1, 1)));
+  REQUIRE(!less(interval_type::closed(1, 1), interval_type::closed(0, 0)));
+  REQUIRE(less(interval_type::closed(0, 4), interval_type::open(4, 9)));
+  REQUIRE(!less(interval_type::closed(0, 5), interval_type::open(4, 9)));
+  REQUIRE(less(interval_type::right_open(0, 5), interval_type::closed(5, 5)));
+  REQUIRE(less(interval_type::closed(0, 5), interval_type::closed(6, ~0u)));
+  REQUIRE(!less(interval_type::closed(6, ~0u), interval_type::closed(0, 5)));
+}
@@ -0,0 +1,160 @@
+#include "random_container.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/expression.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <concepts>
+
+namespace {
+
+// Identities of maps are generated as well, so that absorbing them is tested
+constexpr icl_test::random_shape shape{
+    .domain = 300, .max_length = 25, .min_value = 0};
+
+// An expression must evaluate to the container, that the operators yield.
+template <typename Expression, typename Type>
+void check(const Expression& expression, const Type& expected) {
+  static_assert(std::same_as<typename Expression::result_type, Type>);
+  REQUIRE(icl::evaluate(expression) == expected);
+  const Type converted = expression;
+  REQUIRE(converted == expected);
+}
+
+} // namespace
+
+template <typename A, typename B, typename C, typename D>
+void run_expressions() {
+  for (const int count : {0, 1, 4, 30, 120}) {
+    const A a = icl_test::random_container<A>(count + 1, count, shape);
+    const B b = icl_test::random_container<B>(count + 2, count / 2 + 1, shape);
+    const C c = icl_test::random_container<C>(count + 3, count, shape);
+    const D d = icl_test::random_container<D>(count + 4, count + 3, shape);
+    using icl::lazy;
+
+    check((lazy(a) + b - c) & d, (a + b - c) & d);
+    check(lazy(a) | b | c | d, a | b | c | d);
+    check(lazy(a) & b & c & d, a & b & c & d);
+    check(lazy(a) ^ b ^ c ^ d, a ^ b ^ c ^ d);
+    check(lazy(a) - (lazy(b) + c), a - (b + c));
+    check((lazy(a) & b) + (lazy(c) & d), (a & b) + (c & d));
+    check((lazy(a) ^ b) - (lazy(d) & c), (a ^ b) - (d & c));
+    check(b + lazy(a) - d, b + a - d);
+  }
+}
+
+template <typename MapT, typename SetT> void run_map_set_expressions() {
+  for (const int count : {0, 1, 4, 30, 120}) {
+    const MapT a = icl_test::random_container<MapT>(count + 1, count, shape);
+    const MapT b = icl_test::random_container<MapT>(count + 2, count, shape);
+    const SetT s =
+        icl_test::random_container<SetT>(count + 3, count / 2, shape);
+    using icl::lazy;
+
+    check(lazy(a) - s, a - s);
+    check(lazy(a) & s, a & s);
+    check(s & lazy(a), s & a);
+    check((lazy(a) + b) & s, (a + b) & s);
+    check(lazy(a) - (s & b), a - (s & b));
+  }
+}
+
+TEST_CASE("Test Expression Sets", "[expression]") {
+  using interval_set = icl::interval_set<int>;
+  using separate_set = icl::separate_interval_set<int>;
+  using split_set = icl::split_interval_set<int>;
+
+  run_expressions<interval_set, interval_set, interval_set, interval_set>();
+  run_expressions<separate_set, separate_set, separate_set, separate_set>();
+  run_expressions<split_set, split_set, split_set, split_set>();
+  run_expressions<interval_set, split_set, separate_set, interval_set>();
+  run_expressions<separate_set, split_set, interval_set, split_set>();
+  run_expressions<split_set, interval_set, separate_set, separate_set>();
+}
+
+TEST_CASE("Test Expression Maps", "[expression]") {
+  using interval_map = icl::interval_map<int, int>;
+  using split_map = icl::split_interval_map<int, int>;
+
+  run_expressions<interval_map, interval_map, interval_map, interval_map>();
+  run_expressions<split_map, split_map, split_map, split_map>();
+  run_expressions<interval_map, split_map, interval_map, split_map>();
+  run_expressions<split_map, interval_map, interval_map, split_map>();
+
+  using enricher_map = icl::interval_map<int, int, icl::partial_enricher>;
+  using split_enricher_map =
+      icl::split_interval_map<int, int, icl::partial_enricher>;
+  run_expressions<enricher_map, split_enricher_map, enricher_map,
+                  split_enricher_map>();
+
+  using minus_map = icl::interval_map<int, int, icl::partial_absorber,
+                                      std::less, icl::inplace_minus>;
+  using split_minus_map =
+      icl::split_interval_map<int, int, icl::partial_absorber, std::less,
+                              icl::inplace_minus>;
+  run_expressions<minus_map, split_minus_map, minus_map, minus_map>();
+
+  using max_map = icl::split_interval_map<int, int, icl::partial_enricher,
+                                          std::less, icl::inplace_max>;
+  run_expressions<max_map, max_map, max_map, max_map>();
+}
+
+TEST_CASE("Test Expression Maps And Sets", "[expression]") {
+  run_map_set_expressions<icl::interval_map<int, int>,
+                          icl::interval_set<int>>();
+  run_map_set_expressions<icl::split_interval_map<int, int>,
+                          icl::split_interval_set<int>>();
+  run_map_set_expressions<icl::interval_map<int, int>,
+                          icl::separate_interval_set<int>>();
+  run_map_set_expressions<
+      icl::split_interval_map<int, int, icl::partial_enricher>,
+      icl::interval_set<int>>();
+}
+
+TEST_CASE("Test Expression Assignment", "[expression]") {
+  using interval_map = icl::interval_map<int, int>;
+  using split_map = icl::split_interval_map<int, int>;
+  using interval_type = icl::discrete_interval<int>;
+
+  split_map a;
+  a.add(std::make_pair(interval_type::right_open(0, 4), 1));
+  a.add(std::make_pair(interval_type::right_open(4, 8), 1));
+  interval_map b;
+  b.add(std::make_pair(interval_type::right_open(2, 6), 2));
+
+  // The result is converted like the container of the operators
+  interval_map joined = icl::lazy(a) - b;
+  REQUIRE(joined == interval_map(a - b));
+  REQUIRE(joined.iterative_size() == 3);
+  split_map split = icl::lazy(a) - b;
+  REQUIRE(split == a - b);
+  REQUIRE(split.iterative_size() == 4);
+
+  joined = icl::lazy(b) + b;
+  REQUIRE(joined == b + b);
+  REQUIRE(icl::evaluate(joined, icl::lazy(a) & interval_map()).empty());
+}
+
+// The result may be an operand of the expression, that it is evaluated to.
+template <typename Type> void run_evaluate_in_place() {
+  for (const int count : {0, 1, 4, 30}) {
+    Type a = icl_test::random_container<Type>(count + 1, count, shape);
+    const Type b = icl_test::random_container<Type>(count + 2, count, shape);
+    const Type c =
+        icl_test::random_container<Type>(count + 3, count / 2 + 1, shape);
+    const Type expected = a + b - c;
+    REQUIRE(icl::evaluate(a, icl::lazy(a) + b - c) == expected);
+    REQUIRE(a == expected);
+    REQUIRE(icl::evaluate(a, icl::lazy(b) & a) == (b & expected));
+  }
+}
+
+TEST_CASE("Test Expression In Place", "[expression]") {
+  run_evaluate_in_place<icl::interval_set<int>>();
+  run_evaluate_in_place<icl::split_interval_set<int>>();
+  run_evaluate_in_place<icl::interval_map<int, int>>();
+  run_evaluate_in_place<icl::split_interval_map<int, int>>();
+}
@@ -0,0 +1,166 @@
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/split_interval_map.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <initializer_list>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+// A set valued codomain, whose combination fails after a given number of
+// combinations
+struct fallible {
+  inline static int combinations_left = -1;
+  std::set<int> elements;
+
+  fallible() = default;
+  fallible(std::initializer_list<int> init) : elements(init) {}
+
+  fallible& operator+=(const fallible& other) {
+    if (combinations_left == 0)
+      throw std::runtime_error("combination failed");
+    --combinations_left;
+    elements.insert(other.elements.begin(), other.elements.end());
+    return *this;
+  }
+  fallible& operator-=(const fallible& other) {
+    for (const int element : other.elements)
+      elements.erase(element);
+    return *this;
+  }
+
+  friend bool operator==(const fallible&, const fallible&) = default;
+  friend auto operator<=>(const fallible&, const fallible&) = default;
+};
+
+} // namespace
+
+// Maps on flat storage must hold exactly the segments of their node based
+// counterparts after every operation.
+template <typename FlatMapT, typename TreeMapT>
+bool same_segments(const FlatMapT& flat, const TreeMapT& tree) {
+  return std::equal(flat.begin(), flat.end(), tree.begin(), tree.end(),
+                    [](const auto& lhs, const auto& rhs) {
+                      return lhs.first == rhs.first &&
+                             lhs.second == rhs.second;
+                    });
+}
+
+template <typename FlatMapT, typename TreeMapT> void run_random_updates() {
+  using interval_type = typename TreeMapT::interval_type;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 200);
+  std::uniform_int_distribution<int> len(1, 20);
+  std::uniform_int_distribution<int> val(1, 3);
+  std::uniform_int_distribution<int> op(0, 5);
+
+  FlatMapT flat;
+  TreeMapT tree;
+  for (int step = 0; step < 2000; ++step) {
+    const int lo = pos(gen);
+    const auto segment =
+        std::make_pair(interval_type::right_open(lo, lo + len(gen)), val(gen));
+    switch (op(gen)) {
+    case 0:
+    case 1:
+      flat += segment;
+      tree += segment;
+      break;
+    case 2:
+      flat -= segment;
+      tree -= segment;
+      break;
+    case 3:
+      flat.insert(segment);
+      tree.insert(segment);
+      break;
+    case 4:
+      flat.erase(segment.first);
+      tree.erase(segment.first);
+      break;
+    default:
+      flat.set(segment);
+      tree.set(segment);
+      break;
+    }
+    REQUIRE(same_segments(flat, tree));
+  }
+}
+
+TEST_CASE("Test Flat Interval Map Random Updates", "[flat]") {
+  run_random_updates<icl::flat_interval_map<int, int>,
+                     icl::interval_map<int, int>>();
+}
+
+TEST_CASE("Test Flat Split Interval Map Random Updates", "[flat]") {
+  run_random_updates<icl::flat_split_interval_map<int, int>,
+                     icl::split_interval_map<int, int>>();
+}
+
+TEST_CASE("Test Flat Interval Map Lookup", "[flat]") {
+  using interval_type = icl::discrete_interval<int>;
+  icl::flat_interval_map<int, int> overlap_counter;
+
+  overlap_counter += std::make_pair(interval_type::right_open(4, 8), 1);
+  overlap_counter += std::make_pair(interval_type::right_open(6, 9), 1);
+  overlap_counter += std::make_pair(interval_type::right_open(1, 9), 1);
+
+  REQUIRE(overlap_counter.iterative_size() == 4);
+  REQUIRE(overlap_counter.find(0) == overlap_counter.end());
+  REQUIRE(overlap_counter.find(9) == overlap_counter.end());
+  REQUIRE(overlap_counter.find(2)->first == interval_type::right_open(1, 4));
+  REQUIRE(overlap_counter.find(3)->second == 1);
+  REQUIRE(overlap_counter.find(5)->second == 2);
+  REQUIRE(overlap_counter.find(6)->second == 3);
+  REQUIRE(overlap_counter.find(8)->second == 2);
+
+  auto exterior = overlap_counter.equal_range(interval_type::right_open(5, 7));
+  REQUIRE(std::distance(exterior.first, exterior.second) == 2);
+  REQUIRE(exterior.first->first == interval_type::right_open(4, 6));
+
+  icl::interval_map<int, int> tree_counter(overlap_counter);
+  icl::flat_interval_map<int, int> copied(tree_counter);
+  REQUIRE(same_segments(copied, tree_counter));
+
+  overlap_counter -= std::make_pair(interval_type::right_open(1, 9), 1);
+  REQUIRE(overlap_counter.iterative_size() == 3);
+  REQUIRE(overlap_counter.find(3) == overlap_counter.end());
+  REQUIRE(overlap_counter.find(7)->second == 2);
+}
+
+// A failed update must leave the map valid: Its segments are disjoint and
+// ascending, and no value, that the map absorbs, is left by a move.
+TEST_CASE("Test Flat Interval Map Failed Update", "[flat]") {
+  using interval_type = icl::discrete_interval<int>;
+  using map_type = icl::flat_interval_map<int, fallible>;
+
+  for (int fail_after = 0; fail_after < 4; ++fail_after) {
+    map_type object;
+    object += std::make_pair(interval_type::right_open(0, 4), fallible{1});
+    object += std::make_pair(interval_type::right_open(6, 10), fallible{2});
+    object += std::make_pair(interval_type::right_open(10, 12), fallible{3});
+    object += std::make_pair(interval_type::right_open(20, 30), fallible{4});
+
+    fallible::combinations_left = fail_after;
+    bool failed = false;
+    try {
+      object += std::make_pair(interval_type::right_open(2, 11), fallible{5});
+    } catch (const std::runtime_error&) {
+      failed = true;
+    }
+    fallible::combinations_left = -1;
+
+    REQUIRE(failed == (fail_after < 3));
+    for (auto it_ = object.begin(); it_ != object.end(); ++it_) {
+      REQUIRE(!it_->second.elements.empty());
+      if (std::next(it_) != object.end())
+        REQUIRE(icl::exclusive_less(it_->first, std::next(it_)->first));
+    }
+    REQUIRE(object.find(0)->second == fallible{1});
+    REQUIRE(object.find(25)->second == fallible{4});
+  }
+}
@@ -0,0 +1,153 @@
+#include "icl/compact_discrete_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_set.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+
+static_assert(
+    sizeof(icl::flat_compact_interval_set<std::int64_t>::value_type) ==
+    2 * sizeof(std::int64_t));
+static_assert(sizeof(icl::flat_interval_set<std::int64_t>::value_type) >
+              2 * sizeof(std::int64_t));
+
+// Counts the bytes that are allocated and not yet released
+class live_bytes_resource : public std::pmr::memory_resource {
+public:
+  std::size_t live_bytes() const { return _live_bytes; }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    _live_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* pointer, std::size_t bytes,
+                     std::size_t alignment) override {
+    _live_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::size_t _live_bytes = 0;
+};
+
+// Sets on flat storage must hold exactly the intervals of their node based
+// counterparts after every operation.
+template <typename FlatSetT, typename TreeSetT> void run_random_updates() {
+  using interval_type = typename TreeSetT::interval_type;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 200);
+  std::uniform_int_distribution<int> len(1, 20);
+  std::uniform_int_distribution<int> op(0, 3);
+
+  FlatSetT flat;
+  TreeSetT tree;
+  for (int step = 0; step < 2000; ++step) {
+    const int lo = pos(gen);
+    const interval_type inter_val =
+        interval_type::right_open(lo, lo + len(gen));
+    switch (op(gen)) {
+    case 0:
+    case 1:
+      flat += inter_val;
+      tree += inter_val;
+      break;
+    case 2:
+      flat -= inter_val;
+      tree -= inter_val;
+      break;
+    default:
+      flat ^= inter_val;
+      tree ^= inter_val;
+      break;
+    }
+    REQUIRE(std::equal(flat.begin(), flat.end(), tree.begin(), tree.end()));
+  }
+}
+
+TEST_CASE("Test Flat Interval Set Random Updates", "[flat]") {
+  run_random_updates<icl::flat_interval_set<int>, icl::interval_set<int>>();
+}
+
+TEST_CASE("Test Flat Separate Interval Set Random Updates", "[flat]") {
+  run_random_updates<icl::flat_separate_interval_set<int>,
+                     icl::separate_interval_set<int>>();
+}
+
+TEST_CASE("Test Flat Split Interval Set Random Updates", "[flat]") {
+  run_random_updates<icl::flat_split_interval_set<int>,
+                     icl::split_interval_set<int>>();
+}
+
+TEST_CASE("Test Flat Interval Set Lookup", "[flat]") {
+  using interval_type = icl::discrete_interval<int>;
+  icl::flat_interval_set<int> blacklist;
+
+  blacklist += interval_type::right_open(10, 20);
+  blacklist += interval_type::right_open(30, 40);
+  blacklist += interval_type::right_open(20, 25);
+  blacklist += interval_type::right_open(50, 60);
+
+  REQUIRE(blacklist.iterative_size() == 3);
+  REQUIRE(blacklist.find(9) == blacklist.end());
+  REQUIRE(*blacklist.find(22) == interval_type::right_open(10, 25));
+  REQUIRE(*blacklist.find(30) == interval_type::right_open(30, 40));
+  REQUIRE(blacklist.find(45) == blacklist.end());
+
+  auto exterior = blacklist.equal_range(interval_type::right_open(24, 55));
+  REQUIRE(std::distance(exterior.first, exterior.second) == 3);
+  REQUIRE(*blacklist.lower_bound(interval_type::right_open(26, 28)) ==
+          interval_type::right_open(30, 40));
+  REQUIRE(*blacklist.upper_bound(interval_type::right_open(26, 28)) ==
+          interval_type::right_open(30, 40));
+
+  icl::interval_set<int> tree_blacklist(blacklist);
+  icl::flat_interval_set<int> copied(tree_blacklist);
+  REQUIRE(std::equal(copied.begin(), copied.end(), tree_blacklist.begin(),
+                     tree_blacklist.end()));
+
+  blacklist -= interval_type::right_open(15, 35);
+  REQUIRE(blacklist.iterative_size() == 3);
+  REQUIRE(*blacklist.find(12) == interval_type::right_open(10, 15));
+  REQUIRE(*blacklist.find(35) == interval_type::right_open(35, 40));
+}
+
+TEST_CASE("Test Flat Compact Interval Set Footprint", "[flat]") {
+  using compact_set =
+      icl::flat_compact_interval_set<std::int64_t, std::less,
+                                     std::pmr::polymorphic_allocator>;
+  using discrete_set =
+      icl::flat_interval_set<std::int64_t, std::less,
+                             icl::discrete_interval<std::int64_t>,
+                             std::pmr::polymorphic_allocator>;
+  live_bytes_resource compact_resource, discrete_resource;
+  compact_set compact(&compact_resource);
+  discrete_set discrete(&discrete_resource);
+
+  for (std::int64_t lo = 0; lo < 3000; lo += 3) {
+    compact += compact_set::interval_type(lo, lo + 2);
+    discrete += discrete_set::interval_type::right_open(lo, lo + 2);
+  }
+
+  // Both arrays grow alike, the compact one by 16 instead of 24 bytes for
+  // each segment of its capacity.
+  REQUIRE(compact.iterative_size() == 1000);
+  REQUIRE(discrete.iterative_size() == 1000);
+  REQUIRE(compact_resource.live_bytes() >= 1000 * 2 * sizeof(std::int64_t));
+  REQUIRE(compact_resource.live_bytes() * 3 ==
+          discrete_resource.live_bytes() * 2);
+
+  REQUIRE(icl::contains(compact, std::int64_t{301}));
+  REQUIRE(!icl::contains(compact, std::int64_t{302}));
+  REQUIRE(*compact.find(1501) == compact_set::interval_type(1500, 1502));
+}
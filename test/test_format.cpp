@@ -0,0 +1,121 @@
+#include "icl/closed_interval.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/format.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/right_open_interval.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+#include <version>
+
+#ifdef __cpp_lib_format
+
+#include <format>
+
+// Formatting without a spec must yield the text of operator<<.
+template <typename Type> void run_format(const Type& object) {
+  std::ostringstream stream;
+  stream << object;
+  REQUIRE(std::format("{}", object) == stream.str());
+
+  std::wostringstream wide_stream;
+  wide_stream << object;
+  REQUIRE(std::format(L"{}", object) == wide_stream.str());
+}
+
+TEST_CASE("Test Format Intervals", "[format]") {
+  using interval_type = icl::discrete_interval<int>;
+  run_format(interval_type::right_open(1, 5));
+  run_format(interval_type::left_open(1, 5));
+  run_format(interval_type::closed(-3, 5));
+  run_format(interval_type::open(1, 5));
+  run_format(interval_type::open(1, 2));
+  run_format(icl::right_open_interval<int>(2, 7));
+  run_format(icl::closed_interval<int>(2, 7));
+  run_format(icl::continuous_interval<double>::left_open(0.5, 2.25));
+  run_format(icl::interval_bounds::left_open());
+
+  REQUIRE(std::format("{:#x}", interval_type::closed(10, 255)) ==
+          "[0xa,0xff]");
+  REQUIRE(std::format("{:>3}", interval_type::right_open(1, 5)) ==
+          "[  1,  5)");
+  REQUIRE(std::format("{:.1f}",
+                      icl::continuous_interval<double>::closed(0.25, 2)) ==
+          "[0.2,2.0]");
+  REQUIRE(std::format("<{}>", icl::interval_bounds::closed()) == "<[]>");
+}
+
+TEST_CASE("Test Format Interval Sets", "[format]") {
+  icl::interval_set<int> joined;
+  icl::separate_interval_set<int> separate;
+  icl::split_interval_set<int> split;
+  icl::flat_interval_set<int> flat;
+  run_format(joined);
+  for (const auto& inter_val : {icl::discrete_interval<int>::closed(1, 3),
+                                icl::discrete_interval<int>::open(3, 8),
+                                icl::discrete_interval<int>::closed(10, 20),
+                                icl::discrete_interval<int>::right_open(
+                                    15, 30)}) {
+    joined.add(inter_val);
+    separate.add(inter_val);
+    split.add(inter_val);
+    flat.add(inter_val);
+  }
+  run_format(joined);
+  run_format(separate);
+  run_format(split);
+  run_format(flat);
+
+  REQUIRE(std::format("{:02}", joined) == "{[01,08)[10,30)}");
+  REQUIRE(std::format("{:x}", split) == "{[1,3](3,8)[a,f)[f,14](14,1e)}");
+}
+
+TEST_CASE("Test Format Interval Maps", "[format]") {
+  using interval_type = icl::discrete_interval<int>;
+
+  icl::interval_map<int, double> joined;
+  icl::split_interval_map<int, int> split;
+  icl::flat_interval_map<int, int> flat;
+  run_format(joined);
+  for (int i = 0; i < 4; ++i) {
+    joined.add(std::make_pair(interval_type::closed(3 * i, 3 * i + 4), 0.5));
+    split.add(std::make_pair(interval_type::right_open(5 * i, 5 * i + 7), i));
+    flat.add(std::make_pair(interval_type::left_open(2 * i, 2 * i + 3), 1));
+  }
+  run_format(joined);
+  run_format(split);
+  run_format(flat);
+
+  icl::interval_map<int, double> small;
+  small.add(std::make_pair(interval_type::right_open(10, 20), 1.5));
+  small.add(std::make_pair(interval_type::closed(15, 31), 0.25));
+  REQUIRE(std::format("{:x|.2f}", small) ==
+          "{([a,f)->1.50)([f,14)->1.75)([14,1f]->0.25)}");
+  REQUIRE(std::format("{:|+}", small) ==
+          "{([10,15)->+1.5)([15,20)->+1.75)([20,31]->+0.25)}");
+  REQUIRE(std::format("{:>3}", small) ==
+          "{([ 10, 15)->1.5)([ 15, 20)->1.75)([ 20, 31]->0.25)}");
+  REQUIRE(std::format(L"{:x|}", small) ==
+          L"{([a,f)->1.5)([f,14)->1.75)([14,1f]->0.25)}");
+}
+
+TEST_CASE("Test Format Errors", "[format]") {
+  icl::interval_map<int, double> map;
+  icl::interval_set<int> set;
+  const icl::interval_bounds bounds = icl::interval_bounds::open();
+  auto rejects = [](std::string_view spec, const auto& object) {
+    REQUIRE_THROWS_AS(std::vformat(spec, std::make_format_args(object)),
+                      std::format_error);
+  };
+  rejects("{:q}", set);
+  rejects("{:q|}", map);
+  rejects("{:|q}", map);
+  rejects("{:x}", bounds);
+}
+
+#endif // __cpp_lib_format
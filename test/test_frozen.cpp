@@ -0,0 +1,104 @@
+#include "icl/continuous_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/frozen.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <random>
+
+// Every search of a snapshot must yield the segment at the position that
+// the search of its container yields.
+template <typename Type> void run_frozen() {
+  using interval_type = typename Type::interval_type;
+  using domain_type = typename Type::domain_type;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 1000);
+  std::uniform_int_distribution<int> len(0, 20);
+  std::uniform_int_distribution<int> bound(0, 3);
+  std::uniform_int_distribution<int> val(1, 3);
+
+  auto random_interval = [&](int max_length) {
+    const int lo = pos(gen);
+    return interval_type(
+        static_cast<domain_type>(lo),
+        static_cast<domain_type>(lo + len(gen) % (max_length + 1)),
+        icl::interval_bounds(static_cast<icl::bound_type>(bound(gen))));
+  };
+
+  for (const int count : {0, 1, 2, 7, 100, 400}) {
+    Type object;
+    for (int i = 0; i < count; ++i)
+      if constexpr (icl::is_interval_map<Type>::value)
+        object.add(std::make_pair(random_interval(20), val(gen)));
+      else
+        object.add(random_interval(20));
+
+    const Type& source = object;
+    const icl::frozen<Type> snapshot = source.freeze();
+    REQUIRE(snapshot.iterative_size() == object.iterative_size());
+    REQUIRE(snapshot.size() == object.size());
+    REQUIRE(snapshot.length() == object.length());
+    REQUIRE(std::equal(snapshot.begin(), snapshot.end(), object.begin(),
+                       object.end(), [](const auto& left, const auto& right) {
+                         if constexpr (icl::is_interval_map<Type>::value)
+                           return left.first == right.first &&
+                                  left.second == right.second;
+                         else
+                           return left == right;
+                       }));
+    REQUIRE(std::distance(snapshot.rbegin(), snapshot.rend()) ==
+            static_cast<std::ptrdiff_t>(object.iterative_size()));
+
+    auto position = [](const auto& container, const auto& it_) {
+      return std::distance(container.begin(), it_);
+    };
+    for (int point = -2; point <= 1030; ++point) {
+      const auto key = static_cast<domain_type>(point);
+      REQUIRE(position(snapshot, snapshot.find(key)) ==
+              position(source, source.find(key)));
+      REQUIRE(snapshot.contains(key) == icl::contains(source, key));
+      REQUIRE(snapshot.intersects(key) == icl::intersects(source, key));
+      if constexpr (icl::is_interval_map<Type>::value)
+        REQUIRE(snapshot(key) == source(key));
+    }
+
+    for (int query = 0; query < 500; ++query) {
+      const interval_type inter_val = random_interval(query % 2 ? 3 : 20);
+      REQUIRE(position(snapshot, snapshot.find(inter_val)) ==
+              position(source, source.find(inter_val)));
+      REQUIRE(position(snapshot, snapshot.lower_bound(inter_val)) ==
+              position(source, source.lower_bound(inter_val)));
+      REQUIRE(position(snapshot, snapshot.upper_bound(inter_val)) ==
+              position(source, source.upper_bound(inter_val)));
+      REQUIRE(snapshot.contains(inter_val) ==
+              icl::contains(source, inter_val));
+      REQUIRE(snapshot.intersects(inter_val) ==
+              icl::intersects(source, inter_val));
+    }
+  }
+}
+
+TEST_CASE("Test Frozen Interval Sets", "[frozen]") {
+  run_frozen<icl::interval_set<int>>();
+  run_frozen<icl::separate_interval_set<int>>();
+  run_frozen<icl::split_interval_set<int>>();
+  run_frozen<icl::flat_interval_set<int>>();
+  run_frozen<icl::interval_set<double, std::less,
+                               icl::continuous_interval<double>>>();
+}
+
+TEST_CASE("Test Frozen Interval Maps", "[frozen]") {
+  run_frozen<icl::interval_map<int, int>>();
+  run_frozen<icl::split_interval_map<int, int>>();
+  run_frozen<icl::flat_interval_map<int, int>>();
+  run_frozen<icl::interval_map<int, int, icl::total_absorber>>();
+  run_frozen<icl::interval_map<double, int, icl::partial_absorber, std::less,
+                               icl::inplace_plus, icl::inter_section,
+                               icl::continuous_interval<double>>>();
+}
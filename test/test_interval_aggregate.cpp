@@ -0,0 +1,136 @@
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/split_interval_map.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <random>
+
+// Aggregates of augmented maps must equal those of a walk over the segments
+// that overlap the queried interval.
+template <typename MapT>
+std::optional<typename MapT::aggregate_type>
+walk(const MapT& object, const typename MapT::interval_type& inter_val) {
+  using aggregate_type = typename MapT::aggregate_type;
+
+  std::optional<aggregate_type> result;
+  if (icl::is_empty(inter_val))
+    return result;
+  const auto exterior = object.equal_range(inter_val);
+  for (auto it_ = exterior.first; it_ != exterior.second; ++it_) {
+    const aggregate_type segment((*it_).first & inter_val, (*it_).second);
+    if (result)
+      result->append(segment);
+    else
+      result = segment;
+  }
+  return result;
+}
+
+template <typename MapT>
+bool same_aggregates(const MapT& object,
+                     const typename MapT::interval_type& inter_val) {
+  const auto expected = walk(object, inter_val);
+  if constexpr (MapT::aggregate_type::is_weightable)
+    if (object.aggregate(inter_val, icl::aggregate_weighted_sum) !=
+        icl::aggregate_weighted_sum(expected))
+      return false;
+  return object.aggregate(inter_val, icl::aggregate_sum) ==
+             icl::aggregate_sum(expected) &&
+         object.aggregate(inter_val, icl::aggregate_min) ==
+             icl::aggregate_min(expected) &&
+         object.aggregate(inter_val, icl::aggregate_max) ==
+             icl::aggregate_max(expected);
+}
+
+template <typename MapT> void run_aggregate_queries() {
+  using interval_type = typename MapT::interval_type;
+  using segment_type = typename MapT::segment_type;
+  using codomain_type = typename MapT::codomain_type;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 1000);
+  std::uniform_int_distribution<int> len(0, 60);
+  std::uniform_int_distribution<int> val(1, 9);
+  std::uniform_int_distribution<int> op(0, 5);
+
+  MapT object;
+  for (int step = 0; step < 2000; ++step) {
+    const int lo = pos(gen);
+    const interval_type inter_val =
+        interval_type::right_open(lo, lo + len(gen));
+    const segment_type segment(inter_val,
+                               static_cast<codomain_type>(val(gen)));
+    switch (op(gen)) {
+    case 0:
+    case 1:
+      object.add(segment);
+      break;
+    case 2:
+      object.subtract(segment);
+      break;
+    case 3:
+      object.insert(segment);
+      break;
+    case 4:
+      object.erase(inter_val);
+      break;
+    default:
+      object.set(segment);
+      break;
+    }
+
+    const int query_lo = pos(gen);
+    REQUIRE(same_aggregates(
+        object, interval_type::right_open(query_lo, query_lo + 5 * len(gen))));
+  }
+
+  REQUIRE(same_aggregates(object, interval_type::closed(-1, 2000)));
+  object.flip(segment_type(interval_type::right_open(50, 950), 1));
+  REQUIRE(same_aggregates(object, interval_type::closed(-1, 2000)));
+  const MapT copied(object);
+  REQUIRE(same_aggregates(copied, interval_type::right_open(100, 900)));
+}
+
+TEST_CASE("Test Augmented Interval Map Aggregates", "[aggregate]") {
+  run_aggregate_queries<icl::augmented_interval_map<int, int>>();
+  run_aggregate_queries<icl::augmented_interval_map<int, double>>();
+  run_aggregate_queries<
+      icl::augmented_interval_map<int, int, icl::partial_enricher>>();
+  run_aggregate_queries<
+      icl::augmented_interval_map<int, int, icl::total_enricher>>();
+  run_aggregate_queries<icl::augmented_interval_map<
+      int, int, icl::partial_absorber, std::less, icl::inplace_max>>();
+  run_aggregate_queries<icl::split_interval_map<
+      int, int, icl::partial_absorber, std::less, icl::inplace_plus,
+      icl::inter_section, icl::discrete_interval<int>, std::allocator,
+      icl::augmented_storage>>();
+}
+
+TEST_CASE("Test Augmented Interval Map Usage Counter", "[aggregate]") {
+  using interval_type = icl::discrete_interval<int>;
+
+  icl::augmented_interval_map<int, int> usage;
+  usage += std::make_pair(interval_type::right_open(0, 10), 1);
+  usage += std::make_pair(interval_type::right_open(5, 15), 2);
+  usage += std::make_pair(interval_type::right_open(20, 30), 4);
+
+  // [0,5)->1 [5,10)->3 [10,15)->2 [20,30)->4
+  const interval_type query = interval_type::right_open(3, 25);
+  REQUIRE(usage.aggregate(query, icl::aggregate_sum) == 10);
+  REQUIRE(usage.aggregate(query, icl::aggregate_weighted_sum) ==
+          2 * 1 + 5 * 3 + 5 * 2 + 5 * 4);
+  REQUIRE(usage.aggregate(query, icl::aggregate_min) == 1);
+  REQUIRE(usage.aggregate(query, icl::aggregate_max) == 4);
+
+  const interval_type gap = interval_type::right_open(16, 19);
+  REQUIRE(usage.aggregate(gap, icl::aggregate_sum) == 0);
+  REQUIRE(!usage.aggregate(gap, icl::aggregate_max));
+
+  usage -= std::make_pair(interval_type::right_open(5, 10), 3);
+  REQUIRE(usage.aggregate(query, icl::aggregate_weighted_sum) ==
+          2 * 1 + 5 * 2 + 5 * 4);
+  REQUIRE(usage.aggregate(interval_type::right_open(0, 100),
+                          icl::aggregate_weighted_sum) ==
+          icl::aggregate_weighted_sum(walk(
+              usage, interval_type::right_open(0, 100))));
+}
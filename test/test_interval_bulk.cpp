@@ -0,0 +1,140 @@
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <execution>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Maps built from a range in bulk must equal maps that are built by adding
+// the segments one by one.
+template <typename MapT>
+bool same_segments(const MapT& built, const MapT& expected) {
+  return std::equal(built.begin(), built.end(), expected.begin(),
+                    expected.end());
+}
+
+template <typename MapT> void run_bulk_build(int max_length) {
+  using interval_type = typename MapT::interval_type;
+  using codomain_type = typename MapT::codomain_type;
+  using segment_type = std::pair<interval_type, codomain_type>;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 500);
+  std::uniform_int_distribution<int> len(0, max_length);
+  std::uniform_int_distribution<int> val(-2, 3);
+
+  for (int round = 0; round < 50; ++round) {
+    std::vector<segment_type> segments;
+    for (int i = 0; i < 300; ++i) {
+      const int lo = pos(gen);
+      segments.emplace_back(interval_type::right_open(lo, lo + len(gen)),
+                            static_cast<codomain_type>(val(gen)));
+    }
+
+    MapT expected;
+    for (const segment_type& segment : segments)
+      expected.add(segment);
+
+    const MapT built(segments.begin(), segments.end());
+    REQUIRE(same_segments(built, expected));
+
+    MapT assigned = expected;
+    assigned.assign(segments.begin(), segments.end());
+    REQUIRE(same_segments(assigned, expected));
+  }
+}
+
+TEST_CASE("Test Interval Map Bulk Build", "[bulk]") {
+  run_bulk_build<icl::interval_map<int, int>>(20);
+  run_bulk_build<icl::interval_map<int, int>>(400);
+  run_bulk_build<icl::flat_interval_map<int, int>>(20);
+  run_bulk_build<icl::interval_map<int, int, icl::partial_enricher>>(20);
+  run_bulk_build<icl::interval_map<int, int, icl::total_absorber>>(20);
+}
+
+TEST_CASE("Test Interval Map Bulk Build Folds Values", "[bulk]") {
+  run_bulk_build<icl::interval_map<int, double>>(20);
+  run_bulk_build<icl::interval_map<int, int, icl::partial_absorber, std::less,
+                                   icl::inplace_max>>(20);
+  run_bulk_build<icl::interval_map<int, int, icl::partial_enricher, std::less,
+                                   icl::inplace_max>>(20);
+}
+
+TEST_CASE("Test Interval Map Bulk Build Example", "[bulk]") {
+  using interval_type = icl::discrete_interval<int>;
+  const std::vector<std::pair<interval_type, int>> segments = {
+      {interval_type::right_open(6, 9), 1},
+      {interval_type::right_open(1, 9), 1},
+      {interval_type::right_open(4, 8), 1},
+      {interval_type::right_open(9, 12), 1},
+      {interval_type::right_open(2, 2), 5}};
+
+  const icl::interval_map<int, int> overlap_counter(segments.begin(),
+                                                    segments.end());
+  REQUIRE(overlap_counter.iterative_size() == 5);
+  REQUIRE(overlap_counter.find(0) == overlap_counter.end());
+  REQUIRE(overlap_counter.find(2)->second == 1);
+  REQUIRE(overlap_counter.find(6)->second == 3);
+  REQUIRE(overlap_counter.find(8)->second == 2);
+  REQUIRE(overlap_counter.find(9)->first == interval_type::right_open(9, 12));
+}
+
+// Parallel construction partitions the input, segments that span partition
+// borders are carried over.
+template <typename MapT> void run_parallel_bulk_build(int max_length) {
+  using interval_type = typename MapT::interval_type;
+  using codomain_type = typename MapT::codomain_type;
+  using segment_type = std::pair<interval_type, codomain_type>;
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> pos(0, 1000000);
+  std::uniform_int_distribution<int> len(0, max_length);
+  std::uniform_int_distribution<int> val(-2, 3);
+
+  std::vector<segment_type> segments;
+  for (int i = 0; i < 100000; ++i) {
+    const int lo = pos(gen);
+    segments.emplace_back(interval_type::right_open(lo, lo + len(gen)),
+                          static_cast<codomain_type>(val(gen)));
+  }
+  segments.emplace_back(interval_type::right_open(10, 900000), 1);
+
+  const MapT expected(segments.begin(), segments.end());
+  const MapT built(std::execution::par, segments.begin(), segments.end());
+  REQUIRE(same_segments(built, expected));
+}
+
+TEST_CASE("Test Interval Map Parallel Bulk Build", "[bulk]") {
+  run_parallel_bulk_build<icl::interval_map<int, int>>(50);
+  run_parallel_bulk_build<icl::interval_map<int, int>>(50000);
+  run_parallel_bulk_build<icl::interval_map<int, double>>(500);
+  run_parallel_bulk_build<icl::flat_interval_map<int, int>>(50);
+}
+
+TEST_CASE("Test Interval Set Bulk Build", "[bulk]") {
+  using interval_type = icl::discrete_interval<int>;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 1000000);
+  std::uniform_int_distribution<int> len(0, 20);
+
+  std::vector<interval_type> intervals;
+  for (int i = 0; i < 100000; ++i) {
+    const int lo = pos(gen);
+    intervals.push_back(interval_type::right_open(lo, lo + len(gen)));
+  }
+
+  icl::interval_set<int> expected;
+  for (const interval_type& inter_val : intervals)
+    expected.add(inter_val);
+
+  const icl::interval_set<int> built(intervals.begin(), intervals.end());
+  REQUIRE(built == expected);
+
+  const icl::interval_set<int> parallel_built(
+      std::execution::par, intervals.begin(), intervals.end());
+  REQUIRE(parallel_built == expected);
+}
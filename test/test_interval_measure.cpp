@@ -0,0 +1,211 @@
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Containers keep running totals of their cardinality and length. After
+// every update they must equal the sums over the segments.
+template <typename Type> bool consistent(const Type& object) {
+  typename Type::size_type cardinality = 0;
+  typename Type::difference_type length = 0;
+  for (auto it_ = object.begin(); it_ != object.end(); ++it_) {
+    cardinality += icl::cardinality(icl::key_value<Type>(it_));
+    length += icl::length(icl::key_value<Type>(it_));
+  }
+  return object.size() == cardinality &&
+         icl::cardinality(object) == cardinality &&
+         object.length() == length && icl::length(object) == length;
+}
+
+template <typename SetT> void run_set_updates() {
+  using interval_type = typename SetT::interval_type;
+  static_assert(SetT::caches_measure);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 300);
+  std::uniform_int_distribution<int> len(0, 30);
+  std::uniform_int_distribution<int> op(0, 7);
+
+  SetT object, other;
+  for (int step = 0; step < 3000; ++step) {
+    const int lo = pos(gen);
+    const interval_type inter_val =
+        interval_type::right_open(lo, lo + len(gen));
+    switch (op(gen)) {
+    case 0:
+    case 1:
+      object.add(inter_val);
+      break;
+    case 2:
+      object.subtract(inter_val);
+      break;
+    case 3:
+      object.flip(inter_val);
+      break;
+    case 4:
+      if (!object.empty())
+        object.erase(object.begin());
+      break;
+    case 5:
+      other.add(inter_val);
+      object += other;
+      break;
+    case 6:
+      object &= other;
+      break;
+    default:
+      other.insert(inter_val);
+      object -= other;
+      break;
+    }
+    REQUIRE(consistent(object));
+  }
+
+  SetT moved = std::move(object);
+  REQUIRE(consistent(moved));
+  REQUIRE(object.size() == 0);
+  moved.swap(other);
+  REQUIRE(consistent(moved));
+  REQUIRE(consistent(other));
+  icl::join(other);
+  REQUIRE(consistent(other));
+  other.clear();
+  REQUIRE(other.size() == 0);
+  REQUIRE(other.length() == 0);
+}
+
+template <typename MapT> void run_map_updates() {
+  using interval_type = typename MapT::interval_type;
+  using segment_type = typename MapT::segment_type;
+  static_assert(MapT::caches_measure);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 300);
+  std::uniform_int_distribution<int> len(0, 30);
+  std::uniform_int_distribution<int> val(-1, 2);
+  std::uniform_int_distribution<int> op(0, 9);
+
+  MapT object, other;
+  for (int step = 0; step < 3000; ++step) {
+    const int lo = pos(gen);
+    const interval_type inter_val =
+        interval_type::right_open(lo, lo + len(gen));
+    const segment_type segment(inter_val, val(gen));
+    switch (op(gen)) {
+    case 0:
+    case 1:
+      object.add(segment);
+      break;
+    case 2:
+      object.subtract(segment);
+      break;
+    case 3:
+      object.insert(segment);
+      break;
+    case 4:
+      object.erase(segment);
+      break;
+    case 5:
+      object.erase(inter_val);
+      break;
+    case 6:
+      object.set(segment);
+      break;
+    case 7:
+      if (!object.empty())
+        object.erase(object.begin());
+      break;
+    case 8:
+      other.add(segment);
+      object += other;
+      break;
+    default:
+      if constexpr (!icl::is_total<MapT>::value)
+        object.flip(segment);
+      break;
+    }
+    REQUIRE(consistent(object));
+  }
+
+  MapT copied(object);
+  REQUIRE(consistent(copied));
+  copied.swap(other);
+  REQUIRE(consistent(copied));
+  REQUIRE(consistent(other));
+  icl::join(other);
+  REQUIRE(consistent(other));
+  other.clear();
+  REQUIRE(other.size() == 0);
+}
+
+TEST_CASE("Test Interval Set Cached Measure", "[measure]") {
+  run_set_updates<icl::interval_set<int>>();
+  run_set_updates<icl::separate_interval_set<int>>();
+  run_set_updates<icl::split_interval_set<int>>();
+  run_set_updates<icl::flat_interval_set<int>>();
+}
+
+TEST_CASE("Test Interval Map Cached Measure", "[measure]") {
+  run_map_updates<icl::interval_map<int, int>>();
+  run_map_updates<icl::interval_map<int, int, icl::partial_enricher>>();
+  run_map_updates<icl::interval_map<int, int, icl::total_absorber>>();
+  run_map_updates<icl::interval_map<int, int, icl::total_enricher>>();
+  run_map_updates<icl::split_interval_map<int, int>>();
+  run_map_updates<icl::flat_interval_map<int, int>>();
+}
+
+TEST_CASE("Test Interval Container Without Cached Measure", "[measure]") {
+  using interval_type = icl::discrete_interval<int>;
+  using set_type = icl::interval_set<int, std::less, interval_type,
+                                     std::allocator,
+                                     icl::uncached<icl::tree_storage>>;
+  static_assert(!set_type::caches_measure);
+
+  set_type object;
+  object.add(interval_type::right_open(1, 5));
+  object.add(interval_type::right_open(10, 12));
+  object.subtract(interval_type::right_open(3, 11));
+  REQUIRE(object.size() == 3);
+  REQUIRE(object.length() == 3);
+
+  const icl::interval_set<int> cached(object);
+  REQUIRE(cached.size() == 3);
+  REQUIRE(icl::length(cached) == 3);
+}
+
+TEST_CASE("Test Interval Container Cached Measure After Bulk Build",
+          "[measure]") {
+  using interval_type = icl::discrete_interval<int>;
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> pos(0, 5000);
+  std::uniform_int_distribution<int> len(0, 40);
+
+  std::vector<interval_type> intervals;
+  std::vector<std::pair<interval_type, int>> segments;
+  for (int i = 0; i < 2000; ++i) {
+    const int lo = pos(gen);
+    intervals.push_back(interval_type::right_open(lo, lo + len(gen)));
+    segments.emplace_back(intervals.back(), i % 3);
+  }
+
+  const icl::interval_set<int> set(intervals.begin(), intervals.end());
+  REQUIRE(consistent(set));
+  icl::interval_map<int, int> map(segments.begin(), segments.end());
+  REQUIRE(consistent(map));
+  map.assign(segments.begin(), segments.begin() + 100);
+  REQUIRE(consistent(map));
+  const icl::flat_interval_map<int, int> flat(segments.begin(),
+                                              segments.end());
+  REQUIRE(consistent(flat));
+
+  icl::interval_set<int> joined = set;
+  joined += icl::interval_set<int>(intervals.begin(), intervals.begin() + 500);
+  REQUIRE(consistent(joined));
+}
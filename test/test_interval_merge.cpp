@@ -0,0 +1,130 @@
+#include "random_container.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+// Containers of comparable sizes are combined in one merging sweep. The
+// results must be those of the segmentwise algorithms.
+template <typename LeftT, typename RightT>
+bool same_segments(const LeftT& left, const RightT& right) {
+  return std::equal(left.begin(), left.end(), right.begin(), right.end());
+}
+
+// Right open intervals, that are never empty, and maps with identities
+constexpr icl_test::random_shape shape{.domain = 400, .min_length = 1,
+                                       .max_length = 20, .min_value = 0,
+                                       .right_open = true};
+
+template <typename SetT> void run_set_merges() {
+  std::mt19937 gen(42);
+  for (int round = 0; round < 200; ++round) {
+    const SetT left = icl_test::random_container<SetT>(gen, 30, shape);
+    const SetT right = icl_test::random_container<SetT>(gen, 30, shape);
+    const icl::interval_set<int> joined =
+        icl_test::random_container<icl::interval_set<int>>(gen, 30, shape);
+
+    SetT sum = left, expected_sum = left;
+    sum += right;
+    for (const auto& inter_val : right)
+      icl::add(expected_sum, inter_val);
+    REQUIRE(same_segments(sum, expected_sum));
+
+    SetT difference = left, expected_difference = left;
+    difference -= joined;
+    icl::erase(expected_difference, joined);
+    REQUIRE(same_segments(difference, expected_difference));
+
+    SetT section = left, expected_section;
+    section &= right;
+    icl::add_intersection(expected_section, left, right);
+    REQUIRE(same_segments(section, expected_section));
+
+    SetT flipped = left, expected_flipped = left;
+    flipped ^= right;
+    icl::flip(expected_flipped, right);
+    REQUIRE(same_segments(flipped, expected_flipped));
+  }
+}
+
+template <typename MapT> void run_map_merges() {
+  std::mt19937 gen(42);
+  for (int round = 0; round < 200; ++round) {
+    const MapT left = icl_test::random_container<MapT>(gen, 30, shape);
+    const MapT right = icl_test::random_container<MapT>(gen, 30, shape);
+    const icl::interval_set<int> key_set =
+        icl_test::random_container<icl::interval_set<int>>(gen, 30, shape);
+
+    MapT sum = left, expected_sum = left;
+    sum += right;
+    for (const auto& segment : right)
+      icl::add(expected_sum, segment);
+    REQUIRE(same_segments(sum, expected_sum));
+
+    MapT difference = left, expected_difference = left;
+    difference -= right;
+    for (const auto& segment : right)
+      icl::subtract(expected_difference, segment);
+    REQUIRE(same_segments(difference, expected_difference));
+
+    MapT erased = left, expected_erased = left;
+    erased -= key_set;
+    icl::erase(expected_erased, key_set);
+    REQUIRE(same_segments(erased, expected_erased));
+
+    MapT restricted = left, expected_restricted;
+    restricted &= key_set;
+    icl::add_intersection(expected_restricted, left, key_set);
+    REQUIRE(same_segments(restricted, expected_restricted));
+
+    if constexpr (!icl::is_total<MapT>::value) {
+      MapT section = left, expected_section;
+      section &= right;
+      icl::add_intersection(expected_section, left, right);
+      REQUIRE(same_segments(section, expected_section));
+
+      MapT flipped = left, expected_flipped = left;
+      flipped ^= right;
+      icl::flip(expected_flipped, right);
+      REQUIRE(same_segments(flipped, expected_flipped));
+    }
+  }
+}
+
+TEST_CASE("Test Interval Set Merge", "[merge]") {
+  run_set_merges<icl::interval_set<int>>();
+  run_set_merges<icl::separate_interval_set<int>>();
+  run_set_merges<icl::split_interval_set<int>>();
+  run_set_merges<icl::flat_interval_set<int>>();
+}
+
+TEST_CASE("Test Interval Map Merge", "[merge]") {
+  run_map_merges<icl::interval_map<int, int>>();
+  run_map_merges<icl::split_interval_map<int, int>>();
+  run_map_merges<icl::flat_interval_map<int, int>>();
+  run_map_merges<icl::interval_map<int, int, icl::partial_enricher>>();
+  run_map_merges<icl::interval_map<int, int, icl::total_absorber>>();
+  run_map_merges<icl::split_interval_map<int, int, icl::total_enricher>>();
+}
+
+TEST_CASE("Test Interval Merge Of Sets Of Different Styles", "[merge]") {
+  using interval_type = icl::discrete_interval<int>;
+  icl::separate_interval_set<int> object;
+  object.add(interval_type::right_open(1, 3));
+  object.add(interval_type::right_open(3, 5));
+  object.add(interval_type::right_open(8, 9));
+
+  icl::split_interval_set<int> operand;
+  operand.add(interval_type::right_open(2, 4));
+  operand.add(interval_type::right_open(4, 6));
+
+  // Overlapping intervals are joined, touching ones are kept apart
+  object += operand;
+  REQUIRE(object.iterative_size() == 2);
+  REQUIRE(*object.begin() == interval_type::right_open(1, 6));
+}
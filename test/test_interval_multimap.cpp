@@ -0,0 +1,176 @@
+#include "icl/continuous_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_multimap.hpp"
+#include "icl/right_open_interval.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename MultimapT>
+std::vector<typename MultimapT::segment_type> random_records(unsigned seed,
+                                                             int count) {
+  using interval_type = typename MultimapT::interval_type;
+  using domain_type = typename MultimapT::domain_type;
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> pos(0, 500);
+  std::uniform_int_distribution<int> len(0, 40);
+  std::uniform_int_distribution<int> bound(0, 3);
+
+  std::vector<typename MultimapT::segment_type> records;
+  for (int i = 0; i < count; ++i) {
+    const auto lo = static_cast<domain_type>(pos(gen));
+    const auto up = static_cast<domain_type>(lo + len(gen));
+    if constexpr (icl::has_dynamic_bounds<interval_type>::value)
+      records.emplace_back(
+          interval_type(lo, up,
+                        icl::interval_bounds(
+                            static_cast<icl::bound_type>(bound(gen)))),
+          i);
+    else
+      records.emplace_back(interval_type(lo, up), i);
+  }
+  return records;
+}
+
+// The records of a walk over all records, that overlap query
+template <typename MultimapT>
+std::vector<typename MultimapT::segment_type>
+scan(const MultimapT& object, const typename MultimapT::interval_type& query) {
+  std::vector<typename MultimapT::segment_type> result;
+  for (const auto& record : object)
+    if (icl::intersects(record.first, query))
+      result.emplace_back(record.first, record.second);
+  return result;
+}
+
+template <typename MultimapT>
+std::vector<typename MultimapT::interval_type>
+intervals_of(const MultimapT& object) {
+  std::vector<typename MultimapT::interval_type> result;
+  for (const auto& record : object)
+    result.push_back(record.first);
+  return result;
+}
+
+template <typename Range, typename Records>
+bool same_records(const Range& range, const Records& records) {
+  return std::ranges::equal(range, records, [](const auto& x, const auto& y) {
+    return x.first == y.first && x.second == y.second;
+  });
+}
+
+} // namespace
+
+// Overlap queries must find the records of a scan over all records, built
+// in bulk and one by one alike.
+template <typename MultimapT> void run_overlap_queries() {
+  using interval_type = typename MultimapT::interval_type;
+  using domain_type = typename MultimapT::domain_type;
+  static_assert(std::ranges::forward_range<typename MultimapT::overlap_range>);
+
+  for (const int count : {0, 1, 10, 300}) {
+    const auto records = random_records<MultimapT>(count + 1, count);
+    const MultimapT bulk(records.begin(), records.end());
+    MultimapT single;
+    for (const auto& record : records)
+      single.insert(record);
+    REQUIRE(bulk == single);
+    REQUIRE(std::ranges::is_sorted(intervals_of(bulk), bulk.key_comp()));
+
+    std::size_t stored = 0;
+    for (const auto& record : records)
+      stored += !icl::is_empty(record.first);
+    REQUIRE(bulk.size() == stored);
+
+    for (const auto& record : random_records<MultimapT>(count + 2, 100)) {
+      const interval_type& query = record.first;
+      REQUIRE(same_records(bulk.overlapping(query), scan(bulk, query)));
+    }
+    for (int point = -5; point < 560; point += 7) {
+      const auto key_val = static_cast<domain_type>(point);
+      std::vector<typename MultimapT::segment_type> expected;
+      for (const auto& record : bulk)
+        if (icl::contains(record.first, key_val))
+          expected.emplace_back(record.first, record.second);
+      REQUIRE(same_records(bulk.overlapping(key_val), expected));
+    }
+  }
+}
+
+TEST_CASE("Test Interval Multimap Overlaps", "[interval_multimap]") {
+  run_overlap_queries<icl::interval_multimap<int, int>>();
+  run_overlap_queries<icl::interval_multimap<
+      int, int, std::less, icl::right_open_interval<int>>>();
+  run_overlap_queries<icl::interval_multimap<double, int>>();
+}
+
+TEST_CASE("Test Interval Multimap Updates", "[interval_multimap]") {
+  using multimap = icl::interval_multimap<int, int>;
+  using interval_type = multimap::interval_type;
+
+  // Equal and overlapping intervals are kept as distinct records
+  multimap genes{{interval_type::right_open(10, 20), 1},
+                 {interval_type::right_open(15, 30), 2},
+                 {interval_type::right_open(10, 20), 3},
+                 {interval_type::right_open(40, 40), 4}};
+  REQUIRE(genes.size() == 3);
+  REQUIRE(genes.count(interval_type::right_open(10, 20)) == 2);
+  REQUIRE(genes.find(interval_type::right_open(10, 20))->second == 1);
+  REQUIRE(genes.find(interval_type::right_open(10, 25)) == genes.end());
+  REQUIRE(genes.insert({interval_type::right_open(5, 5), 5}) == genes.end());
+
+  genes.insert({interval_type::right_open(10, 20), 6});
+  std::vector<int> values;
+  for (const auto& record : genes.overlapping(12))
+    values.push_back(record.second);
+  REQUIRE(values == std::vector<int>{1, 3, 6});
+  REQUIRE(std::ranges::distance(genes.overlapping(
+              interval_type::right_open(19, 21))) == 4);
+  REQUIRE(genes.overlapping(interval_type::right_open(30, 40)).empty());
+  REQUIRE(genes.overlapping(interval_type::right_open(20, 10)).empty());
+
+  // Records found by queries can be erased
+  auto found = genes.overlapping(25);
+  REQUIRE(std::ranges::distance(found) == 1);
+  genes.erase(found.begin().base());
+  REQUIRE(genes.overlapping(25).empty());
+  REQUIRE(genes.erase(interval_type::right_open(10, 20)) == 3);
+  REQUIRE(genes.empty());
+
+  // Insertions and erasures keep the summaries of the tree up to date
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> pos(0, 1000);
+  std::uniform_int_distribution<int> len(1, 60);
+  multimap object;
+  for (int i = 0; i < 2000; ++i) {
+    const int lo = pos(gen);
+    if (i % 3 == 2 && !object.empty()) {
+      const auto hits = object.overlapping(lo);
+      if (!hits.empty())
+        object.erase(hits.begin().base());
+    } else
+      object.insert({interval_type::right_open(lo, lo + len(gen)), i});
+
+    if (i % 50 == 0) {
+      const interval_type query = interval_type::right_open(lo, lo + 30);
+      REQUIRE(same_records(object.overlapping(query), scan(object, query)));
+    }
+  }
+
+  // Bulk insertion into a filled multimap keeps the order of equal records
+  const auto more = random_records<multimap>(11, 200);
+  multimap single = object;
+  for (const auto& record : more)
+    single.insert(record);
+  object.insert(more.begin(), more.end());
+  REQUIRE(object == single);
+  const auto few = random_records<multimap>(12, 3);
+  for (const auto& record : few)
+    single.insert(record);
+  object.insert(few.begin(), few.end());
+  REQUIRE(object == single);
+}
@@ -0,0 +1,80 @@
+#include "random_container.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+// Batched lookups must equal lookups of the points one by one, for sorted
+// and unsorted points alike.
+template <typename Type> void run_batched_find() {
+  using const_iterator = typename Type::const_iterator;
+  using domain_type = typename Type::domain_type;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(-10, 2050);
+
+  for (int round = 0; round < 20; ++round) {
+    const Type object = icl_test::random_container<Type>(
+        gen, 200, {.domain = 2000, .max_value = 5, .right_open = true});
+
+    std::vector<domain_type> points(1000);
+    for (domain_type& point : points)
+      point = static_cast<domain_type>(pos(gen));
+
+    std::vector<const_iterator> found(points.size());
+    object.find(points, found);
+    for (std::size_t i = 0; i < points.size(); ++i)
+      REQUIRE(found[i] == object.find(points[i]));
+
+    std::sort(points.begin(), points.end());
+    object.find(icl::sorted_points, points, found);
+    for (std::size_t i = 0; i < points.size(); ++i)
+      REQUIRE(found[i] == object.find(points[i]));
+
+    if constexpr (icl::is_interval_map<Type>::value) {
+      using codomain_type = typename Type::codomain_type;
+      std::shuffle(points.begin(), points.end(), gen);
+      std::vector<codomain_type> values(points.size());
+      object.select(points, values);
+      for (std::size_t i = 0; i < points.size(); ++i)
+        REQUIRE(values[i] == object(points[i]));
+    }
+  }
+}
+
+TEST_CASE("Test Interval Map Batched Find", "[stabbing]") {
+  run_batched_find<icl::interval_map<int, int>>();
+  run_batched_find<icl::split_interval_map<int, int>>();
+  run_batched_find<icl::flat_interval_map<int, int>>();
+  run_batched_find<icl::augmented_interval_map<int, int>>();
+  run_batched_find<icl::interval_map<double, int>>();
+}
+
+TEST_CASE("Test Interval Set Batched Find", "[stabbing]") {
+  run_batched_find<icl::interval_set<int>>();
+  run_batched_find<icl::flat_interval_set<int>>();
+  run_batched_find<icl::interval_set<double>>();
+}
+
+TEST_CASE("Test Interval Map Batched Select Example", "[stabbing]") {
+  using interval_type = icl::discrete_interval<int>;
+
+  icl::interval_map<int, int> timeline;
+  timeline += std::make_pair(interval_type::right_open(10, 20), 1);
+  timeline += std::make_pair(interval_type::right_open(30, 40), 2);
+
+  const std::vector<int> stamps = {35, 5, 10, 19, 20, 39, 40};
+  std::vector<int> values(stamps.size());
+  timeline.select(stamps, values);
+  REQUIRE(values == std::vector<int>{2, 0, 1, 1, 0, 2, 0});
+
+  std::vector<icl::interval_map<int, int>::const_iterator> found(2);
+  timeline.find(icl::sorted_points, std::vector<int>{15, 25}, found);
+  REQUIRE(found[0] == timeline.begin());
+  REQUIRE(found[1] == timeline.end());
+}
@@ -0,0 +1,220 @@
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/split_interval_map.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// A set valued codomain, that counts how often it is copied
+struct tags {
+  inline static std::size_t copies = 0;
+  std::set<std::string> names;
+
+  tags() = default;
+  tags(std::initializer_list<std::string> init) : names(init) {}
+  tags(const tags& other) : names(other.names) { ++copies; }
+  tags(tags&&) noexcept = default;
+  tags& operator=(const tags& other) {
+    names = other.names;
+    ++copies;
+    return *this;
+  }
+  tags& operator=(tags&&) noexcept = default;
+
+  tags& operator+=(const tags& other) {
+    names.insert(other.names.begin(), other.names.end());
+    return *this;
+  }
+  tags& operator-=(const tags& other) {
+    for (const std::string& name : other.names)
+      names.erase(name);
+    return *this;
+  }
+
+  friend bool operator==(const tags&, const tags&) = default;
+  friend auto operator<=>(const tags&, const tags&) = default;
+
+  friend std::ostream& operator<<(std::ostream& stream, const tags& value) {
+    stream << '{';
+    for (const std::string& name : value.names)
+      stream << (name == *value.names.begin() ? "" : ",") << name;
+    return stream << '}';
+  }
+};
+
+using interval_type = icl::discrete_interval<int>;
+
+// The number of copies of the codomain values made by \c update
+template <typename Update> std::size_t copies_of(Update update) {
+  const std::size_t before = tags::copies;
+  update();
+  return tags::copies - before;
+}
+
+tags random_tags(std::mt19937& gen) {
+  static const std::vector<std::string> names = {"a", "b", "c", "d"};
+  std::uniform_int_distribution<std::size_t> pick(0, names.size() - 1);
+  tags value;
+  value.names.insert(names[pick(gen)]);
+  if (pick(gen) == 0)
+    value.names.insert(names[pick(gen)]);
+  return value;
+}
+
+} // namespace
+
+template <typename MapT>
+MapT::segment_type segment(int lower, int upper, tags value) {
+  return {interval_type::right_open(lower, upper), std::move(value)};
+}
+
+template <typename MapT> void run_move_copies() {
+  using segment_type = typename MapT::segment_type;
+
+  // A segment in a gap of the map is moved into it, or copied once
+  MapT moved, copied;
+  REQUIRE(copies_of([&] { moved.add(segment<MapT>(0, 10, {"a"})); }) == 0);
+  const segment_type lvalue = segment<MapT>(0, 10, {"a"});
+  REQUIRE(copies_of([&] { copied.add(lvalue); }) == 1);
+  REQUIRE(moved == copied);
+
+  // Hinted additions in ascending order
+  REQUIRE(copies_of([&] {
+            typename MapT::iterator prior_ = moved.end();
+            for (int lower = 20; lower < 100; lower += 10)
+              prior_ = moved.add(prior_, segment<MapT>(lower, lower + 5,
+                                                       {"b"}));
+          }) == 0);
+  REQUIRE(moved.iterative_size() == 9);
+
+  // A collision splits the left residual, the end gap takes the value
+  moved = MapT(segment<MapT>(0, 10, {"a"}));
+  copied = moved;
+  REQUIRE(copies_of([&] { moved.add(segment<MapT>(5, 15, {"b"})); }) == 1);
+  const segment_type overlapping = segment<MapT>(5, 15, {"b"});
+  REQUIRE(copies_of([&] { copied.add(overlapping); }) == 2);
+  REQUIRE(moved == copied);
+  REQUIRE(moved(12) == tags{"b"});
+  REQUIRE(moved(7) == tags{"a", "b"});
+
+  // A right residual is split, the value is combined only
+  REQUIRE(copies_of([&] { moved.add(segment<MapT>(0, 2, {"c"})); }) == 1);
+  REQUIRE(moved(1) == tags{"a", "c"});
+  REQUIRE(moved(3) == tags{"a"});
+
+  // Insertion moves the value into the last gap, that is filled
+  moved = MapT(segment<MapT>(0, 10, {"a"}));
+  moved.insert(segment<MapT>(20, 30, {"b"}));
+  copied = moved;
+  REQUIRE(copies_of([&] { moved.insert(segment<MapT>(-5, 40, {"c"})); }) ==
+          2);
+  const segment_type covering = segment<MapT>(-5, 40, {"c"});
+  REQUIRE(copies_of([&] { copied.insert(covering); }) == 3);
+  REQUIRE(moved == copied);
+  REQUIRE(copies_of([&] { moved.insert(segment<MapT>(-20, -10, {"d"})); }) ==
+          0);
+  // The last gap to fill may be left of a collision
+  REQUIRE(copies_of([&] { moved.insert(segment<MapT>(-15, 0, {"d"})); }) ==
+          0);
+  REQUIRE(moved(-12) == tags{"d"});
+  REQUIRE(moved(-7) == tags{"d"});
+  REQUIRE(moved(-3) == tags{"c"});
+
+  // Setting a value erases the range first, so the value is moved
+  REQUIRE(copies_of([&] { moved.set(segment<MapT>(0, 25, {"e"})); }) == 0);
+  REQUIRE(moved(15) == tags{"e"});
+  REQUIRE(copies_of([&] { icl::set_at(moved, segment<MapT>(0, 5, {"f"})); }) ==
+          0);
+  REQUIRE(moved(2) == tags{"f"});
+
+  // The free functions and operators
+  REQUIRE(copies_of([&] { moved += segment<MapT>(50, 60, {"g"}); }) == 0);
+  REQUIRE(copies_of([&] { icl::add(moved, segment<MapT>(60, 70, {"h"})); }) ==
+          0);
+  REQUIRE(copies_of([&] {
+            icl::insert(moved, segment<MapT>(70, 80, {"i"}));
+          }) == 0);
+  REQUIRE(moved(55) == tags{"g"});
+  REQUIRE(moved(65) == tags{"h"});
+  REQUIRE(moved(75) == tags{"i"});
+}
+
+// Maps built from rvalues must equal maps built from lvalues, with fewer
+// copies.
+template <typename MapT> void run_move_updates() {
+  using segment_type = typename MapT::segment_type;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 200);
+  std::uniform_int_distribution<int> len(0, 30);
+  std::uniform_int_distribution<int> operations(0, 4);
+
+  MapT moved, copied;
+  typename MapT::iterator moved_prior_ = moved.end();
+  typename MapT::iterator copied_prior_ = copied.end();
+  std::size_t moved_copies = 0, copied_copies = 0;
+  for (int i = 0; i < 400; ++i) {
+    const int lower = pos(gen);
+    const segment_type operand = segment<MapT>(
+        lower, lower + len(gen), i % 17 == 0 ? tags() : random_tags(gen));
+    segment_type moving = operand;
+    const int operation = operations(gen);
+    switch (operation) {
+    case 0:
+      moved_copies += copies_of([&] { moved.add(std::move(moving)); });
+      copied_copies += copies_of([&] { copied.add(operand); });
+      break;
+    case 1:
+      moved_copies += copies_of(
+          [&] { moved_prior_ = moved.add(moved_prior_, std::move(moving)); });
+      copied_copies += copies_of(
+          [&] { copied_prior_ = copied.add(copied_prior_, operand); });
+      break;
+    case 2:
+      moved_copies += copies_of([&] { moved.insert(std::move(moving)); });
+      copied_copies += copies_of([&] { copied.insert(operand); });
+      break;
+    case 3:
+      moved_copies += copies_of([&] {
+        moved_prior_ = moved.insert(moved_prior_, std::move(moving));
+      });
+      copied_copies += copies_of(
+          [&] { copied_prior_ = copied.insert(copied_prior_, operand); });
+      break;
+    default:
+      moved_copies += copies_of([&] { moved.set(std::move(moving)); });
+      copied_copies += copies_of([&] { copied.set(operand); });
+      break;
+    }
+    if (operation != 1 && operation != 3) {
+      moved_prior_ = moved.end();
+      copied_prior_ = copied.end();
+    }
+    REQUIRE(moved == copied);
+  }
+  REQUIRE(moved_copies < copied_copies);
+}
+
+TEST_CASE("Test Move Insertion Copies", "[move]") {
+  run_move_copies<icl::interval_map<int, tags>>();
+  run_move_copies<icl::split_interval_map<int, tags>>();
+  run_move_copies<icl::flat_interval_map<int, tags>>();
+  run_move_copies<icl::flat_split_interval_map<int, tags>>();
+}
+
+TEST_CASE("Test Move Insertion Updates", "[move]") {
+  run_move_updates<icl::interval_map<int, tags>>();
+  run_move_updates<icl::split_interval_map<int, tags>>();
+  run_move_updates<icl::interval_map<int, tags, icl::partial_enricher>>();
+  run_move_updates<
+      icl::split_interval_map<int, tags, icl::partial_enricher>>();
+  run_move_updates<icl::flat_interval_map<int, tags>>();
+}
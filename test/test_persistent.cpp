@@ -0,0 +1,239 @@
+#include "random_container.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/persistent.hpp"
+#include "icl/split_interval_map.hpp"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr icl_test::random_shape shape{.domain = 300, .max_length = 40};
+
+template <typename Persistent, typename MapT>
+bool same_segments(const Persistent& object, const MapT& expected) {
+  if (object.iterative_size() != expected.iterative_size())
+    return false;
+  auto it_ = object.begin();
+  for (const auto& segment : expected) {
+    if (!(it_->first == segment.first && it_->second == segment.second))
+      return false;
+    ++it_;
+  }
+  // Backwards, too
+  for (auto segment_ = expected.rbegin(); segment_ != expected.rend();
+       ++segment_) {
+    --it_;
+    if (!(it_->first == segment_->first))
+      return false;
+  }
+  return it_ == object.begin();
+}
+
+// Counts the allocations of nodes
+class counting_resource : public std::pmr::memory_resource {
+public:
+  std::size_t allocations() const { return _allocations; }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++_allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* pointer, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::size_t _allocations = 0;
+};
+
+} // namespace
+
+// Updates of a persistent map must have the effects of those of the map,
+// its queries the results of those of the map, and the snapshots taken
+// before must keep their segments.
+template <typename MapT> void run_persistent_updates() {
+  using domain_type = typename MapT::domain_type;
+  using segment_type = typename MapT::segment_type;
+  using element_type = typename MapT::element_type;
+  icl::persistent<MapT> object;
+  MapT expected;
+  std::vector<std::pair<icl::persistent<MapT>, MapT>> snapshots;
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int> op(0, 9);
+  std::uniform_int_distribution<int> value(1, 3);
+  std::uniform_int_distribution<int> pos(0, 330);
+
+  for (int i = 0; i < 800; ++i) {
+    const segment_type segment = icl_test::random_segment<MapT>(gen, shape);
+    const element_type element(static_cast<domain_type>(pos(gen)),
+                               value(gen));
+    switch (op(gen)) {
+    case 0:
+    case 1:
+      object.add(segment);
+      expected.add(segment);
+      break;
+    case 2:
+      object.subtract(segment);
+      expected.subtract(segment);
+      break;
+    case 3:
+      object.insert(segment);
+      expected.insert(segment);
+      break;
+    case 4:
+      object.set(segment);
+      expected.set(segment);
+      break;
+    case 5:
+      object.erase(segment);
+      expected.erase(segment);
+      break;
+    case 6:
+      object.erase(segment.first);
+      expected.erase(segment.first);
+      break;
+    case 7:
+      object.add(element).insert(element);
+      expected.add(element).insert(element);
+      break;
+    case 8:
+      object.subtract(element).erase(element.key);
+      expected.subtract(element).erase(element.key);
+      break;
+    default:
+      object.set(element);
+      expected.set(element);
+    }
+    REQUIRE(same_segments(object, expected));
+
+    for (int point = i % 5; point < 340; point += 11) {
+      const auto key = static_cast<domain_type>(point);
+      const auto found = object.find(key);
+      const auto it_ = expected.find(key);
+      REQUIRE((found == object.end()) == (it_ == expected.end()));
+      if (found != object.end())
+        REQUIRE(found->first == it_->first);
+      REQUIRE(object(key) == expected(key));
+      REQUIRE(object.contains(key) == icl::contains(expected, key));
+    }
+    const segment_type probe = icl_test::random_segment<MapT>(gen, shape);
+    REQUIRE(object.contains(probe) == icl::contains(expected, probe));
+    REQUIRE(object.contains(probe.first) ==
+            icl::contains(expected, probe.first));
+    REQUIRE(object.intersects(probe) == icl::intersects(expected, probe));
+    REQUIRE(object.intersects(probe.first) ==
+            icl::intersects(expected, probe.first));
+
+    if (i % 40 == 0) {
+      snapshots.emplace_back(object.snapshot(), expected);
+      REQUIRE(snapshots.back().first.shares(object));
+    }
+  }
+  REQUIRE(object.container() == expected);
+  REQUIRE(icl::persistent<MapT>(expected) == object);
+  for (const auto& [snapshot, content] : snapshots) {
+    REQUIRE(!snapshot.shares(object));
+    REQUIRE(same_segments(snapshot, content));
+  }
+  const icl::persistent<MapT> before = object;
+  object.clear();
+  REQUIRE(object.empty());
+  REQUIRE(before.container() == expected);
+}
+
+TEST_CASE("Test Persistent Map Updates", "[persistent]") {
+  run_persistent_updates<icl::interval_map<int, int>>();
+  run_persistent_updates<icl::split_interval_map<int, int>>();
+  run_persistent_updates<icl::interval_map<int, int, icl::total_absorber>>();
+  run_persistent_updates<icl::interval_map<double, int>>();
+}
+
+// An update must copy the nodes on a path of the tree only, and leave the
+// others to the snapshots.
+TEST_CASE("Test Persistent Map Path Copying", "[persistent]") {
+  using map_type = icl::pmr::interval_map<int, int>;
+  using interval_type = map_type::interval_type;
+  counting_resource resource;
+  map_type plain(&resource);
+  for (int i = 0; i < 20000; ++i)
+    plain.add({interval_type::right_open(4 * i, 4 * i + 3), i % 5 + 1});
+
+  const std::size_t built = resource.allocations();
+  const icl::persistent<map_type> object(plain);
+  REQUIRE(resource.allocations() - built == 20000);
+
+  icl::persistent<map_type> updated = object;
+  REQUIRE(resource.allocations() - built == 20000);
+  updated.add({interval_type::right_open(40003, 40004), 7});
+  // The path to a segment has about 2 ln(20000), some 20 nodes
+  REQUIRE(resource.allocations() - built - 20000 < 200);
+  REQUIRE(updated.iterative_size() == 20001);
+  REQUIRE(object.iterative_size() == 20000);
+  REQUIRE(object(40003) == 0);
+  REQUIRE(updated(40003) == 7);
+  REQUIRE(object.container() == plain);
+}
+
+// Readers must see whole updates in the snapshots they take, while a
+// writer updates the map.
+TEST_CASE("Test Persistent Map Snapshots Across Threads", "[persistent]") {
+  using map_type = icl::interval_map<int, std::int64_t>;
+  using interval_type = map_type::interval_type;
+  icl::persistent<map_type> object;
+  std::atomic<bool> writing{true};
+  std::atomic<bool> consistent{true};
+
+  // Every update adds one unit to each of 10 elements
+  const auto units = [](const icl::persistent<map_type>& snapshot) {
+    std::int64_t sum = 0;
+    for (const auto& [inter_val, value] : snapshot)
+      sum += value * static_cast<std::int64_t>(icl::length(inter_val));
+    return sum;
+  };
+
+  std::vector<std::thread> readers;
+  for (int reader = 0; reader < 3; ++reader)
+    readers.emplace_back([&] {
+      std::int64_t seen = 0;
+      while (writing) {
+        const icl::persistent<map_type> snapshot = object.snapshot();
+        const std::int64_t sum = units(snapshot);
+        if (sum % 10 != 0 || sum < seen)
+          consistent = false;
+        seen = sum;
+      }
+    });
+
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> pos(0, 2000);
+  map_type expected;
+  for (int i = 0; i < 3000; ++i) {
+    const int lo = pos(gen);
+    const map_type::segment_type segment(interval_type::right_open(lo, lo + 10),
+                                         1);
+    object.add(segment);
+    expected.add(segment);
+  }
+  writing = false;
+  for (std::thread& thread : readers)
+    thread.join();
+  REQUIRE(consistent);
+  REQUIRE(object.container() == expected);
+  REQUIRE(units(object) == 30000);
+}
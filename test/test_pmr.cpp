@@ -0,0 +1,257 @@
+#include "icl/discrete_interval.hpp"
+#include "icl/expression.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/map.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Containers of the icl::pmr namespace allocate from the resource that they
+// are constructed with. Results and temporaries of their operations must not
+// fall back to the default resource.
+class counting_resource : public std::pmr::memory_resource {
+public:
+  explicit counting_resource(std::pmr::memory_resource* upstream)
+      : _upstream(upstream) {}
+
+  std::size_t allocations() const { return _allocations; }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++_allocations;
+    return _upstream->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* pointer, std::size_t bytes,
+                     std::size_t alignment) override {
+    _upstream->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource* _upstream;
+  std::size_t _allocations = 0;
+};
+
+// Counts the allocations from the default resource during its lifetime
+class default_resource_counter {
+public:
+  default_resource_counter()
+      : _counter(std::pmr::get_default_resource()),
+        _prior(std::pmr::set_default_resource(&_counter)) {}
+
+  ~default_resource_counter() { std::pmr::set_default_resource(_prior); }
+
+  std::size_t allocations() const { return _counter.allocations(); }
+
+private:
+  counting_resource _counter;
+  std::pmr::memory_resource* _prior;
+};
+
+template <typename Type, typename PlainT>
+bool same_content(const Type& object, const PlainT& plain) {
+  auto it_ = object.begin();
+  auto plain_ = plain.begin();
+  for (; it_ != object.end() && plain_ != plain.end(); ++it_, ++plain_)
+    if (!(*it_ == *plain_))
+      return false;
+  return it_ == object.end() && plain_ == plain.end();
+}
+
+template <typename Type>
+bool allocates_from(const Type& object, std::pmr::memory_resource* resource) {
+  return object.get_allocator().resource() == resource;
+}
+
+template <typename Type, typename Generator>
+void fill(Type& object, Generator& gen, int count) {
+  using interval_type = typename Type::interval_type;
+
+  std::uniform_int_distribution<int> pos(0, 500);
+  std::uniform_int_distribution<int> len(1, 40);
+  std::uniform_int_distribution<int> val(1, 4);
+  for (int i = 0; i < count; ++i) {
+    const int lo = pos(gen);
+    const interval_type inter_val =
+        interval_type::right_open(lo, lo + len(gen));
+    if constexpr (icl::is_interval_map<Type>::value)
+      object.add(std::make_pair(inter_val, val(gen)));
+    else
+      object.add(inter_val);
+  }
+}
+
+template <typename Type, typename PlainT> void run_pmr_operations() {
+  std::pmr::monotonic_buffer_resource arena;
+  counting_resource resource(&arena);
+  counting_resource other_resource(&arena);
+  default_resource_counter fallback;
+
+  std::mt19937 gen(42), plain_gen(42);
+  Type left(&resource), right(&resource);
+  PlainT plain_left, plain_right;
+  fill(left, gen, 100);
+  fill(right, gen, 100);
+  fill(plain_left, plain_gen, 100);
+  fill(plain_right, plain_gen, 100);
+  REQUIRE(same_content(left, plain_left));
+  REQUIRE(allocates_from(left, &resource));
+
+  const Type sum = left + right;
+  REQUIRE(same_content(sum, plain_left + plain_right));
+  REQUIRE(allocates_from(sum, &resource));
+
+  const Type difference = left - right;
+  REQUIRE(same_content(difference, plain_left - plain_right));
+  REQUIRE(allocates_from(difference, &resource));
+
+  const Type section = left & right;
+  REQUIRE(same_content(section, plain_left & plain_right));
+  REQUIRE(allocates_from(section, &resource));
+
+  Type intersection(&resource);
+  icl::add_intersection(intersection, left, right);
+  REQUIRE(same_content(intersection, plain_left & plain_right));
+
+  const Type flipped = left ^ right;
+  REQUIRE(same_content(flipped, plain_left ^ plain_right));
+  REQUIRE(allocates_from(flipped, &resource));
+
+  REQUIRE(icl::intersects(left, right) ==
+          icl::intersects(plain_left, plain_right));
+  if constexpr (icl::is_interval_map<Type>::value) {
+    icl::pmr::interval_set<int> keys(&resource);
+    keys += icl::discrete_interval<int>::right_open(100, 200);
+    REQUIRE(icl::intersects(left, keys));
+  }
+
+  // Expressions evaluate to the allocator of their first operand
+  if constexpr (!icl::is_total<Type>::value) {
+    const Type evaluated = icl::lazy(left) + right - section;
+    REQUIRE(same_content(evaluated, plain_left + plain_right -
+                                        (plain_left & plain_right)));
+    REQUIRE(allocates_from(evaluated, &resource));
+    REQUIRE(allocates_from(icl::evaluate(icl::lazy(left) ^ right), &resource));
+  }
+
+  Type updated(left, &resource);
+  PlainT plain_updated(plain_left);
+  updated &= right;
+  plain_updated &= plain_right;
+  REQUIRE(same_content(updated, plain_updated));
+  updated += right;
+  plain_updated += plain_right;
+  REQUIRE(same_content(updated, plain_updated));
+  REQUIRE(allocates_from(updated, &resource));
+
+  std::vector<typename Type::value_type> segments(left.begin(), left.end());
+  Type built(&resource);
+  if constexpr (requires { built.assign(segments.begin(), segments.end()); })
+    built.assign(segments.begin(), segments.end());
+  else
+    built += left;
+  REQUIRE(same_content(built, plain_left));
+
+  Type moved(std::move(built), &other_resource);
+  REQUIRE(same_content(moved, plain_left));
+  REQUIRE(allocates_from(moved, &other_resource));
+  REQUIRE(built.empty());
+  REQUIRE(icl::cardinality(built) == 0);
+
+  REQUIRE(fallback.allocations() == 0);
+  REQUIRE(other_resource.allocations() > 0);
+}
+
+TEST_CASE("Test Pmr Interval Map", "[pmr]") {
+  run_pmr_operations<icl::pmr::interval_map<int, int>,
+                     icl::interval_map<int, int>>();
+  run_pmr_operations<icl::pmr::split_interval_map<int, int>,
+                     icl::split_interval_map<int, int>>();
+  run_pmr_operations<icl::pmr::interval_map<int, int, icl::total_absorber>,
+                     icl::interval_map<int, int, icl::total_absorber>>();
+  run_pmr_operations<icl::pmr::interval_map<int, int, icl::partial_absorber,
+                                            std::less, icl::inplace_plus,
+                                            icl::inter_section,
+                                            icl::discrete_interval<int>,
+                                            icl::flat_storage>,
+                     icl::flat_interval_map<int, int>>();
+  run_pmr_operations<icl::pmr::interval_map<int, int, icl::partial_absorber,
+                                            std::less, icl::inplace_plus,
+                                            icl::inter_section,
+                                            icl::discrete_interval<int>,
+                                            icl::augmented_storage>,
+                     icl::augmented_interval_map<int, int>>();
+}
+
+TEST_CASE("Test Pmr Interval Set", "[pmr]") {
+  run_pmr_operations<icl::pmr::interval_set<int>, icl::interval_set<int>>();
+  run_pmr_operations<icl::pmr::separate_interval_set<int>,
+                     icl::separate_interval_set<int>>();
+  run_pmr_operations<icl::pmr::split_interval_set<int>,
+                     icl::split_interval_set<int>>();
+  run_pmr_operations<
+      icl::pmr::interval_set<int, std::less, icl::discrete_interval<int>,
+                             icl::flat_storage>,
+      icl::flat_interval_set<int>>();
+}
+
+TEST_CASE("Test Pmr Map", "[pmr]") {
+  std::pmr::monotonic_buffer_resource arena;
+  counting_resource resource(&arena);
+  default_resource_counter fallback;
+
+  icl::pmr::map<int, int> left(&resource), right(&resource);
+  icl::map<int, int> plain_left, plain_right;
+  for (int key = 0; key < 50; ++key) {
+    left.add(std::make_pair(key, key % 3 + 1));
+    plain_left.add(std::make_pair(key, key % 3 + 1));
+    right.add(std::make_pair(2 * key, 1));
+    plain_right.add(std::make_pair(2 * key, 1));
+  }
+
+  const icl::pmr::map<int, int> sum = left + right;
+  REQUIRE(same_content(sum, plain_left + plain_right));
+  REQUIRE(allocates_from(sum, &resource));
+
+  const icl::pmr::map<int, int> section = left & right;
+  REQUIRE(same_content(section, plain_left & plain_right));
+  REQUIRE(allocates_from(section, &resource));
+
+  const icl::pmr::map<int, int> difference = left - right;
+  REQUIRE(same_content(difference, plain_left - plain_right));
+
+  icl::pmr::map<int, int> intersection(&resource);
+  icl::add_intersection(intersection, left, right);
+  REQUIRE(same_content(intersection, plain_left & plain_right));
+
+  REQUIRE(fallback.allocations() == 0);
+}
+
+TEST_CASE("Test Pmr Interval Map Arena Example", "[pmr]") {
+  using interval_type = icl::discrete_interval<int>;
+
+  // All memory of one request comes from a buffer on the stack
+  std::byte buffer[4096];
+  std::pmr::monotonic_buffer_resource request(buffer, sizeof(buffer),
+                                              std::pmr::null_memory_resource());
+
+  icl::pmr::interval_map<int, int> booked(&request), requested(&request);
+  booked += std::make_pair(interval_type::right_open(9, 12), 1);
+  booked += std::make_pair(interval_type::right_open(14, 17), 1);
+  requested += std::make_pair(interval_type::right_open(11, 15), 1);
+
+  const icl::pmr::interval_map<int, int> conflicts = booked & requested;
+  REQUIRE(conflicts.iterative_size() == 2);
+  REQUIRE(conflicts.get_allocator().resource() == &request);
+  REQUIRE(icl::length(conflicts) == 2);
+}
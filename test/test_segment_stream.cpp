@@ -0,0 +1,125 @@
+#include "random_container.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/right_open_interval.hpp"
+#include "icl/segment_stream.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/split_interval_set.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <sstream>
+#include <string>
+
+namespace {
+
+template <typename Type> Type read_all(std::istream& stream) {
+  icl::segment_reader<Type> reader(stream);
+  Type object;
+  auto prior_ = object.end();
+  for (const auto& segment : reader)
+    prior_ = object.insert(prior_, segment);
+  return object;
+}
+
+} // namespace
+
+// Reading a stream must yield the segments that were written, in any size
+// of blocks.
+template <typename Type> void run_segment_stream() {
+  static_assert(std::ranges::input_range<icl::segment_reader<Type>>);
+  for (const int count : {0, 1, 2, 7, 100, 400})
+    for (const std::size_t chunk : {1, 2, 3, 64, 1000}) {
+      const Type source = icl_test::random_container<Type>(count, count);
+      std::stringstream stream;
+      icl::write_segments(stream, source, chunk);
+      REQUIRE(read_all<Type>(stream) == source);
+    }
+}
+
+// Merging streams must yield the segments of += on the containers.
+template <typename Type> void run_merge_segments() {
+  for (const int left_count : {0, 1, 5, 50, 300})
+    for (const int right_count : {0, 1, 5, 50, 300})
+      for (const std::size_t chunk : {2, 3, 16, 1000}) {
+        const Type left =
+            icl_test::random_container<Type>(left_count, left_count);
+        const Type right =
+            icl_test::random_container<Type>(right_count + 1000, right_count);
+        std::stringstream left_stream;
+        std::stringstream right_stream;
+        std::stringstream merged;
+        icl::write_segments(left_stream, left, chunk);
+        icl::write_segments(right_stream, right, 5);
+        icl::merge_segments<Type>(left_stream, right_stream, merged, chunk);
+
+        Type expected = left;
+        expected += right;
+        REQUIRE(read_all<Type>(merged) == expected);
+      }
+}
+
+TEST_CASE("Test Segment Stream Round Trip", "[segment_stream]") {
+  run_segment_stream<icl::interval_set<int>>();
+  run_segment_stream<icl::split_interval_set<std::int64_t>>();
+  run_segment_stream<
+      icl::interval_set<int, std::less, icl::right_open_interval<int>>>();
+  run_segment_stream<icl::interval_map<int, int>>();
+  run_segment_stream<icl::split_interval_map<int, double>>();
+  run_segment_stream<icl::interval_map<double, float, icl::partial_absorber,
+                                       std::less, icl::inplace_plus,
+                                       icl::inter_section,
+                                       icl::continuous_interval<double>>>();
+}
+
+TEST_CASE("Test Segment Stream Merge", "[segment_stream]") {
+  run_merge_segments<icl::interval_set<int>>();
+  run_merge_segments<icl::split_interval_set<int>>();
+  run_merge_segments<icl::interval_map<int, int>>();
+  run_merge_segments<icl::split_interval_map<int, int>>();
+  run_merge_segments<icl::interval_map<int, int, icl::partial_enricher>>();
+  run_merge_segments<icl::interval_map<int, int, icl::total_absorber>>();
+  run_merge_segments<icl::interval_map<int, int, icl::partial_absorber,
+                                       std::less, icl::inplace_minus>>();
+  run_merge_segments<icl::split_interval_map<int, int, icl::partial_absorber,
+                                             std::less, icl::inplace_max>>();
+  run_merge_segments<
+      icl::interval_map<int, int, icl::partial_absorber, std::less,
+                        icl::inplace_plus, icl::inter_section,
+                        icl::right_open_interval<int>>>();
+  run_merge_segments<icl::interval_map<double, int, icl::partial_absorber,
+                                       std::less, icl::inplace_plus,
+                                       icl::inter_section,
+                                       icl::continuous_interval<double>>>();
+}
+
+TEST_CASE("Test Segment Stream Errors", "[segment_stream]") {
+  using map_type = icl::interval_map<int, int>;
+
+  std::stringstream stream;
+  icl::write_segments(stream, icl_test::random_container<map_type>(1, 100),
+                      16);
+  const std::string data = stream.str();
+
+  auto rejects = [](const std::string& bytes) {
+    std::istringstream input(bytes);
+    REQUIRE_THROWS_AS(read_all<map_type>(input), icl::binary_format_error);
+  };
+  rejects(std::string());
+  rejects(data.substr(0, data.size() - 1));
+  rejects(data.substr(0, data.size() / 2));
+  std::string oversized = data;
+  const std::uint64_t chunk = 8;
+  std::memcpy(oversized.data() + offsetof(icl::binary_header, count), &chunk,
+              sizeof(chunk));
+  rejects(oversized);
+
+  std::istringstream input(data);
+  REQUIRE_THROWS_AS(
+      (icl::segment_reader<icl::interval_map<int, double>>(input)),
+      icl::binary_format_error);
+}
@@ -0,0 +1,138 @@
+#include "random_container.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/discrete_interval.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/separate_interval_set.hpp"
+#include "icl/split_interval_set.hpp"
+#include "icl/views.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <ranges>
+#include <vector>
+
+namespace {
+
+constexpr icl_test::random_shape shape{.domain = 400, .max_length = 20};
+
+template <typename Range, typename SetT>
+bool same_segments(Range&& range, const SetT& object) {
+  return std::ranges::equal(range, object);
+}
+
+} // namespace
+
+// Views must yield the segments of the left operand after the compound
+// assignments.
+template <typename LeftT, typename RightT> void run_set_views() {
+  static_assert(std::ranges::forward_range<decltype(icl::views::intersection(
+                    std::declval<const LeftT&>(),
+                    std::declval<const RightT&>()))>);
+  for (const int left_count : {0, 1, 5, 40, 200})
+    for (const int right_count : {0, 1, 5, 40, 200}) {
+      const LeftT left =
+          icl_test::random_container<LeftT>(left_count, left_count, shape);
+      const RightT right = icl_test::random_container<RightT>(
+          right_count + 7, right_count, shape);
+
+      LeftT expected = left;
+      REQUIRE(same_segments(icl::views::intersection(left, right),
+                            expected &= right));
+      expected = left;
+      REQUIRE(same_segments(icl::views::union_(left, right),
+                            expected += right));
+      expected = left;
+      REQUIRE(same_segments(icl::views::difference(left, right),
+                            expected -= right));
+      expected = left;
+      REQUIRE(same_segments(icl::views::symmetric_difference(left, right),
+                            expected ^= right));
+    }
+}
+
+TEST_CASE("Test Set Views", "[views]") {
+  using interval_set = icl::interval_set<int>;
+  using separate_set = icl::separate_interval_set<int>;
+  using split_set = icl::split_interval_set<int>;
+
+  run_set_views<interval_set, interval_set>();
+  run_set_views<interval_set, split_set>();
+  run_set_views<separate_set, separate_set>();
+  run_set_views<separate_set, interval_set>();
+  run_set_views<split_set, split_set>();
+  run_set_views<split_set, separate_set>();
+  run_set_views<icl::flat_interval_set<int>,
+                icl::flat_split_interval_set<int>>();
+  run_set_views<icl::flat_separate_interval_set<int>, split_set>();
+  run_set_views<
+      icl::interval_set<double, std::less, icl::continuous_interval<double>>,
+      icl::split_interval_set<double, std::less,
+                              icl::continuous_interval<double>>>();
+}
+
+TEST_CASE("Test Set Views Composition", "[views]") {
+  using interval_type = icl::discrete_interval<int>;
+  using interval_set = icl::interval_set<int>;
+  using split_set = icl::split_interval_set<int>;
+
+  const interval_set a = icl_test::random_container<interval_set>(1, 60, shape);
+  const split_set b = icl_test::random_container<split_set>(2, 60, shape);
+  const interval_set c = icl_test::random_container<interval_set>(3, 60, shape);
+
+  // Views are operands of views
+  interval_set expected = a;
+  expected += b;
+  REQUIRE(same_segments(icl::views::difference(icl::views::union_(a, b), c),
+                        expected -= c));
+  split_set flipped = b;
+  flipped ^= a;
+  expected = c;
+  REQUIRE(same_segments(
+      icl::views::intersection(c, icl::views::symmetric_difference(b, a)),
+      expected &= flipped));
+  REQUIRE(icl::views::union_(b, a).fineness == split_set::fineness);
+  split_set joined = b;
+  joined += a;
+  REQUIRE(same_segments(icl::views::intersection(icl::views::union_(b, a), c),
+                        joined &= c));
+
+  // Plain ranges of disjoint intervals are joining operands
+  const std::vector<interval_type> ranges(a.begin(), a.end());
+  expected = a;
+  REQUIRE(same_segments(icl::views::union_(ranges, b), expected += b));
+
+  // Views compose with the standard adaptors
+  interval_set both = a;
+  both &= b;
+  std::vector<int> sizes;
+  for (const int size : icl::views::intersection(a, b) |
+                            std::views::transform([](const interval_type& x) {
+                              return static_cast<int>(icl::cardinality(x));
+                            }) |
+                            std::views::filter([](int x) { return x > 2; }))
+    sizes.push_back(size);
+  std::vector<int> large;
+  for (const interval_type& segment : both)
+    if (icl::cardinality(segment) > 2)
+      large.push_back(static_cast<int>(icl::cardinality(segment)));
+  REQUIRE(sizes == large);
+
+  // Ranges filtered by the standard adaptors are operands
+  const auto large_only = std::views::filter(
+      [](const interval_type& x) { return icl::cardinality(x) > 2; });
+  interval_set large_a;
+  for (const interval_type& segment : a | large_only)
+    large_a += segment;
+  expected = large_a;
+  REQUIRE(same_segments(icl::views::union_(a | large_only, b), expected += b));
+  expected = c;
+  REQUIRE(same_segments(
+      icl::views::difference(c, icl::views::intersection(a | large_only, b)),
+      expected -= large_a & b));
+
+  auto view = icl::views::union_(a, c);
+  REQUIRE(static_cast<std::size_t>(std::ranges::distance(view)) ==
+          (a + c).iterative_size());
+  REQUIRE(std::ranges::equal(view | std::views::take(3),
+                             (a + c) | std::views::take(3)));
+  REQUIRE(icl::views::intersection(a, interval_set()).empty());
+}
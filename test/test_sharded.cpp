@@ -0,0 +1,182 @@
+#include "random_container.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/interval_set.hpp"
+#include "icl/right_open_interval.hpp"
+#include "icl/sharded.hpp"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr icl_test::random_shape shape{.domain = 200, .max_length = 60};
+
+template <typename Segment>
+bool same_segment(const Segment& left, const Segment& right) {
+  if constexpr (requires { left.second; })
+    return left.first == right.first && left.second == right.second;
+  else
+    return left == right;
+}
+
+} // namespace
+
+// Updates of a sharded container must have the effects of those of the
+// container, and its queries the results of the queries of the container,
+// whose segments are not cut at the bounds of the shards.
+template <typename Type> void run_sharded_semantics() {
+  using domain_type = typename Type::domain_type;
+  icl::sharded<Type> shards({150, 50, 100, 101, 100});
+  REQUIRE(shards.shard_count() == 5);
+  REQUIRE(shards.shard_of(50) == 1);
+  REQUIRE(shards.shard_of(100) == 2);
+  Type expected;
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> op(0, 5);
+
+  for (int i = 0; i < 600; ++i) {
+    const auto segment = icl_test::random_segment<Type>(gen, shape);
+    switch (op(gen)) {
+    case 0:
+    case 1:
+      shards.add(segment);
+      expected.add(segment);
+      break;
+    case 2:
+      shards.subtract(segment);
+      expected.subtract(segment);
+      break;
+    case 3:
+      shards.insert(segment);
+      expected.insert(segment);
+      break;
+    case 4:
+      shards.erase(segment);
+      expected.erase(segment);
+      break;
+    default:
+      if constexpr (icl::is_interval_map<Type>::value) {
+        shards.set(segment);
+        expected.set(segment);
+      } else {
+        shards += Type(segment);
+        expected += segment;
+      }
+    }
+    REQUIRE(shards.snapshot() == expected);
+    REQUIRE(shards.iterative_size() == expected.iterative_size());
+
+    for (int point = i % 3; point < 270; point += 7) {
+      const auto key = static_cast<domain_type>(point);
+      const auto found = shards.find(key);
+      const auto it_ = expected.find(key);
+      REQUIRE(found.has_value() == (it_ != expected.end()));
+      if (found)
+        REQUIRE(same_segment(*found, typename Type::segment_type(*it_)));
+      REQUIRE(shards.contains(key) == icl::contains(expected, key));
+      if constexpr (icl::is_interval_map<Type>::value)
+        REQUIRE(shards(key) == expected(key));
+    }
+    const auto probe = icl_test::random_segment<Type>(gen, shape);
+    REQUIRE(shards.contains(probe) == icl::contains(expected, probe));
+    if constexpr (icl::is_interval_map<Type>::value) {
+      REQUIRE(shards.contains(probe.first) ==
+              icl::contains(expected, probe.first));
+      REQUIRE(shards.intersects(probe.first) ==
+              icl::intersects(expected, probe.first));
+    } else
+      REQUIRE(shards.intersects(probe) == icl::intersects(expected, probe));
+  }
+
+  const icl::sharded<Type> copied(expected, {20, 40, 60, 80, 100, 120});
+  REQUIRE(copied.snapshot() == expected);
+  REQUIRE(copied.iterative_size() == expected.iterative_size());
+  shards.clear();
+  REQUIRE(shards.empty());
+}
+
+TEST_CASE("Test Sharded Semantics", "[sharded]") {
+  run_sharded_semantics<icl::interval_map<int, int>>();
+  run_sharded_semantics<icl::interval_set<int>>();
+  run_sharded_semantics<icl::interval_map<double, int>>();
+  run_sharded_semantics<icl::interval_set<
+      int, std::less, icl::right_open_interval<int>>>();
+}
+
+TEST_CASE("Test Sharded Joins", "[sharded]") {
+  using map_type = icl::interval_map<int, int>;
+  using interval_type = map_type::interval_type;
+  icl::sharded<map_type> shards({10, 20, 30});
+
+  // A segment over all shards is seen as one
+  shards.add({interval_type::right_open(5, 35), 1});
+  REQUIRE(shards.iterative_size() == 1);
+  REQUIRE(shards.find(15)->first == interval_type::right_open(5, 35));
+  REQUIRE(shards.contains({interval_type::right_open(5, 35), 1}));
+
+  // Segments that meet at a bound are joined
+  shards.add({interval_type::right_open(35, 40), 2})
+      .add({interval_type::right_open(30, 35), 1});
+  map_type joined({interval_type::right_open(5, 30), 1});
+  joined.add({interval_type::right_open(30, 40), 2});
+  REQUIRE(shards.snapshot() == joined);
+  REQUIRE(shards.find(39)->first == interval_type::right_open(30, 40));
+  REQUIRE(shards.find(29)->first == interval_type::right_open(5, 30));
+  REQUIRE(!shards.find(40));
+  REQUIRE(shards.iterative_size() == 2);
+
+  shards.subtract({interval_type::right_open(10, 20), 1});
+  REQUIRE(shards.find(5)->first == interval_type::right_open(5, 10));
+  REQUIRE(shards.find(20)->first == interval_type::right_open(20, 30));
+
+  // Elements are updated in their shards
+  shards.add(map_type::element_type(40, 2)).subtract(
+      map_type::element_type(25, 1));
+  REQUIRE(shards.find(32)->first == interval_type::right_open(30, 41));
+  REQUIRE(shards.find(26)->first == interval_type::right_open(26, 30));
+  REQUIRE(shards(25) == 0);
+}
+
+// Threads that update the shards in parallel must give the container of
+// the updates in any order.
+TEST_CASE("Test Sharded Parallel Updates", "[sharded]") {
+  using map_type = icl::interval_map<int, int>;
+  using interval_type = map_type::interval_type;
+  std::vector<int> bounds;
+  for (int bound = 100; bound < 1000; bound += 100)
+    bounds.push_back(bound);
+  icl::sharded<map_type> shards(bounds);
+
+  constexpr int writers = 4;
+  std::vector<std::vector<map_type::segment_type>> added(writers);
+  std::atomic<bool> found{true};
+  std::vector<std::thread> threads;
+  for (int writer = 0; writer < writers; ++writer)
+    threads.emplace_back([&, writer] {
+      std::mt19937 gen(writer);
+      std::uniform_int_distribution<int> pos(0, 990);
+      std::uniform_int_distribution<int> len(1, 150);
+      for (int i = 0; i < 2000; ++i) {
+        const int lo = pos(gen);
+        const map_type::segment_type segment(
+            interval_type::right_open(lo, lo + len(gen)), 1 + i % 3);
+        shards.add(segment);
+        added[writer].push_back(segment);
+        if (i % 5 == 0 && !shards.find(lo))
+          found = false;
+      }
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+  REQUIRE(found);
+
+  map_type expected;
+  for (const auto& segments : added)
+    for (const map_type::segment_type& segment : segments)
+      expected.add(segment);
+  REQUIRE(shards.snapshot() == expected);
+  REQUIRE(shards.iterative_size() == expected.iterative_size());
+}
@@ -0,0 +1,170 @@
+#include "random_container.hpp"
+#include "icl/continuous_interval.hpp"
+#include "icl/interval_map.hpp"
+#include "icl/split_interval_map.hpp"
+#include "icl/versioned.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr icl_test::random_shape shape{.domain = 200};
+
+template <typename MapT>
+void random_update(icl::versioned<MapT>& object, MapT& expected,
+                   std::mt19937& gen) {
+  using domain_type = typename MapT::domain_type;
+  using segment_type = typename MapT::segment_type;
+  using element_type = typename MapT::element_type;
+  std::uniform_int_distribution<int> op(0, 7);
+  std::uniform_int_distribution<int> value(1, 3);
+  std::uniform_int_distribution<int> pos(0, 230);
+  const segment_type segment = icl_test::random_segment<MapT>(gen, shape);
+  const element_type element(static_cast<domain_type>(pos(gen)), value(gen));
+  switch (op(gen)) {
+  case 0:
+  case 1:
+    object.add(segment);
+    expected.add(segment);
+    break;
+  case 2:
+    object.subtract(segment);
+    expected.subtract(segment);
+    break;
+  case 3:
+    object.set(segment);
+    expected.set(segment);
+    break;
+  case 4:
+    object.erase(segment.first);
+    expected.erase(segment.first);
+    break;
+  case 5:
+    object.insert(segment);
+    expected.insert(segment);
+    break;
+  case 6:
+    object.add(element);
+    expected.add(element);
+    break;
+  default:
+    object.set(element);
+    expected.set(element);
+  }
+}
+
+} // namespace
+
+// Each version of a versioned map must be the map after as many updates,
+// as found by key, as a whole, and compared to other versions.
+template <typename MapT> void run_versioned_history() {
+  using domain_type = typename MapT::domain_type;
+  icl::versioned<MapT> object;
+  std::vector<MapT> versions(1);
+  MapT expected;
+  std::mt19937 gen(11);
+  for (int i = 0; i < 300; ++i) {
+    random_update(object, expected, gen);
+    versions.push_back(expected);
+  }
+  REQUIRE(object.version() == 300);
+  REQUIRE(object.oldest_version() == 0);
+  REQUIRE(object.current().container() == expected);
+
+  std::uniform_int_distribution<int> pick(0, 300);
+  for (int probe = 0; probe < 40; ++probe) {
+    const auto at = static_cast<std::size_t>(pick(gen));
+    REQUIRE(object.at(at).container() == versions[at]);
+    for (int point = probe % 4; point < 240; point += 9) {
+      const auto key = static_cast<domain_type>(point);
+      const auto found = object.find_at(at, key);
+      REQUIRE(found.has_value() ==
+              (versions[at].find(key) != versions[at].end()));
+      REQUIRE(found.value_or(0) == versions[at](key));
+    }
+
+    const auto other = static_cast<std::size_t>(pick(gen));
+    const auto difference = object.diff(at, other);
+    MapT removed = versions[at];
+    for (const auto& segment : versions[other])
+      removed.erase(segment);
+    MapT added = versions[other];
+    for (const auto& segment : versions[at])
+      added.erase(segment);
+    REQUIRE(icl::is_element_equal(difference.removed, removed));
+    REQUIRE(icl::is_element_equal(difference.added, added));
+  }
+  REQUIRE(object.diff(120, 120).removed.empty());
+}
+
+TEST_CASE("Test Versioned Map History", "[versioned]") {
+  run_versioned_history<icl::interval_map<int, int>>();
+  run_versioned_history<icl::split_interval_map<int, int>>();
+  run_versioned_history<icl::interval_map<int, int, icl::total_absorber>>();
+  run_versioned_history<icl::interval_map<double, int>>();
+}
+
+TEST_CASE("Test Versioned Map Changes", "[versioned]") {
+  using map_type = icl::interval_map<int, int>;
+  using interval_type = map_type::interval_type;
+  icl::versioned<map_type> object(
+      map_type({interval_type::right_open(0, 10), 1}));
+  object.add({interval_type::right_open(5, 15), 2})
+      .erase(interval_type::right_open(0, 3))
+      .set(map_type::element_type(12, 7));
+  REQUIRE(object.version() == 3);
+  REQUIRE(object.find_at(0, 12) == std::nullopt);
+  REQUIRE(object.find_at(1, 12) == 2);
+  REQUIRE(object.find_at(3, 12) == 7);
+  REQUIRE(object.find_at(1, 1) == 1);
+  REQUIRE(object.find_at(2, 1) == std::nullopt);
+  REQUIRE(object.find_at(3, 7) == 3);
+
+  const auto difference = object.diff(0, 3);
+  REQUIRE(difference.removed ==
+          map_type({interval_type::right_open(0, 3), 1})
+              .add({interval_type::right_open(5, 10), 1}));
+  REQUIRE(difference.added ==
+          map_type({interval_type::right_open(5, 10), 3})
+              .add({interval_type::right_open(10, 12), 2})
+              .add({interval_type::right_open(12, 13), 7})
+              .add({interval_type::right_open(13, 15), 2}));
+}
+
+// Versions older than the retention are dropped, the others are kept.
+TEST_CASE("Test Versioned Map Retention", "[versioned]") {
+  using map_type = icl::interval_map<int, int>;
+  icl::versioned<map_type> object;
+  std::vector<map_type> versions(1);
+  map_type expected;
+  std::mt19937 gen(2);
+  object.retain(100);
+  REQUIRE(object.retention() == 100);
+  for (int i = 0; i < 1000; ++i) {
+    random_update(object, expected, gen);
+    versions.push_back(expected);
+    REQUIRE((object.oldest_version() + 100 <= object.version() ||
+             object.oldest_version() == 0));
+    REQUIRE(object.version() - object.oldest_version() <
+            100 + icl::versioned<map_type>::checkpoint_interval);
+  }
+  for (auto at = object.oldest_version(); at <= object.version(); ++at) {
+    REQUIRE(object.at(at).container() == versions[at]);
+    REQUIRE(object.find_at(at, 100).has_value() ==
+            icl::contains(versions[at], 100));
+  }
+
+  object.retain(10);
+  REQUIRE(object.oldest_version() == 990);
+  REQUIRE(object.at(990).container() == versions[990]);
+  REQUIRE(object.diff(990, 1000).added ==
+          [&] {
+            map_type added = versions[1000];
+            for (const auto& segment : versions[990])
+              added.erase(segment);
+            return added;
+          }());
+  object.compact();
+  REQUIRE(object.oldest_version() == 990);
+}